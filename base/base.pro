@@ -11,11 +11,13 @@ SOURCES += \
     base.cpp \
     condition.cpp \
     exception.cpp \
+    fork_join_pool.cpp \
     internal/message.cpp \
     logging.cpp \
     lower_case.cpp \
     normalize_unicode.cpp \
     object_tracker.cpp \
+    priority_thread_pool.cpp \
     shared_buffer_manager.cpp \
     src_point.cpp \
     string_format.cpp \
@@ -40,6 +42,7 @@ HEADERS += \
     condition.hpp \
     const_helper.hpp \
     exception.hpp \
+    fork_join_pool.hpp \
     internal/message.hpp \
     limited_priority_queue.hpp \
     logging.hpp \
@@ -50,6 +53,7 @@ HEADERS += \
     mutex.hpp \
     object_tracker.hpp \
     observer_list.hpp \
+    priority_thread_pool.hpp \
     regexp.hpp \
     rolling_hash.hpp \
     scope_guard.hpp \
@@ -19,11 +19,13 @@ SOURCES += \
   condition_test.cpp \
   const_helper.cpp \
   containers_test.cpp \
+  fork_join_pool_test.cpp \
   logging_test.cpp \
   math_test.cpp \
   matrix_test.cpp \
   mem_trie_test.cpp \
   observer_list_test.cpp \
+  priority_thread_pool_test.cpp \
   regexp_test.cpp \
   rolling_hash_test.cpp \
   scope_guard_test.cpp \
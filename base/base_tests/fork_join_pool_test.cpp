@@ -0,0 +1,57 @@
+#include "testing/testing.hpp"
+
+#include "base/exception.hpp"
+#include "base/fork_join_pool.hpp"
+
+#include "std/atomic.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+DECLARE_EXCEPTION(TestException, RootException);
+}  // namespace
+
+UNIT_TEST(ForkJoinPool_Smoke)
+{
+  size_t const kThreadsCounts[] = {0, 1, 4};
+  for (size_t threadsCount : kThreadsCounts)
+  {
+    threads::ForkJoinPool pool(threadsCount);
+    TEST_EQUAL(pool.GetThreadsCount(), threadsCount, ());
+
+    vector<size_t> results(100, 0);
+    pool.ForEach(results.size(), [&results](size_t i) { results[i] = i * i; });
+    for (size_t i = 0; i < results.size(); ++i)
+      TEST_EQUAL(results[i], i * i, (threadsCount));
+
+    // Pool is reusable.
+    atomic<size_t> counter(0);
+    vector<threads::ForkJoinPool::TTask> tasks(10, [&counter]() { ++counter; });
+    pool.Run(tasks);
+    pool.Run(tasks);
+    TEST_EQUAL(counter, 20, (threadsCount));
+  }
+}
+
+UNIT_TEST(ForkJoinPool_Exception)
+{
+  threads::ForkJoinPool pool(4);
+
+  atomic<size_t> counter(0);
+  bool thrown = false;
+  try
+  {
+    pool.ForEach(10, [&counter](size_t i)
+    {
+      ++counter;
+      if (i == 5)
+        MYTHROW(TestException, ());
+    });
+  }
+  catch (TestException const &)
+  {
+    thrown = true;
+  }
+  TEST(thrown, ());
+  TEST_EQUAL(counter, 10, ());
+}
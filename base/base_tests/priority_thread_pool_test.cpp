@@ -0,0 +1,163 @@
+#include "testing/testing.hpp"
+
+#include "base/priority_thread_pool.hpp"
+#include "base/thread.hpp"
+
+#include "std/bind.hpp"
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+class Context
+{
+public:
+  void OnStarted(size_t id)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_started.push_back(id);
+    m_cv.notify_all();
+  }
+
+  void OnFinished(threads::IRoutine * routine)
+  {
+    delete routine;
+    lock_guard<mutex> lock(m_mutex);
+    ++m_finishedCount;
+    m_cv.notify_all();
+  }
+
+  void WaitStarted(size_t count)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this, count]() { return m_started.size() >= count; });
+  }
+
+  void WaitFinished(size_t count)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this, count]() { return m_finishedCount >= count; });
+  }
+
+  // Lets one of the blocked tasks finish.
+  void Release()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    ++m_releasesCount;
+    m_cv.notify_all();
+  }
+
+  void WaitReleased()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_releasesCount != 0; });
+    --m_releasesCount;
+  }
+
+  vector<size_t> m_started;
+  vector<double> m_priorities;
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  size_t m_finishedCount = 0;
+  size_t m_releasesCount = 0;
+};
+
+class Task : public threads::IRoutine
+{
+public:
+  Task(Context & context, size_t id, bool isBlocker = false)
+    : m_context(context), m_id(id), m_isBlocker(isBlocker)
+  {
+  }
+
+  // IRoutine overrides:
+  void Do() override
+  {
+    m_context.OnStarted(m_id);
+    if (m_isBlocker)
+      m_context.WaitReleased();
+  }
+
+  size_t GetId() const { return m_id; }
+
+private:
+  Context & m_context;
+  size_t const m_id;
+  bool const m_isBlocker;
+};
+
+double GetPriority(Context const & context, threads::IRoutine * routine)
+{
+  return context.m_priorities[static_cast<Task *>(routine)->GetId()];
+}
+}  // namespace
+
+UNIT_TEST(PriorityThreadPool_Order)
+{
+  Context context;
+  context.m_priorities = {0.0, 3.0, 1.0, 4.0, 2.0};
+  threads::PriorityThreadPool pool(1, bind(&GetPriority, cref(context), _1),
+                                   bind(&Context::OnFinished, &context, _1));
+
+  // The worker is busy with the first task while the others are queued.
+  pool.Push(new Task(context, 0, true /* isBlocker */));
+  context.WaitStarted(1);
+  for (size_t i = 1; i < context.m_priorities.size(); ++i)
+    pool.Push(new Task(context, i));
+
+  // Priorities of queued tasks are changed in place.
+  context.m_priorities[3] = 0.5;
+  pool.Reprioritize();
+
+  context.Release();
+  context.WaitFinished(context.m_priorities.size());
+  pool.Stop();
+
+  vector<size_t> const expected = {0, 3, 2, 4, 1};
+  TEST_EQUAL(context.m_started, expected, ());
+}
+
+UNIT_TEST(PriorityThreadPool_GlobalOrder)
+{
+  Context context;
+  context.m_priorities = {0.0, 0.0, 5.0, 1.0, 4.0, 2.0, 3.0};
+  threads::PriorityThreadPool pool(2, bind(&GetPriority, cref(context), _1),
+                                   bind(&Context::OnFinished, &context, _1));
+
+  // Both workers are busy while the others are queued.
+  pool.Push(new Task(context, 0, true /* isBlocker */));
+  pool.Push(new Task(context, 1, true /* isBlocker */));
+  context.WaitStarted(2);
+  for (size_t i = 2; i < context.m_priorities.size(); ++i)
+    pool.Push(new Task(context, i));
+
+  // The released worker runs all queued tasks in the order of their priorities,
+  // whichever worker they were pushed for.
+  context.Release();
+  context.WaitFinished(context.m_priorities.size() - 1);
+  context.Release();
+  context.WaitFinished(context.m_priorities.size());
+  pool.Stop();
+
+  vector<size_t> const started(context.m_started.begin() + 2, context.m_started.end());
+  vector<size_t> const expected = {3, 5, 6, 4, 2};
+  TEST_EQUAL(started, expected, ());
+}
+
+UNIT_TEST(PriorityThreadPool_Stop)
+{
+  Context context;
+  context.m_priorities.assign(10, 0.0);
+  // Without workers all tasks are finished on Stop.
+  threads::PriorityThreadPool pool(0, bind(&GetPriority, cref(context), _1),
+                                   bind(&Context::OnFinished, &context, _1));
+  for (size_t i = 0; i < context.m_priorities.size(); ++i)
+    pool.Push(new Task(context, i));
+  pool.Stop();
+
+  context.WaitFinished(context.m_priorities.size());
+  TEST(context.m_started.empty(), ());
+}
@@ -0,0 +1,114 @@
+#include "base/fork_join_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/thread.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/exception.hpp"
+#include "std/mutex.hpp"
+
+namespace threads
+{
+class ForkJoinPool::Batch
+{
+public:
+  explicit Batch(size_t count) : m_count(count) {}
+
+  void OnDone(exception_ptr const & ex)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (ex && !m_exception)
+      m_exception = ex;
+    ASSERT_GREATER(m_count, 0, ());
+    if (--m_count == 0)
+      m_cv.notify_one();
+  }
+
+  void Wait()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_count == 0; });
+    if (m_exception)
+      rethrow_exception(m_exception);
+  }
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  size_t m_count;
+  exception_ptr m_exception;
+};
+
+class ForkJoinPool::Task : public IRoutine
+{
+public:
+  Task(TTask const & task, Batch & batch) : m_task(task), m_batch(batch) {}
+
+  // IRoutine overrides:
+  void Do() override
+  {
+    try
+    {
+      m_task();
+    }
+    catch (...)
+    {
+      m_exception = current_exception();
+    }
+  }
+
+  void Finish() { m_batch.OnDone(m_exception); }
+
+private:
+  TTask const & m_task;
+  Batch & m_batch;
+  exception_ptr m_exception;
+};
+
+ForkJoinPool::ForkJoinPool(size_t threadsCount) : m_threadsCount(threadsCount)
+{
+  if (m_threadsCount != 0)
+    m_pool.reset(new ThreadPool(m_threadsCount, &ForkJoinPool::OnTaskFinished));
+}
+
+ForkJoinPool::~ForkJoinPool()
+{
+  if (m_pool)
+    m_pool->Stop();
+}
+
+void ForkJoinPool::Run(vector<TTask> const & tasks)
+{
+  if (tasks.empty())
+    return;
+
+  if (!m_pool || tasks.size() == 1)
+  {
+    for (auto const & task : tasks)
+      task();
+    return;
+  }
+
+  Batch batch(tasks.size());
+  for (auto const & task : tasks)
+    m_pool->PushBack(new Task(task, batch));
+  batch.Wait();
+}
+
+void ForkJoinPool::ForEach(size_t count, function<void(size_t)> const & fn)
+{
+  vector<TTask> tasks;
+  tasks.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    tasks.push_back([&fn, i]() { fn(i); });
+  Run(tasks);
+}
+
+// static
+void ForkJoinPool::OnTaskFinished(IRoutine * routine)
+{
+  Task * task = static_cast<Task *>(routine);
+  task->Finish();
+  delete task;
+}
+}  // namespace threads
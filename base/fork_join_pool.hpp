@@ -0,0 +1,47 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/thread_pool.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace threads
+{
+/// Fork-join wrapper around ThreadPool: runs a batch of tasks on the pool
+/// workers and blocks the caller until all of them are finished.
+/// Several threads may run their batches on the same pool simultaneously.
+class ForkJoinPool
+{
+public:
+  using TTask = function<void()>;
+
+  /// @param[in] threadsCount Number of workers. When it's zero, tasks are
+  ///            executed on the caller's thread.
+  explicit ForkJoinPool(size_t threadsCount);
+  ~ForkJoinPool();
+
+  inline size_t GetThreadsCount() const { return m_threadsCount; }
+
+  /// Runs all tasks and waits for them. Tasks are executed in an arbitrary order.
+  /// If some tasks throw, the first caught exception is rethrown after all tasks are done.
+  /// @note Don't call it from the tasks of the same pool, it may deadlock.
+  void Run(vector<TTask> const & tasks);
+
+  /// Runs fn(i) for every i in [0, count) and waits for them.
+  void ForEach(size_t count, function<void(size_t)> const & fn);
+
+private:
+  class Batch;
+  class Task;
+
+  static void OnTaskFinished(IRoutine * routine);
+
+  size_t const m_threadsCount;
+  unique_ptr<ThreadPool> m_pool;
+
+  DISALLOW_COPY_AND_MOVE(ForkJoinPool);
+};
+}  // namespace threads
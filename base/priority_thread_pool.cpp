@@ -0,0 +1,145 @@
+#include "base/priority_thread_pool.hpp"
+
+#include "base/thread.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace threads
+{
+class PriorityThreadPool::Impl
+{
+public:
+  Impl(size_t size, TPriorityFn const & priorityFn, TFinishRoutineFn const & finishFn)
+    : m_priorityFn(priorityFn)
+    , m_finishFn(finishFn)
+    , m_threads(size)
+    , m_stopped(false)
+  {
+    for (size_t i = 0; i < m_threads.size(); ++i)
+    {
+      m_threads[i].reset(new Thread());
+      m_threads[i]->Create(make_unique<Worker>(*this));
+    }
+  }
+
+  ~Impl() { Stop(); }
+
+  void Push(IRoutine * routine)
+  {
+    double const priority = m_priorityFn(routine);
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_tasks.emplace_back(priority, routine);
+      push_heap(m_tasks.begin(), m_tasks.end(), LessImportant());
+    }
+    m_cv.notify_one();
+  }
+
+  void Reprioritize()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (TTask & task : m_tasks)
+      task.first = m_priorityFn(task.second);
+    make_heap(m_tasks.begin(), m_tasks.end(), LessImportant());
+  }
+
+  void Stop()
+  {
+    vector<TTask> tasks;
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_stopped = true;
+      tasks.swap(m_tasks);
+    }
+    m_cv.notify_all();
+
+    for (auto & thread : m_threads)
+      thread->Cancel();
+    m_threads.clear();
+
+    for (TTask & task : tasks)
+    {
+      task.second->Cancel();
+      m_finishFn(task.second);
+    }
+  }
+
+private:
+  using TTask = pair<double, IRoutine *>;
+
+  // Heap order: the task with the smallest priority value is on the top.
+  struct LessImportant
+  {
+    bool operator()(TTask const & l, TTask const & r) const { return l.first > r.first; }
+  };
+
+  class Worker : public IRoutine
+  {
+  public:
+    explicit Worker(Impl & impl) : m_impl(impl) {}
+
+    // IRoutine overrides:
+    void Do() override
+    {
+      while (!IsCancelled())
+      {
+        IRoutine * task = m_impl.Pop();
+        if (task == nullptr)
+          break;
+
+        if (!task->IsCancelled())
+          task->Do();
+        m_impl.m_finishFn(task);
+      }
+    }
+
+  private:
+    Impl & m_impl;
+  };
+
+  // Blocks until there is a task or the pool is stopped, returns nullptr in the latter case.
+  IRoutine * Pop()
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_stopped || !m_tasks.empty(); });
+    if (m_stopped)
+      return nullptr;
+
+    pop_heap(m_tasks.begin(), m_tasks.end(), LessImportant());
+    IRoutine * task = m_tasks.back().second;
+    m_tasks.pop_back();
+    return task;
+  }
+
+  TPriorityFn m_priorityFn;
+  TFinishRoutineFn m_finishFn;
+
+  vector<unique_ptr<Thread>> m_threads;
+
+  // Guards m_tasks and m_stopped.
+  mutex m_mutex;
+  condition_variable m_cv;
+  // Queued tasks of all workers, a heap ordered by LessImportant.
+  vector<TTask> m_tasks;
+  bool m_stopped;
+};
+
+PriorityThreadPool::PriorityThreadPool(size_t size, TPriorityFn const & priorityFn,
+                                       TFinishRoutineFn const & finishFn)
+  : m_impl(new Impl(size, priorityFn, finishFn))
+{
+}
+
+PriorityThreadPool::~PriorityThreadPool() { delete m_impl; }
+
+void PriorityThreadPool::Push(IRoutine * routine) { m_impl->Push(routine); }
+
+void PriorityThreadPool::Reprioritize() { m_impl->Reprioritize(); }
+
+void PriorityThreadPool::Stop() { m_impl->Stop(); }
+}  // namespace threads
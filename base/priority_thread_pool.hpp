@@ -0,0 +1,40 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/thread_pool.hpp"
+
+#include "std/function.hpp"
+
+namespace threads
+{
+/// Thread pool which runs the most important tasks first. All workers share one
+/// priority queue, so every free worker takes the task with the smallest priority
+/// value among all queued tasks.
+class PriorityThreadPool
+{
+public:
+  /// Returns priority of the task, tasks with smaller values are run first.
+  /// It's called on the threads which push tasks or reprioritize the pool.
+  using TPriorityFn = function<double(IRoutine *)>;
+
+  PriorityThreadPool(size_t size, TPriorityFn const & priorityFn,
+                     TFinishRoutineFn const & finishFn);
+  ~PriorityThreadPool();
+
+  /// The pool doesn't delete routines, it can be done in finishFn.
+  void Push(IRoutine * routine);
+
+  /// Recalculates priorities of all queued tasks, e.g. when the data the priority
+  /// function depends on has been changed.
+  void Reprioritize();
+
+  /// Cancels queued tasks and calls finishFn for them.
+  void Stop();
+
+private:
+  class Impl;
+  Impl * m_impl;
+
+  DISALLOW_COPY_AND_MOVE(PriorityThreadPool);
+};
+}  // namespace threads
@@ -62,8 +62,10 @@ HEADERS += \
     file_reader.hpp \
     file_reader_stream.hpp \
     file_sort.hpp \
+    parallel_file_sort.hpp \
     file_writer.hpp \
     file_writer_stream.hpp \
+    flat_trie.hpp \
     hex.hpp \
     huffman.hpp \
     internal/file64_api.hpp \
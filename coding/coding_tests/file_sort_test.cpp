@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 
 #include "coding/file_sort.hpp"
+#include "coding/parallel_file_sort.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/reader.hpp"
 
@@ -28,6 +29,21 @@ namespace
     reader.Read(0, &result[0], reader.Size());
     TEST_EQUAL(result, data, ());
   }
+
+  void TestParallelFileSorter(vector<uint32_t> data, char const * tmpFileName, size_t memoryBytes,
+                              size_t threadsCount)
+  {
+    vector<uint32_t> result;
+    auto out = [&result](uint32_t v) { result.push_back(v); };
+    ParallelFileSorter<uint32_t, decltype(out)> sorter(memoryBytes, tmpFileName, out,
+                                                       threadsCount);
+    for (uint32_t v : data)
+      sorter.Add(v);
+    sorter.SortAndFinish();
+
+    sort(data.begin(), data.end());
+    TEST_EQUAL(result, data, ());
+  }
 }
 
 UNIT_TEST(FileSorter_Smoke)
@@ -49,3 +65,25 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(ParallelFileSorter_Smoke)
+{
+  TestParallelFileSorter({}, "parallel_file_sorter_test_empty.tmp", 1024, 4);
+  TestParallelFileSorter({2, 3, 1}, "parallel_file_sorter_test_smoke.tmp", 1024, 4);
+}
+
+UNIT_TEST(ParallelFileSorter_Random)
+{
+  mt19937 rng(0);
+  vector<uint32_t> data(10000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = (i % 7 == 0 && i != 0) ? data[i - 1] : rng();
+
+  for (size_t threadsCount : {0, 1, 3, 8})
+  {
+    // Many runs with small merge buffers.
+    TestParallelFileSorter(data, "parallel_file_sorter_test_random.tmp", 1000, threadsCount);
+    // One flush of the whole data.
+    TestParallelFileSorter(data, "parallel_file_sorter_test_random.tmp", 1 << 20, threadsCount);
+  }
+}
@@ -1,4 +1,5 @@
 #include "testing/testing.hpp"
+#include "coding/flat_trie.hpp"
 #include "coding/trie.hpp"
 #include "coding/trie_builder.hpp"
 #include "coding/trie_reader.hpp"
@@ -270,3 +271,60 @@ UNIT_TEST(TrieBuilder_Build)
     TEST_EQUAL(maxEdgeValue, expectedMaxEdgeValue, (v, f.m_v));
   }
 }
+
+UNIT_TEST(FlatTrie_Smoke)
+{
+  vector<string> const keys = {"", "A", "AB", "ABC", "ABCD", "ABD", "AC", "B", "BAA", "BAB", "C"};
+  vector<KeyValuePair> v;
+  for (size_t i = 0; i < keys.size(); ++i)
+    v.push_back(KeyValuePair(keys[i], static_cast<int>(i)));
+
+  vector<uint8_t> serial;
+  PushBackByteSink<vector<uint8_t> > sink(serial);
+  trie::Build<PushBackByteSink<vector<uint8_t>>, typename vector<KeyValuePair>::iterator,
+              trie::MaxValueEdgeBuilder<MaxValueCalc>, Uint32ValueList>(
+      sink, v.begin(), v.end(), trie::MaxValueEdgeBuilder<MaxValueCalc>());
+  reverse(serial.begin(), serial.end());
+
+  MemReader memReader = MemReader(&serial[0], serial.size());
+  using TValue = trie::FixedSizeValueReader<4>::ValueType;
+  using TEdgeValue = trie::FixedSizeValueReader<1>::ValueType;
+  using IteratorType = trie::Iterator<TValue, TEdgeValue>;
+  unique_ptr<IteratorType> const root(trie::ReadTrie(memReader, trie::FixedSizeValueReader<4>(),
+                                                     trie::FixedSizeValueReader<1>()));
+  trie::FlatTrie<TValue, TEdgeValue> const flatTrie(*root);
+  TEST_EQUAL(flatTrie.GetValuesCount(), v.size(), ());
+
+  // The generic interface enumerates the same key-value pairs.
+  {
+    unique_ptr<IteratorType> const flatRoot(flatTrie.CreateRootIterator());
+    KeyValuePairBackInserter f;
+    trie::ForEachRef(*flatRoot, f, vector<trie::TrieChar>());
+    sort(f.m_v.begin(), f.m_v.end());
+    TEST_EQUAL(v, f.m_v, ());
+  }
+
+  auto const subtreeValues = [&flatTrie](string const & prefix)
+  {
+    vector<uint32_t> values;
+    auto node = flatTrie.GetRoot();
+    if (!flatTrie.MoveToString(node, prefix.data(), prefix.size()))
+      return values;
+    flatTrie.ForEachValueInSubtree(node, [&values](TValue const & rawValue)
+    {
+      uint32_t value;
+      memcpy(&value, &rawValue, 4);
+      values.push_back(value);
+    });
+    sort(values.begin(), values.end());
+    return values;
+  };
+
+  TEST_EQUAL(subtreeValues(""), vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}), ());
+  TEST_EQUAL(subtreeValues("AB"), vector<uint32_t>({2, 3, 4, 5}), ());
+  TEST_EQUAL(subtreeValues("ABC"), vector<uint32_t>({3, 4}), ());
+  TEST_EQUAL(subtreeValues("BA"), vector<uint32_t>({8, 9}), ());
+  TEST_EQUAL(subtreeValues("C"), vector<uint32_t>({10}), ());
+  TEST(subtreeValues("AD").empty(), ());
+  TEST(subtreeValues("ABCDE").empty(), ());
+}
@@ -71,3 +71,53 @@ UNIT_TEST(VarRecordReader_Simple)
     TEST_EQUAL(forEachCalls, expectedForEachCalls, ());
   }
 }
+
+UNIT_TEST(VarRecordReader_ForEachRecordAt)
+{
+  vector<char> data;
+  vector<uint64_t> allPositions;
+  vector<string> records;
+  {
+    MemWriter<vector<char> > writer(data);
+    for (size_t i = 0; i < 100; ++i)
+    {
+      string const record(i * 7 % 300, static_cast<char>('a' + i % 26));
+      allPositions.push_back(writer.Pos());
+      records.push_back(record);
+      WriteVarUint(writer, static_cast<uint32_t>(record.size()));
+      writer.Write(record.data(), record.size());
+    }
+  }
+
+  vector<uint64_t> positions;
+  vector<string> expected;
+  for (size_t i = 0; i < allPositions.size(); i += 3)
+  {
+    positions.push_back(allPositions[i]);
+    expected.push_back(records[i]);
+    // Duplicates are allowed.
+    if (i % 10 == 0)
+    {
+      positions.push_back(allPositions[i]);
+      expected.push_back(records[i]);
+    }
+  }
+
+  uint32_t const chunkSizes[] = {4, 5, 64, 256, 1000};
+  uint32_t const maxGaps[] = {0, 64, 1024};
+  for (uint32_t chunkSize : chunkSizes)
+  {
+    for (uint32_t maxGap : maxGaps)
+    {
+      MemReader reader(&data[0], data.size());
+      VarRecordReader<MemReader, &VarRecordSizeReaderVarint> recordReader(reader, chunkSize);
+
+      vector<string> actual(positions.size());
+      recordReader.ForEachRecordAt(positions, [&actual](size_t i, char const * p, uint32_t size)
+      {
+        actual[i].assign(p, p + size);
+      }, maxGap, 4096 /* maxChunkSize */);
+      TEST_EQUAL(actual, expected, (chunkSize, maxGap));
+    }
+  }
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "coding/trie.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace trie
+{
+/// In-memory copy of a trie, built once from any trie::Iterator.
+///
+/// Nodes are numbered in DFS preorder, so every subtree is a contiguous range of nodes and
+/// its values are a contiguous range of m_values. Edges of a node are contiguous too and
+/// their first symbols are kept in a separate array to scan them without touching the rest.
+/// All arrays are flat, so navigation is allocation-free and needs no decoding.
+template <typename ValueT, typename EdgeValueT>
+class FlatTrie
+{
+public:
+  using TNodeId = uint32_t;
+
+  struct Node
+  {
+    uint32_t m_firstEdge;
+    uint32_t m_firstValue;
+    // Node id past the last node of the subtree.
+    TNodeId m_subtreeEnd;
+  };
+
+  /// Adapter to the generic trie interface, so all existing trie algorithms work with
+  /// the flat trie. It copies edges of a node from the flat arrays instead of decoding them.
+  class Iterator : public trie::Iterator<ValueT, EdgeValueT>
+  {
+  public:
+    Iterator(FlatTrie const & trie, TNodeId node) : m_trie(trie), m_node(node)
+    {
+      m_trie.ForEachValue(m_node, [this](ValueT const & v) { this->m_value.push_back(v); });
+      uint32_t const firstEdge = m_trie.m_nodes[m_node].m_firstEdge;
+      uint32_t const edgesCount = m_trie.GetEdgesCount(m_node);
+      this->m_edge.resize(edgesCount);
+      for (uint32_t i = 0; i < edgesCount; ++i)
+      {
+        auto & edge = this->m_edge[i];
+        uint32_t const e = firstEdge + i;
+        edge.m_str.assign(m_trie.m_chars.begin() + m_trie.m_edgeChars[e],
+                          m_trie.m_chars.begin() + m_trie.m_edgeChars[e + 1]);
+        edge.m_value = m_trie.m_edgeValues[e];
+      }
+    }
+
+    trie::Iterator<ValueT, EdgeValueT> * Clone() const override { return new Iterator(*this); }
+
+    trie::Iterator<ValueT, EdgeValueT> * GoToEdge(size_t i) const override
+    {
+      return new Iterator(m_trie, m_trie.GetChild(m_node, static_cast<uint32_t>(i)));
+    }
+
+    inline FlatTrie const & GetTrie() const { return m_trie; }
+    inline TNodeId GetNode() const { return m_node; }
+
+  private:
+    FlatTrie const & m_trie;
+    TNodeId m_node;
+  };
+
+  explicit FlatTrie(trie::Iterator<ValueT, EdgeValueT> const & root)
+  {
+    m_edgeChars.push_back(0);
+    AddNode(root);
+    // Sentinel node.
+    m_nodes.push_back({static_cast<uint32_t>(m_edgeChild.size()),
+                       static_cast<uint32_t>(m_values.size()), 0});
+
+    m_nodes.shrink_to_fit();
+    m_values.shrink_to_fit();
+    m_edgeChild.shrink_to_fit();
+    m_edgeChars.shrink_to_fit();
+    m_edgeFirstChar.shrink_to_fit();
+    m_edgeValues.shrink_to_fit();
+    m_chars.shrink_to_fit();
+  }
+
+  inline TNodeId GetRoot() const { return 0; }
+
+  /// @return Iterator to the root for the generic trie algorithms.
+  trie::Iterator<ValueT, EdgeValueT> * CreateRootIterator() const
+  {
+    return new Iterator(*this, GetRoot());
+  }
+
+  inline uint32_t GetEdgesCount(TNodeId node) const
+  {
+    return m_nodes[node + 1].m_firstEdge - m_nodes[node].m_firstEdge;
+  }
+
+  inline TNodeId GetChild(TNodeId node, uint32_t i) const
+  {
+    ASSERT_LESS(i, GetEdgesCount(node), ());
+    return m_edgeChild[m_nodes[node].m_firstEdge + i];
+  }
+
+  /// @return Index of the edge of the node starting with c or GetEdgesCount(node).
+  uint32_t FindEdge(TNodeId node, TrieChar c) const
+  {
+    uint32_t const first = m_nodes[node].m_firstEdge;
+    uint32_t const count = GetEdgesCount(node);
+    TrieChar const * chars = m_edgeFirstChar.data() + first;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      if (chars[i] == c)
+        return i;
+    }
+    return count;
+  }
+
+  /// Moves from node along the symbols [s, s + size).
+  /// @return false if there is no such path. Otherwise node is the deepest node on the path
+  /// and the symbols left are the prefix of its incoming edge.
+  template <typename TChar>
+  bool MoveToString(TNodeId & node, TChar const * s, size_t size) const
+  {
+    bool isNodeReached;
+    return Move(node, s, size, isNodeReached);
+  }
+
+  /// The same as MoveToString() but the path should end exactly at a node.
+  template <typename TChar>
+  bool MoveToNode(TNodeId & node, TChar const * s, size_t size) const
+  {
+    bool isNodeReached;
+    return Move(node, s, size, isNodeReached) && isNodeReached;
+  }
+
+  template <typename F>
+  void ForEachValue(TNodeId node, F && f) const
+  {
+    for (uint32_t i = m_nodes[node].m_firstValue; i < m_nodes[node + 1].m_firstValue; ++i)
+      f(m_values[i]);
+  }
+
+  /// Calls f for all values of the node and its descendants.
+  template <typename F>
+  void ForEachValueInSubtree(TNodeId node, F && f) const
+  {
+    uint32_t const end = m_nodes[m_nodes[node].m_subtreeEnd].m_firstValue;
+    for (uint32_t i = m_nodes[node].m_firstValue; i < end; ++i)
+      f(m_values[i]);
+  }
+
+  inline size_t GetNodesCount() const { return m_nodes.size() - 1; }
+  inline size_t GetValuesCount() const { return m_values.size(); }
+
+  size_t GetMemoryBytes() const
+  {
+    return m_nodes.capacity() * sizeof(Node) + m_values.capacity() * sizeof(ValueT) +
+           m_edgeChild.capacity() * sizeof(TNodeId) + m_edgeChars.capacity() * sizeof(uint32_t) +
+           m_edgeFirstChar.capacity() * sizeof(TrieChar) +
+           m_edgeValues.capacity() * sizeof(EdgeValueT) + m_chars.capacity() * sizeof(TrieChar);
+  }
+
+private:
+  template <typename TChar>
+  bool Move(TNodeId & node, TChar const * s, size_t size, bool & isNodeReached) const
+  {
+    isNodeReached = true;
+    size_t i = 0;
+    while (i < size)
+    {
+      uint32_t const edge = FindEdge(node, static_cast<TrieChar>(s[i]));
+      if (edge == GetEdgesCount(node))
+        return false;
+
+      uint32_t const e = m_nodes[node].m_firstEdge + edge;
+      uint32_t const length = m_edgeChars[e + 1] - m_edgeChars[e];
+      TrieChar const * chars = m_chars.data() + m_edgeChars[e];
+      for (uint32_t j = 0; j < length; ++j, ++i)
+      {
+        if (i == size)
+        {
+          isNodeReached = false;
+          break;
+        }
+        if (chars[j] != static_cast<TrieChar>(s[i]))
+          return false;
+      }
+      node = m_edgeChild[e];
+    }
+    return true;
+  }
+
+  TNodeId AddNode(trie::Iterator<ValueT, EdgeValueT> const & it)
+  {
+    TNodeId const node = static_cast<TNodeId>(m_nodes.size());
+    uint32_t const firstEdge = static_cast<uint32_t>(m_edgeChild.size());
+    m_nodes.push_back({firstEdge, static_cast<uint32_t>(m_values.size()), 0});
+    m_values.insert(m_values.end(), it.m_value.begin(), it.m_value.end());
+
+    for (auto const & edge : it.m_edge)
+    {
+      ASSERT(!edge.m_str.empty(), ());
+      m_edgeChild.push_back(0);
+      m_edgeFirstChar.push_back(edge.m_str[0]);
+      m_edgeValues.push_back(edge.m_value);
+      m_chars.insert(m_chars.end(), edge.m_str.begin(), edge.m_str.end());
+      m_edgeChars.push_back(static_cast<uint32_t>(m_chars.size()));
+    }
+
+    for (size_t i = 0; i < it.m_edge.size(); ++i)
+    {
+      unique_ptr<trie::Iterator<ValueT, EdgeValueT>> const child(it.GoToEdge(i));
+      TNodeId const childNode = AddNode(*child);
+      m_edgeChild[firstEdge + i] = childNode;
+    }
+
+    m_nodes[node].m_subtreeEnd = static_cast<TNodeId>(m_nodes.size());
+    return node;
+  }
+
+  vector<Node> m_nodes;
+  vector<ValueT> m_values;
+
+  // Edges data, indexed by edge id.
+  vector<TNodeId> m_edgeChild;
+  // Symbols of edge e are [m_edgeChars[e], m_edgeChars[e + 1]) in m_chars.
+  vector<uint32_t> m_edgeChars;
+  vector<TrieChar> m_edgeFirstChar;
+  vector<EdgeValueT> m_edgeValues;
+  vector<TrieChar> m_chars;
+};
+}  // namespace trie
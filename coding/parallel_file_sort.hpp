@@ -0,0 +1,254 @@
+#pragma once
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/fork_join_pool.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/functional.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+/// External sorter of fixed-size items.
+///
+/// Items are accumulated in a buffer of memoryBytes. A full buffer is split into
+/// slices which are sorted in parallel and written to the temporary file as separate
+/// sorted runs. SortAndFinish merges all runs through a loser tree, so every output
+/// item costs log2(runs count) comparisons, and passes the items to the output sink.
+template <typename T, class OutputSinkT = FileWriter, typename LessT = less<T>>
+class ParallelFileSorter
+{
+public:
+  /// @param[in] memoryBytes Memory budget for run generation and for merge buffers.
+  /// @param[in] threadsCount Number of sorting threads, 0 means caller's thread only.
+  ParallelFileSorter(size_t memoryBytes, string const & tmpFileName, OutputSinkT & outputSink,
+                     size_t threadsCount, LessT less = LessT())
+    : m_tmpFileName(tmpFileName)
+    , m_memoryBytes(memoryBytes)
+    , m_bufferCapacity(
+          max(kMinItemsPerRun * max(threadsCount, size_t(1)), memoryBytes / sizeof(T)))
+    , m_outputSink(outputSink)
+    , m_less(less)
+    , m_pool(threadsCount)
+    , m_tmpWriter(new FileWriter(tmpFileName))
+  {
+  }
+
+  ~ParallelFileSorter()
+  {
+    if (m_tmpWriter)
+    {
+      try
+      {
+        SortAndFinish();
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, (e.Msg()));
+      }
+      catch (std::exception const & e)
+      {
+        LOG(LERROR, (e.what()));
+      }
+    }
+  }
+
+  void Add(T const & item)
+  {
+    if (m_buffer.size() == m_bufferCapacity)
+      FlushRuns();
+    m_buffer.push_back(item);
+  }
+
+  void SortAndFinish()
+  {
+    ASSERT(m_tmpWriter, ());
+    FlushRuns();
+    vector<T>().swap(m_buffer);
+    m_tmpWriter.reset();
+
+    {
+      FileReader reader(m_tmpFileName);
+      size_t const bufferItems =
+          max(kMinItemsPerRun, m_memoryBytes / sizeof(T) / max(m_runs.size(), size_t(1)));
+      vector<RunReader> runs;
+      runs.reserve(m_runs.size());
+      for (auto const & run : m_runs)
+        runs.emplace_back(reader, run.first, run.second, bufferItems);
+
+      LoserTree tree(runs, m_less);
+      while (!tree.IsEmpty())
+        m_outputSink(tree.PopTop());
+    }
+
+    m_runs.clear();
+    FileWriter::DeleteFileX(m_tmpFileName);
+  }
+
+private:
+  static size_t constexpr kMinItemsPerRun = 16;
+
+  /// Sequential reader of a sorted run with a read buffer.
+  class RunReader
+  {
+  public:
+    RunReader(FileReader const & reader, uint64_t first, uint64_t count, size_t bufferItems)
+      : m_reader(reader), m_next(first), m_end(first + count), m_bufferItems(bufferItems)
+    {
+      Fill();
+    }
+
+    bool IsEmpty() const { return m_pos == m_buffer.size(); }
+    T const & Top() const
+    {
+      ASSERT(!IsEmpty(), ());
+      return m_buffer[m_pos];
+    }
+
+    void Pop()
+    {
+      ASSERT(!IsEmpty(), ());
+      if (++m_pos == m_buffer.size())
+        Fill();
+    }
+
+  private:
+    void Fill()
+    {
+      m_pos = 0;
+      m_buffer.resize(
+          static_cast<size_t>(min(static_cast<uint64_t>(m_bufferItems), m_end - m_next)));
+      if (m_buffer.empty())
+        return;
+      m_reader.Read(m_next * sizeof(T), m_buffer.data(), m_buffer.size() * sizeof(T));
+      m_next += m_buffer.size();
+    }
+
+    FileReader const & m_reader;
+    uint64_t m_next;
+    uint64_t m_end;
+    size_t m_bufferItems;
+    vector<T> m_buffer;
+    size_t m_pos = 0;
+  };
+
+  /// Tournament tree which keeps losers of the matches in the inner nodes.
+  /// Leaf i is the node runs.size() + i, the overall winner is kept separately.
+  class LoserTree
+  {
+  public:
+    LoserTree(vector<RunReader> & runs, LessT const & less) : m_runs(runs), m_less(less)
+    {
+      size_t const count = m_runs.size();
+      if (count == 0)
+        return;
+
+      m_losers.resize(count);
+      vector<size_t> winners(2 * count);
+      for (size_t i = 0; i < count; ++i)
+        winners[count + i] = i;
+      for (size_t node = count - 1; node > 0; --node)
+      {
+        size_t const a = winners[2 * node];
+        size_t const b = winners[2 * node + 1];
+        if (Beats(b, a))
+        {
+          winners[node] = b;
+          m_losers[node] = a;
+        }
+        else
+        {
+          winners[node] = a;
+          m_losers[node] = b;
+        }
+      }
+      m_winner = winners[1];
+    }
+
+    bool IsEmpty() const { return m_runs.empty() || m_runs[m_winner].IsEmpty(); }
+
+    T PopTop()
+    {
+      T const item = m_runs[m_winner].Top();
+      m_runs[m_winner].Pop();
+
+      size_t winner = m_winner;
+      for (size_t node = (m_runs.size() + winner) / 2; node > 0; node /= 2)
+      {
+        if (Beats(m_losers[node], winner))
+          swap(m_losers[node], winner);
+      }
+      m_winner = winner;
+      return item;
+    }
+
+  private:
+    // Exhausted runs lose to everybody, ties are resolved by run index
+    // to make the output deterministic.
+    bool Beats(size_t a, size_t b) const
+    {
+      if (m_runs[a].IsEmpty())
+        return false;
+      if (m_runs[b].IsEmpty())
+        return true;
+      if (m_less(m_runs[a].Top(), m_runs[b].Top()))
+        return true;
+      if (m_less(m_runs[b].Top(), m_runs[a].Top()))
+        return false;
+      return a < b;
+    }
+
+    vector<RunReader> & m_runs;
+    LessT const & m_less;
+    vector<size_t> m_losers;
+    size_t m_winner = 0;
+  };
+
+  void FlushRuns()
+  {
+    if (m_buffer.empty())
+      return;
+
+    size_t const slicesCount =
+        min(max(m_pool.GetThreadsCount(), size_t(1)),
+            (m_buffer.size() + kMinItemsPerRun - 1) / kMinItemsPerRun);
+    size_t const sliceSize = (m_buffer.size() + slicesCount - 1) / slicesCount;
+    m_pool.ForEach(slicesCount, [this, sliceSize](size_t i)
+    {
+      auto const begin = m_buffer.begin() + min(m_buffer.size(), i * sliceSize);
+      auto const end = m_buffer.begin() + min(m_buffer.size(), (i + 1) * sliceSize);
+      sort(begin, end, m_less);
+    });
+
+    for (size_t i = 0; i * sliceSize < m_buffer.size(); ++i)
+    {
+      size_t const size = min(sliceSize, m_buffer.size() - i * sliceSize);
+      m_runs.emplace_back(m_tmpWriter->Pos() / sizeof(T), size);
+      m_tmpWriter->Write(&m_buffer[i * sliceSize], size * sizeof(T));
+    }
+    m_buffer.clear();
+  }
+
+  string const m_tmpFileName;
+  size_t const m_memoryBytes;
+  size_t const m_bufferCapacity;
+  OutputSinkT & m_outputSink;
+  LessT m_less;
+  threads::ForkJoinPool m_pool;
+  unique_ptr<FileWriter> m_tmpWriter;
+  vector<T> m_buffer;
+  // First item and items count of every sorted run in the temporary file.
+  vector<pair<uint64_t, uint64_t>> m_runs;
+
+  DISALLOW_COPY_AND_MOVE(ParallelFileSorter);
+};
+
+template <typename T, class OutputSinkT, typename LessT>
+size_t constexpr ParallelFileSorter<T, OutputSinkT, LessT>::kMinItemsPerRun;
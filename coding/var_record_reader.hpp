@@ -72,6 +72,60 @@ public:
     ASSERT_EQUAL(pos, m_ReaderSize, ());
   }
 
+  // Reads records at non-decreasing positions @positions. Records that are close to each other
+  // (not more than @maxGap bytes between starts of neighbours and not more than @maxChunkSize
+  // bytes from the start of the first one) are read with one Reader.Read() call.
+  // Calls f(i, data, size) for every positions[i] in the order of positions.
+  template <typename F>
+  void ForEachRecordAt(vector<uint64_t> const & positions, F const & f,
+                       uint32_t maxGap, uint32_t maxChunkSize) const
+  {
+    ASSERT(is_sorted(positions.begin(), positions.end()), ());
+
+    // Max size of the encoded record size.
+    uint32_t const kMaxSizeSize = 5;
+
+    vector<char> chunk;
+    vector<char> buffer;
+    size_t i = 0;
+    while (i < positions.size())
+    {
+      uint64_t const start = positions[i];
+      size_t j = i + 1;
+      while (j < positions.size() && positions[j] - positions[j - 1] <= maxGap &&
+             positions[j] - start <= maxChunkSize)
+      {
+        ++j;
+      }
+
+      uint64_t const end = min(m_ReaderSize, positions[j - 1] + m_ExpectedRecordSize);
+      ASSERT_LESS(start, end, ());
+      chunk.resize(static_cast<size_t>(end - start));
+      m_Reader.Read(start, &chunk[0], chunk.size());
+
+      for (; i < j; ++i)
+      {
+        size_t const pos = static_cast<size_t>(positions[i] - start);
+        if (pos + kMaxSizeSize <= chunk.size() || end == m_ReaderSize)
+        {
+          ArrayByteSource source(&chunk[pos]);
+          uint32_t const recordSize = VarRecordSizeReaderFn(source);
+          size_t const recordOffset = static_cast<size_t>(source.PtrC() - &chunk[0]);
+          if (recordOffset + recordSize <= chunk.size())
+          {
+            f(i, &chunk[recordOffset], recordSize);
+            continue;
+          }
+        }
+
+        // The record is not completely inside the chunk, read it separately.
+        uint32_t offset = 0, size = 0;
+        ReadRecord(positions[i], buffer, offset, size);
+        f(i, &buffer[offset], size - offset);
+      }
+    }
+  }
+
   bool IsEqual(string const & fName) const { return m_Reader.IsEqual(fName); }
 
 protected:
@@ -25,6 +25,7 @@
 #define METADATA_INDEX_FILE_TAG "metaidx"
 #define COMPRESSED_SEARCH_INDEX_FILE_TAG "csdx"
 #define FEATURE_OFFSETS_FILE_TAG "offs"
+#define STREET_HOUSES_FILE_TAG "strhouses"
 
 #define ROUTING_MATRIX_FILE_TAG "mercedes"
 #define ROUTING_EDGEDATA_FILE_TAG "daewoo"
@@ -35,6 +36,8 @@
 #define ROUTING_FTSEG_FILE_TAG  "ftseg"
 #define ROUTING_NODEIND_TO_FTSEGIND_FILE_TAG  "node2ftseg"
 
+#define ROUTING_LANDMARKS_FILE_TAG "landmarks"
+
 #define READY_FILE_EXTENSION ".ready"
 #define RESUME_FILE_EXTENSION ".resume"
 #define DOWNLOADING_FILE_EXTENSION ".downloading"
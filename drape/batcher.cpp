@@ -98,9 +98,11 @@ private:
 
 ////////////////////////////////////////////////////////////////
 
-Batcher::Batcher(uint32_t indexBufferSize, uint32_t vertexBufferSize)
+Batcher::Batcher(uint32_t indexBufferSize, uint32_t vertexBufferSize,
+                 ref_ptr<CPUBufferPool> bufferPool)
   : m_indexBufferSize(indexBufferSize)
   , m_vertexBufferSize(vertexBufferSize)
+  , m_bufferPool(bufferPool)
 {
 }
 
@@ -180,7 +182,8 @@ ref_ptr<RenderBucket> Batcher::GetBucket(GLState const & state)
   if (it != m_buckets.end())
     return make_ref(it->second);
 
-  drape_ptr<VertexArrayBuffer> vao = make_unique_dp<VertexArrayBuffer>(m_indexBufferSize, m_vertexBufferSize);
+  drape_ptr<VertexArrayBuffer> vao = make_unique_dp<VertexArrayBuffer>(m_indexBufferSize, m_vertexBufferSize,
+                                                                       m_bufferPool);
   drape_ptr<RenderBucket> buffer = make_unique_dp<RenderBucket>(move(vao));
   ref_ptr<RenderBucket> result = make_ref(buffer);
   m_buckets.emplace(state, move(buffer));
@@ -246,11 +249,16 @@ IndicesRange Batcher::InsertTriangles(GLState const & state, ref_ptr<AttributePr
   return range;
 }
 
+BatcherFactory::BatcherFactory(ref_ptr<CPUBufferPool> bufferPool)
+  : m_bufferPool(bufferPool)
+{
+}
+
 Batcher * BatcherFactory::GetNew() const
 {
   uint32_t const kIndexBufferSize = 5000;
   uint32_t const kVertexBufferSize = 5000;
-  return new Batcher(kIndexBufferSize, kVertexBufferSize);
+  return new Batcher(kIndexBufferSize, kVertexBufferSize, m_bufferPool);
 }
 
 SessionGuard::SessionGuard(Batcher & batcher, const Batcher::TFlushFn & flusher)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drape/attribute_provider.hpp"
+#include "drape/cpu_buffer_pool.hpp"
 #include "drape/glstate.hpp"
 #include "drape/overlay_handle.hpp"
 #include "drape/pointers.hpp"
@@ -26,7 +27,9 @@ public:
   static uint32_t const IndexPerQuad = 6;
   static uint32_t const VertexPerQuad = 4;
 
-  Batcher(uint32_t indexBufferSize, uint32_t vertexBufferSize);
+  /// Memory of CPU buffers is taken from bufferPool if it's set.
+  Batcher(uint32_t indexBufferSize, uint32_t vertexBufferSize,
+          ref_ptr<CPUBufferPool> bufferPool = nullptr);
   ~Batcher();
 
   void InsertTriangleList(GLState const & state, ref_ptr<AttributeProvider> params);
@@ -70,12 +73,18 @@ private:
 
   uint32_t m_indexBufferSize;
   uint32_t m_vertexBufferSize;
+  ref_ptr<CPUBufferPool> m_bufferPool;
 };
 
 class BatcherFactory
 {
 public:
+  BatcherFactory(ref_ptr<CPUBufferPool> bufferPool = nullptr);
+
   Batcher * GetNew() const;
+
+private:
+  ref_ptr<CPUBufferPool> m_bufferPool;
 };
 
 class SessionGuard
@@ -9,18 +9,25 @@
 namespace dp
 {
 
-CPUBuffer::CPUBuffer(uint8_t elementSize, uint32_t capacity)
+CPUBuffer::CPUBuffer(uint8_t elementSize, uint32_t capacity, ref_ptr<CPUBufferPool> pool)
   : TBase(elementSize, capacity)
+  , m_pool(pool)
 {
   uint32_t memorySize = my::NextPowOf2(GetCapacity() * GetElementSize());
-  m_memory = SharedBufferManager::instance().reserveSharedBuffer(memorySize);
+  if (m_pool != nullptr)
+    m_memory = m_pool->Reserve(memorySize);
+  else
+    m_memory = SharedBufferManager::instance().reserveSharedBuffer(memorySize);
   m_memoryCursor = NonConstData();
 }
 
 CPUBuffer::~CPUBuffer()
 {
   m_memoryCursor = NULL;
-  SharedBufferManager::instance().freeSharedBuffer(m_memory->size(), m_memory);
+  if (m_pool != nullptr)
+    m_pool->Free(move(m_memory));
+  else
+    SharedBufferManager::instance().freeSharedBuffer(m_memory->size(), m_memory);
 }
 
 void CPUBuffer::UploadData(void const * data, uint32_t elementCount)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "drape/buffer_base.hpp"
+#include "drape/cpu_buffer_pool.hpp"
+#include "drape/pointers.hpp"
 
 #include "std/vector.hpp"
 #include "std/shared_ptr.hpp"
@@ -12,7 +14,8 @@ class CPUBuffer : public BufferBase
 {
   typedef BufferBase TBase;
 public:
-  CPUBuffer(uint8_t elementSize, uint32_t capacity);
+  /// Memory is taken from the pool if it's set, otherwise from SharedBufferManager.
+  CPUBuffer(uint8_t elementSize, uint32_t capacity, ref_ptr<CPUBufferPool> pool = nullptr);
   ~CPUBuffer();
 
   void UploadData(void const * data, uint32_t elementCount);
@@ -30,6 +33,7 @@ private:
 private:
   unsigned char * m_memoryCursor;
   shared_ptr<vector<unsigned char> > m_memory;
+  ref_ptr<CPUBufferPool> m_pool;
 };
 
 } //namespace dp
@@ -0,0 +1,39 @@
+#include "drape/cpu_buffer_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+namespace dp
+{
+
+CPUBufferPool::TMemory CPUBufferPool::Reserve(uint32_t size)
+{
+  uint32_t const sizeClass = my::NextPowOf2(size);
+  vector<TMemory> & freeMemory = m_freeMemory[sizeClass];
+  if (freeMemory.empty())
+  {
+    ++m_stats.m_allocationsCount;
+    m_stats.m_allocatedBytes += sizeClass;
+    return make_shared<SharedBufferManager::shared_buffer_t>(sizeClass);
+  }
+
+  ++m_stats.m_reusesCount;
+  TMemory memory = move(freeMemory.back());
+  freeMemory.pop_back();
+  return memory;
+}
+
+void CPUBufferPool::Free(TMemory && memory)
+{
+  ASSERT(memory != nullptr, ());
+  uint32_t const sizeClass = static_cast<uint32_t>(memory->size());
+  ASSERT_EQUAL(sizeClass, my::NextPowOf2(sizeClass), ());
+  m_freeMemory[sizeClass].push_back(move(memory));
+}
+
+void CPUBufferPool::Clear()
+{
+  m_freeMemory.clear();
+}
+
+} // namespace dp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "base/shared_buffer_manager.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/noncopyable.hpp"
+#include "std/vector.hpp"
+
+namespace dp
+{
+
+/// Size-classed pool of memory of CPU buffers. Memory returns to the pool when a CPU buffer is
+/// destroyed (i.e. when its data is moved to GPU), so next batching sessions reuse it instead of
+/// allocating. Sizes are rounded up to the power of two.
+/// Not thread safe: buffers of the pool must be created and destroyed on one thread.
+class CPUBufferPool : private noncopyable
+{
+public:
+  using TMemory = SharedBufferManager::shared_buffer_ptr_t;
+
+  struct Stats
+  {
+    // Count of memory blocks allocated by the pool.
+    uint32_t m_allocationsCount = 0;
+    // Count of memory blocks taken from the pool without allocation.
+    uint32_t m_reusesCount = 0;
+    uint64_t m_allocatedBytes = 0;
+  };
+
+  TMemory Reserve(uint32_t size);
+  void Free(TMemory && memory);
+
+  /// Releases all the free memory of the pool.
+  void Clear();
+
+  Stats const & GetStats() const { return m_stats; }
+
+private:
+  map<uint32_t, vector<TMemory>> m_freeMemory;
+  Stats m_stats;
+};
+
+} // namespace dp
@@ -4,8 +4,8 @@
 namespace dp
 {
 
-DataBuffer::DataBuffer(uint8_t elementSize, uint32_t capacity)
-  : m_impl(make_unique_dp<CpuBufferImpl>(elementSize, capacity))
+DataBuffer::DataBuffer(uint8_t elementSize, uint32_t capacity, ref_ptr<CPUBufferPool> pool)
+  : m_impl(make_unique_dp<CpuBufferImpl>(elementSize, capacity, pool))
 {
 }
 
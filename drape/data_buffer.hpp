@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape/cpu_buffer_pool.hpp"
 #include "drape/pointers.hpp"
 #include "drape/gpu_buffer.hpp"
 
@@ -30,7 +31,7 @@ public:
 class DataBuffer
 {
 public:
-  DataBuffer(uint8_t elementSize, uint32_t capacity);
+  DataBuffer(uint8_t elementSize, uint32_t capacity, ref_ptr<CPUBufferPool> pool = nullptr);
 
   ref_ptr<DataBufferBase> GetBuffer() const;
   void MoveToGPU(GPUBuffer::Target target);
@@ -14,6 +14,7 @@ SOURCES += \
     $$DRAPE_DIR/buffer_base.cpp \
     $$DRAPE_DIR/color.cpp \
     $$DRAPE_DIR/cpu_buffer.cpp \
+    $$DRAPE_DIR/cpu_buffer_pool.cpp \
     $$DRAPE_DIR/data_buffer.cpp \
     $$DRAPE_DIR/debug_rect_renderer.cpp \
     $$DRAPE_DIR/font_texture.cpp \
@@ -60,6 +61,7 @@ HEADERS += \
     $$DRAPE_DIR/buffer_base.hpp \
     $$DRAPE_DIR/color.hpp \
     $$DRAPE_DIR/cpu_buffer.hpp \
+    $$DRAPE_DIR/cpu_buffer_pool.hpp \
     $$DRAPE_DIR/data_buffer.hpp \
     $$DRAPE_DIR/data_buffer_impl.hpp \
     $$DRAPE_DIR/debug_rect_renderer.hpp \
@@ -2,6 +2,7 @@
 
 #include "drape/drape_tests/glmock_functions.hpp"
 
+#include "drape/cpu_buffer_pool.hpp"
 #include "drape/data_buffer.hpp"
 #include "drape/gpu_buffer.hpp"
 #include "drape/index_buffer.hpp"
@@ -101,3 +102,53 @@ UNIT_TEST(ParticalUploadDataTest)
 
   buffer->MoveToGPU(GPUBuffer::ElementBuffer);
 }
+
+UNIT_TEST(CPUBufferPoolTest)
+{
+  CPUBufferPool pool;
+  CPUBufferPool::TMemory memory = pool.Reserve(100);
+  TEST_EQUAL(memory->size(), 128, ());
+  TEST_EQUAL(pool.GetStats().m_allocationsCount, 1, ());
+  TEST_EQUAL(pool.GetStats().m_allocatedBytes, 128, ());
+
+  // Memory of the same size class is reused.
+  uint8_t const * data = memory->data();
+  pool.Free(move(memory));
+  memory = pool.Reserve(120);
+  TEST_EQUAL(memory->data(), data, ());
+  TEST_EQUAL(pool.GetStats().m_allocationsCount, 1, ());
+  TEST_EQUAL(pool.GetStats().m_reusesCount, 1, ());
+
+  CPUBufferPool::TMemory other = pool.Reserve(64);
+  TEST_EQUAL(other->size(), 64, ());
+  TEST_EQUAL(pool.GetStats().m_allocationsCount, 2, ());
+  pool.Free(move(other));
+  pool.Free(move(memory));
+
+  pool.Clear();
+  memory = pool.Reserve(128);
+  TEST_EQUAL(pool.GetStats().m_allocationsCount, 3, ());
+}
+
+UNIT_TEST(PooledDataBufferTest)
+{
+  InSequence s;
+  EXPECTGL(glGenBuffer()).WillOnce(Return(1));
+  EXPECTGL(glBindBuffer(1, gl_const::GLArrayBuffer));
+  EXPECTGL(glBufferData(gl_const::GLArrayBuffer, 3 * 100 * sizeof(float), _, gl_const::GLDynamicDraw));
+  EXPECTGL(glBindBuffer(0, gl_const::GLArrayBuffer));
+  EXPECTGL(glDeleteBuffer(1));
+
+  CPUBufferPool pool;
+  {
+    unique_ptr<DataBuffer> buffer(new DataBuffer(3 * sizeof(float), 100, make_ref(&pool)));
+    TEST_EQUAL(pool.GetStats().m_allocationsCount, 1, ());
+
+    // CPU memory returns to the pool when data is moved to GPU.
+    buffer->MoveToGPU(GPUBuffer::ElementBuffer);
+  }
+
+  CPUBufferPool::TMemory memory = pool.Reserve(3 * sizeof(float) * 100);
+  TEST_EQUAL(pool.GetStats().m_allocationsCount, 1, ());
+  TEST_EQUAL(pool.GetStats().m_reusesCount, 1, ());
+}
@@ -32,6 +32,7 @@ SOURCES += \
     glyph_mng_tests.cpp \
     glyph_packer_test.cpp \
     img.cpp \
+    overlay_tree_tests.cpp \
     pointers_tests.cpp \
     stipple_pen_tests.cpp \
     testingmain.cpp \
@@ -265,3 +265,31 @@ int32_t GLFunctions::glGetBufferParameter(glConst target, glConst name)
 {
   return MOCK_CALL(glGetBufferParameter(target, name));
 }
+
+void GLFunctions::Init() {}
+
+void GLFunctions::AttachCache(thread::id const & threadId) {}
+
+void GLFunctions::glClearColor(float r, float g, float b, float a) {}
+
+void GLFunctions::glClear() {}
+
+void GLFunctions::glClearDepth() {}
+
+void GLFunctions::glViewport(uint32_t x, uint32_t y, uint32_t w, uint32_t h) {}
+
+void GLFunctions::glFinish() {}
+
+void GLFunctions::glFrontFace(glConst mode) {}
+
+void GLFunctions::glCullFace(glConst face) {}
+
+void GLFunctions::glClearDepthValue(double depth) {}
+
+void GLFunctions::glDepthMask(bool needWriteToDepthBuffer) {}
+
+void GLFunctions::glDepthFunc(glConst depthFunc) {}
+
+void GLFunctions::glBindFramebuffer(glConst target, uint32_t id) {}
+
+void GLFunctions::glUniformValuefv(int8_t location, float * v, uint32_t size) {}
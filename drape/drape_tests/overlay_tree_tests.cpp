@@ -0,0 +1,149 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_handle.hpp"
+#include "drape/overlay_tree.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "std/chrono.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+using namespace dp;
+
+namespace
+{
+ScreenBase MakeScreen(m2::RectD const & rect)
+{
+  ScreenBase screen;
+  screen.OnSize(0, 0, 100, 100);
+  screen.SetFromRect(m2::AnyRectD(rect));
+  return screen;
+}
+
+void PlaceOverlays(OverlayTree & tree, ScreenBase const & screen,
+                   vector<ref_ptr<OverlayHandle>> const & handles)
+{
+  tree.ForceUpdate();
+  TEST(tree.Frame(), ());
+  tree.StartOverlayPlacing(screen);
+  for (ref_ptr<OverlayHandle> handle : handles)
+    tree.Add(handle, false /* isTransparent */);
+  tree.EndOverlayPlacing();
+}
+
+SquareHandle MakeHandle(double x, double y, uint64_t priority)
+{
+  return SquareHandle(FeatureID(), dp::Center, m2::PointD(x, y), m2::PointD(10, 10), priority);
+}
+}  // namespace
+
+UNIT_TEST(OverlayTree_IncrementalPlacing)
+{
+  // B intersects A and has lower priority, D is out of the screen at first.
+  SquareHandle a = MakeHandle(40, 50, 2);
+  SquareHandle b = MakeHandle(44, 50, 1);
+  SquareHandle c = MakeHandle(70, 50, 1);
+  SquareHandle d = MakeHandle(120, 50, 1);
+  vector<ref_ptr<OverlayHandle>> handles = {make_ref(&a), make_ref(&b), make_ref(&c),
+                                            make_ref(&d)};
+
+  OverlayTree tree;
+  PlaceOverlays(tree, MakeScreen(m2::RectD(0, 0, 100, 100)), handles);
+  TEST(!tree.IsIncrementalPlacing(), ());
+  TEST(a.IsVisible() && !b.IsVisible() && c.IsVisible() && !d.IsVisible(), ());
+
+  // Pan keeps placement and places D which is on the screen now.
+  ScreenBase const panned = MakeScreen(m2::RectD(30, 0, 130, 100));
+  PlaceOverlays(tree, panned, handles);
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(a.IsVisible() && !b.IsVisible() && c.IsVisible() && d.IsVisible(), ());
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  // B takes the place of the removed A.
+  handles.erase(handles.begin());
+  PlaceOverlays(tree, panned, handles);
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(b.IsVisible() && c.IsVisible() && d.IsVisible(), ());
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  // Scaling rebuilds placement.
+  PlaceOverlays(tree, MakeScreen(m2::RectD(30, 0, 230, 200)), handles);
+  TEST(!tree.IsIncrementalPlacing(), ());
+
+  // Placement is rebuilt after invalidation.
+  tree.Invalidate();
+  TEST(tree.IsNeedUpdate(), ());
+  PlaceOverlays(tree, panned, handles);
+  TEST(!tree.IsIncrementalPlacing(), ());
+}
+
+UNIT_TEST(OverlayTree_RemovedHandleStorageReuse)
+{
+  SquareHandle a = MakeHandle(40, 50, 2);
+  SquareHandle c = MakeHandle(70, 50, 2);
+
+  OverlayTree tree;
+  ScreenBase const screen = MakeScreen(m2::RectD(0, 0, 100, 100));
+  PlaceOverlays(tree, screen, {make_ref(&a), make_ref(&c)});
+  TEST(a.IsVisible() && c.IsVisible(), ());
+
+  // A is destroyed and a new handle which intersects C is created in its storage.
+  tree.Remove({make_ref(&a)});
+  TEST_EQUAL(tree.GetSize(), 1, ());
+  a.~SquareHandle();
+  SquareHandle * reused = new (&a) SquareHandle(MakeHandle(74, 50, 1));
+
+  // The new handle doesn't inherit placement of A and loses to C.
+  PlaceOverlays(tree, screen, {make_ref(reused), make_ref(&c)});
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(!reused->IsVisible() && c.IsVisible(), ());
+  TEST_EQUAL(tree.GetSize(), 1, ());
+}
+
+UNIT_TEST(OverlayTree_RemovedRejectedHandle)
+{
+  SquareHandle a = MakeHandle(40, 50, 2);
+  SquareHandle b = MakeHandle(44, 50, 1);
+
+  OverlayTree tree;
+  ScreenBase const screen = MakeScreen(m2::RectD(0, 0, 100, 100));
+  PlaceOverlays(tree, screen, {make_ref(&a), make_ref(&b)});
+  TEST(a.IsVisible() && !b.IsVisible(), ());
+
+  // Rejected B isn't in the tree, but a new handle in its storage must be placed as a new one.
+  tree.Remove({make_ref(&b)});
+  TEST_EQUAL(tree.GetSize(), 1, ());
+  b.~SquareHandle();
+  SquareHandle * reused = new (&b) SquareHandle(MakeHandle(10, 50, 1));
+
+  PlaceOverlays(tree, screen, {make_ref(&a), make_ref(reused)});
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(a.IsVisible() && reused->IsVisible(), ());
+  TEST_EQUAL(tree.GetSize(), 2, ());
+}
+
+UNIT_TEST(OverlayTree_RejectedHandleWinsLater)
+{
+  SquareHandle low = MakeHandle(40, 50, 1);
+  SquareHandle high = MakeHandle(44, 50, 2);
+
+  OverlayTree tree;
+  ScreenBase const screen = MakeScreen(m2::RectD(0, 0, 100, 100));
+  PlaceOverlays(tree, screen, {make_ref(&low)});
+  TEST(low.IsVisible(), ());
+
+  // The more important handle comes while the placed one has to stay visible.
+  PlaceOverlays(tree, screen, {make_ref(&low), make_ref(&high)});
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(low.IsVisible() && !high.IsVisible(), ());
+
+  // The conflict is resolved by priority when the minimum visibility time is up,
+  // though the screen is the same.
+  this_thread::sleep_for(milliseconds(600));
+  PlaceOverlays(tree, screen, {make_ref(&low), make_ref(&high)});
+  TEST(tree.IsIncrementalPlacing(), ());
+  TEST(!low.IsVisible() && high.IsVisible(), ());
+  TEST_EQUAL(tree.GetSize(), 1, ());
+}
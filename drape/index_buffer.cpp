@@ -4,8 +4,8 @@
 namespace dp
 {
 
-IndexBuffer::IndexBuffer(uint32_t capacity)
-  : DataBuffer((uint8_t)IndexStorage::SizeOfIndex(), capacity)
+IndexBuffer::IndexBuffer(uint32_t capacity, ref_ptr<CPUBufferPool> pool)
+  : DataBuffer((uint8_t)IndexStorage::SizeOfIndex(), capacity, pool)
 {
 }
 
@@ -8,7 +8,7 @@ namespace dp
 class IndexBuffer : public DataBuffer
 {
 public:
-  IndexBuffer(uint32_t capacity);
+  IndexBuffer(uint32_t capacity, ref_ptr<CPUBufferPool> pool = nullptr);
 
   /// check size of buffer and size of uploaded data
   void UploadData(void const * data, uint32_t size);
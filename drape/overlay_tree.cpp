@@ -1,5 +1,7 @@
 #include "drape/overlay_tree.hpp"
 
+#include "base/math.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
 
@@ -45,10 +47,22 @@ public:
   }
 };
 
+// Returns true if the screens differ by position only.
+bool IsTranslated(ScreenBase const & screen1, ScreenBase const & screen2)
+{
+  return my::AlmostEqualULPs(screen1.GetScale(), screen2.GetScale()) &&
+         my::AlmostEqualULPs(screen1.GetAngle(), screen2.GetAngle()) &&
+         screen1.PixelRect() == screen2.PixelRect();
+}
+
 } // namespace
 
 OverlayTree::OverlayTree()
   : m_frameCounter(-1)
+  , m_pixelOffset(m2::PointD::Zero())
+  , m_hasPlacement(false)
+  , m_isIncremental(false)
+  , m_hasErasedHandles(false)
 {
   for (size_t i = 0; i < m_handles.size(); i++)
     m_handles[i].reserve(kAverageHandlesCount[i]);
@@ -76,11 +90,68 @@ void OverlayTree::ForceUpdate()
   m_frameCounter = -1;
 }
 
+void OverlayTree::Invalidate()
+{
+  ClearTree();
+  m_hasErasedHandles = false;
+  m_hasPlacement = false;
+  ForceUpdate();
+}
+
+void OverlayTree::Remove(THandles const & handles)
+{
+  if (handles.empty())
+    return;
+
+  bool hasErased = false;
+  for (ref_ptr<OverlayHandle> const & handle : handles)
+  {
+    auto const it = m_placedHandles.find(handle.get());
+    if (it != m_placedHandles.end())
+    {
+      EraseFromTree(detail::OverlayInfo(it->second));
+      hasErased = true;
+    }
+  }
+
+  // Handles are collected only while placing, so usually there is nothing to check here.
+  for (auto & rankHandles : m_handles)
+  {
+    rankHandles.erase(remove_if(rankHandles.begin(), rankHandles.end(), [&handles](THandle const & h)
+    {
+      return find(handles.begin(), handles.end(), h.first) != handles.end();
+    }), rankHandles.end());
+  }
+
+  if (hasErased)
+  {
+    m_hasErasedHandles = true;
+    ForceUpdate();
+  }
+}
+
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen)
 {
   ASSERT(IsNeedUpdate(), ());
-  Clear();
-  m_traits.m_modelView = screen;
+
+  ScreenBase const & modelView = GetModelView();
+  m_isIncremental = m_hasPlacement && IsTranslated(modelView, screen);
+  m_screen = screen;
+  if (m_isIncremental)
+  {
+    m2::PointD const center = screen.PixelRect().Center();
+    m_pixelOffset = modelView.GtoP(screen.PtoG(center)) - center;
+  }
+  else
+  {
+    ClearTree();
+    m_hasErasedHandles = false;
+    m_traits.m_modelView = screen;
+    m_pixelOffset = m2::PointD::Zero();
+  }
+
+  m_visibleRect = screen.PixelRect();
+  m_visibleRect.Offset(m_pixelOffset);
 }
 
 void OverlayTree::Add(ref_ptr<OverlayHandle> handle, bool isTransparent)
@@ -91,11 +162,11 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle, bool isTransparent)
 
   handle->SetIsVisible(false);
 
-  if (!handle->Update(modelView))
+  if (!handle->Update(m_screen))
     return;
 
   m2::RectD const pixelRect = handle->GetExtendedPixelRect(modelView);
-  if (!m_traits.m_modelView.PixelRect().IsIntersect(pixelRect))
+  if (!m_visibleRect.IsIntersect(pixelRect))
   {
     handle->SetIsVisible(false);
     return;
@@ -147,7 +218,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, bool isTransparent
       {
         // Handle is displaced and bound to its parent, parent will be displaced too.
         if (boundToParent)
-          Erase(parentOverlay);
+          EraseFromTree(parentOverlay);
         return;
       }
     }
@@ -158,17 +229,43 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, bool isTransparent
     AddHandleToDelete(info);
 
   for (auto const & handle : m_handlesToDelete)
-    Erase(handle);
+    EraseFromTree(handle);
 
   m_handlesToDelete.clear();
 
-  TBase::Add(detail::OverlayInfo(handle, isTransparent), pixelRect);
+  InsertToTree(detail::OverlayInfo(handle, isTransparent, pixelRect));
 }
 
 void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
+  vector<OverlayHandle const *> addedHandles;
+  for (auto const & handles : m_handles)
+  {
+    for (auto const & handle : handles)
+      addedHandles.push_back(handle.first.get());
+  }
+  sort(addedHandles.begin(), addedHandles.end());
+
+  if (m_isIncremental)
+    UpdatePlacedHandles(addedHandles);
+
+  m_hasErasedHandles = false;
+
+  InsertHandles();
+
+  ForEach([] (detail::OverlayInfo const & info)
+  {
+    info.m_handle->SetIsVisible(true);
+  });
+
+  m_hasPlacement = true;
+  m_frameCounter = 0;
+}
+
+void OverlayTree::InsertHandles()
+{
   HandleComparator comparator;
 
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
@@ -185,13 +282,58 @@ void OverlayTree::EndOverlayPlacing()
 
     m_handles[rank].clear();
   }
+}
 
-  ForEach([] (detail::OverlayInfo const & info)
+void OverlayTree::UpdatePlacedHandles(vector<OverlayHandle const *> const & addedHandles)
+{
+  // Handles which are not added anymore (e.g. they are out of the viewport or their tiles
+  // disappear) are erased. Destroyed handles are already removed from the tree.
+  vector<detail::OverlayInfo> erasedHandles;
+  ForEach([&](detail::OverlayInfo const & info)
   {
-    info.m_handle->SetIsVisible(true);
+    if (!binary_search(addedHandles.begin(), addedHandles.end(), info.m_handle.get()))
+      erasedHandles.push_back(info);
   });
 
-  m_frameCounter = 0;
+  for (detail::OverlayInfo const & info : erasedHandles)
+    EraseFromTree(info);
+
+  // Handles of higher ranks are placed only with their parents.
+  bool const hasFreedSpace = !erasedHandles.empty() || m_hasErasedHandles;
+  for (int rank = dp::OverlayRank1; rank < dp::OverlayRanksCount && hasFreedSpace; rank++)
+  {
+    vector<FeatureID> parents;
+    ForEach([&parents, rank](detail::OverlayInfo const & info)
+    {
+      if (info.m_handle->GetOverlayRank() == rank - 1)
+        parents.push_back(info.m_handle->GetFeatureID());
+    });
+    sort(parents.begin(), parents.end());
+
+    size_t const erasedCount = erasedHandles.size();
+    ForEach([&](detail::OverlayInfo const & info)
+    {
+      if (info.m_handle->GetOverlayRank() == rank &&
+          !binary_search(parents.begin(), parents.end(), info.m_handle->GetFeatureID()))
+      {
+        erasedHandles.push_back(info);
+      }
+    });
+
+    for (size_t i = erasedCount; i < erasedHandles.size(); i++)
+      EraseFromTree(erasedHandles[i]);
+  }
+
+  // Placed handles keep their places. New and rejected handles are placed again, so
+  // a rejected handle displaces a less important one as soon as it's allowed to,
+  // e.g. when the minimum visibility time of the winner is up.
+  auto const isKept = [this](THandle const & handle)
+  {
+    return m_placedHandles.find(handle.first.get()) != m_placedHandles.end();
+  };
+
+  for (auto & handles : m_handles)
+    handles.erase(remove_if(handles.begin(), handles.end(), isKept), handles.end());
 }
 
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
@@ -235,10 +377,30 @@ void OverlayTree::AddHandleToDelete(detail::OverlayInfo const & overlay)
   }
 }
 
+void OverlayTree::InsertToTree(detail::OverlayInfo const & info)
+{
+  TBase::Add(info, info.m_pixelRect);
+  m_placedHandles[info.m_handle.get()] = info;
+}
+
+void OverlayTree::EraseFromTree(detail::OverlayInfo const & info)
+{
+  Erase(info);
+  m_placedHandles.erase(info.m_handle.get());
+}
+
+void OverlayTree::ClearTree()
+{
+  Clear();
+  m_placedHandles.clear();
+}
+
 void OverlayTree::Select(m2::RectD const & rect, TSelectResult & result) const
 {
-  ScreenBase screen = m_traits.m_modelView;
-  ForEachInRect(rect, [&](detail::OverlayInfo const & info)
+  ScreenBase const & screen = GetModelView();
+  m2::RectD treeRect = rect;
+  treeRect.Offset(m_pixelOffset);
+  ForEachInRect(treeRect, [&](detail::OverlayInfo const & info)
   {
     if (info.m_handle->IsVisible() && info.m_handle->GetFeatureID().IsValid())
     {
@@ -246,7 +408,7 @@ void OverlayTree::Select(m2::RectD const & rect, TSelectResult & result) const
       info.m_handle->GetPixelShape(screen, shape);
       for (m2::RectF const & rShape : shape)
       {
-        if (rShape.IsIntersect(m2::RectF(rect)))
+        if (rShape.IsIntersect(m2::RectF(treeRect)))
         {
           result.push_back(info.m_handle);
           break;
@@ -8,6 +8,7 @@
 #include "base/buffer_vector.hpp"
 
 #include "std/array.hpp"
+#include "std/unordered_map.hpp"
 #include "std/vector.hpp"
 
 namespace dp
@@ -20,11 +21,14 @@ struct OverlayInfo
 {
   ref_ptr<OverlayHandle> m_handle;
   bool m_isTransparent = false;
+  // Pixel rect of the handle at the moment of insertion to the tree.
+  m2::RectD m_pixelRect;
 
   OverlayInfo() = default;
-  OverlayInfo(ref_ptr<OverlayHandle> handle, bool isTransparent)
+  OverlayInfo(ref_ptr<OverlayHandle> handle, bool isTransparent, m2::RectD const & pixelRect)
     : m_handle(handle)
     , m_isTransparent(isTransparent)
+    , m_pixelRect(pixelRect)
   {}
 
   bool operator==(OverlayInfo const & rhs) const
@@ -37,14 +41,20 @@ struct OverlayTraits
 {
   ScreenBase m_modelView;
 
+  // Handles may be moved since insertion, so the tree uses the rect they were inserted with.
   inline m2::RectD const LimitRect(OverlayInfo const & info)
   {
-    return info.m_handle->GetExtendedPixelRect(m_modelView);
+    return info.m_pixelRect;
   }
 };
 
 }
 
+/// Places overlay handles so that they don't intersect each other.
+/// Placement is incremental while the screen is only translated: placed handles keep
+/// their places, and only new and rejected handles are processed, removed handles free
+/// their space. Any other change of the screen rebuilds the placement from scratch.
+/// Pixel rects in the tree are calculated for the screen of the last full rebuild.
 class OverlayTree : public m4::Tree<detail::OverlayInfo, detail::OverlayTraits>
 {
   using TBase = m4::Tree<detail::OverlayInfo, detail::OverlayTraits>;
@@ -56,10 +66,22 @@ public:
   bool IsNeedUpdate() const;
   void ForceUpdate();
 
+  /// Drops placement of all handles. Must be called before all handles are destroyed.
+  void Invalidate();
+
+  /// Removes handles from the tree and forgets their placement. Must be called before
+  /// the handles are destroyed, the space they occupied is reused by the next placing.
+  /// Takes time proportional to the number of the removed handles.
+  using THandles = vector<ref_ptr<OverlayHandle>>;
+  void Remove(THandles const & handles);
+
   void StartOverlayPlacing(ScreenBase const & screen);
   void Add(ref_ptr<OverlayHandle> handle, bool isTransparent);
   void EndOverlayPlacing();
 
+  /// Returns true if the current placing keeps the previous placement.
+  bool IsIncrementalPlacing() const { return m_isIncremental; }
+
   using TSelectResult = buffer_vector<ref_ptr<OverlayHandle>, 8>;
   void Select(m2::RectD const & rect, TSelectResult & result) const;
 
@@ -73,9 +95,34 @@ private:
                    detail::OverlayInfo & parentOverlay) const;
   void AddHandleToDelete(detail::OverlayInfo const & overlay);
 
+  // The tree must be modified only through these methods to keep m_placedHandles in sync.
+  void InsertToTree(detail::OverlayInfo const & info);
+  void EraseFromTree(detail::OverlayInfo const & info);
+  void ClearTree();
+
+  void InsertHandles();
+
+  // Removes from the tree handles which are not added on the current placing and
+  // leaves in m_handles only handles which must be placed again.
+  void UpdatePlacedHandles(vector<OverlayHandle const *> const & addedHandles);
+
   int m_frameCounter;
   array<vector<THandle>, dp::OverlayRanksCount> m_handles;
   vector<detail::OverlayInfo> m_handlesToDelete;
+
+  // Current screen, it differs from the screen of the tree on incremental placing.
+  ScreenBase m_screen;
+  // Viewport and shift of the current screen in pixels of the screen of the tree.
+  m2::RectD m_visibleRect;
+  m2::PointD m_pixelOffset;
+
+  bool m_hasPlacement;
+  bool m_isIncremental;
+  // Handles in the tree. Removed handles leave it at once, so a new handle
+  // created in the storage of a removed one never inherits its place.
+  unordered_map<OverlayHandle const *, detail::OverlayInfo> m_placedHandles;
+  // True if placed handles were removed after the last placing.
+  bool m_hasErasedHandles;
 };
 
 } // namespace dp
@@ -71,6 +71,15 @@ void RenderBucket::CollectOverlayHandles(ref_ptr<OverlayTree> tree, bool isTrans
     tree->Add(make_ref(overlayHandle), isTransparent);
 }
 
+void RenderBucket::RemoveOverlayHandles(ref_ptr<OverlayTree> tree)
+{
+  OverlayTree::THandles handles;
+  handles.reserve(m_overlay.size());
+  for (drape_ptr<OverlayHandle> const & overlayHandle : m_overlay)
+    handles.push_back(make_ref(overlayHandle));
+  tree->Remove(handles);
+}
+
 void RenderBucket::Render(ScreenBase const & screen)
 {
   ASSERT(m_buffer != nullptr, ());
@@ -27,6 +27,7 @@ public:
 
   void Update(ScreenBase const & modelView);
   void CollectOverlayHandles(ref_ptr<OverlayTree> tree, bool isTransparent);
+  void RemoveOverlayHandles(ref_ptr<OverlayTree> tree);
   void Render(ScreenBase const & screen);
 
   // Only for testing! Don't use this function in production code!
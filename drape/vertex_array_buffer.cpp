@@ -9,12 +9,14 @@
 namespace dp
 {
 
-VertexArrayBuffer::VertexArrayBuffer(uint32_t indexBufferSize, uint32_t dataBufferSize)
+VertexArrayBuffer::VertexArrayBuffer(uint32_t indexBufferSize, uint32_t dataBufferSize,
+                                     ref_ptr<CPUBufferPool> bufferPool)
   : m_VAO(0)
   , m_dataBufferSize(dataBufferSize)
+  , m_bufferPool(bufferPool)
   , m_program()
 {
-  m_indexBuffer = make_unique_dp<IndexBuffer>(indexBufferSize);
+  m_indexBuffer = make_unique_dp<IndexBuffer>(indexBufferSize, m_bufferPool);
 }
 
 VertexArrayBuffer::~VertexArrayBuffer()
@@ -140,7 +142,8 @@ ref_ptr<DataBuffer> VertexArrayBuffer::GetOrCreateBuffer(BindingInfo const & bin
   TBuffersMap::iterator it = buffers->find(bindingInfo);
   if (it == buffers->end())
   {
-    drape_ptr<DataBuffer> dataBuffer = make_unique_dp<DataBuffer>(bindingInfo.GetElementSize(), m_dataBufferSize);
+    drape_ptr<DataBuffer> dataBuffer = make_unique_dp<DataBuffer>(bindingInfo.GetElementSize(),
+                                                                  m_dataBufferSize, m_bufferPool);
     ref_ptr<DataBuffer> result = make_ref(dataBuffer);
     (*buffers).insert(make_pair(bindingInfo, move(dataBuffer)));
     return result;
@@ -33,7 +33,9 @@ class VertexArrayBuffer
 {
   typedef map<BindingInfo, drape_ptr<DataBuffer> > TBuffersMap;
 public:
-  VertexArrayBuffer(uint32_t indexBufferSize, uint32_t dataBufferSize);
+  /// CPU buffers take memory from the pool if it's set.
+  VertexArrayBuffer(uint32_t indexBufferSize, uint32_t dataBufferSize,
+                    ref_ptr<CPUBufferPool> bufferPool = nullptr);
   ~VertexArrayBuffer();
 
   /// This method must be call on reading thread, before VAO will be transfer on render thread
@@ -82,6 +84,7 @@ private:
 
   drape_ptr<IndexBuffer> m_indexBuffer;
   uint32_t m_dataBufferSize;
+  ref_ptr<CPUBufferPool> m_bufferPool;
 
   ref_ptr<GpuProgram> m_program;
 };
@@ -27,7 +27,7 @@ void FlushGeometry(BatchersPool::TSendMessageFn const & sendMessage,
 
 BatchersPool::BatchersPool(int initBatcherCount, TSendMessageFn const & sendMessageFn)
   : m_sendMessageFn(sendMessageFn)
-  , m_pool(initBatcherCount, dp::BatcherFactory())
+  , m_pool(initBatcherCount, dp::BatcherFactory(make_ref(&m_bufferPool)))
 {}
 
 BatchersPool::~BatchersPool()
@@ -5,6 +5,7 @@
 #include "drape/pointers.hpp"
 #include "drape/object_pool.hpp"
 #include "drape/batcher.hpp"
+#include "drape/cpu_buffer_pool.hpp"
 
 #include "std/map.hpp"
 #include "std/stack.hpp"
@@ -27,12 +28,18 @@ public:
   ref_ptr<dp::Batcher> GetTileBatcher(TileKey const & key);
   void ReleaseBatcher(TileKey const & key);
 
+  /// Batchers take memory of CPU buffers from the pool and return it there
+  /// when buffers are uploaded to GPU.
+  dp::CPUBufferPool::Stats const & GetBufferPoolStats() const { return m_bufferPool.GetStats(); }
+
 private:
   typedef pair<dp::Batcher *, int> TBatcherPair;
   typedef map<TileKey, TBatcherPair> TBatcherMap;
   typedef TBatcherMap::iterator TIterator;
   TSendMessageFn m_sendMessageFn;
 
+  // Must outlive batchers, their buffers return memory here.
+  dp::CPUBufferPool m_bufferPool;
   ObjectPool<dp::Batcher, dp::BatcherFactory> m_pool;
   TBatcherMap m_batchs;
 };
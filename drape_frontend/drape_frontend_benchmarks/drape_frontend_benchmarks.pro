@@ -0,0 +1,37 @@
+# This subproject implements benchmarks of the drape backend.
+# Tiles are generated from real maps on the glmock GL layer, so GPU is not needed.
+
+TARGET = drape_frontend_benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+DEFINES += GTEST_DONT_DEFINE_TEST
+
+ROOT_DIR = ../..
+DEPENDENCIES = drape_frontend storage indexer platform geometry coding base gmock freetype fribidi \
+               expat protobuf tomcrypt gflags
+SHADER_COMPILE_ARGS = $$PWD/../../drape/shaders shader_index.txt shader_def
+include($$ROOT_DIR/common.pri)
+
+QT *= core
+
+# Drape is built from sources here because the glmock GL layer replaces glfunctions.cpp.
+DRAPE_DIR = ../../drape
+include($$DRAPE_DIR/drape_common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gmock/include $$ROOT_DIR/3party/gmock/gtest/include \
+               $$ROOT_DIR/3party/gflags/src
+
+macx-* {
+  LIBS *= "-framework CoreLocation" "-framework Foundation" "-framework CoreWLAN" \
+          "-framework QuartzCore" "-framework IOKit"
+}
+
+SOURCES += \
+  ../../drape/drape_tests/failure_reporter.cpp \
+  ../../drape/drape_tests/glfunctions.cpp \
+  ../../drape/drape_tests/glmock_functions.cpp \
+  tile_generation_benchmark.cpp \
+
+HEADERS += \
+  ../../drape/drape_tests/glmock_functions.hpp \
@@ -0,0 +1,466 @@
+#include "drape/drape_tests/glmock_functions.hpp"
+
+#include "drape_frontend/batchers_pool.hpp"
+#include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/map_data_provider.hpp"
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/memory_feature_index.hpp"
+#include "drape_frontend/message.hpp"
+#include "drape_frontend/message_acceptor.hpp"
+#include "drape_frontend/message_subclasses.hpp"
+#include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/visual_params.hpp"
+
+#include "drape/glconstants.hpp"
+#include "drape/overlay_tree.hpp"
+#include "drape/render_bucket.hpp"
+#include "drape/texture_manager.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/index.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
+#include "std/cmath.hpp"
+#include "std/numeric.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+DEFINE_string(data_path, "../../data/", "Working directory, 'path_to_exe/../../data' if empty.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+DEFINE_string(mwm, "minsk-pass", "Name of the mwm file without extension in the data directory.");
+DEFINE_string(zooms, "12,15,17", "Comma separated zoom levels of tiles around the center of the mwm.");
+DEFINE_uint64(tiles_per_side, 4, "Side of the square block of tiles for every zoom level.");
+DEFINE_string(tiles, "", "Semicolon separated tiles as 'x,y,zoom', used instead of zooms if set.");
+DEFINE_uint64(runs, 3, "Count of passes over all the tiles.");
+DEFINE_double(visual_scale, 2.0, "Visual scale of the device.");
+DEFINE_uint64(tile_size, 512, "Tile size in pixels.");
+DEFINE_uint64(features_cache_mb, 0, "Budget of the cache of features read for tiles in megabytes.");
+DEFINE_uint64(pan_frames, 100, "Count of frames of the scripted pan over overlays of the last run.");
+DEFINE_int32(pan_zoom, 17, "Zoom level of tiles which overlays are used for the pan.");
+DEFINE_double(pan_step, 4.0, "Shift of the screen in pixels per frame of the pan.");
+
+namespace
+{
+struct Stats
+{
+  // Seconds spent in every stage of tile generation.
+  double m_indexTime = 0.0;
+  double m_loadingTime = 0.0;
+  double m_ruleDrawerTime = 0.0;
+  double m_readingTime = 0.0;
+  double m_batchingTime = 0.0;
+  double m_flushingTime = 0.0;
+
+  size_t m_featuresCount = 0;
+  size_t m_shapesCount = 0;
+  size_t m_bucketsCount = 0;
+};
+
+// Bytes of geometry uploaded through the mocked GL layer.
+uint64_t g_vertexBytes = 0;
+uint64_t g_indexBytes = 0;
+
+/// Plays the role of BackendRenderer: batches shapes of tiles on the glmock GL layer.
+class TileBatcher : public df::MessageAcceptor
+{
+public:
+  TileBatcher(ref_ptr<dp::TextureManager> texMng, df::BatchersPool & batchersPool, Stats & stats)
+    : m_texMng(texMng), m_batchersPool(batchersPool), m_stats(stats)
+  {
+  }
+
+  ~TileBatcher() override { CloseQueue(); }
+
+  void ProcessMessages()
+  {
+    while (ProcessSingleMessage(false /* waitForMessage */))
+      ;
+  }
+
+protected:
+  // MessageAcceptor overrides:
+  void AcceptMessage(ref_ptr<df::Message> message) override
+  {
+    switch (message->GetType())
+    {
+    case df::Message::TileReadStarted:
+      {
+        m_batchersPool.ReserveBatcher(static_cast<ref_ptr<df::BaseTileMessage>>(message)->GetKey());
+        break;
+      }
+    case df::Message::MapShapeReaded:
+      {
+        ref_ptr<df::MapShapeReadedMessage> msg = message;
+        ref_ptr<dp::Batcher> batcher = m_batchersPool.GetTileBatcher(msg->GetKey());
+        my::Timer timer;
+        for (drape_ptr<df::MapShape> const & shape : msg->GetShapes())
+          shape->Draw(batcher, m_texMng);
+        m_stats.m_batchingTime += timer.ElapsedSeconds();
+        m_stats.m_shapesCount += msg->GetShapes().size();
+        break;
+      }
+    case df::Message::TileReadEnded:
+      {
+        ref_ptr<df::TileReadEndMessage> msg = message;
+        my::Timer timer;
+        m_batchersPool.ReleaseBatcher(msg->GetKey());
+        m_texMng->UpdateDynamicTextures();
+        m_stats.m_flushingTime += timer.ElapsedSeconds();
+        break;
+      }
+    default:
+      break;
+    }
+  }
+
+  bool CanReceiveMessage() override { return true; }
+
+private:
+  ref_ptr<dp::TextureManager> m_texMng;
+  df::BatchersPool & m_batchersPool;
+  Stats & m_stats;
+};
+
+void SetUpGLMock()
+{
+  emul::GLMockFunctions & gl = emul::GLMockFunctions::Instance();
+  ON_CALL(gl, glGetInteger(gl_const::GLMaxTextureSize)).WillByDefault(Return(4096));
+
+  // Buffers are allocated with null data and filled in Preflush, so only uploads of
+  // real data are counted.
+  auto const countBytes = [](glConst target, uint32_t size, void const * data)
+  {
+    if (data == nullptr)
+      return;
+    if (target == gl_const::GLArrayBuffer)
+      g_vertexBytes += size;
+    else if (target == gl_const::GLElementArrayBuffer)
+      g_indexBytes += size;
+  };
+  ON_CALL(gl, glBufferData(_, _, _, _))
+      .WillByDefault(Invoke([countBytes](glConst target, uint32_t size, void const * data,
+                                         glConst /* usage */)
+  {
+    countBytes(target, size, data);
+  }));
+  ON_CALL(gl, glBufferSubData(_, _, _, _))
+      .WillByDefault(Invoke([countBytes](glConst target, uint32_t size, void const * data,
+                                         uint32_t /* offset */)
+  {
+    countBytes(target, size, data);
+  }));
+}
+
+void InitTextureManager(dp::TextureManager & texMng)
+{
+  dp::TextureManager::Params params;
+  params.m_resPostfix = df::VisualParams::Instance().GetResourcePostfix();
+  params.m_visualScale = df::VisualParams::Instance().GetVisualScale();
+  params.m_colors = "colors.txt";
+  params.m_patterns = "patterns.txt";
+  params.m_glyphMngParams.m_uniBlocks = "unicode_blocks.txt";
+  params.m_glyphMngParams.m_whitelist = "fonts_whitelist.txt";
+  params.m_glyphMngParams.m_blacklist = "fonts_blacklist.txt";
+  params.m_glyphMngParams.m_sdfScale = df::VisualParams::Instance().GetGlyphSdfScale();
+  GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+
+  texMng.Init(params);
+}
+
+df::TileKey GetTileByPoint(m2::PointD const & pt, int zoom)
+{
+  double const rectSize = (MercatorBounds::maxX - MercatorBounds::minX) / (1 << zoom);
+  return df::TileKey(static_cast<int>(floor(pt.x / rectSize)),
+                     static_cast<int>(floor(pt.y / rectSize)), zoom);
+}
+
+vector<string> Split(string const & str, char const * delims)
+{
+  vector<string> parts;
+  strings::Tokenize(str, delims, [&parts](string const & part) { parts.push_back(part); });
+  return parts;
+}
+
+vector<df::TileKey> GetTiles(m2::RectD const & limitRect)
+{
+  vector<df::TileKey> tiles;
+  if (!FLAGS_tiles.empty())
+  {
+    for (string const & tile : Split(FLAGS_tiles, ";"))
+    {
+      vector<string> const parts = Split(tile, ",");
+      int x, y, zoom;
+      CHECK(parts.size() == 3 && strings::to_int(parts[0], x) && strings::to_int(parts[1], y) &&
+                strings::to_int(parts[2], zoom),
+            ("Bad tile:", tile));
+      tiles.emplace_back(x, y, zoom);
+    }
+    return tiles;
+  }
+
+  int const side = static_cast<int>(FLAGS_tiles_per_side);
+  for (string const & zoomStr : Split(FLAGS_zooms, ","))
+  {
+    int zoom;
+    CHECK(strings::to_int(zoomStr, zoom), ("Bad zoom:", zoomStr));
+    df::TileKey const center = GetTileByPoint(limitRect.Center(), zoom);
+    for (int y = 0; y < side; ++y)
+    {
+      for (int x = 0; x < side; ++x)
+        tiles.emplace_back(center.m_x - side / 2 + x, center.m_y - side / 2 + y, zoom);
+    }
+  }
+  return tiles;
+}
+
+void RunBenchmark(Index const & index, FeaturesCache & featuresCache,
+                  vector<df::TileKey> const & tiles, ref_ptr<dp::TextureManager> texMng, df::BatchersPool & batchersPool,
+                  Stats & stats)
+{
+  uint64_t const vertexBytes = g_vertexBytes;
+  uint64_t const indexBytes = g_indexBytes;
+  dp::CPUBufferPool::Stats const poolStats = batchersPool.GetBufferPoolStats();
+
+  df::ThreadsCommutator commutator;
+  TileBatcher batcher(texMng, batchersPool, stats);
+  commutator.RegisterThread(df::ThreadsCommutator::ResourceUploadThread, &batcher);
+
+  // Time inside of the feature callback is the time of RuleDrawer, the rest of
+  // ReadFeatures is the time of features loading. Geometry of a feature is parsed
+  // lazily, so it goes to the time of RuleDrawer.
+  double drawerTime = 0.0;
+  df::MapDataProvider const model(
+      [&index, &stats](df::MapDataProvider::TReadCallback<FeatureID> const & fn,
+                       m2::RectD const & r, int scale)
+      {
+        my::Timer timer;
+        auto f = [&fn](FeatureID const & id) { fn(id); };
+        index.ForEachFeatureIDInRect(f, r, scale);
+        stats.m_indexTime += timer.ElapsedSeconds();
+      },
+      [&index, &featuresCache, &stats, &drawerTime](
+          df::MapDataProvider::TReadCallback<FeatureType> const & fn,
+          vector<FeatureID> const & ids, int scale)
+      {
+        my::Timer timer;
+        drawerTime = 0.0;
+        auto f = [&fn, &drawerTime](FeatureType const & ft)
+        {
+          my::Timer drawerTimer;
+          fn(ft);
+          drawerTime += drawerTimer.ElapsedSeconds();
+        };
+        if (featuresCache.IsEnabled())
+          index.ReadFeatures(f, ids, featuresCache, scale);
+        else
+          index.ReadFeatures(f, ids);
+        stats.m_loadingTime += timer.ElapsedSeconds() - drawerTime;
+        stats.m_ruleDrawerTime += drawerTime;
+        stats.m_featuresCount += ids.size();
+      },
+      [](storage::TIndex const &, m2::PointF const &) {},
+      [](m2::PointD const &) { return true; },
+      [](string const &) { return false; },
+      [](storage::TIndex const &) {},
+      [](storage::TIndex const &) {},
+      [](storage::TIndex const &) {});
+
+  // Tiles are alive during the whole run like in ReadManager, so the memory
+  // index doesn't block reading of features shared by tiles.
+  df::MemoryFeatureIndex memIndex;
+  vector<unique_ptr<df::TileInfo>> tileInfos;
+  tileInfos.reserve(tiles.size());
+
+  my::Timer timer;
+  for (df::TileKey const & key : tiles)
+  {
+    tileInfos.emplace_back(new df::TileInfo(
+        make_unique_dp<df::EngineContext>(key, make_ref(&commutator), texMng)));
+
+    my::Timer readTimer;
+    tileInfos.back()->ReadFeatures(model, memIndex);
+    stats.m_readingTime += readTimer.ElapsedSeconds();
+
+    batcher.ProcessMessages();
+  }
+  double const seconds = timer.ElapsedSeconds();
+
+  double const otherReadingTime =
+      stats.m_readingTime - stats.m_indexTime - stats.m_loadingTime - stats.m_ruleDrawerTime;
+  LOG(LINFO, ("Tiles:", tiles.size(), "time:", seconds, "s, tiles per second:",
+              tiles.size() / seconds));
+  LOG(LINFO, ("Features:", stats.m_featuresCount, "shapes:", stats.m_shapesCount,
+              "buckets:", stats.m_bucketsCount));
+  LOG(LINFO, ("Vertex bytes:", g_vertexBytes - vertexBytes, "index bytes:",
+              g_indexBytes - indexBytes));
+  // Buffers memory is reused from previous runs, so next runs shouldn't allocate.
+  dp::CPUBufferPool::Stats const & newPoolStats = batchersPool.GetBufferPoolStats();
+  LOG(LINFO, ("Buffer allocations:", newPoolStats.m_allocationsCount - poolStats.m_allocationsCount,
+              "reuses:", newPoolStats.m_reusesCount - poolStats.m_reusesCount,
+              "allocated bytes:", newPoolStats.m_allocatedBytes - poolStats.m_allocatedBytes));
+  LOG(LINFO, ("Features cache:", featuresCache.GetStats()));
+  LOG(LINFO, ("Index:", stats.m_indexTime, "s, loading:", stats.m_loadingTime,
+              "s, rule drawer:", stats.m_ruleDrawerTime, "s, other reading:", otherReadingTime,
+              "s, batching:", stats.m_batchingTime, "s, flushing:", stats.m_flushingTime, "s"));
+}
+/// Places overlays of the buckets on every frame of a horizontal pan, like FrontendRenderer
+/// does on frames with overlay tree update. Incremental placing is compared with rebuilding
+/// the tree from scratch.
+void RunPanBenchmark(vector<drape_ptr<dp::RenderBucket>> const & buckets,
+                     vector<df::TileKey> const & tiles)
+{
+  m2::RectD tilesRect;
+  double tileGlobalSize = 0.0;
+  for (df::TileKey const & key : tiles)
+  {
+    if (key.m_zoomLevel != FLAGS_pan_zoom)
+      continue;
+    m2::RectD const tileRect = key.GetGlobalRect();
+    tilesRect.Add(tileRect);
+    tileGlobalSize = tileRect.SizeX();
+  }
+  if (buckets.empty() || tilesRect.IsEmptyInterior())
+  {
+    LOG(LWARNING, ("No overlays of zoom", FLAGS_pan_zoom, "for the pan."));
+    return;
+  }
+
+  // The screen is a half of the tiles rect and it's panned to the east.
+  m2::RectD glbRect = tilesRect;
+  glbRect.Scale(0.5);
+  glbRect.Offset(-0.25 * tilesRect.SizeX(), 0.0);
+  double const pixelsPerUnit = FLAGS_tile_size / tileGlobalSize;
+  ScreenBase startScreen;
+  startScreen.OnSize(0, 0, static_cast<int>(glbRect.SizeX() * pixelsPerUnit),
+                     static_cast<int>(glbRect.SizeY() * pixelsPerUnit));
+  startScreen.SetFromRect(m2::AnyRectD(glbRect));
+
+  for (bool const incremental : {false, true})
+  {
+    dp::OverlayTree tree;
+    ScreenBase screen = startScreen;
+    vector<double> frameTimes;
+    size_t incrementalCount = 0;
+    for (uint64_t frame = 0; frame < FLAGS_pan_frames; ++frame)
+    {
+      my::Timer timer;
+      if (incremental)
+        tree.ForceUpdate();
+      else
+        tree.Invalidate();
+
+      CHECK(tree.Frame(), ());
+      tree.StartOverlayPlacing(screen);
+      for (drape_ptr<dp::RenderBucket> const & bucket : buckets)
+        bucket->CollectOverlayHandles(make_ref(&tree), false /* isTransparent */);
+      tree.EndOverlayPlacing();
+
+      frameTimes.push_back(timer.ElapsedSeconds());
+      if (tree.IsIncrementalPlacing())
+        ++incrementalCount;
+
+      screen.Move(-FLAGS_pan_step, 0.0);
+    }
+
+    if (frameTimes.empty())
+      return;
+
+    double const totalTime = accumulate(frameTimes.begin(), frameTimes.end(), 0.0);
+    sort(frameTimes.begin(), frameTimes.end());
+    LOG(LINFO, (incremental ? "Incremental" : "Full", "overlays placing, frames:",
+                frameTimes.size(), "incremental frames:", incrementalCount, "average frame:",
+                1000.0 * totalTime / frameTimes.size(), "ms, median frame:",
+                1000.0 * frameTimes[frameTimes.size() / 2], "ms, max frame:",
+                1000.0 * frameTimes.back(), "ms, placed overlays:", tree.GetSize()));
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Times tile generation of the drape backend without GPU.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  emul::GLMockFunctions::Init(&argc, argv);
+  ::testing::GMOCK_FLAG(verbose) = "error";
+  SetUpGLMock();
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+  {
+    platform.SetResourceDir(FLAGS_data_path);
+    platform.SetWritableDirForTests(FLAGS_data_path);
+  }
+  if (!FLAGS_user_resource_path.empty())
+    platform.SetResourceDir(FLAGS_user_resource_path);
+
+  classificator::Load();
+  df::VisualParams::Init(FLAGS_visual_scale, static_cast<uint32_t>(FLAGS_tile_size));
+
+  Index index;
+  auto const r = index.RegisterMap(platform::LocalCountryFile::MakeForTesting(FLAGS_mwm));
+  CHECK_EQUAL(r.second, MwmSet::RegResult::Success, ("Can't register", FLAGS_mwm));
+  CHECK(r.first.IsAlive(), ());
+  FeaturesCache featuresCache(FLAGS_features_cache_mb * 1024 * 1024);
+
+  vector<df::TileKey> const tiles = GetTiles(r.first.GetInfo()->m_limitRect);
+  CHECK(!tiles.empty(), ());
+
+  {
+    dp::TextureManager texMng;
+    InitTextureManager(texMng);
+
+    // Like in BackendRenderer the pool lives longer than a batching session.
+    Stats stats;
+    vector<drape_ptr<dp::RenderBucket>> overlayBuckets;
+    df::BatchersPool batchersPool(1 /* initBatcherCount */,
+                                  [&stats, &overlayBuckets](drape_ptr<df::Message> && message)
+    {
+      ASSERT_EQUAL(message->GetType(), df::Message::FlushTile, ());
+      ++stats.m_bucketsCount;
+
+      ref_ptr<df::FlushRenderBucketMessage> msg = make_ref(message);
+      if (msg->GetState().GetDepthLayer() == dp::GLState::OverlayLayer &&
+          msg->GetKey().m_zoomLevel == FLAGS_pan_zoom)
+      {
+        overlayBuckets.push_back(msg->AcceptBuffer());
+      }
+    });
+
+    for (uint64_t i = 0; i < FLAGS_runs; ++i)
+    {
+      LOG(LINFO, ("Run", i + 1));
+      stats = Stats();
+      overlayBuckets.clear();
+      RunBenchmark(index, featuresCache, tiles, make_ref(&texMng), batchersPool, stats);
+    }
+
+    if (FLAGS_pan_frames != 0)
+      RunPanBenchmark(overlayBuckets, tiles);
+    overlayBuckets.clear();
+
+    texMng.Release();
+  }
+
+  emul::GLMockFunctions::Teardown();
+  return 0;
+}
@@ -149,13 +149,15 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
         m_tileTree->Invalidate();
         ResolveTileKeys(rect, tiles);
 
-        auto eraseFunction = [&tiles](vector<drape_ptr<RenderGroup>> & groups)
+        auto eraseFunction = [this, &tiles](vector<drape_ptr<RenderGroup>> & groups)
         {
           vector<drape_ptr<RenderGroup> > newGroups;
           for (drape_ptr<RenderGroup> & group : groups)
           {
             if (tiles.find(group->GetTileKey()) == tiles.end())
               newGroups.push_back(move(group));
+            else if (group->IsOverlay())
+              group->RemoveOverlay(make_ref(m_overlayTree));
           }
 
           swap(groups, newGroups);
@@ -381,6 +383,7 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       ResolveTileKeys(screen.ClipRect(), tiles);
 
       // Clear all graphics.
+      m_overlayTree->Invalidate();
       m_renderGroups.clear();
       m_deferredRenderGroups.clear();
 
@@ -623,6 +626,8 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
 
     if (group->IsPendingOnDelete())
     {
+      if (group->IsOverlay())
+        group->RemoveOverlay(make_ref(m_overlayTree));
       group.reset();
       ++eraseCount;
       continue;
@@ -1006,6 +1011,7 @@ void FrontendRenderer::Routine::Do()
 void FrontendRenderer::ReleaseResources()
 {
   m_tileTree.reset();
+  m_overlayTree->Invalidate();
   m_renderGroups.clear();
   m_deferredRenderGroups.clear();
   m_userMarkRenderGroups.clear();
@@ -27,9 +27,9 @@ void MapDataProvider::ReadFeaturesID(TReadCallback<FeatureID> const & fn, m2::Re
   m_idsReader(fn, r, scale);
 }
 
-void MapDataProvider::ReadFeatures(TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids) const
+void MapDataProvider::ReadFeatures(TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids, int scale) const
 {
-  m_featureReader(fn, ids);
+  m_featureReader(fn, ids, scale);
 }
 
 void MapDataProvider::UpdateCountryIndex(storage::TIndex const & currentIndex, m2::PointF const & pt)
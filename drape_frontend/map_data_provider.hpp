@@ -15,7 +15,7 @@ class MapDataProvider
 {
 public:
   template <typename T> using TReadCallback = function<void (T const &)>;
-  using TReadFeaturesFn = function<void (TReadCallback<FeatureType> const & , vector<FeatureID> const &)>;
+  using TReadFeaturesFn = function<void (TReadCallback<FeatureType> const & , vector<FeatureID> const &, int)>;
   using TReadIDsFn = function<void (TReadCallback<FeatureID> const & , m2::RectD const &, int)>;
   using TUpdateCountryIndexFn = function<void (storage::TIndex const & , m2::PointF const &)>;
   using TIsCountryLoadedFn = function<bool (m2::PointD const &)>;
@@ -32,7 +32,7 @@ public:
                   TDownloadFn const & downloadRetryHandler);
 
   void ReadFeaturesID(TReadCallback<FeatureID> const & fn, m2::RectD const & r, int scale) const;
-  void ReadFeatures(TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids) const;
+  void ReadFeatures(TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids, int scale) const;
 
   void UpdateCountryIndex(storage::TIndex const & currentIndex, m2::PointF const & pt);
   TIsCountryLoadedFn const & GetIsCountryLoadedFn() const;
@@ -5,10 +5,12 @@
 #include "platform/platform.hpp"
 
 #include "base/buffer_vector.hpp"
+#include "base/logging.hpp"
 #include "base/stl_add.hpp"
 
 #include "std/bind.hpp"
 #include "std/algorithm.hpp"
+#include "std/cstdlib.hpp"
 
 namespace df
 {
@@ -16,6 +18,10 @@ namespace df
 namespace
 {
 
+// Priority penalty of a tile which scale differs from the current one by 1.
+// It's greater than a distance in tiles to any tile of the coverage.
+double const kZoomMismatchPenalty = 1000.0;
+
 struct LessCoverageCell
 {
   bool operator()(shared_ptr<TileInfo> const & l, TileKey const & r) const
@@ -34,11 +40,15 @@ struct LessCoverageCell
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model)
   : m_commutator(commutator)
   , m_model(model)
-  , m_pool(make_unique_dp<threads::ThreadPool>(ReadCount(), bind(&ReadManager::OnTaskFinished, this, _1)))
+  , m_pool(make_unique_dp<threads::PriorityThreadPool>(ReadCount(),
+                                                       bind(&ReadManager::GetTaskPriority, this, _1),
+                                                       bind(&ReadManager::OnTaskFinished, this, _1)))
+  , m_tileScale(0)
   , m_forceUpdate(true)
   , myPool(64, ReadMWMTaskFactory(m_memIndex, m_model))
   , m_counter(0)
   , m_generationCounter(0)
+  , m_isFirstTileRead(true)
 {
 }
 
@@ -54,11 +64,18 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
     // add finished tile to collection
     m_finishedTiles.emplace(t->GetTileKey());
 
+    if (!m_isFirstTileRead && !t->IsCancelled())
+    {
+      m_isFirstTileRead = true;
+      LOG(LDEBUG, ("Time to first tile:", m_coverageTimer.ElapsedSeconds()));
+    }
+
     // decrement counter
     ASSERT(m_counter > 0, ());
     --m_counter;
     if (m_counter == 0)
     {
+      LOG(LDEBUG, ("Time to full coverage:", m_coverageTimer.ElapsedSeconds()));
       m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                                 make_unique_dp<FinishReadingMessage>(m_finishedTiles),
                                 MessagePriority::Normal);
@@ -76,6 +93,8 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, TTilesCollection con
     return;
 
   m_forceUpdate = false;
+  m_viewportCenter = screen.GetOrg();
+  m_tileScale = df::GetTileScaleBase(screen);
   if (MustDropAllTiles(screen))
   {
     IncreaseCounter(static_cast<int>(tiles.size()));
@@ -83,7 +102,8 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, TTilesCollection con
 
     for_each(m_tileInfos.begin(), m_tileInfos.end(), bind(&ReadManager::CancelTileInfo, this, _1));
     m_tileInfos.clear();
-    for_each(tiles.begin(), tiles.end(), bind(&ReadManager::PushTaskBackForTileKey, this, _1, texMng));
+    m_pool->Reprioritize();
+    for_each(tiles.begin(), tiles.end(), bind(&ReadManager::PushTaskForTileKey, this, _1, texMng));
   }
   else
   {
@@ -122,8 +142,10 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, TTilesCollection con
     IncreaseCounter(static_cast<int>(inputRects.size() + rereadTiles.size()));
 
     for_each(outdatedTiles.begin(), outdatedTiles.end(), bind(&ReadManager::ClearTileInfo, this, _1));
-    for_each(rereadTiles.begin(), rereadTiles.end(), bind(&ReadManager::PushTaskFront, this, _1));
-    for_each(inputRects.begin(), inputRects.end(), bind(&ReadManager::PushTaskBackForTileKey, this, _1, texMng));
+    // Queued tasks are ordered according to the new viewport.
+    m_pool->Reprioritize();
+    for_each(rereadTiles.begin(), rereadTiles.end(), bind(&ReadManager::PushTaskForReread, this, _1));
+    for_each(inputRects.begin(), inputRects.end(), bind(&ReadManager::PushTaskForTileKey, this, _1, texMng));
   }
   m_currentViewport = screen;
 }
@@ -176,21 +198,34 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
   return (oldScale != newScale) || !m_currentViewport.GlobalRect().IsIntersect(screen.GlobalRect());
 }
 
-void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng)
+double ReadManager::GetTaskPriority(threads::IRoutine * task) const
+{
+  ASSERT(dynamic_cast<ReadMWMTask *>(task) != NULL, ());
+  ReadMWMTask * t = static_cast<ReadMWMTask *>(task);
+  if (t->IsCancelled())
+    return -1.0;
+
+  TileKey const & tileKey = t->GetTileKey();
+  m2::RectD const rect = tileKey.GetGlobalRect();
+  double const distanceInTiles = m_viewportCenter.Length(rect.Center()) / rect.SizeX();
+  return distanceInTiles + kZoomMismatchPenalty * abs(tileKey.m_zoomLevel - m_tileScale);
+}
+
+void ReadManager::PushTaskForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng)
 {
   shared_ptr<TileInfo> tileInfo(new TileInfo(make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter),
                                                                            m_commutator, texMng)));
   m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = myPool.Get();
   task->Init(tileInfo);
-  m_pool->PushBack(task);
+  m_pool->Push(task);
 }
 
-void ReadManager::PushTaskFront(shared_ptr<TileInfo> const & tileToReread)
+void ReadManager::PushTaskForReread(shared_ptr<TileInfo> const & tileToReread)
 {
   ReadMWMTask * task = myPool.Get();
   task->Init(tileToReread);
-  m_pool->PushFront(task);
+  m_pool->Push(task);
 }
 
 void ReadManager::CancelTileInfo(shared_ptr<TileInfo> const & tileToCancel)
@@ -208,6 +243,11 @@ void ReadManager::IncreaseCounter(int value)
 {
   lock_guard<mutex> lock(m_finishedTilesMutex);
   m_counter += value;
+  if (value > 0)
+  {
+    m_coverageTimer.Reset();
+    m_isFirstTileRead = false;
+  }
 }
 
 } // namespace df
@@ -12,7 +12,8 @@
 #include "drape/pointers.hpp"
 #include "drape/texture_manager.hpp"
 
-#include "base/thread_pool.hpp"
+#include "base/priority_thread_pool.hpp"
+#include "base/timer.hpp"
 
 #include "std/atomic.hpp"
 #include "std/mutex.hpp"
@@ -42,8 +43,12 @@ private:
   void OnTaskFinished(threads::IRoutine * task);
   bool MustDropAllTiles(ScreenBase const & screen) const;
 
-  void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng);
-  void PushTaskFront(shared_ptr<TileInfo> const & tileToReread);
+  // Tasks of tiles which are closer to the viewport center and have the current
+  // tile scale are read first, cancelled tasks are retired before all of them.
+  double GetTaskPriority(threads::IRoutine * task) const;
+
+  void PushTaskForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng);
+  void PushTaskForReread(shared_ptr<TileInfo> const & tileToReread);
 
 private:
   MemoryFeatureIndex m_memIndex;
@@ -51,9 +56,11 @@ private:
 
   MapDataProvider & m_model;
 
-  drape_ptr<threads::ThreadPool> m_pool;
+  drape_ptr<threads::PriorityThreadPool> m_pool;
 
   ScreenBase m_currentViewport;
+  m2::PointD m_viewportCenter;
+  int m_tileScale;
   bool m_forceUpdate;
 
   struct LessByTileInfo
@@ -74,6 +81,10 @@ private:
   mutex m_finishedTilesMutex;
   uint64_t m_generationCounter;
 
+  // Time from the last coverage update which has requested tiles.
+  my::Timer m_coverageTimer;
+  bool m_isFirstTileRead;
+
   void CancelTileInfo(shared_ptr<TileInfo> const & tileToCancel);
   void ClearTileInfo(shared_ptr<TileInfo> const & tileToClear);
   void IncreaseCounter(int value);
@@ -69,6 +69,12 @@ void RenderGroup::CollectOverlay(ref_ptr<dp::OverlayTree> tree)
     renderBucket->CollectOverlayHandles(tree, false /* isTransparent */);
 }
 
+void RenderGroup::RemoveOverlay(ref_ptr<dp::OverlayTree> tree)
+{
+  for (auto & renderBucket : m_renderBuckets)
+    renderBucket->RemoveOverlayHandles(tree);
+}
+
 void RenderGroup::Render(ScreenBase const & screen)
 {
   BaseRenderGroup::Render(screen);
@@ -7,8 +7,6 @@
 #include "indexer/drules_include.hpp"
 #include "indexer/scales.hpp"
 
-#include "std/bind.hpp"
-
 namespace df
 {
 
@@ -67,13 +65,11 @@ bool IsMiddleTunnel(int const layer, double const depth)
   return layer != feature::LAYER_EMPTY && depth < 19000;
 }
 
-void FilterRulesByRuntimeSelector(FeatureType const & f, int zoomLevel, drule::KeysT & keys)
+void FilterRulesByRuntimeSelector(FeatureType const & f, int zoomLevel, drule::RulesTable::TRules & rules)
 {
-  keys.erase_if([&f, zoomLevel](drule::Key const & key)->bool
+  rules.erase_if([&f, zoomLevel](drule::RulesTable::Rule const & rule)->bool
   {
-    drule::BaseRule const * const rule = drule::rules().Find(key);
-    ASSERT(rule != nullptr, ());
-    return !rule->TestFeature(f, zoomLevel);
+    return rule.m_hasSelector && !rule.m_rule->TestFeature(f, zoomLevel);
   });
 }
 
@@ -83,7 +79,7 @@ public:
   KeyFunctor(FeatureType const & f,
              feature::EGeomType type,
              int const zoomLevel,
-             int const keyCount,
+             int const ruleCount,
              bool isNameExists)
     : m_pointStyleFound(false)
     , m_lineStyleFound(false)
@@ -96,12 +92,13 @@ public:
     , m_zoomLevel(zoomLevel)
     , m_isNameExists(isNameExists)
   {
-    m_rules.reserve(keyCount);
+    m_rules.reserve(ruleCount);
     Init();
   }
 
-  void ProcessKey(drule::Key const & key)
+  void ProcessRule(drule::RulesTable::Rule const & rule)
   {
+    drule::Key const & key = rule.m_key;
     double depth = key.m_priority;
     if (IsMiddleTunnel(m_depthLayer, depth) &&
         IsTypeOf(key, Line | Area | Waymarker))
@@ -119,7 +116,7 @@ public:
     else if (IsTypeOf(key, Area))
       depth -= m_priorityModifier;
 
-    drule::BaseRule const * dRule = drule::rules().Find(key);
+    drule::BaseRule const * dRule = rule.m_rule;
     m_rules.push_back(make_pair(dRule, depth));
 
     bool isNonEmptyCaption = IsTypeOf(key, Caption) && m_isNameExists;
@@ -335,15 +332,15 @@ CaptionDescription & Stylist::GetCaptionDescriptionImpl()
 
 bool InitStylist(FeatureType const & f, int const zoomLevel, Stylist & s)
 {
-  drule::KeysT keys;
-  pair<int, bool> geomType = feature::GetDrawRule(f, zoomLevel, keys);
+  drule::RulesTable::TRules rules;
+  pair<int, bool> geomType = feature::GetDrawRules(f, zoomLevel, rules);
 
-  FilterRulesByRuntimeSelector(f, zoomLevel, keys);
+  FilterRulesByRuntimeSelector(f, zoomLevel, rules);
 
-  if (keys.empty())
+  if (rules.empty())
     return false;
 
-  drule::MakeUnique(keys);
+  drule::MakeUnique(rules);
   if (geomType.second)
     s.RaiseCoastlineFlag();
 
@@ -368,8 +365,9 @@ bool InitStylist(FeatureType const & f, int const zoomLevel, Stylist & s)
   CaptionDescription & descr = s.GetCaptionDescriptionImpl();
   descr.Init(f, zoomLevel);
 
-  KeyFunctor keyFunctor(f, mainGeomType, zoomLevel, keys.size(), descr.IsNameExists());
-  for_each(keys.begin(), keys.end(), bind(&KeyFunctor::ProcessKey, &keyFunctor, _1));
+  KeyFunctor keyFunctor(f, mainGeomType, zoomLevel, rules.size(), descr.IsNameExists());
+  for (drule::RulesTable::Rule const & rule : rules)
+    keyFunctor.ProcessRule(rule);
 
   if (keyFunctor.m_pointStyleFound)
     s.RaisePointStyleFlag();
@@ -74,7 +74,7 @@ void TileInfo::ReadFeatures(MapDataProvider const & model, MemoryFeatureIndex &
                       bind(&TileInfo::IsCancelled, this),
                       model.m_isCountryLoadedByNameFn,
                       make_ref(m_context));
-    model.ReadFeatures(bind<void>(ref(drawer), _1), featuresToRead);
+    model.ReadFeatures(bind<void>(ref(drawer), _1), featuresToRead, GetZoomLevel());
   }
 }
 
@@ -0,0 +1,129 @@
+#include "generator/country_pipeline.hpp"
+
+#include "generator/feature_sorter.hpp"
+
+#include "indexer/categories_holder.hpp"
+#include "indexer/data_header.hpp"
+#include "indexer/features_offsets_table.hpp"
+#include "indexer/index_builder.hpp"
+#include "indexer/search_index_builder.hpp"
+#include "indexer/street_houses_index.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/fork_join_pool.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/unique_ptr.hpp"
+
+#include "defines.hpp"
+
+namespace feature
+{
+bool GenerateCountry(GenerateInfo const & info, string const & country, CountryStages const & stages,
+                     CategoriesHolder const & categories, CountryResources const & resources,
+                     CountryStagesTiming & timing)
+{
+  string const datFile = info.GetTargetFileName(country);
+  my::Timer timer;
+
+  if (stages.m_geometry)
+  {
+    int mapType = DataHeader::country;
+    if (country == WORLD_FILE_NAME)
+      mapType = DataHeader::world;
+    if (country == WORLD_COASTS_FILE_NAME)
+      mapType = DataHeader::worldcoasts;
+
+    // If error - move to next bucket without index generation.
+
+    LOG(LINFO, ("Generating result features for", country));
+    if (!GenerateFinalFeatures(info, country, mapType))
+      return false;
+
+    LOG(LINFO, ("Generating offsets table for", datFile));
+    if (!BuildOffsetsTable(datFile))
+      return false;
+
+    timing.m_geometry = timer.ElapsedSeconds();
+    timer.Reset();
+  }
+
+  if (stages.m_index)
+  {
+    LOG(LINFO, ("Generating index for", datFile));
+
+    if (!indexer::BuildIndexFromDatFile(datFile, info.GetIntermediateFileName(country, ""),
+                                        resources.m_sortMemoryBytes,
+                                        resources.m_sortThreadsCount))
+      LOG(LCRITICAL, ("Error generating index."));
+
+    timing.m_index = timer.ElapsedSeconds();
+    timer.Reset();
+  }
+
+  if (stages.m_searchIndex)
+  {
+    LOG(LINFO, ("Generating search index for ", datFile));
+
+    if (!indexer::BuildSearchIndexFromDatFile(datFile, categories, true /* forceRebuild */,
+                                              resources.m_sortThreadsCount))
+      LOG(LCRITICAL, ("Error generating search index."));
+
+    LOG(LINFO, ("Generating street houses index for", datFile));
+    if (!indexer::BuildStreetHousesIndexFromDatFile(datFile))
+      LOG(LCRITICAL, ("Error generating street houses index."));
+
+    timing.m_searchIndex = timer.ElapsedSeconds();
+  }
+
+  return true;
+}
+
+void GenerateCountries(GenerateInfo const & info, vector<string> const & countries,
+                       CountryStages const & stages, size_t threadsCount)
+{
+  if (countries.empty() || !(stages.m_geometry || stages.m_index || stages.m_searchIndex))
+    return;
+
+  my::Timer timer;
+
+  unique_ptr<CategoriesHolder> categories;
+  if (stages.m_searchIndex)
+    categories.reset(new CategoriesHolder(GetPlatform().GetReader(SEARCH_CATEGORIES_FILE_NAME)));
+  else
+    categories.reset(new CategoriesHolder());
+
+  // Every worker sorts its own files, so sorters of a country get a share of the machine.
+  size_t const workersCount = max(threadsCount, size_t(1));
+  CountryResources resources;
+  resources.m_sortThreadsCount = GetPlatform().CpuCores() / workersCount;
+  resources.m_sortMemoryBytes = covering::kScaleIndexSortMemoryBytes / workersCount;
+
+  vector<CountryStagesTiming> timings(countries.size());
+  threads::ForkJoinPool pool(threadsCount);
+  pool.ForEach(countries.size(), [&](size_t i)
+  {
+    CountryStagesTiming & timing = timings[i];
+    if (!GenerateCountry(info, countries[i], stages, *categories, resources, timing))
+      return;
+    LOG(LINFO, ("Country", countries[i], "is done. Geometry:", timing.m_geometry, "s, index:",
+                timing.m_index, "s, search index:", timing.m_searchIndex, "s"));
+  });
+
+  CountryStagesTiming total;
+  for (auto const & timing : timings)
+  {
+    total.m_geometry += timing.m_geometry;
+    total.m_index += timing.m_index;
+    total.m_searchIndex += timing.m_searchIndex;
+  }
+  LOG(LINFO, ("Countries:", countries.size(), "threads:", threadsCount, "sorting threads:",
+              resources.m_sortThreadsCount, "sorting memory:", resources.m_sortMemoryBytes,
+              "elapsed:",
+              timer.ElapsedSeconds(), "s. Sum of geometry:", total.m_geometry, "s, index:",
+              total.m_index, "s, search index:", total.m_searchIndex, "s"));
+}
+}  // namespace feature
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "generator/generate_info.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+class CategoriesHolder;
+
+namespace feature
+{
+/// Generation passes which are done for every country separately.
+struct CountryStages
+{
+  bool m_geometry = false;
+  bool m_index = false;
+  bool m_searchIndex = false;
+};
+
+/// Budget of external sorters of index passes of a country.
+struct CountryResources
+{
+  /// Sorting threads, 0 means the caller's thread only.
+  size_t m_sortThreadsCount = 0;
+  size_t m_sortMemoryBytes = 0;
+};
+
+/// Seconds spent on every pass.
+struct CountryStagesTiming
+{
+  double m_geometry = 0.0;
+  double m_index = 0.0;
+  double m_searchIndex = 0.0;
+};
+
+/// Runs the passes for the country. Index passes are skipped when geometry pass fails.
+/// @return false if geometry pass failed.
+bool GenerateCountry(GenerateInfo const & info, string const & country, CountryStages const & stages,
+                     CategoriesHolder const & categories, CountryResources const & resources,
+                     CountryStagesTiming & timing);
+
+/// Runs the passes for every country on threadsCount workers (0 means caller's thread only)
+/// and logs timing of every pass. Categories are loaded once for all countries.
+/// Cpu cores and the default sorting memory are split between the workers.
+void GenerateCountries(GenerateInfo const & info, vector<string> const & countries,
+                       CountryStages const & stages, size_t threadsCount);
+}  // namespace feature
@@ -18,13 +18,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Sparse
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
 
@@ -41,6 +43,8 @@ struct GenerateInfo
   NodeStorageType m_nodeStorageType;
   OsmSourceType m_osmFileType;
   string m_osmFileName;
+  // Number of threads for parallel tasks, 0 means single-threaded mode.
+  size_t m_threadsCount = 0;
 
   uint32_t m_versionDate = 0;
 
@@ -63,6 +67,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -75,6 +81,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "sparse")
+      m_nodeStorageType = NodeStorageType::Sparse;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
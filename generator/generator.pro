@@ -18,6 +18,7 @@ SOURCES += \
     borders_loader.cpp \
     check_model.cpp \
     coastlines_generator.cpp \
+    country_pipeline.cpp \
     dumper.cpp \
     feature_builder.cpp \
     feature_generator.cpp \
@@ -27,6 +28,7 @@ SOURCES += \
     osm2type.cpp \
     osm_element.cpp \
     osm_id.cpp \
+    osm_pbf_source.cpp \
     osm_source.cpp \
     routing_generator.cpp \
     statistics.cpp \
@@ -39,6 +41,7 @@ HEADERS += \
     borders_loader.hpp \
     check_model.hpp \
     coastlines_generator.hpp \
+    country_pipeline.hpp \
     dumper.hpp \
     intermediate_data.hpp\
     intermediate_elements.hpp\
@@ -54,6 +57,7 @@ HEADERS += \
     osm_element.hpp \
     osm_id.hpp \
     osm_o5m_source.hpp \
+    osm_pbf_source.hpp \
     osm_translator.hpp \
     osm_xml_source.hpp \
     polygonizer.hpp \
@@ -21,6 +21,7 @@ SOURCES += \
     coasts_test.cpp \
     feature_builder_test.cpp \
     feature_merger_test.cpp \
+    intermediate_data_test.cpp \
     metadata_parser_test.cpp \
     osm_id_test.cpp \
     osm_o5m_source_test.cpp \
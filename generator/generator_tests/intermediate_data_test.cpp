@@ -8,8 +8,17 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+
 
 UNIT_TEST(Intermediate_Data_empty_way_element_save_load_test)
 {
@@ -99,3 +108,42 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_sparse_array_test)
+{
+  string const name = GetPlatform().WritablePathForFile("sparse_array_test.tmp");
+  MY_SCOPE_GUARD(deleteFileGuard, bind(&FileWriter::DeleteFileX, cref(name)));
+
+  uint64_t const kFullChunkStart = 5 * cache::detail::SparseArrayLayout::kChunkSize;
+  uint64_t const kFarId = 0xFFFFFFFFFFFFull;
+
+  {
+    cache::detail::SparseArrayWriter<uint64_t> writer(name);
+    writer.Set(3, 30);
+    writer.Set(1, 10);
+    writer.Set(100, 1000);
+    for (uint64_t id = kFullChunkStart; id < kFullChunkStart + 4096; ++id)
+      writer.Set(id, id * 2);
+    writer.Set(kFarId, 42);
+  }
+
+  cache::detail::SparseArrayReader<uint64_t> reader(name);
+  uint64_t value = 0;
+  TEST(reader.Get(1, value), ());
+  TEST_EQUAL(value, 10, ());
+  TEST(reader.Get(3, value), ());
+  TEST_EQUAL(value, 30, ());
+  TEST(reader.Get(100, value), ());
+  TEST_EQUAL(value, 1000, ());
+  TEST(!reader.Get(0, value), ());
+  TEST(!reader.Get(2, value), ());
+  TEST(!reader.Get(kFullChunkStart - 1, value), ());
+  TEST(reader.Get(kFullChunkStart, value), ());
+  TEST_EQUAL(value, kFullChunkStart * 2, ());
+  TEST(reader.Get(kFullChunkStart + 4095, value), ());
+  TEST_EQUAL(value, (kFullChunkStart + 4095) * 2, ());
+  TEST(!reader.Get(kFullChunkStart + 4096, value), ());
+  TEST(reader.Get(kFarId, value), ());
+  TEST_EQUAL(value, 42, ());
+  TEST(!reader.Get(kFarId + 1, value), ());
+}
@@ -138,3 +138,67 @@ unsigned char const relation_o5m_data[] = /* 224 */
   0x61, 0x63, 0x65, 0x00, 0x74, 0x6F, 0x77, 0x6E, 0x00, 0x00, 0x74, 0x79, 0x70, 0x65, 0x00,
   0x6D, 0x75, 0x6C, 0x74, 0x69, 0x70, 0x6F, 0x6C, 0x79, 0x67, 0x6F, 0x6E, 0x00, 0xFE};
 static_assert(sizeof(relation_o5m_data) == 224, "Size check failed");
+
+// binary data: relation.pbf
+unsigned char const relation_pbf_data[] = /* 385 */
+{0x00, 0x00, 0x00, 0x0D, 0x0A, 0x09, 0x4F, 0x53, 0x4D, 0x48, 0x65, 0x61, 0x64, 0x65, 0x72,
+  0x18, 0x2B, 0x0A, 0x29, 0x22, 0x0E, 0x4F, 0x73, 0x6D, 0x53, 0x63, 0x68, 0x65, 0x6D, 0x61,
+  0x2D, 0x56, 0x30, 0x2E, 0x36, 0x22, 0x0A, 0x44, 0x65, 0x6E, 0x73, 0x65, 0x4E, 0x6F, 0x64,
+  0x65, 0x73, 0x82, 0x01, 0x0A, 0x6F, 0x73, 0x6D, 0x32, 0x70, 0x62, 0x66, 0x2E, 0x70, 0x79,
+  0x00, 0x00, 0x00, 0x0C, 0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0x86,
+  0x01, 0x10, 0x7F, 0x1A, 0x81, 0x01, 0x78, 0x9C, 0xE3, 0x52, 0xE4, 0x62, 0xE0, 0x62, 0xC9,
+  0x4B, 0xCC, 0x4D, 0xE5, 0xE2, 0x0A, 0xCF, 0xC8, 0x2C, 0x49, 0xCD, 0xC8, 0x2F, 0x2A, 0x4E,
+  0xE5, 0x62, 0x2D, 0xC8, 0x49, 0x4C, 0x4E, 0xE5, 0x62, 0x29, 0xC9, 0x2F, 0xCF, 0x13, 0x8A,
+  0x12, 0x8A, 0xE0, 0xE2, 0xBE, 0xBE, 0x46, 0x51, 0x87, 0x05, 0x0C, 0x98, 0x9C, 0xA4, 0x97,
+  0x9D, 0xEB, 0x38, 0xCC, 0x72, 0x33, 0xE3, 0xFB, 0x37, 0xD1, 0xDF, 0x67, 0x04, 0xFF, 0xCD,
+  0x62, 0x3A, 0xB4, 0x9C, 0xFF, 0xC2, 0x61, 0xC9, 0x07, 0x77, 0xC5, 0xE6, 0x7A, 0x7A, 0xC9,
+  0xAE, 0x3F, 0xFF, 0xA7, 0x9D, 0x6B, 0xCE, 0x04, 0x95, 0x3B, 0x67, 0xE5, 0xFA, 0x2F, 0x6B,
+  0x3D, 0x9F, 0x9A, 0x30, 0xFD, 0x9E, 0xF0, 0x96, 0x79, 0x22, 0x2B, 0xFA, 0x95, 0x96, 0x7D,
+  0x93, 0x0C, 0xE2, 0x65, 0x64, 0x62, 0x66, 0x61, 0x80, 0x01, 0x00, 0xDE, 0xF2, 0x2C, 0xE2,
+  0x00, 0x00, 0x00, 0x0B, 0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0x25,
+  0x10, 0x20, 0x1A, 0x21, 0x78, 0x9C, 0xE3, 0x62, 0xE2, 0x62, 0x10, 0x92, 0x92, 0x92, 0xE0,
+  0xF8, 0xBA, 0xF2, 0xFD, 0x7F, 0x30, 0x60, 0x74, 0xE2, 0x9E, 0xB8, 0x46, 0x91, 0x91, 0x19,
+  0x0C, 0xA4, 0x00, 0xC0, 0x72, 0x0A, 0xDD, 0x00, 0x00, 0x00, 0x0B, 0x0A, 0x07, 0x4F, 0x53,
+  0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0x6C, 0x10, 0x65, 0x1A, 0x68, 0x78, 0x9C, 0xE3, 0xB2,
+  0xE1, 0x62, 0xE0, 0x62, 0xC9, 0x4B, 0xCC, 0x4D, 0xE5, 0x62, 0x2D, 0xC8, 0x49, 0x4C, 0x4E,
+  0xE5, 0x62, 0x29, 0xA9, 0x2C, 0x48, 0xE5, 0xE2, 0x0A, 0xCF, 0xC8, 0x2C, 0x49, 0xCD, 0xC8,
+  0x2F, 0x2A, 0x06, 0x89, 0xE4, 0x97, 0xE7, 0x71, 0xF1, 0xE4, 0x96, 0xE6, 0x94, 0x64, 0x16,
+  0xE4, 0xE7, 0x54, 0xA6, 0xE7, 0xE7, 0x71, 0xB1, 0xE6, 0x97, 0x96, 0xA4, 0x16, 0x09, 0xA9,
+  0x2A, 0x29, 0x73, 0x3C, 0x5F, 0xF9, 0xFE, 0x3F, 0x18, 0x30, 0x0A, 0x31, 0x33, 0x32, 0x31,
+  0x4B, 0x31, 0xB3, 0xB0, 0xB2, 0x39, 0x31, 0xB1, 0x33, 0x78, 0xB1, 0x4C, 0x5D, 0xA3, 0xE8,
+  0x18, 0xC4, 0xC4, 0xC8, 0x00, 0x00, 0x42, 0xC8, 0x1F, 0x4D};
+static_assert(sizeof(relation_pbf_data) == 385, "Size check failed");
+
+// binary data: relation_sparse.pbf
+unsigned char const relation_sparse_pbf_data[] = /* 441 */
+{0x00, 0x00, 0x00, 0x0D, 0x0A, 0x09, 0x4F, 0x53, 0x4D, 0x48, 0x65, 0x61, 0x64, 0x65, 0x72,
+  0x18, 0x2B, 0x0A, 0x29, 0x22, 0x0E, 0x4F, 0x73, 0x6D, 0x53, 0x63, 0x68, 0x65, 0x6D, 0x61,
+  0x2D, 0x56, 0x30, 0x2E, 0x36, 0x22, 0x0A, 0x44, 0x65, 0x6E, 0x73, 0x65, 0x4E, 0x6F, 0x64,
+  0x65, 0x73, 0x82, 0x01, 0x0A, 0x6F, 0x73, 0x6D, 0x32, 0x70, 0x62, 0x66, 0x2E, 0x70, 0x79,
+  0x00, 0x00, 0x00, 0x0C, 0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0xBE,
+  0x01, 0x10, 0xD0, 0x01, 0x1A, 0xB8, 0x01, 0x78, 0x9C, 0xE3, 0x52, 0xE4, 0x62, 0xE0, 0x62,
+  0xC9, 0x4B, 0xCC, 0x4D, 0xE5, 0x62, 0x2D, 0xC8, 0x49, 0x4C, 0x4E, 0xE5, 0xE2, 0x0A, 0xCF,
+  0xC8, 0x2C, 0x49, 0xCD, 0xC8, 0x2F, 0x2A, 0x4E, 0xE5, 0x62, 0x29, 0xC9, 0x2F, 0xCF, 0x13,
+  0x5A, 0xC5, 0xC8, 0x25, 0xC1, 0x71, 0x7D, 0x8D, 0xA2, 0x10, 0x13, 0x23, 0x93, 0x14, 0x13,
+  0x33, 0x8B, 0xC3, 0xB2, 0x73, 0x1D, 0x87, 0x59, 0x3C, 0xD6, 0x9F, 0xFF, 0xD3, 0xCE, 0xC5,
+  0x25, 0xC0, 0xB1, 0x7A, 0x8D, 0xA2, 0xC3, 0x99, 0xA7, 0xED, 0x40, 0x91, 0xC9, 0xFB, 0x6F,
+  0x80, 0x45, 0x96, 0x03, 0x45, 0xAE, 0xBC, 0xFB, 0x78, 0x88, 0xC5, 0x63, 0xFB, 0xC7, 0x9D,
+  0x60, 0x91, 0xC5, 0x40, 0x91, 0x1B, 0x0B, 0x1F, 0x00, 0x45, 0x8E, 0x1F, 0x79, 0x02, 0x16,
+  0x99, 0x0F, 0x14, 0xB9, 0xB6, 0xE7, 0x11, 0x50, 0x64, 0xFD, 0xAD, 0x23, 0x1D, 0x20, 0x91,
+  0xD9, 0x40, 0x91, 0x19, 0x4F, 0x40, 0xBA, 0x8E, 0xEF, 0xB8, 0x01, 0x16, 0x99, 0x0E, 0x14,
+  0x79, 0xB1, 0xBC, 0x1B, 0x64, 0xF2, 0x2C, 0x88, 0x9A, 0xC9, 0x40, 0x91, 0x13, 0xAD, 0x8B,
+  0x80, 0x22, 0xAF, 0xBB, 0x16, 0x81, 0x45, 0x26, 0x02, 0x45, 0x56, 0xED, 0x59, 0x08, 0x14,
+  0x39, 0x3A, 0xA5, 0xA3, 0x83, 0x0B, 0x00, 0xED, 0x41, 0x52, 0x3F, 0x00, 0x00, 0x00, 0x0B,
+  0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0x25, 0x10, 0x20, 0x1A, 0x21,
+  0x78, 0x9C, 0xE3, 0x62, 0xE2, 0x62, 0x10, 0x92, 0x92, 0x92, 0xE0, 0xF8, 0xBA, 0xF2, 0xFD,
+  0x7F, 0x30, 0x60, 0x74, 0xE2, 0x9E, 0xB8, 0x46, 0x91, 0x91, 0x19, 0x0C, 0xA4, 0x00, 0xC0,
+  0x72, 0x0A, 0xDD, 0x00, 0x00, 0x00, 0x0B, 0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74,
+  0x61, 0x18, 0x6C, 0x10, 0x65, 0x1A, 0x68, 0x78, 0x9C, 0xE3, 0xB2, 0xE1, 0x62, 0xE0, 0x62,
+  0xC9, 0x4B, 0xCC, 0x4D, 0xE5, 0x62, 0x2D, 0xC8, 0x49, 0x4C, 0x4E, 0xE5, 0x62, 0x29, 0xA9,
+  0x2C, 0x48, 0xE5, 0xE2, 0x0A, 0xCF, 0xC8, 0x2C, 0x49, 0xCD, 0xC8, 0x2F, 0x2A, 0x06, 0x89,
+  0xE4, 0x97, 0xE7, 0x71, 0xF1, 0xE4, 0x96, 0xE6, 0x94, 0x64, 0x16, 0xE4, 0xE7, 0x54, 0xA6,
+  0xE7, 0xE7, 0x71, 0xB1, 0xE6, 0x97, 0x96, 0xA4, 0x16, 0x09, 0xA9, 0x2A, 0x29, 0x73, 0x3C,
+  0x5F, 0xF9, 0xFE, 0x3F, 0x18, 0x30, 0x0A, 0x31, 0x33, 0x32, 0x31, 0x4B, 0x31, 0xB3, 0xB0,
+  0xB2, 0x39, 0x31, 0xB1, 0x33, 0x78, 0xB1, 0x4C, 0x5D, 0xA3, 0xE8, 0x18, 0xC4, 0xC4, 0xC8,
+  0x00, 0x00, 0x42, 0xC8, 0x1F, 0x4D};
+static_assert(sizeof(relation_sparse_pbf_data) == 441, "Size check failed");
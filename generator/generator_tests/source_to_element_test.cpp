@@ -64,3 +64,45 @@ UNIT_TEST(Source_To_Element_check_equivalence)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
   }
 }
+
+namespace
+{
+vector<OsmElement> ReadPbf(unsigned char const * begin, unsigned char const * end,
+                           size_t threadsCount)
+{
+  string src(begin, end);
+  istringstream ss(src);
+  SourceReader reader(ss);
+
+  vector<OsmElement> elements;
+  BuildFeaturesFromPBF(reader, [&elements](OsmElement * e)
+  {
+    elements.push_back(*e);
+  }, threadsCount);
+  return elements;
+}
+}  // namespace
+
+UNIT_TEST(Source_To_Element_check_pbf_equivalence)
+{
+  istringstream ss(relation_xml_data);
+  SourceReader readerXML(ss);
+
+  vector<OsmElement> elementsXML;
+  BuildFeaturesFromXML(readerXML, [&elementsXML](OsmElement * e)
+  {
+    elementsXML.push_back(*e);
+  });
+
+  // Dense and not dense nodes, single-threaded and multi-threaded decoding.
+  for (size_t threadsCount : {0, 4})
+  {
+    vector<OsmElement> const dense =
+        ReadPbf(begin(relation_pbf_data), end(relation_pbf_data), threadsCount);
+    TEST_EQUAL(elementsXML, dense, (threadsCount));
+
+    vector<OsmElement> const sparse =
+        ReadPbf(begin(relation_sparse_pbf_data), end(relation_sparse_pbf_data), threadsCount);
+    TEST_EQUAL(elementsXML, sparse, (threadsCount));
+  }
+}
@@ -5,6 +5,7 @@
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/index_builder.hpp"
 #include "indexer/search_index_builder.hpp"
+#include "indexer/street_houses_index.hpp"
 
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
@@ -79,5 +80,8 @@ void TestMwmBuilder::Finish()
   CHECK(indexer::BuildSearchIndexFromDatFile(mapFilePath, true /* forceRebuild */),
         ("Can't build search index."));
 
+  CHECK(indexer::BuildStreetHousesIndexFromDatFile(mapFilePath),
+        ("Can't build street houses index."));
+
   m_file.SyncWithDisk();
 }
@@ -8,6 +8,7 @@
 #include "generator/unpack_mwm.hpp"
 #include "generator/generate_info.hpp"
 #include "generator/check_model.hpp"
+#include "generator/country_pipeline.hpp"
 #include "generator/routing_generator.hpp"
 #include "generator/osm_source.hpp"
 
@@ -22,6 +23,8 @@
 
 #include "coding/file_name_utils.hpp"
 
+#include "base/stl_add.hpp"
+#include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
@@ -52,9 +55,12 @@ DEFINE_bool(generate_search_index, false, "5th pass - generate search index");
 DEFINE_bool(calc_statistics, false, "Calculate feature statistics for specified mwm bucket files");
 DEFINE_bool(type_statistics, false, "Calculate statistics by type for specified mwm bucket files");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache");
-DEFINE_string(node_storage, "map", "Type of storage for intermediate points representation. Available: raw, map, mem");
+DEFINE_string(node_storage, "map", "Type of storage for intermediate points representation. Available: raw, map, mem, sparse");
 DEFINE_string(data_path, "", "Working directory, 'path_to_exe/../../data' if empty.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
+DEFINE_string(countries, "", "Comma-separated file names (without 'mwm' ext) to process in parallel "
+                             "by --generate_geometry, --generate_index and --generate_search_index "
+                             "on --threads_count workers.");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
 DEFINE_bool(generate_world, false, "Generate separate world file");
 DEFINE_bool(split_by_polygons, false, "Use countries borders to split planet by regions and countries");
@@ -70,8 +76,11 @@ DEFINE_bool(generate_addresses_file, false, "Generate .addr file (for '--output'
 DEFINE_string(osrm_file_name, "", "Input osrm file to generate routing info");
 DEFINE_bool(make_routing, false, "Make routing info based on osrm file");
 DEFINE_bool(make_cross_section, false, "Make corss section in routing file for cross mwm routing");
+DEFINE_bool(make_pedestrian_landmarks, false, "Make landmarks section in mwm for pedestrian ALT routing");
+DEFINE_uint64(landmarks_count, 8, "Number of landmarks for --make_pedestrian_landmarks");
 DEFINE_string(osm_file_name, "", "Input osm area file");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m]");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf]");
+DEFINE_uint64(threads_count, 0, "Number of threads for parallel tasks, cores count if 0");
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_uint64(planet_version, my::TodayAsYYMMDD(), "Version as YYMMDD, by default - today");
 
@@ -106,6 +115,8 @@ int main(int argc, char ** argv)
   genInfo.m_osmFileName = FLAGS_osm_file_name;
   genInfo.m_failOnCoasts = FLAGS_fail_on_coasts;
   genInfo.m_preloadCache = FLAGS_preload_cache;
+  genInfo.m_threadsCount =
+      FLAGS_threads_count == 0 ? pl.CpuCores() : static_cast<size_t>(FLAGS_threads_count);
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
 
@@ -161,49 +172,20 @@ int main(int argc, char ** argv)
       genInfo.m_bucketNames.push_back(FLAGS_output);
   }
 
-  // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  if (!FLAGS_countries.empty())
   {
-    string const & country = genInfo.m_bucketNames[i];
-    string const datFile = my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION);
-
-    if (FLAGS_generate_geometry)
-    {
-      int mapType = feature::DataHeader::country;
-      if (country == WORLD_FILE_NAME)
-        mapType = feature::DataHeader::world;
-      if (country == WORLD_COASTS_FILE_NAME)
-        mapType = feature::DataHeader::worldcoasts;
-
-      // If error - move to next bucket without index generation.
-
-      LOG(LINFO, ("Generating result features for", country));
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
-
-      LOG(LINFO, ("Generating offsets table for", datFile));
-      if (!feature::BuildOffsetsTable(datFile))
-        continue;
-    }
-
-    if (FLAGS_generate_index)
-    {
-      LOG(LINFO, ("Generating index for", datFile));
-
-      if (!indexer::BuildIndexFromDatFile(datFile, FLAGS_intermediate_data_path + country))
-        LOG(LCRITICAL, ("Error generating index."));
-    }
-
-    if (FLAGS_generate_search_index)
-    {
-      LOG(LINFO, ("Generating search index for ", datFile));
-
-      if (!indexer::BuildSearchIndexFromDatFile(datFile, true))
-        LOG(LCRITICAL, ("Error generating search index."));
-    }
+    genInfo.m_bucketNames.clear();
+    strings::Tokenize(FLAGS_countries, ",", MakeBackInsertFunctor(genInfo.m_bucketNames));
   }
 
+  // Enumerate over all dat files that were created.
+  feature::CountryStages stages;
+  stages.m_geometry = FLAGS_generate_geometry;
+  stages.m_index = FLAGS_generate_index;
+  stages.m_searchIndex = FLAGS_generate_search_index;
+  feature::GenerateCountries(genInfo, genInfo.m_bucketNames, stages,
+                             FLAGS_countries.empty() ? 0 : genInfo.m_threadsCount);
+
   // Create http update list for countries and corresponding files
   if (FLAGS_generate_update)
   {
@@ -261,5 +243,8 @@ int main(int argc, char ** argv)
   if (!FLAGS_osrm_file_name.empty() && FLAGS_make_cross_section)
     routing::BuildCrossRoutingIndex(path, FLAGS_output, FLAGS_osrm_file_name);
 
+  if (FLAGS_make_pedestrian_landmarks)
+    routing::BuildPedestrianLandmarks(path, FLAGS_output, FLAGS_landmarks_count);
+
   return 0;
 }
@@ -9,10 +9,16 @@
 
 #include "base/logging.hpp"
 
+#include "base/bits.hpp"
+
 #include "std/algorithm.hpp"
+#include "std/array.hpp"
+#include "std/cstring.hpp"
 #include "std/deque.hpp"
 #include "std/exception.hpp"
 #include "std/limits.hpp"
+#include "std/type_traits.hpp"
+#include "std/unordered_map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -128,20 +134,311 @@ public:
     }
   }
 };
+
+/// Chunked array of values by 64-bit ids on disk. Every chunk covers kChunkSize consecutive ids.
+/// Chunks without values are not stored at all, full chunks are stored as plain arrays,
+/// other chunks as a presence bitmap with ranks and packed values of present ids.
+/// So the file size is proportional to the number of ids, lookups are O(1) and reading doesn't
+/// need any sorting.
+///
+/// File layout: chunks, a directory of (chunk number, chunk offset) pairs, number of directory
+/// entries and a format tag.
+struct SparseArrayLayout
+{
+  static uint32_t constexpr kChunkBits = 12;
+  static uint64_t constexpr kChunkSize = 1 << kChunkBits;
+  static uint32_t constexpr kWordsCount = kChunkSize / 64;
+  static uint64_t constexpr kFormatTag = 0x3179617272417053;  // "SpArray1"
+
+  // Directory entries of chunks with smaller numbers are stored in a vector, others in a hash map.
+  // 2^26 entries are enough for 2^38 ids.
+  static uint64_t constexpr kMaxPlainDirectorySize = 1 << 26;
+
+  enum ChunkType : uint32_t
+  {
+    kSparseChunk = 0,
+    kFullChunk = 1
+  };
+
+  struct ChunkHeader
+  {
+    uint32_t m_count;
+    uint32_t m_type;
+  };
+
+  // Header of a sparse chunk, it's followed by m_count values.
+  struct SparseChunk
+  {
+    uint64_t m_bits[kWordsCount];
+    // Number of present ids in the previous words.
+    uint16_t m_ranks[kWordsCount];
+  };
+};
+
+/// Writes SparseArrayLayout file. Ids must be added in ascending order of chunks,
+/// ids inside of a chunk may be added in any order.
+template <class TValue>
+class SparseArrayWriter : public SparseArrayLayout
+{
+  static_assert(is_pod<TValue>::value, "");
+
+public:
+  explicit SparseArrayWriter(string const & name) : m_file(name) {}
+
+  ~SparseArrayWriter()
+  {
+    if (!m_finished)
+      Finish();
+  }
+
+  string GetFileName() const { return m_file.GetName(); }
+
+  void Set(uint64_t id, TValue const & value)
+  {
+    uint64_t const chunk = id >> kChunkBits;
+    if (chunk != m_chunk)
+    {
+      CHECK(m_count == 0 || chunk > m_chunk, ("Ids must be sorted by chunks. Id:", id, "file:",
+                                              GetFileName()));
+      FlushChunk();
+      m_chunk = chunk;
+    }
+
+    uint32_t const index = static_cast<uint32_t>(id & (kChunkSize - 1));
+    uint64_t & word = m_bits[index / 64];
+    uint64_t const mask = uint64_t(1) << (index % 64);
+    if ((word & mask) == 0)
+    {
+      word |= mask;
+      ++m_count;
+    }
+    m_values[index] = value;
+  }
+
+  void Finish()
+  {
+    FlushChunk();
+
+    for (auto const & entry : m_directory)
+      m_file.Write(&entry, sizeof(entry));
+    uint64_t const count = m_directory.size();
+    m_file.Write(&count, sizeof(count));
+    uint64_t const tag = kFormatTag;
+    m_file.Write(&tag, sizeof(tag));
+    m_file.Flush();
+    m_finished = true;
+  }
+
+private:
+  void FlushChunk()
+  {
+    if (m_count == 0)
+      return;
+
+    m_directory.emplace_back(m_chunk, static_cast<uint64_t>(m_file.Pos()));
+    ChunkHeader header;
+    header.m_count = m_count;
+    if (m_count == kChunkSize)
+    {
+      header.m_type = kFullChunk;
+      m_file.Write(&header, sizeof(header));
+      m_file.Write(m_values.data(), kChunkSize * sizeof(TValue));
+    }
+    else
+    {
+      header.m_type = kSparseChunk;
+      SparseChunk sparse;
+      m_packed.clear();
+      for (uint32_t w = 0; w < kWordsCount; ++w)
+      {
+        sparse.m_bits[w] = m_bits[w];
+        sparse.m_ranks[w] = static_cast<uint16_t>(m_packed.size());
+        for (uint32_t bit = 0; bit < 64; ++bit)
+        {
+          if (m_bits[w] & (uint64_t(1) << bit))
+            m_packed.push_back(m_values[w * 64 + bit]);
+        }
+      }
+      m_file.Write(&header, sizeof(header));
+      m_file.Write(&sparse, sizeof(sparse));
+      m_file.Write(m_packed.data(), m_packed.size() * sizeof(TValue));
+    }
+
+    // Keep chunks aligned for direct access to values.
+    uint64_t const padding = (8 - m_file.Pos() % 8) % 8;
+    uint64_t const zero = 0;
+    m_file.Write(&zero, padding);
+
+    fill(m_bits.begin(), m_bits.end(), 0);
+    m_count = 0;
+  }
+
+  FileWriter m_file;
+  vector<pair<uint64_t, uint64_t>> m_directory;
+  uint64_t m_chunk = 0;
+  uint32_t m_count = 0;
+  array<uint64_t, kWordsCount> m_bits = {};
+  vector<TValue> m_values = vector<TValue>(kChunkSize);
+  vector<TValue> m_packed;
+  bool m_finished = false;
+};
+
+/// Reads SparseArrayLayout file mapped into memory.
+template <class TValue>
+class SparseArrayReader : public SparseArrayLayout
+{
+  static_assert(is_pod<TValue>::value, "");
+
+public:
+  explicit SparseArrayReader(string const & name) : m_file(name), m_name(name)
+  {
+#ifdef OMIM_OS_WINDOWS
+    m_buffer.resize(m_file.Size());
+    m_file.Read(0, m_buffer.data(), m_buffer.size());
+    m_data = m_buffer.data();
+#else
+    m_data = m_file.Data();
+#endif
+    uint64_t const size = m_file.Size();
+    CHECK_GREATER_OR_EQUAL(size, 2 * sizeof(uint64_t), ("Damaged file", name));
+
+    uint64_t count, tag;
+    memcpy(&count, m_data + size - 2 * sizeof(uint64_t), sizeof(count));
+    memcpy(&tag, m_data + size - sizeof(uint64_t), sizeof(tag));
+    CHECK_EQUAL(tag, uint64_t(kFormatTag), ("Damaged file", name));
+    uint64_t const directorySize = count * sizeof(pair<uint64_t, uint64_t>);
+    CHECK_LESS_OR_EQUAL(directorySize, size - 2 * sizeof(uint64_t), ("Damaged file", name));
+
+    uint8_t const * entry = m_data + size - 2 * sizeof(uint64_t) - directorySize;
+    for (uint64_t i = 0; i < count; ++i, entry += 2 * sizeof(uint64_t))
+    {
+      uint64_t chunk, offset;
+      memcpy(&chunk, entry, sizeof(chunk));
+      memcpy(&offset, entry + sizeof(chunk), sizeof(offset));
+      if (chunk < kMaxPlainDirectorySize)
+      {
+        if (chunk >= m_directory.size())
+          m_directory.resize(chunk + 1, kNoChunk);
+        m_directory[chunk] = offset;
+      }
+      else
+      {
+        m_farDirectory[chunk] = offset;
+      }
+    }
+  }
+
+  string GetFileName() const { return m_name; }
+
+  bool Get(uint64_t id, TValue & value) const
+  {
+    uint64_t const offset = GetChunkOffset(id >> kChunkBits);
+    if (offset == kNoChunk)
+      return false;
+
+    uint8_t const * chunk = m_data + offset;
+    ChunkHeader header;
+    memcpy(&header, chunk, sizeof(header));
+    chunk += sizeof(header);
+
+    uint32_t const index = static_cast<uint32_t>(id & (kChunkSize - 1));
+    if (header.m_type == kFullChunk)
+    {
+      memcpy(&value, chunk + index * sizeof(TValue), sizeof(TValue));
+      return true;
+    }
+
+    SparseChunk const * sparse = reinterpret_cast<SparseChunk const *>(chunk);
+    uint64_t const word = sparse->m_bits[index / 64];
+    uint64_t const mask = uint64_t(1) << (index % 64);
+    if ((word & mask) == 0)
+      return false;
+
+    uint64_t const rank = sparse->m_ranks[index / 64] + bits::popcount(word & (mask - 1));
+    memcpy(&value, chunk + sizeof(SparseChunk) + rank * sizeof(TValue), sizeof(TValue));
+    return true;
+  }
+
+private:
+  static uint64_t constexpr kNoChunk = numeric_limits<uint64_t>::max();
+
+  uint64_t GetChunkOffset(uint64_t chunk) const
+  {
+    if (chunk < m_directory.size())
+      return m_directory[chunk];
+    if (chunk < kMaxPlainDirectorySize)
+      return kNoChunk;
+    auto const it = m_farDirectory.find(chunk);
+    return it == m_farDirectory.end() ? kNoChunk : it->second;
+  }
+
+#ifdef OMIM_OS_WINDOWS
+  FileReader m_file;
+  vector<uint8_t> m_buffer;
+#else
+  MmapReader m_file;
+#endif
+  string m_name;
+  uint8_t const * m_data = nullptr;
+  vector<uint64_t> m_directory;
+  unordered_map<uint64_t, uint64_t> m_farDirectory;
+};
+
+template <class TValue>
+uint64_t constexpr SparseArrayReader<TValue>::kNoChunk;
+
+/// Drop-in replacement of IndexFile with unique keys for SparseArray files.
+template <EMode TMode>
+class SparseIndexFile
+{
+  using TArray = typename conditional<TMode == EMode::Write, SparseArrayWriter<uint64_t>,
+                                      SparseArrayReader<uint64_t>>::type;
+  TArray m_array;
+
+public:
+  explicit SparseIndexFile(string const & name) : m_array(name) {}
+
+  string GetFileName() const { return m_array.GetFileName(); }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type Add(uint64_t key, uint64_t value)
+  {
+    m_array.Set(key, value);
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type WriteAll()
+  {
+    m_array.Finish();
+  }
+
+  // There is nothing to load, the file is mapped into memory.
+  void ReadAll() {}
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, bool>::type GetValueByKey(uint64_t key,
+                                                                 uint64_t & value) const
+  {
+    return m_array.Get(key, value);
+  }
+};
 } // namespace detail
 
 template <EMode TMode>
+using TDefaultOffsets = detail::IndexFile<
+    typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type, uint64_t>;
+
+template <EMode TMode, class TOffsets = TDefaultOffsets<TMode>>
 class OSMElementCache
 {
 public:
   using TKey = uint64_t;
   using TStorage = typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type;
-  using TOffsetFile = typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type;
 
 protected:
   using TBuffer = vector<uint8_t>;
   TStorage m_storage;
-  detail::IndexFile<TOffsetFile, uint64_t> m_offsets;
+  TOffsets m_offsets;
   string m_name;
   TBuffer m_data;
   bool m_preload = false;
@@ -425,4 +722,51 @@ public:
   }
 };
 
+/// Stores nodes in SparseArray file, so memory and disk usage depend only on the number of nodes
+/// and there is no loading step. Nodes must be added in ascending order of ids.
+template <EMode TMode>
+class SparsePointStorage : public PointStorage
+{
+  using TArray = typename conditional<TMode == EMode::Write, detail::SparseArrayWriter<LatLon>,
+                                      detail::SparseArrayReader<LatLon>>::type;
+  TArray m_array;
+
+  constexpr static double const kValueOrder = 1E+7;
+
+public:
+  explicit SparsePointStorage(string const & name) : m_array(name + ".sparse") {}
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLon ll;
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+
+    m_array.Set(id, ll);
+
+    IncProcessedPoint();
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, bool>::type GetPoint(uint64_t id, double & lat,
+                                                            double & lng) const
+  {
+    LatLon ll;
+    if (!m_array.Get(id, ll))
+    {
+      LOG(LERROR, ("Node with id = ", id, " not found!"));
+      return false;
+    }
+    lat = static_cast<double>(ll.lat) / kValueOrder;
+    lng = static_cast<double>(ll.lon) / kValueOrder;
+    return true;
+  }
+};
+
 }  // namespace cache
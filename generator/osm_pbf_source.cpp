@@ -0,0 +1,544 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/fork_join_pool.hpp"
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstring.hpp"
+#include "std/functional.hpp"
+#include "std/thread.hpp"
+#include "std/utility.hpp"
+
+#include <zlib.h>
+
+namespace
+{
+// Limits from the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Blobs per decoding task of every worker.
+size_t constexpr kBlobsPerWorker = 2;
+
+char const kHeaderBlobType[] = "OSMHeader";
+char const kDataBlobType[] = "OSMData";
+
+// Decoder of the protocol buffers wire format, see
+// https://developers.google.com/protocol-buffers/docs/encoding
+class ProtoReader
+{
+public:
+  enum WireType
+  {
+    Varint = 0,
+    Fixed64 = 1,
+    Length = 2,
+    Fixed32 = 5
+  };
+
+  ProtoReader(uint8_t const * begin, uint8_t const * end) : m_pos(begin), m_end(end) {}
+
+  // Reads the key of the next field. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_pos == m_end)
+      return false;
+    uint64_t const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint32_t>(key & 0x7);
+    return true;
+  }
+
+  inline uint32_t Field() const { return m_field; }
+
+  uint64_t GetVarint()
+  {
+    CHECK_EQUAL(m_wireType, Varint, ("Unexpected wire type of field", m_field));
+    return ReadVarint();
+  }
+
+  int64_t GetSVarint() { return bits::ZigZagDecode(GetVarint()); }
+
+  ProtoReader GetMessage()
+  {
+    CHECK_EQUAL(m_wireType, Length, ("Unexpected wire type of field", m_field));
+    size_t const size = static_cast<size_t>(ReadVarint());
+    CHECK_LESS_OR_EQUAL(size, static_cast<size_t>(m_end - m_pos), ("Truncated field", m_field));
+    ProtoReader message(m_pos, m_pos + size);
+    m_pos += size;
+    return message;
+  }
+
+  pair<uint8_t const *, size_t> GetBytes()
+  {
+    ProtoReader const data = GetMessage();
+    return make_pair(data.m_pos, static_cast<size_t>(data.m_end - data.m_pos));
+  }
+
+  string GetString()
+  {
+    auto const bytes = GetBytes();
+    return string(reinterpret_cast<char const *>(bytes.first), bytes.second);
+  }
+
+  // Reads a repeated varint field, packed or not.
+  template <typename TFn>
+  void ForEachVarint(TFn && fn)
+  {
+    if (m_wireType == Varint)
+    {
+      fn(ReadVarint());
+      return;
+    }
+
+    ProtoReader packed = GetMessage();
+    while (packed.m_pos != packed.m_end)
+      fn(packed.ReadVarint());
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+      case Varint: ReadVarint(); break;
+      case Fixed64: Advance(8); break;
+      case Length: GetMessage(); break;
+      case Fixed32: Advance(4); break;
+      default: CHECK(false, ("Unsupported wire type", m_wireType, "of field", m_field));
+    }
+  }
+
+private:
+  uint64_t ReadVarint()
+  {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      CHECK(m_pos != m_end, ("Truncated varint"));
+      uint8_t const byte = *m_pos++;
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return result;
+    }
+    CHECK(false, ("Too long varint"));
+    return result;
+  }
+
+  void Advance(size_t size)
+  {
+    CHECK_LESS_OR_EQUAL(size, static_cast<size_t>(m_end - m_pos), ("Truncated field", m_field));
+    m_pos += size;
+  }
+
+  uint8_t const * m_pos;
+  uint8_t const * m_end;
+  uint32_t m_field = 0;
+  uint32_t m_wireType = Varint;
+};
+
+class PrimitiveBlockDecoder
+{
+public:
+  explicit PrimitiveBlockDecoder(vector<OsmElement> & elements) : m_elements(elements) {}
+
+  void Decode(ProtoReader block)
+  {
+    // The string table and coordinate parameters are needed to decode groups.
+    vector<ProtoReader> groups;
+    while (block.Next())
+    {
+      switch (block.Field())
+      {
+        case 1: ReadStringTable(block.GetMessage()); break;
+        case 2: groups.push_back(block.GetMessage()); break;
+        case 17: m_granularity = static_cast<int64_t>(block.GetVarint()); break;
+        case 19: m_latOffset = static_cast<int64_t>(block.GetVarint()); break;
+        case 20: m_lonOffset = static_cast<int64_t>(block.GetVarint()); break;
+        default: block.Skip(); break;
+      }
+    }
+
+    for (auto & group : groups)
+    {
+      while (group.Next())
+      {
+        switch (group.Field())
+        {
+          case 1: DecodeNode(group.GetMessage()); break;
+          case 2: DecodeDenseNodes(group.GetMessage()); break;
+          case 3: DecodeWay(group.GetMessage()); break;
+          case 4: DecodeRelation(group.GetMessage()); break;
+          default: group.Skip(); break;
+        }
+      }
+    }
+  }
+
+private:
+  void ReadStringTable(ProtoReader table)
+  {
+    while (table.Next())
+    {
+      if (table.Field() == 1)
+        m_strings.push_back(table.GetString());
+      else
+        table.Skip();
+    }
+  }
+
+  string const & GetString(uint64_t index) const
+  {
+    CHECK_LESS(index, m_strings.size(), ("Invalid string index"));
+    return m_strings[index];
+  }
+
+  double GetLat(int64_t lat) const { return 1e-9 * (m_latOffset + m_granularity * lat); }
+  double GetLon(int64_t lon) const { return 1e-9 * (m_lonOffset + m_granularity * lon); }
+
+  OsmElement & AddElement(OsmElement::EntityType type, int64_t id)
+  {
+    m_elements.emplace_back();
+    OsmElement & e = m_elements.back();
+    e.type = type;
+    e.id = static_cast<uint64_t>(id);
+    return e;
+  }
+
+  void AddTags(vector<uint32_t> const & keys, vector<uint32_t> const & values, OsmElement & e)
+  {
+    CHECK_EQUAL(keys.size(), values.size(), ("Different number of keys and values, id:", e.id));
+    for (size_t i = 0; i < keys.size(); ++i)
+      e.AddTag(GetString(keys[i]), GetString(values[i]));
+  }
+
+  void DecodeNode(ProtoReader node)
+  {
+    int64_t id = 0, lat = 0, lon = 0;
+    vector<uint32_t> keys, values;
+    while (node.Next())
+    {
+      switch (node.Field())
+      {
+        case 1: id = node.GetSVarint(); break;
+        case 2: ReadIndexes(node, keys); break;
+        case 3: ReadIndexes(node, values); break;
+        case 8: lat = node.GetSVarint(); break;
+        case 9: lon = node.GetSVarint(); break;
+        default: node.Skip(); break;
+      }
+    }
+
+    OsmElement & e = AddElement(OsmElement::EntityType::Node, id);
+    e.lat = GetLat(lat);
+    e.lon = GetLon(lon);
+    AddTags(keys, values, e);
+  }
+
+  void DecodeDenseNodes(ProtoReader dense)
+  {
+    vector<int64_t> ids, lats, lons;
+    vector<uint32_t> keysValues;
+    while (dense.Next())
+    {
+      switch (dense.Field())
+      {
+        case 1: ReadDeltas(dense, ids); break;
+        case 8: ReadDeltas(dense, lats); break;
+        case 9: ReadDeltas(dense, lons); break;
+        case 10: ReadIndexes(dense, keysValues); break;
+        default: dense.Skip(); break;
+      }
+    }
+    CHECK(ids.size() == lats.size() && ids.size() == lons.size(), ("Invalid dense nodes"));
+
+    // Tags of all the nodes are stored as key, value, ..., 0, key, value, ..., 0.
+    size_t tag = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      OsmElement & e = AddElement(OsmElement::EntityType::Node, ids[i]);
+      e.lat = GetLat(lats[i]);
+      e.lon = GetLon(lons[i]);
+      while (tag < keysValues.size() && keysValues[tag] != 0)
+      {
+        CHECK_LESS(tag + 1, keysValues.size(), ("Invalid dense nodes tags"));
+        e.AddTag(GetString(keysValues[tag]), GetString(keysValues[tag + 1]));
+        tag += 2;
+      }
+      ++tag;
+    }
+  }
+
+  void DecodeWay(ProtoReader way)
+  {
+    int64_t id = 0;
+    vector<uint32_t> keys, values;
+    vector<int64_t> refs;
+    while (way.Next())
+    {
+      switch (way.Field())
+      {
+        case 1: id = static_cast<int64_t>(way.GetVarint()); break;
+        case 2: ReadIndexes(way, keys); break;
+        case 3: ReadIndexes(way, values); break;
+        case 8: ReadDeltas(way, refs); break;
+        default: way.Skip(); break;
+      }
+    }
+
+    OsmElement & e = AddElement(OsmElement::EntityType::Way, id);
+    for (int64_t ref : refs)
+      e.AddNd(static_cast<uint64_t>(ref));
+    AddTags(keys, values, e);
+  }
+
+  void DecodeRelation(ProtoReader relation)
+  {
+    int64_t id = 0;
+    vector<uint32_t> keys, values, roles, types;
+    vector<int64_t> refs;
+    while (relation.Next())
+    {
+      switch (relation.Field())
+      {
+        case 1: id = static_cast<int64_t>(relation.GetVarint()); break;
+        case 2: ReadIndexes(relation, keys); break;
+        case 3: ReadIndexes(relation, values); break;
+        case 8: ReadIndexes(relation, roles); break;
+        case 9: ReadDeltas(relation, refs); break;
+        case 10: ReadIndexes(relation, types); break;
+        default: relation.Skip(); break;
+      }
+    }
+    CHECK(refs.size() == roles.size() && refs.size() == types.size(),
+          ("Invalid members of relation", id));
+
+    OsmElement & e = AddElement(OsmElement::EntityType::Relation, id);
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      OsmElement::EntityType type = OsmElement::EntityType::Unknown;
+      switch (types[i])
+      {
+        case 0: type = OsmElement::EntityType::Node; break;
+        case 1: type = OsmElement::EntityType::Way; break;
+        case 2: type = OsmElement::EntityType::Relation; break;
+        default: CHECK(false, ("Unknown member type", types[i], "of relation", id));
+      }
+      e.AddMember(static_cast<uint64_t>(refs[i]), type, GetString(roles[i]));
+    }
+    AddTags(keys, values, e);
+  }
+
+  static void ReadIndexes(ProtoReader & reader, vector<uint32_t> & indexes)
+  {
+    reader.ForEachVarint([&indexes](uint64_t v) { indexes.push_back(static_cast<uint32_t>(v)); });
+  }
+
+  // Reads delta coded sint64 values.
+  static void ReadDeltas(ProtoReader & reader, vector<int64_t> & values)
+  {
+    int64_t value = values.empty() ? 0 : values.back();
+    reader.ForEachVarint([&value, &values](uint64_t v)
+    {
+      value += bits::ZigZagDecode(v);
+      values.push_back(value);
+    });
+  }
+
+  vector<OsmElement> & m_elements;
+  vector<string> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+
+void CheckHeaderBlock(ProtoReader header)
+{
+  while (header.Next())
+  {
+    // Required features.
+    if (header.Field() == 4)
+    {
+      string const feature = header.GetString();
+      CHECK(feature == "OsmSchema-V0.6" || feature == "DenseNodes",
+            ("Unsupported PBF feature:", feature));
+    }
+    else
+    {
+      header.Skip();
+    }
+  }
+}
+
+// Returns uncompressed data of the Blob message.
+vector<uint8_t> UnpackBlob(vector<uint8_t> const & blob)
+{
+  ProtoReader reader(blob.data(), blob.data() + blob.size());
+  pair<uint8_t const *, size_t> raw(nullptr, 0), zlibData(nullptr, 0);
+  uint64_t rawSize = 0;
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+      case 1: raw = reader.GetBytes(); break;
+      case 2: rawSize = reader.GetVarint(); break;
+      case 3: zlibData = reader.GetBytes(); break;
+      case 4: CHECK(false, ("LZMA compressed blobs are not supported")); break;
+      default: reader.Skip(); break;
+    }
+  }
+
+  if (raw.first != nullptr)
+    return vector<uint8_t>(raw.first, raw.first + raw.second);
+
+  CHECK(zlibData.first != nullptr, ("Blob without data"));
+  CHECK_LESS_OR_EQUAL(rawSize, kMaxBlobSize, ());
+  vector<uint8_t> data(rawSize);
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  stream.next_in = const_cast<Bytef *>(zlibData.first);
+  stream.avail_in = static_cast<uInt>(zlibData.second);
+  stream.next_out = data.data();
+  stream.avail_out = static_cast<uInt>(data.size());
+  CHECK_EQUAL(inflateInit(&stream), Z_OK, ());
+  int const res = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+  CHECK_EQUAL(res, Z_STREAM_END, ("Can't inflate blob"));
+  CHECK_EQUAL(stream.total_out, rawSize, ("Invalid size of inflated blob"));
+  return data;
+}
+
+void DecodeBlob(string const & type, vector<uint8_t> const & blob, vector<OsmElement> & elements)
+{
+  if (type == kHeaderBlobType)
+  {
+    vector<uint8_t> const data = UnpackBlob(blob);
+    CheckHeaderBlock(ProtoReader(data.data(), data.data() + data.size()));
+  }
+  else if (type == kDataBlobType)
+  {
+    vector<uint8_t> const data = UnpackBlob(blob);
+    PrimitiveBlockDecoder(elements).Decode(ProtoReader(data.data(), data.data() + data.size()));
+  }
+  // Blobs of unknown types are skipped according to the specification.
+}
+}  // namespace
+
+namespace osm
+{
+PbfSource::PbfSource(TReader const & reader, size_t threadsCount)
+  : m_reader(reader), m_threadsCount(threadsCount)
+{
+}
+
+void PbfSource::ForEach(TProcessor const & processor)
+{
+  threads::ForkJoinPool pool(m_threadsCount);
+  size_t const batchSize = max(m_threadsCount, size_t(1)) * kBlobsPerWorker;
+
+  auto const readBatch = [this, batchSize](vector<Blob> & batch)
+  {
+    batch.clear();
+    Blob blob;
+    while (batch.size() < batchSize && ReadBlob(blob))
+      batch.push_back(move(blob));
+  };
+
+  auto const decodeBatch = [&pool](vector<Blob> const & batch,
+                                   vector<vector<OsmElement>> & elements)
+  {
+    elements.assign(batch.size(), vector<OsmElement>());
+    pool.ForEach(batch.size(), [&batch, &elements](size_t i)
+    {
+      DecodeBlob(batch[i].m_type, batch[i].m_data, elements[i]);
+    });
+  };
+
+  vector<Blob> batch;
+  vector<vector<OsmElement>> elements;
+  readBatch(batch);
+  decodeBatch(batch, elements);
+
+  vector<Blob> nextBatch;
+  vector<vector<OsmElement>> nextElements;
+  while (!batch.empty())
+  {
+    // Decoding of the next batch overlaps with processing of the current one.
+    readBatch(nextBatch);
+    thread decoder;
+    if (m_threadsCount != 0 && !nextBatch.empty())
+      decoder = thread(decodeBatch, cref(nextBatch), ref(nextElements));
+    MY_SCOPE_GUARD(decoderJoiner, [&decoder]()
+    {
+      if (decoder.joinable())
+        decoder.join();
+    });
+
+    for (auto & blockElements : elements)
+    {
+      for (auto & e : blockElements)
+        processor(&e);
+    }
+
+    if (decoder.joinable())
+      decoder.join();
+    else
+      decodeBatch(nextBatch, nextElements);
+
+    batch.swap(nextBatch);
+    elements.swap(nextElements);
+  }
+}
+
+bool PbfSource::ReadBlob(Blob & blob)
+{
+  uint8_t sizeBuffer[4];
+  if (!ReadExactly(sizeBuffer, sizeof(sizeBuffer)))
+    return false;
+
+  // Network byte order.
+  uint32_t const headerSize = (uint32_t(sizeBuffer[0]) << 24) | (uint32_t(sizeBuffer[1]) << 16) |
+                              (uint32_t(sizeBuffer[2]) << 8) | uint32_t(sizeBuffer[3]);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("Invalid blob header size"));
+
+  vector<uint8_t> header(headerSize);
+  CHECK(ReadExactly(header.data(), header.size()), ("Unexpected end of PBF stream"));
+
+  blob.m_type.clear();
+  uint64_t dataSize = 0;
+  ProtoReader reader(header.data(), header.data() + header.size());
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+      case 1: blob.m_type = reader.GetString(); break;
+      case 3: dataSize = reader.GetVarint(); break;
+      default: reader.Skip(); break;
+    }
+  }
+  CHECK_LESS_OR_EQUAL(dataSize, kMaxBlobSize, ("Invalid blob size"));
+
+  blob.m_data.resize(dataSize);
+  CHECK(ReadExactly(blob.m_data.data(), blob.m_data.size()), ("Unexpected end of PBF stream"));
+  return true;
+}
+
+bool PbfSource::ReadExactly(uint8_t * buffer, size_t size)
+{
+  size_t done = 0;
+  while (done < size)
+  {
+    size_t const read = m_reader(buffer + done, size - done);
+    if (read == 0)
+    {
+      CHECK_EQUAL(done, 0, ("Unexpected end of PBF stream"));
+      return false;
+    }
+    done += read;
+  }
+  return true;
+}
+}  // namespace osm
@@ -0,0 +1,43 @@
+// See PBF Format definition at http://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace osm
+{
+/// Streaming reader of OSM PBF files. Blobs are read from the stream on the caller's thread,
+/// decompressed and decoded on a pool of workers in batches. The next batch is decoded while
+/// elements of the current one are processed. Elements are passed to the processor on the
+/// caller's thread in the same order as they are stored in the file.
+class PbfSource
+{
+public:
+  using TReader = function<size_t(uint8_t *, size_t)>;
+  using TProcessor = function<void(OsmElement *)>;
+
+  /// \param threadsCount Number of decoding workers, blobs are decoded on the caller's thread
+  /// when it's zero.
+  PbfSource(TReader const & reader, size_t threadsCount);
+
+  void ForEach(TProcessor const & processor);
+
+private:
+  struct Blob
+  {
+    string m_type;
+    vector<uint8_t> m_data;
+  };
+
+  // Returns false at the end of the stream.
+  bool ReadBlob(Blob & blob);
+  bool ReadExactly(uint8_t * buffer, size_t size);
+
+  TReader m_reader;
+  size_t const m_threadsCount;
+};
+}  // namespace osm
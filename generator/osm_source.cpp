@@ -4,6 +4,7 @@
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_translator.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/polygonizer.hpp"
@@ -47,10 +48,24 @@ uint64_t SourceReader::Read(char * buffer, uint64_t bufferSize)
 
 namespace
 {
+// Offsets of ways and relations are stored the same way as nodes are.
+template <class TNodesHolder, cache::EMode TMode>
+struct ElementOffsets
+{
+  using Type = cache::TDefaultOffsets<TMode>;
+};
+
+template <cache::EMode TNodesMode, cache::EMode TMode>
+struct ElementOffsets<cache::SparsePointStorage<TNodesMode>, TMode>
+{
+  using Type = cache::detail::SparseIndexFile<TMode>;
+};
+
 template <class TNodesHolder, cache::EMode TMode>
 class IntermediateData
 {
-  using TReader = cache::OSMElementCache<TMode>;
+  using TReader =
+      cache::OSMElementCache<TMode, typename ElementOffsets<TNodesHolder, TMode>::Type>;
 
   using TFile = typename conditional<TMode == cache::EMode::Write, FileWriter, FileReader>::type;
 
@@ -281,6 +296,10 @@ public:
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish()
   {
+    // Collect features which are still processed by the polygonizer threads.
+    if (m_countries)
+      m_countries->Parent().Finish();
+
     if (m_world)
       m_world->DoMerge();
 
@@ -476,6 +495,28 @@ void BuildFeaturesFromO5M(SourceReader & stream, function<void(OsmElement *)> pr
   }
 }
 
+template <typename TCache>
+void BuildIntermediateDataFromPBF(SourceReader & stream, TCache & cache, size_t threadsCount)
+{
+  osm::PbfSource dataset([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  }, threadsCount);
+
+  dataset.ForEach([&cache](OsmElement * e) { AddElementToCache(cache, *e); });
+}
+
+void BuildFeaturesFromPBF(SourceReader & stream, function<void(OsmElement *)> processor,
+                          size_t threadsCount)
+{
+  osm::PbfSource dataset([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  }, threadsCount);
+
+  dataset.ForEach(processor);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -507,6 +548,9 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info)
       case feature::GenerateInfo::OsmSourceType::O5M:
         BuildFeaturesFromO5M(reader, fn);
         break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildFeaturesFromPBF(reader, fn, info.m_threadsCount);
+        break;
     }
 
     LOG(LINFO, ("Processing", info.m_osmFileName, "done."));
@@ -548,6 +592,9 @@ bool GenerateIntermediateDataImpl(feature::GenerateInfo & info)
       case feature::GenerateInfo::OsmSourceType::O5M:
         BuildIntermediateDataFromO5M(reader, cache);
         break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildIntermediateDataFromPBF(reader, cache, info.m_threadsCount);
+        break;
     }
 
     cache.SaveIndex();
@@ -570,6 +617,8 @@ bool GenerateFeatures(feature::GenerateInfo & info)
       return GenerateFeaturesImpl<cache::MapFilePointStorage<cache::EMode::Read>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateFeaturesImpl<cache::RawMemPointStorage<cache::EMode::Read>>(info);
+    case feature::GenerateInfo::NodeStorageType::Sparse:
+      return GenerateFeaturesImpl<cache::SparsePointStorage<cache::EMode::Read>>(info);
   }
   return false;
 }
@@ -584,6 +633,8 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
       return GenerateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Write>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateIntermediateDataImpl<cache::RawMemPointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::Sparse:
+      return GenerateIntermediateDataImpl<cache::SparsePointStorage<cache::EMode::Write>>(info);
   }
   return false;
 }
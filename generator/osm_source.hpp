@@ -36,5 +36,7 @@ bool GenerateFeatures(feature::GenerateInfo & info);
 bool GenerateIntermediateData(feature::GenerateInfo & info);
 
 void BuildFeaturesFromO5M(SourceReader & stream, function<void(OsmElement *)> processor);
+void BuildFeaturesFromPBF(SourceReader & stream, function<void(OsmElement *)> processor,
+                          size_t threadsCount);
 void BuildFeaturesFromXML(SourceReader & stream, function<void(OsmElement *)> processor);
 
@@ -14,20 +14,15 @@
 #include "base/base.hpp"
 #include "base/buffer_vector.hpp"
 #include "base/macros.hpp"
+#include "base/thread.hpp"
+#include "base/thread_pool.hpp"
 
+#include "std/bind.hpp"
+#include "std/condition_variable.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
-
-
-#ifndef PARALLEL_POLYGONIZER
-#define PARALLEL_POLYGONIZER 1
-#endif
-
-#if PARALLEL_POLYGONIZER
-#include <QtCore/QSemaphore>
-#include <QtCore/QThreadPool>
-#include <QtCore/QMutex>
-#include <QtCore/QMutexLocker>
-#endif
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 
 namespace feature
@@ -36,27 +31,33 @@ namespace feature
   template <class FeatureOutT>
   class Polygonizer
   {
+    class PolygonizerTask;
+
     feature::GenerateInfo const & m_info;
 
     vector<FeatureOutT*> m_Buckets;
     vector<string> m_Names;
     borders::CountriesContainerT m_countries;
 
-#if PARALLEL_POLYGONIZER
-    QThreadPool m_ThreadPool;
-    QSemaphore m_ThreadPoolSemaphore;
-    QMutex m_EmitFeatureMutex;
-#endif
+    // Multi-country features are checked on the pool, but buckets are written only
+    // on the caller's thread, when finished tasks are collected.
+    unique_ptr<threads::ThreadPool> m_threadPool;
+    size_t m_maxTasksInFlight = 0;
+    mutex m_tasksMutex;
+    condition_variable m_tasksCondition;
+    size_t m_tasksInFlight = 0;
+    vector<PolygonizerTask *> m_finishedTasks;
 
   public:
     explicit Polygonizer(feature::GenerateInfo const & info) : m_info(info)
-#if PARALLEL_POLYGONIZER
-    , m_ThreadPoolSemaphore(m_ThreadPool.maxThreadCount() * 8)
-#endif
     {
-#if PARALLEL_POLYGONIZER
-      LOG(LINFO, ("Polygonizer thread pool threads:", m_ThreadPool.maxThreadCount()));
-#endif
+      if (info.m_threadsCount != 0)
+      {
+        m_threadPool.reset(new threads::ThreadPool(
+            info.m_threadsCount, bind(&Polygonizer::OnTaskFinished, this, _1)));
+        m_maxTasksInFlight = info.m_threadsCount * 8;
+        LOG(LINFO, ("Polygonizer thread pool threads:", info.m_threadsCount));
+      }
 
       if (info.m_splitByPolygons)
       {
@@ -73,6 +74,7 @@ namespace feature
     ~Polygonizer()
     {
       Finish();
+      m_threadPool.reset();
       for_each(m_Buckets.begin(), m_Buckets.end(), DeleteFunctor());
     }
 
@@ -124,13 +126,21 @@ namespace feature
         break;
       default:
         {
-#if PARALLEL_POLYGONIZER
-          m_ThreadPoolSemaphore.acquire();
-          m_ThreadPool.start(new PolygonizerTask(this, vec, fb));
-#else
-          PolygonizerTask task(this, vec, fb);
-          task.RunBase();
-#endif
+          if (m_threadPool)
+          {
+            EmitFinishedTasks(m_maxTasksInFlight - 1);
+            {
+              lock_guard<mutex> lock(m_tasksMutex);
+              ++m_tasksInFlight;
+            }
+            m_threadPool->PushBack(new PolygonizerTask(vec, fb));
+          }
+          else
+          {
+            PolygonizerTask task(vec, fb);
+            task.Do();
+            task.Emit(*this);
+          }
         }
       }
     }
@@ -144,17 +154,12 @@ namespace feature
 
     void Finish()
     {
-#if PARALLEL_POLYGONIZER
-      m_ThreadPool.waitForDone();
-#endif
+      if (m_threadPool)
+        EmitFinishedTasks(0);
     }
 
     void EmitFeature(borders::CountryPolygons const * country, FeatureBuilder1 const & fb)
     {
-#if PARALLEL_POLYGONIZER
-      QMutexLocker mutexLocker(&m_EmitFeatureMutex);
-      UNUSED_VALUE(mutexLocker);
-#endif
       if (country->m_index == -1)
       {
         m_Names.push_back(country->m_name);
@@ -175,20 +180,46 @@ namespace feature
     }
 
   private:
-    friend class PolygonizerTask;
+    /// Waits until at most maxTasksInFlight tasks are running and writes results of the finished ones.
+    void EmitFinishedTasks(size_t maxTasksInFlight)
+    {
+      vector<PolygonizerTask *> tasks;
+      {
+        unique_lock<mutex> lock(m_tasksMutex);
+        m_tasksCondition.wait(lock, [&]()
+        {
+          return m_tasksInFlight <= maxTasksInFlight;
+        });
+        tasks.swap(m_finishedTasks);
+      }
 
-    class PolygonizerTask
-#if PARALLEL_POLYGONIZER
-      : public QRunnable
-#endif
+      for (PolygonizerTask * task : tasks)
+      {
+        task->Emit(*this);
+        delete task;
+      }
+    }
+
+    // Called on the pool threads.
+    void OnTaskFinished(threads::IRoutine * routine)
+    {
+      {
+        lock_guard<mutex> lock(m_tasksMutex);
+        m_finishedTasks.push_back(static_cast<PolygonizerTask *>(routine));
+        --m_tasksInFlight;
+      }
+      m_tasksCondition.notify_all();
+    }
+
+    class PolygonizerTask : public threads::IRoutine
     {
     public:
-      PolygonizerTask(Polygonizer * pPolygonizer,
-                      buffer_vector<borders::CountryPolygons const *, 32> const & countries,
+      PolygonizerTask(buffer_vector<borders::CountryPolygons const *, 32> const & countries,
                       FeatureBuilder1 const & fb)
-        : m_pPolygonizer(pPolygonizer), m_Countries(countries), m_FB(fb) {}
+        : m_Countries(countries), m_FB(fb) {}
 
-      void RunBase()
+      // Does only point-in-polygon checks, so it's safe to run it concurrently.
+      void Do() override
       {
         for (size_t i = 0; i < m_Countries.size(); ++i)
         {
@@ -196,22 +227,19 @@ namespace feature
           m_FB.ForEachGeometryPoint(doCheck);
 
           if (doCheck.m_belongs)
-            m_pPolygonizer->EmitFeature(m_Countries[i], m_FB);
+            m_Belongs.push_back(m_Countries[i]);
         }
       }
 
-#if PARALLEL_POLYGONIZER
-      void run()
+      void Emit(Polygonizer & polygonizer) const
       {
-        RunBase();
-
-        m_pPolygonizer->m_ThreadPoolSemaphore.release();
+        for (auto const * country : m_Belongs)
+          polygonizer.EmitFeature(country, m_FB);
       }
-#endif
 
     private:
-      Polygonizer * m_pPolygonizer;
       buffer_vector<borders::CountryPolygons const *, 32> m_Countries;
+      buffer_vector<borders::CountryPolygons const *, 32> m_Belongs;
       FeatureBuilder1 m_FB;
     };
   };
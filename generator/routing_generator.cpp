@@ -8,6 +8,10 @@
 #include "routing/osrm_data_facade.hpp"
 #include "routing/osrm_engine.hpp"
 #include "routing/cross_routing_context.hpp"
+#include "routing/features_road_graph.hpp"
+#include "routing/pedestrian_model.hpp"
+#include "routing/road_graph_landmarks.hpp"
+#include "routing/routing_algorithm.hpp"
 
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
@@ -191,7 +195,7 @@ void CalculateCrossAdjacency(string const & mwmRoutingPath, routing::CrossRoutin
 {
   OsrmDataFacade<QueryEdge::EdgeData> facade;
   FilesMappingContainer routingCont(mwmRoutingPath);
-  facade.Load(routingCont);
+  facade.Load(routingCont, string() /* dataId */);
   LOG(LINFO, ("Calculating weight map between outgoing nodes"));
   crossContext.ReserveAdjacencyMatrix();
   auto const & in = crossContext.GetIngoingIterators();
@@ -478,4 +482,66 @@ void BuildRoutingIndex(string const & baseDir, string const & countryName, strin
   VERIFY(my::GetFileSize(fPath, sz), ());
   LOG(LINFO, ("Nodes stored:", stored, "Routing index file size:", sz));
 }
+void BuildPedestrianLandmarks(string const & baseDir, string const & countryName,
+                              size_t landmarksCount)
+{
+  LOG(LINFO, ("Pedestrian landmarks section builder"));
+  classificator::Load();
+
+  CountryFile countryFile(countryName);
+  LocalCountryFile localFile(baseDir, countryFile, 0 /* version */);
+  localFile.SyncWithDisk();
+
+  TRoadGraphLandmarks landmarks;
+  vector<RoadPointId> ids;
+  {
+    // Index must release the mwm before the section is written.
+    Index index;
+    auto p = index.Register(localFile);
+    if (p.second != MwmSet::RegResult::Success)
+    {
+      LOG(LCRITICAL, ("MWM file not found"));
+      return;
+    }
+
+    FeaturesRoadGraph graph(index, make_unique<PedestrianModelFactory>());
+    shared_ptr<IVehicleModel> const model = PedestrianModelFactory().GetVehicleModel();
+
+    // The longest road is most likely a part of the main road network, so
+    // landmarks are built for the part of the graph connected with it.
+    size_t maxPointsCount = 0;
+    m2::PointD seed;
+    auto const findSeed = [&](FeatureType & ft)
+    {
+      if (ft.GetFeatureType() != feature::GEOM_LINE || model->GetSpeed(ft) <= 0.0)
+        return;
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      if (ft.GetPointsCount() > maxPointsCount)
+      {
+        maxPointsCount = ft.GetPointsCount();
+        seed = ft.GetPoint(0);
+      }
+    };
+    index.ForEachInScale(findSeed, FeaturesRoadGraph::GetStreetReadScale());
+
+    if (maxPointsCount == 0)
+    {
+      LOG(LWARNING, ("There are no pedestrian roads in", countryName));
+      return;
+    }
+
+    BuildRoadGraphLandmarks(graph, Junction(seed), landmarksCount, landmarks);
+    if (!GetRoadPointIds(graph, landmarks.GetVertices(), ids))
+    {
+      LOG(LCRITICAL, ("Can't find road points of landmarks vertices in", countryName));
+      return;
+    }
+  }
+  LOG(LINFO, ("Landmarks:", landmarks.GetLandmarksCount(), "junctions:",
+              landmarks.GetVertices().size()));
+
+  FilesContainerW cont(localFile.GetPath(MapOptions::Map), FileWriter::OP_WRITE_EXISTING);
+  FileWriter w = cont.GetWriter(ROUTING_LANDMARKS_FILE_TAG);
+  SerializeRoadGraphLandmarks(landmarks, ids, w);
+}
 }
@@ -17,4 +17,19 @@ void BuildRoutingIndex(string const & baseDir, string const & countryName, strin
 /// perform if it's emplty.
 void BuildCrossRoutingIndex(string const & baseDir, string const & countryName,
                             string const & osrmFile);
+
+/// Builds landmarks for pedestrian routing (see AStarLandmarksRoutingAlgorithm)
+/// and writes them into ROUTING_LANDMARKS_FILE_TAG section of the .mwm file.
+/// @param[in]  baseDir      Full path to .mwm files directory.
+/// @param[in]  countryName   Country name same with .mwm and .border file name.
+/// @param[in]  landmarksCount  Number of landmarks K.
+///
+/// Section format (version 1, see SerializeRoadGraphLandmarks):
+/// [uint8 version] [vu unit of distances in ms] [vu K] [vu N, number of road junctions]
+/// [vu position of the landmark junction] * K
+/// [vu feature id delta, vu point id, vu distance from landmarks * K, vu distance to landmarks * K] * N
+/// Junctions are sorted by road point id and the feature id is a delta from the previous junction,
+/// so the section takes a few bytes per distance, 2 * K distances per road junction.
+void BuildPedestrianLandmarks(string const & baseDir, string const & countryName,
+                              size_t landmarksCount);
 }
@@ -2,6 +2,7 @@
 
 #include "indexer/drawing_rule_def.hpp"
 #include "indexer/drules_selector.hpp"
+#include "indexer/drules_table.hpp"
 
 #include "base/base.hpp"
 #include "base/buffer_vector.hpp"
@@ -61,6 +62,7 @@ namespace drule
     // Test feature by runtime feature style selector
     // Returns true if rule is applicable for feature, otherwise it returns false
     bool TestFeature(FeatureType const & ft, int zoom) const;
+    inline bool HasSelector() const { return m_selector != nullptr; }
 
     // Set runtime feature style selector
     void SetSelector(unique_ptr<ISelector> && selector);
@@ -79,6 +81,9 @@ namespace drule
     /// background color for scales in range [0...scales::UPPER_STYLE_SCALE]
     vector<uint32_t> m_bgColors;
 
+    /// rules compiled for classificator types, rebuilt on every style loading
+    RulesTable m_table;
+
   public:
     RulesHolder();
     ~RulesHolder();
@@ -94,6 +99,8 @@ namespace drule
 
     uint32_t GetBgColor(int scale) const;
 
+    RulesTable const & GetTable() const { return m_table; }
+
 #ifdef OMIM_OS_DESKTOP
     void LoadFromTextProto(string const & buffer);
     static void SaveToBinaryProto(string const & buffer, ostream & s);
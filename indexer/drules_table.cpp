@@ -0,0 +1,101 @@
+#include "indexer/drules_table.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
+
+#include "std/iterator.hpp"
+
+namespace drule
+{
+namespace
+{
+class TableBuilder
+{
+public:
+  TableBuilder(RulesHolder const & holder, unordered_map<uint32_t, uint32_t> & typeToRow,
+               vector<uint32_t> & offsets, vector<RulesTable::Rule> & rules)
+    : m_holder(holder), m_typeToRow(typeToRow), m_offsets(offsets), m_rules(rules)
+  {
+  }
+
+  void operator()(ClassifObject const * p, uint32_t type)
+  {
+    if (!p->IsDrawableAny())
+      return;
+
+    VERIFY(m_typeToRow.insert(make_pair(type, static_cast<uint32_t>(m_typeToRow.size()))).second,
+           (type));
+
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      for (int geomType = feature::GEOM_POINT; geomType <= feature::GEOM_AREA; ++geomType)
+      {
+        m_keys.clear();
+        p->GetSuitable(scale, feature::EGeomType(geomType), m_keys);
+        for (Key const & key : m_keys)
+        {
+          BaseRule const * rule = m_holder.Find(key);
+          ASSERT(rule != nullptr, ());
+          m_rules.push_back({key, rule, rule->HasSelector()});
+        }
+        m_offsets.push_back(static_cast<uint32_t>(m_rules.size()));
+      }
+    }
+  }
+
+private:
+  RulesHolder const & m_holder;
+  unordered_map<uint32_t, uint32_t> & m_typeToRow;
+  vector<uint32_t> & m_offsets;
+  vector<RulesTable::Rule> & m_rules;
+  KeysT m_keys;
+};
+
+struct LessRule
+{
+  bool operator()(RulesTable::Rule const & r1, RulesTable::Rule const & r2) const
+  {
+    return less_key()(r1.m_key, r2.m_key);
+  }
+};
+
+struct EqualRule
+{
+  bool operator()(RulesTable::Rule const & r1, RulesTable::Rule const & r2) const
+  {
+    return equal_key()(r1.m_key, r2.m_key);
+  }
+};
+}  // namespace
+
+// static
+size_t constexpr RulesTable::kScalesCount;
+// static
+size_t constexpr RulesTable::kGeomTypesCount;
+// static
+size_t constexpr RulesTable::kCellsPerType;
+
+void RulesTable::Build(Classificator const & c, RulesHolder const & holder)
+{
+  Clear();
+
+  m_offsets.push_back(0);
+  TableBuilder builder(holder, m_typeToRow, m_offsets, m_rules);
+  c.ForEachTree(builder);
+
+  ASSERT_EQUAL(m_offsets.size(), m_typeToRow.size() * kCellsPerType + 1, ());
+}
+
+void RulesTable::Clear()
+{
+  m_typeToRow.clear();
+  m_offsets.clear();
+  m_rules.clear();
+}
+
+void MakeUnique(RulesTable::TRules & rules)
+{
+  sort(rules.begin(), rules.end(), LessRule());
+  rules.resize(distance(rules.begin(), unique(rules.begin(), rules.end(), EqualRule())));
+}
+}  // namespace drule
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "indexer/drawing_rule_def.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/scales.hpp"
+
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/unordered_map.hpp"
+#include "std/vector.hpp"
+
+class Classificator;
+
+namespace drule
+{
+class BaseRule;
+class RulesHolder;
+
+/// Draw rules of the loaded style compiled to flat lists for every classificator type,
+/// scale and geometry type. Getting rules of a feature with the table doesn't walk
+/// the classificator tree and doesn't look up rules in RulesHolder.
+class RulesTable
+{
+public:
+  struct Rule
+  {
+    Key m_key;
+    BaseRule const * m_rule;
+    /// True if the rule has a runtime selector and is applicable only to some features.
+    bool m_hasSelector;
+  };
+
+  using TRules = buffer_vector<Rule, 16>;
+
+  /// Compiles draw rules of all classificator objects, rules are taken from the holder.
+  void Build(Classificator const & c, RulesHolder const & holder);
+  void Clear();
+
+  /// Calls toDo(Rule const &) for rules of the type at the scale for the geometry type,
+  /// in the same order as ClassifObject::GetSuitable() returns keys.
+  template <typename ToDo>
+  void ForEachRule(uint32_t type, int scale, feature::EGeomType geomType, ToDo && toDo) const
+  {
+    auto const it = m_typeToRow.find(type);
+    if (it == m_typeToRow.end())
+      return;
+
+    size_t const cell = GetCell(it->second, min(scale, scales::GetUpperStyleScale()), geomType);
+    for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+      toDo(m_rules[i]);
+  }
+
+  inline size_t GetTypesCount() const { return m_typeToRow.size(); }
+  inline size_t GetRulesCount() const { return m_rules.size(); }
+
+private:
+  static size_t constexpr kScalesCount = scales::UPPER_STYLE_SCALE + 1;
+  static size_t constexpr kGeomTypesCount = 3;
+  static size_t constexpr kCellsPerType = kScalesCount * kGeomTypesCount;
+
+  static inline size_t GetCell(uint32_t row, int scale, feature::EGeomType geomType)
+  {
+    ASSERT(scale >= 0 && scale < static_cast<int>(kScalesCount), (scale));
+    ASSERT(geomType >= 0 && geomType < static_cast<int>(kGeomTypesCount), (geomType));
+    return (row * kScalesCount + scale) * kGeomTypesCount + geomType;
+  }
+
+  /// Classificator type -> row of the type cells.
+  unordered_map<uint32_t, uint32_t> m_typeToRow;
+  /// Rules of the cell are in range [m_offsets[cell], m_offsets[cell + 1]) of m_rules.
+  vector<uint32_t> m_offsets;
+  vector<Rule> m_rules;
+};
+
+/// The same as MakeUnique(KeysT &) for rules from the table.
+void MakeUnique(RulesTable::TRules & rules);
+}  // namespace drule
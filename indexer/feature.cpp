@@ -100,6 +100,8 @@ void FeatureType::ParseHeader2() const
 
 void FeatureType::ResetGeometry() const
 {
+  ASSERT(m_pLoader, ("Can't reset geometry of the detached feature"));
+
   m_points.clear();
   m_triangles.clear();
 
@@ -113,6 +115,10 @@ void FeatureType::ResetGeometry() const
 
 uint32_t FeatureType::ParseGeometry(int scale) const
 {
+  // Detached feature can't read geometry of another scale and would silently return its own.
+  CHECK(m_pLoader || scale == m_parsedScale, ("Detached feature is parsed for", m_parsedScale,
+                                              "but requested for", scale));
+
   uint32_t sz = 0;
   if (!m_bPointsParsed)
   {
@@ -126,6 +132,10 @@ uint32_t FeatureType::ParseGeometry(int scale) const
 
 uint32_t FeatureType::ParseTriangles(int scale) const
 {
+  // Detached feature can't read geometry of another scale and would silently return its own.
+  CHECK(m_pLoader || scale == m_parsedScale, ("Detached feature is parsed for", m_parsedScale,
+                                              "but requested for", scale));
+
   uint32_t sz = 0;
   if (!m_bTrianglesParsed)
   {
@@ -149,6 +159,17 @@ void FeatureType::ParseMetadata() const
   m_bMetadataParsed = true;
 }
 
+void FeatureType::ParseEverything(int scale)
+{
+  ParseHeader2();
+  ParseAll(scale);
+  ParseMetadata();
+  // Fix the limit rect now, detached feature is shared as const and is not changed anymore.
+  UNUSED_VALUE(GetLimitRect(scale));
+
+  m_parsedScale = scale;
+  m_pLoader = nullptr;
+}
 
 namespace
 {
@@ -211,7 +232,8 @@ m2::RectD FeatureType::GetLimitRect(int scale) const
 {
   ParseAll(scale);
 
-  if (m_triangles.empty() && m_points.empty() && (GetFeatureType() != GEOM_POINT))
+  // Rect of the detached feature is already fixed by ParseEverything().
+  if (m_pLoader && m_triangles.empty() && m_points.empty() && (GetFeatureType() != GEOM_POINT))
   {
     // This function is called during indexing, when we need
     // to check visibility according to feature sizes.
@@ -246,6 +268,26 @@ FeatureType::geom_stat_t FeatureType::GetTrianglesSize(int scale) const
   return geom_stat_t(sz, m_triangles.size());
 }
 
+size_t FeatureType::GetMemoryUsage() const
+{
+  size_t res = sizeof(FeatureType);
+  if (m_points.size() > static_buffer)
+    res += m_points.size() * sizeof(m2::PointD);
+  if (m_triangles.size() > static_buffer)
+    res += m_triangles.size() * sizeof(m2::PointD);
+
+  auto addName = [&res](int8_t, string const & name)
+  {
+    res += name.size();
+    return true;
+  };
+  m_params.name.ForEachRef(addName);
+  res += m_params.ref.size();
+  for (auto const type : m_metadata.GetPresentTypes())
+    res += m_metadata.Get(type).size();
+  return res;
+}
+
 struct BestMatchedLangNames
 {
   string m_defaultName;
@@ -165,6 +165,12 @@ public:
   uint32_t ParseTriangles(int scale) const;
 
   void ParseMetadata() const;
+
+  /// Parses all feature's data (geometry for the @scale) and drops the pointer to the loader.
+  /// After this call the feature doesn't depend on the FeaturesVector it was read from,
+  /// can be stored (see FeaturesCache) and shared between threads as a const object.
+  /// Geometry for another scale is not available, requesting it is a CHECK failure.
+  void ParseEverything(int scale);
   //@}
 
   /// @name Geometry.
@@ -301,6 +307,9 @@ public:
 
   geom_stat_t GetGeometrySize(int scale) const;
   geom_stat_t GetTrianglesSize(int scale) const;
+
+  /// @return Approximate number of bytes occupied by the parsed feature.
+  size_t GetMemoryUsage() const;
   //@}
 
   void SwapGeometry(FeatureType & r);
@@ -324,6 +333,9 @@ private:
 
   mutable bool m_bHeader2Parsed, m_bPointsParsed, m_bTrianglesParsed, m_bMetadataParsed;
 
+  /// Scale which ParseEverything was called for.
+  int m_parsedScale;
+
   mutable inner_geom_stat_t m_innerStats;
 
   friend class feature::LoaderCurrent;
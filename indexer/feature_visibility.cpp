@@ -1,5 +1,6 @@
 #include "indexer/feature_visibility.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/scales.hpp"
 
@@ -60,47 +61,23 @@ string Classificator::GetFullObjectName(uint32_t type) const
 namespace feature
 {
 
-namespace
-{
-  class DrawRuleGetter
-  {
-    int m_scale;
-    EGeomType m_ft;
-    drule::KeysT & m_keys;
-
-  public:
-    DrawRuleGetter(int scale, EGeomType ft, drule::KeysT & keys)
-      : m_scale(scale), m_ft(ft), m_keys(keys)
-    {
-    }
-
-    typedef bool ResultType;
-
-    void operator() (ClassifObject const *)
-    {
-    }
-    bool operator() (ClassifObject const * p, bool & res)
-    {
-      res = true;
-      p->GetSuitable(min(m_scale, scales::GetUpperStyleScale()), m_ft, m_keys);
-      return false;
-    }
-  };
-}
-
 pair<int, bool> GetDrawRule(FeatureBase const & f, int level,
                             drule::KeysT & keys)
 {
   TypesHolder types(f);
 
   ASSERT ( keys.empty(), () );
-  Classificator const & c = classif();
+  drule::RulesTable const & table = drule::rules().GetTable();
 
-  DrawRuleGetter doRules(level, types.GetGeoType(), keys);
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+  {
+    table.ForEachRule(t, level, types.GetGeoType(), [&keys](drule::RulesTable::Rule const & r)
+    {
+      keys.push_back(r.m_key);
+    });
+  }
 
-  return make_pair(types.GetGeoType(), types.Has(c.GetCoastType()));
+  return make_pair(types.GetGeoType(), types.Has(classif().GetCoastType()));
 }
 
 void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
@@ -108,12 +85,34 @@ void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
 
 {
   ASSERT ( keys.empty(), () );
-  Classificator const & c = classif();
+  drule::RulesTable const & table = drule::rules().GetTable();
+
+  for (uint32_t t : types)
+  {
+    table.ForEachRule(t, level, EGeomType(geoType), [&keys](drule::RulesTable::Rule const & r)
+    {
+      keys.push_back(r.m_key);
+    });
+  }
+}
+
+pair<int, bool> GetDrawRules(FeatureBase const & f, int level,
+                             drule::RulesTable::TRules & rules)
+{
+  TypesHolder types(f);
 
-  DrawRuleGetter doRules(level, EGeomType(geoType), keys);
+  ASSERT ( rules.empty(), () );
+  drule::RulesTable const & table = drule::rules().GetTable();
 
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+  {
+    table.ForEachRule(t, level, types.GetGeoType(), [&rules](drule::RulesTable::Rule const & r)
+    {
+      rules.push_back(r);
+    });
+  }
+
+  return make_pair(types.GetGeoType(), types.Has(classif().GetCoastType()));
 }
 
 namespace
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/drawing_rule_def.hpp"
+#include "indexer/drules_table.hpp"
 #include "indexer/feature_decl.hpp"
 
 #include "base/base.hpp"
@@ -60,6 +61,10 @@ namespace feature
                               drule::KeysT & keys);
   void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
                    drule::KeysT & keys);
+  /// The same as GetDrawRule() but also returns rules themselves.
+  /// @return (geometry type, is coastline)
+  pair<int, bool> GetDrawRules(FeatureBase const & f, int level,
+                               drule::RulesTable::TRules & rules);
 
   /// Used to check whether user types belong to particular classificator set.
   class TypeSetChecker
@@ -0,0 +1,123 @@
+#include "indexer/features_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/sstream.hpp"
+
+
+FeaturesCache::FeaturesCache(size_t maxBytes) : m_maxBytes(maxBytes)
+{
+}
+
+void FeaturesCache::SetMaxBytes(size_t maxBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_maxBytes = maxBytes;
+  EvictIfNeeded();
+}
+
+size_t FeaturesCache::GetMaxBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_maxBytes;
+}
+
+FeaturesCache::TFeaturePtr FeaturesCache::Find(FeatureID const & id, int scale)
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  auto const it = m_index.find(make_pair(id, scale));
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return TFeaturePtr();
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_feature;
+}
+
+void FeaturesCache::Add(FeatureID const & id, int scale, TFeaturePtr const & ft)
+{
+  ASSERT(ft, ());
+  size_t const bytes = ft->GetMemoryUsage();
+
+  lock_guard<mutex> lock(m_mutex);
+
+  // Do not flush the whole cache because of one huge feature.
+  if (bytes > m_maxBytes)
+    return;
+
+  TKey const key(id, scale);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it);
+
+  m_entries.emplace_front(key, ft, bytes);
+  m_index.insert(make_pair(key, m_entries.begin()));
+  m_stats.m_bytes += bytes;
+  ++m_stats.m_count;
+
+  EvictIfNeeded();
+}
+
+void FeaturesCache::ClearDeregistered()
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  auto it = m_index.begin();
+  while (it != m_index.end())
+  {
+    if (it->first.first.IsValid())
+      ++it;
+    else
+      Erase(it++);
+  }
+}
+
+void FeaturesCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  m_index.clear();
+  m_entries.clear();
+  m_stats.m_count = 0;
+  m_stats.m_bytes = 0;
+}
+
+FeaturesCache::Stats FeaturesCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void FeaturesCache::Erase(map<TKey, TEntries::iterator>::iterator it)
+{
+  ASSERT_GREATER_OR_EQUAL(m_stats.m_bytes, it->second->m_bytes, ());
+  ASSERT_GREATER(m_stats.m_count, 0, ());
+
+  m_stats.m_bytes -= it->second->m_bytes;
+  --m_stats.m_count;
+  m_entries.erase(it->second);
+  m_index.erase(it);
+}
+
+void FeaturesCache::EvictIfNeeded()
+{
+  while (m_stats.m_bytes > m_maxBytes)
+  {
+    ASSERT(!m_entries.empty(), ());
+    Erase(m_index.find(m_entries.back().m_key));
+    ++m_stats.m_evictions;
+  }
+}
+
+string DebugPrint(FeaturesCache::Stats const & stats)
+{
+  ostringstream out;
+  out << "FeaturesCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", evictions: " << stats.m_evictions << ", count: " << stats.m_count
+      << ", bytes: " << stats.m_bytes << " ]";
+  return out.str();
+}
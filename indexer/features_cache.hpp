@@ -0,0 +1,89 @@
+#pragma once
+#include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+
+
+/// Thread-safe LRU cache of completely decoded features.
+/// Features are keyed by (FeatureID, scale), because geometry is decoded for the particular scale.
+/// Cached features are detached from their loader (see FeatureType::ParseEverything) and
+/// are shared by readers as const objects, so a cache hit doesn't touch the mwm file.
+class FeaturesCache
+{
+  DISALLOW_COPY_AND_MOVE(FeaturesCache);
+
+public:
+  struct Stats
+  {
+    Stats() : m_hits(0), m_misses(0), m_evictions(0), m_count(0), m_bytes(0) {}
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+    size_t m_count;
+    size_t m_bytes;
+  };
+
+  /// @param[in] maxBytes Memory budget for cached features. Zero value disables the cache.
+  explicit FeaturesCache(size_t maxBytes = 0);
+
+  /// Changes memory budget. Evicts least recently used features if needed.
+  void SetMaxBytes(size_t maxBytes);
+  size_t GetMaxBytes() const;
+
+  inline bool IsEnabled() const { return GetMaxBytes() > 0; }
+
+  using TFeaturePtr = shared_ptr<FeatureType const>;
+
+  /// @return Cached feature or nullptr if it's not present in cache.
+  TFeaturePtr Find(FeatureID const & id, int scale);
+
+  /// Adds the feature completely decoded by FeatureType::ParseEverything(scale).
+  void Add(FeatureID const & id, int scale, TFeaturePtr const & ft);
+
+  /// Drops features of all deregistered mwms.
+  void ClearDeregistered();
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  using TKey = pair<FeatureID, int>;
+
+  struct Entry
+  {
+    Entry(TKey const & key, TFeaturePtr const & ft, size_t bytes)
+      : m_key(key), m_feature(ft), m_bytes(bytes)
+    {
+    }
+
+    TKey m_key;
+    TFeaturePtr m_feature;
+    size_t m_bytes;
+  };
+
+  using TEntries = list<Entry>;
+
+  void Erase(map<TKey, TEntries::iterator>::iterator it);
+  void EvictIfNeeded();
+
+  mutable mutex m_mutex;
+
+  /// Most recently used entries are in the front.
+  TEntries m_entries;
+  map<TKey, TEntries::iterator> m_index;
+
+  size_t m_maxBytes;
+  Stats m_stats;
+};
+
+string DebugPrint(FeaturesCache::Stats const & stats);
@@ -5,6 +5,15 @@
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/utility.hpp"
+
+namespace
+{
+// Records which are not further than this from the previous one are read in one chunk.
+uint32_t const kMaxRecordsGap = 4 * 1024;
+uint32_t const kMaxChunkSize = 256 * 1024;
+}  // namespace
 
 void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
 {
@@ -14,6 +23,28 @@ void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
   ft.Deserialize(m_LoadInfo.GetLoader(), &m_buffer[offset]);
 }
 
+void FeaturesVector::GetByIndices(vector<uint32_t> const & indices, TReadFn const & fn) const
+{
+  // (offset, index) pairs sorted by offset.
+  vector<pair<uint32_t, uint32_t>> records;
+  records.reserve(indices.size());
+  for (uint32_t const index : indices)
+    records.emplace_back(m_table ? m_table->GetFeatureOffset(index) : index, index);
+  sort(records.begin(), records.end());
+
+  vector<uint64_t> positions;
+  positions.reserve(records.size());
+  for (auto const & r : records)
+    positions.push_back(r.first);
+
+  m_RecordReader.ForEachRecordAt(positions, [&](size_t i, char const * data, uint32_t /*size*/)
+  {
+    FeatureType ft;
+    ft.Deserialize(m_LoadInfo.GetLoader(), data);
+    fn(records[i].second, ft);
+  }, kMaxRecordsGap, kMaxChunkSize);
+}
+
 
 FeaturesVectorTest::FeaturesVectorTest(string const & filePath)
   : FeaturesVectorTest((FilesContainerR(filePath, READER_CHUNK_LOG_SIZE, READER_CHUNK_LOG_COUNT)))
@@ -4,6 +4,8 @@
 
 #include "coding/var_record_reader.hpp"
 
+#include "std/function.hpp"
+
 
 namespace feature { class FeaturesOffsetsTable; }
 
@@ -22,6 +24,14 @@ public:
 
   void GetByIndex(uint32_t index, FeatureType & ft) const;
 
+  using TReadFn = function<void(uint32_t, FeatureType &)>;
+
+  /// Reads features with given indices. Features are read in the order of their offsets
+  /// in the data section, close records are read with one big sequential read.
+  /// Note! Passed FeatureType is valid only inside the callback.
+  /// @param[in] fn Called as fn(index, feature) for every index from @indices.
+  void GetByIndices(vector<uint32_t> const & indices, TReadFn const & fn) const;
+
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
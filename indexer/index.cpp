@@ -6,6 +6,7 @@
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -17,7 +18,9 @@ using platform::LocalCountryFile;
 MwmValue::MwmValue(LocalCountryFile const & localFile)
     : m_cont(platform::GetCountryReader(localFile, MapOptions::Map)),
       m_file(localFile),
-      m_table(0)
+      m_table(0),
+      m_searchTrieInfo(0),
+      m_streetHousesLoaded(false)
 {
   m_factory.Load(m_cont);
 }
@@ -38,6 +41,39 @@ void MwmValue::SetTable(MwmInfoEx & info)
   m_table = info.m_table.get();
 }
 
+feature::StreetHousesIndex const * MwmValue::GetStreetHousesIndex() const
+{
+  if (!m_streetHousesLoaded)
+  {
+    m_streetHouses = feature::StreetHousesIndex::Load(m_cont, GetHeader().GetDefCodingParams());
+    m_streetHousesLoaded = true;
+  }
+  return m_streetHouses.get();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+// MwmInfoEx implementation
+//////////////////////////////////////////////////////////////////////////////////
+
+trie::DefaultFlatTrie const * MwmInfoEx::GetSearchTrie(MwmValue const & value)
+{
+  lock_guard<mutex> lock(m_searchTrieMutex);
+  if (!m_searchTrie && value.m_cont.IsExist(SEARCH_INDEX_FILE_TAG))
+  {
+    my::Timer timer;
+    serial::CodingParams const cp(
+        trie::GetCodingParams(value.GetHeader().GetDefCodingParams()));
+    unique_ptr<trie::DefaultIterator> const root(
+        trie::ReadTrie(value.m_cont.GetReader(SEARCH_INDEX_FILE_TAG), trie::ValueReader(cp),
+                       trie::TEdgeValueReader()));
+    m_searchTrie.reset(new trie::DefaultFlatTrie(*root));
+    LOG(LINFO, ("Search index of", value.GetCountryFileName(), "is loaded in",
+                timer.ElapsedSeconds(), "s. Nodes:", m_searchTrie->GetNodesCount(), "values:",
+                m_searchTrie->GetValuesCount(), "bytes:", m_searchTrie->GetMemoryBytes()));
+  }
+  return m_searchTrie.get();
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index implementation
 //////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +101,8 @@ unique_ptr<MwmSet::MwmValueBase> Index::CreateValue(MwmInfo & info) const
 {
   unique_ptr<MwmValue> p(new MwmValue(info.GetLocalFile()));
   p->SetTable(dynamic_cast<MwmInfoEx &>(info));
+  if (m_flatSearchTrie)
+    p->SetSearchTrieInfo(dynamic_cast<MwmInfoEx &>(info));
   ASSERT(p->GetHeader().IsMWMSuitable(), ());
   return unique_ptr<MwmSet::MwmValueBase>(move(p));
 }
@@ -2,10 +2,13 @@
 #include "indexer/cell_id.hpp"
 #include "indexer/data_factory.hpp"
 #include "indexer/feature_covering.hpp"
+#include "indexer/features_cache.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/mwm_set.hpp"
 #include "indexer/scale_index.hpp"
+#include "indexer/search_trie.hpp"
+#include "indexer/street_houses_index.hpp"
 #include "indexer/unique_index.hpp"
 
 #include "coding/file_container.hpp"
@@ -17,14 +20,25 @@
 
 #include "std/algorithm.hpp"
 #include "std/limits.hpp"
+#include "std/mutex.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
 
+class MwmValue;
+
 class MwmInfoEx : public MwmInfo
 {
 public:
   unique_ptr<feature::FeaturesOffsetsTable> m_table;
+
+  /// Loads the search index of the mwm into the flat trie on the first call.
+  /// It's called outside of the MwmSet lock, so only the users of this mwm wait for it.
+  trie::DefaultFlatTrie const * GetSearchTrie(MwmValue const & value);
+
+private:
+  mutex m_searchTrieMutex;
+  unique_ptr<trie::DefaultFlatTrie> m_searchTrie;
 };
 
 class MwmValue : public MwmSet::MwmValueBase
@@ -37,10 +51,30 @@ public:
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
+  void SetSearchTrieInfo(MwmInfoEx & info) { m_searchTrieInfo = &info; }
+
+  /// @return In-memory copy of the search index, null if Index::SetFlatSearchTrie()
+  /// is not set or the mwm has no search index.
+  trie::DefaultFlatTrie const * GetSearchTrie() const
+  {
+    return m_searchTrieInfo ? m_searchTrieInfo->GetSearchTrie(*this) : nullptr;
+  }
+
+  /// @return Street-houses section of the mwm, null if the mwm has no one.
+  /// The section is loaded on the first call and lives as long as the value, so it's
+  /// released with the other readers of the mwm when MwmSet drops the value from its cache.
+  feature::StreetHousesIndex const * GetStreetHousesIndex() const;
 
   inline feature::DataHeader const & GetHeader() const { return m_factory.GetHeader(); }
   inline version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
   inline string const & GetCountryFileName() const { return m_file.GetCountryFile().GetNameWithoutExt(); }
+
+private:
+  MwmInfoEx * m_searchTrieInfo;
+
+  // A value is used by one handle at a time, so the section is loaded without locks.
+  mutable unique_ptr<feature::StreetHousesIndex> m_streetHouses;
+  mutable bool m_streetHousesLoaded;
 };
 
 class Index : public MwmSet
@@ -87,8 +121,13 @@ public:
 
   bool RemoveObserver(Observer const & observer);
 
-private:
+  /// When set, the search index of every mwm is loaded into a flat in-memory trie once,
+  /// when the mwm is searched for the first time, and is shared by all search queries.
+  /// It trades memory for the speed of the search index traversal, so it is meant
+  /// for servers which keep many mwms open. Should be set before maps are used.
+  void SetFlatSearchTrie(bool enable) { m_flatSearchTrie = enable; }
 
+private:
   template <typename F> class ReadMWMFunctor
   {
     F & m_f;
@@ -130,7 +169,6 @@ private:
 
               fv.GetByIndex(index, feature);
               feature.SetID(FeatureID(mwmID, index));
-
               m_f(feature);
             }
           }, i.first, i.second, scale);
@@ -212,6 +250,77 @@ public:
   // "features" must be sorted using FeatureID::operator< as predicate.
   template <typename F>
   void ReadFeatures(F & f, vector<FeatureID> const & features) const
+  {
+    ReadFeaturesImpl(features, [&f](MwmValue const & value, MwmId const & id,
+                                    vector<uint32_t> const & indices)
+    {
+      FeaturesVector const featureReader(value.m_cont, value.GetHeader(), value.m_table);
+
+      // Offsets of features grow with indices, so features come in the same order.
+      featureReader.GetByIndices(indices, [&](uint32_t index, FeatureType & featureType)
+      {
+        featureType.SetID(FeatureID(id, index));
+        f(featureType);
+      });
+    });
+  }
+
+  /// The same as above, but features are taken from the @cache, features which are not
+  /// there are parsed for the @scale and put into it. @f gets features as const objects
+  /// which may be shared with other threads, so it shouldn't ask them for geometry of
+  /// another scale. The cache is opt-in for callers which read the same features again
+  /// and again, e.g. the renderer.
+  template <typename F>
+  void ReadFeatures(F & f, vector<FeatureID> const & features, FeaturesCache & cache,
+                    int scale) const
+  {
+    using TFeaturePtr = FeaturesCache::TFeaturePtr;
+
+    ReadFeaturesImpl(features, [&](MwmValue const & value, MwmId const & id,
+                                   vector<uint32_t> const & indices)
+    {
+      // Cached features are not read at all, they are passed to @f in the order of
+      // indices together with the read ones.
+      vector<pair<uint32_t, TFeaturePtr>> cached;
+      vector<uint32_t> missed;
+      for (uint32_t const index : indices)
+      {
+        TFeaturePtr ft = cache.Find(FeatureID(id, index), scale);
+        if (ft)
+          cached.emplace_back(index, move(ft));
+        else
+          missed.push_back(index);
+      }
+
+      auto cachedIt = cached.cbegin();
+      auto const passCached = [&](uint32_t upperIndex)
+      {
+        for (; cachedIt != cached.cend() && cachedIt->first < upperIndex; ++cachedIt)
+          f(*cachedIt->second);
+      };
+
+      if (!missed.empty())
+      {
+        FeaturesVector const featureReader(value.m_cont, value.GetHeader(), value.m_table);
+        featureReader.GetByIndices(missed, [&](uint32_t index, FeatureType & featureType)
+        {
+          passCached(index);
+
+          featureType.SetID(FeatureID(id, index));
+          featureType.ParseEverything(scale);
+          auto const ft = make_shared<FeatureType>(move(featureType));
+          cache.Add(ft->GetID(), scale, ft);
+          f(*ft);
+        });
+      }
+      passCached(numeric_limits<uint32_t>::max());
+    });
+  }
+
+private:
+  /// Calls @fn(mwmValue, mwmId, indices) for every group of features of the same mwm.
+  template <typename TFn>
+  void ReadFeaturesImpl(vector<FeatureID> const & features, TFn && fn) const
   {
     auto fidIter = features.begin();
     auto const endIter = features.end();
@@ -221,16 +330,14 @@ public:
       MwmHandle const handle = GetMwmHandleById(id);
       if (handle.IsAlive())
       {
-        MwmValue const * pValue = handle.GetValue<MwmValue>();
-        FeaturesVector const featureReader(pValue->m_cont, pValue->GetHeader(), pValue->m_table);
+        vector<uint32_t> indices;
         do
         {
-          FeatureType featureType;
-          featureReader.GetByIndex(fidIter->m_index, featureType);
-          featureType.SetID(*fidIter);
-          f(featureType);
+          indices.push_back(fidIter->m_index);
         }
         while (++fidIter != endIter && id == fidIter->m_mwmId);
+
+        fn(*handle.GetValue<MwmValue>(), id, indices);
       }
       else
       {
@@ -240,6 +347,7 @@ public:
     }
   }
 
+public:
   /// Guard for loading features from particular MWM by demand.
   class FeaturesLoaderGuard
   {
@@ -321,4 +429,6 @@ private:
   }
 
   my::ObserverList<Observer> m_observers;
+
+  bool m_flatSearchTrie = false;
 };
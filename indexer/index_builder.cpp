@@ -9,6 +9,13 @@
 namespace indexer
 {
   bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile)
+  {
+    return BuildIndexFromDatFile(datFile, tmpFile, covering::kScaleIndexSortMemoryBytes,
+                                 GetPlatform().CpuCores());
+  }
+
+  bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile,
+                             size_t sortMemoryBytes, size_t sortThreadsCount)
   {
     try
     {
@@ -17,7 +24,8 @@ namespace indexer
         FeaturesVectorTest features(datFile);
         FileWriter writer(idxFileName);
 
-        BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile);
+        BuildIndex(features.GetHeader(), features.GetVector(), writer, tmpFile, sortMemoryBytes,
+                   sortThreadsCount);
       }
 
       FilesContainerW(datFile, FileWriter::OP_WRITE_EXISTING).Write(idxFileName, INDEX_FILE_TAG);
@@ -3,22 +3,39 @@
 #include "indexer/data_header.hpp"
 #include "indexer/scale_index_builder.hpp"
 
+#include "platform/platform.hpp"
+
 namespace indexer
 {
 template <class TFeaturesVector, typename TWriter>
 void BuildIndex(feature::DataHeader const & header, TFeaturesVector const & features,
-                TWriter & writer, string const & tmpFilePrefix)
+                TWriter & writer, string const & tmpFilePrefix, size_t sortMemoryBytes,
+                size_t sortThreadsCount)
   {
     LOG(LINFO, ("Building scale index."));
     uint64_t indexSize;
     {
       SubWriter<TWriter> subWriter(writer);
-      covering::IndexScales(header, features, subWriter, tmpFilePrefix);
+      covering::IndexScales(header, features, subWriter, tmpFilePrefix, sortMemoryBytes,
+                            sortThreadsCount);
       indexSize = subWriter.Size();
     }
     LOG(LINFO, ("Built scale index. Size =", indexSize));
   }
 
+template <class TFeaturesVector, typename TWriter>
+void BuildIndex(feature::DataHeader const & header, TFeaturesVector const & features,
+                TWriter & writer, string const & tmpFilePrefix)
+  {
+    BuildIndex(header, features, writer, tmpFilePrefix, covering::kScaleIndexSortMemoryBytes,
+               GetPlatform().CpuCores());
+  }
+
   // doesn't throw exceptions
   bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile);
+
+  // Same as above, but with the budget of the sorting (see covering::IndexScales),
+  // e.g. when several files are built simultaneously.
+  bool BuildIndexFromDatFile(string const & datFile, string const & tmpFile,
+                             size_t sortMemoryBytes, size_t sortThreadsCount);
 }
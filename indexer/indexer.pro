@@ -20,6 +20,7 @@ SOURCES += \
     drawing_rules.cpp \
     drules_selector.cpp \
     drules_selector_parser.cpp \
+    drules_table.cpp \
     feature.cpp \
     feature_algo.cpp \
     feature_covering.cpp \
@@ -31,6 +32,7 @@ SOURCES += \
     feature_meta.cpp \
     feature_utils.cpp \
     feature_visibility.cpp \
+    features_cache.cpp \
     features_offsets_table.cpp \
     features_vector.cpp \
     ftypes_matcher.cpp \
@@ -47,6 +49,7 @@ SOURCES += \
     search_delimiters.cpp \
     search_index_builder.cpp \
     search_string_utils.cpp \
+    street_houses_index.cpp \
     types_mapping.cpp \
 
 HEADERS += \
@@ -63,6 +66,7 @@ HEADERS += \
     drules_include.hpp \
     drules_selector.cpp \
     drules_selector_parser.cpp \
+    drules_table.hpp \
     feature.hpp \
     feature_algo.hpp \
     feature_covering.hpp \
@@ -75,6 +79,7 @@ HEADERS += \
     feature_processor.hpp \
     feature_utils.hpp \
     feature_visibility.hpp \
+    features_cache.hpp \
     features_offsets_table.hpp \
     features_vector.hpp \
     ftypes_matcher.hpp \
@@ -100,6 +105,7 @@ HEADERS += \
     search_trie.hpp \
     string_file.hpp \
     string_file_values.hpp \
+    street_houses_index.hpp \
     tesselator_decl.hpp \
     tree_structure.hpp \
     types_mapping.hpp \
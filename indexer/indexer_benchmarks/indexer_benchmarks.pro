@@ -0,0 +1,20 @@
+# This subproject implements benchmarks of the index builders.
+# They run on synthetic data and don't need maps.
+
+TARGET = indexer_benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = indexer platform geometry coding base protobuf tomcrypt gflags
+DEPENDENCIES += opening_hours
+
+include($$ROOT_DIR/common.pri)
+
+QT *= core
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+SOURCES += \
+  scale_index_sort_benchmark.cpp \
@@ -0,0 +1,99 @@
+#include "indexer/scale_index_builder.hpp"
+
+#include "coding/file_sort.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/parallel_file_sort.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/bind.hpp"
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+DEFINE_uint64(count, 50000000, "Count of cell-feature-bucket tuples to sort.");
+DEFINE_uint64(buckets, 18, "Count of scale buckets.");
+DEFINE_uint64(memory_mb, 256, "Memory budget of the parallel sorter in megabytes.");
+DEFINE_uint64(threads, 0, "Count of sorting threads, count of cpu cores if 0.");
+DEFINE_uint64(seed, 0, "Seed of the random tuples generator.");
+DEFINE_bool(old_sorter, true, "Also time FileSorter with the 1 MB buffer used before.");
+
+using covering::CellFeatureBucketTuple;
+using covering::CellFeaturePair;
+
+namespace
+{
+// Consumes the sorted tuples without writing them, so only sorting is timed.
+struct CheckingSink
+{
+  void operator()(CellFeatureBucketTuple const & t)
+  {
+    if (m_count != 0 && t < m_last)
+      m_sorted = false;
+    m_last = t;
+    ++m_count;
+  }
+
+  CellFeatureBucketTuple m_last;
+  uint64_t m_count = 0;
+  bool m_sorted = true;
+};
+
+template <class TSorter>
+void RunBenchmark(string const & name, TSorter & sorter, CheckingSink const & sink)
+{
+  mt19937 rng(static_cast<uint32_t>(FLAGS_seed));
+  // Cells are 63-bit ids, feature indices grow as in a real mwm.
+  uniform_int_distribution<uint64_t> cells(0, (uint64_t(1) << 62) - 1);
+  uniform_int_distribution<uint32_t> buckets(0, static_cast<uint32_t>(FLAGS_buckets - 1));
+
+  my::Timer timer;
+  for (uint64_t i = 0; i < FLAGS_count; ++i)
+  {
+    CellFeaturePair const pair(cells(rng), static_cast<uint32_t>(i / 8));
+    sorter.Add(CellFeatureBucketTuple(pair, buckets(rng)));
+  }
+  double const addSeconds = timer.ElapsedSeconds();
+  sorter.SortAndFinish();
+
+  CHECK(sink.m_sorted, (name, "produced unsorted output"));
+  CHECK_EQUAL(sink.m_count, FLAGS_count, (name));
+  LOG(LINFO, (name, "tuples:", sink.m_count, "adding:", addSeconds, "s, total:",
+              timer.ElapsedSeconds(), "s"));
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Times external sorting of random scale index tuples.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  CHECK_GREATER(FLAGS_buckets, 0, ());
+  string const tmpFile = GetPlatform().WritablePathForFile("scale_index_sort_benchmark.tmp");
+  MY_SCOPE_GUARD(tmpFileGuard, bind(&FileWriter::DeleteFileX, tmpFile));
+
+  if (FLAGS_old_sorter)
+  {
+    CheckingSink sink;
+    FileSorter<CellFeatureBucketTuple, CheckingSink> sorter(1024 * 1024 /* bufferBytes */,
+                                                            tmpFile, sink);
+    RunBenchmark("FileSorter", sorter, sink);
+  }
+
+  size_t const threadsCount = FLAGS_threads == 0 ? GetPlatform().CpuCores() : FLAGS_threads;
+  for (size_t threads : {size_t(0), threadsCount})
+  {
+    CheckingSink sink;
+    ParallelFileSorter<CellFeatureBucketTuple, CheckingSink> sorter(
+        static_cast<size_t>(FLAGS_memory_mb) * 1024 * 1024, tmpFile, sink, threads);
+    RunBenchmark("ParallelFileSorter threads: " + strings::to_string(threads), sorter, sink);
+  }
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/index.hpp"
 
@@ -15,14 +16,42 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
+#include "std/map.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
 namespace
 {
+// Collects points and triangles of features for the scale by feature indices,
+// as ids of the same feature in different indexes are different.
+class GeometryCollector
+{
+public:
+  explicit GeometryCollector(int scale) : m_scale(scale) {}
+
+  void operator()(FeatureType const & ft)
+  {
+    m_ids.push_back(ft.GetID());
+    vector<m2::PointD> & points = m_geometry[ft.GetID().m_index];
+    ft.ForEachPoint([&points](m2::PointD const & p) { points.push_back(p); }, m_scale);
+    ft.ForEachTriangle([&points](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+    {
+      points.push_back(p1);
+      points.push_back(p2);
+      points.push_back(p3);
+    }, m_scale);
+  }
+
+  int const m_scale;
+  vector<FeatureID> m_ids;
+  map<uint32_t, vector<m2::PointD>> m_geometry;
+};
+
 class Observer : public Index::Observer
 {
 public:
@@ -153,3 +182,98 @@ UNIT_TEST(Index_MwmStatusNotifications)
   observer.CheckExpectations();
   index.RemoveObserver(observer);
 }
+
+UNIT_TEST(Index_FeaturesCache)
+{
+  classificator::Load();
+
+  Index index;
+  UNUSED_VALUE(index.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass")));
+
+  vector<FeatureID> ids;
+  auto idsCollector = [&ids](FeatureType const & ft) { ids.push_back(ft.GetID()); };
+  index.ForEachInScale(idsCollector, 15);
+  sort(ids.begin(), ids.end());
+  TEST(!ids.empty(), ());
+
+  FeaturesCache cache(64 * 1024 * 1024);
+  vector<FeatureType const *> features;
+  auto collector = [&features](FeatureType const & ft) { features.push_back(&ft); };
+
+  index.ReadFeatures(collector, ids, cache, 15);
+  TEST_EQUAL(features.size(), ids.size(), ());
+
+  FeaturesCache::Stats stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 0, (stats));
+  TEST_EQUAL(stats.m_misses, ids.size(), (stats));
+  TEST_EQUAL(stats.m_count, ids.size(), (stats));
+
+  // Second pass over the same scale is served from the cache completely,
+  // the cached features are passed without copying.
+  vector<FeatureType const *> const firstFeatures = features;
+  features.clear();
+  index.ReadFeatures(collector, ids, cache, 15);
+  TEST(features == firstFeatures, ());
+
+  stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, ids.size(), (stats));
+  TEST_EQUAL(stats.m_misses, ids.size(), (stats));
+
+  // Other callers don't use the cache.
+  size_t count = 0;
+  auto counter = [&count](FeatureType const &) { ++count; };
+  index.ForEachInScale(counter, 15);
+  TEST_EQUAL(count, ids.size(), ());
+  TEST_EQUAL(cache.GetStats().m_hits, ids.size(), ());
+
+  // Shrinking of the budget evicts features.
+  size_t const budget = stats.m_bytes / 2;
+  cache.SetMaxBytes(budget);
+  stats = cache.GetStats();
+  TEST_LESS_OR_EQUAL(stats.m_bytes, budget, (stats));
+  TEST_GREATER(stats.m_evictions, 0, (stats));
+}
+
+UNIT_TEST(Index_FeaturesCacheScales)
+{
+  int const kScale = 12;
+  classificator::Load();
+
+  Index index;
+  UNUSED_VALUE(index.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass")));
+
+  GeometryCollector expected(kScale);
+  index.ForEachInScale(expected, kScale);
+  vector<FeatureID> ids = expected.m_ids;
+  sort(ids.begin(), ids.end());
+  TEST(!ids.empty(), ());
+
+  // Some features are cached on the first pass, then hits and misses are mixed.
+  FeaturesCache cache(64 * 1024 * 1024);
+  vector<FeatureID> someIds;
+  for (size_t i = 0; i < ids.size(); i += 3)
+    someIds.push_back(ids[i]);
+  GeometryCollector some(kScale);
+  index.ReadFeatures(some, someIds, cache, kScale);
+  TEST_EQUAL(some.m_ids, someIds, ());
+
+  // Features come in the order of ids and have the same geometry as not cached ones.
+  for (size_t i = 0; i < 2; ++i)
+  {
+    GeometryCollector scale(kScale);
+    index.ReadFeatures(scale, ids, cache, kScale);
+    TEST_EQUAL(scale.m_ids, ids, (i));
+    TEST(scale.m_geometry == expected.m_geometry, (i));
+  }
+
+  FeaturesCache::Stats stats = cache.GetStats();
+  TEST_EQUAL(stats.m_misses, ids.size(), (stats));
+  TEST_EQUAL(stats.m_hits, someIds.size() + ids.size(), (stats));
+
+  // Features are cached for every scale separately.
+  GeometryCollector otherScale(kScale + 1);
+  index.ReadFeatures(otherScale, ids, cache, kScale + 1);
+  stats = cache.GetStats();
+  TEST_EQUAL(stats.m_misses, 2 * ids.size(), (stats));
+  TEST_EQUAL(stats.m_count, 2 * ids.size(), (stats));
+}
@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature_impl.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+#include "indexer/street_houses_index.hpp"
+
+#include "defines.hpp"
+
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/writer.hpp"
+
+#include "base/stl_add.hpp"
+
+
+UNIT_TEST(StreetHousesIndex_Build)
+{
+  Platform & p = GetPlatform();
+  classificator::Load();
+
+  FilesContainerR originalContainer(p.GetReader("minsk-pass" DATA_FILE_EXTENSION));
+  TEST(!feature::StreetHousesIndex::Load(originalContainer,
+                                         serial::CodingParams()),
+       ("Test data should not have street houses section."));
+
+  vector<char> section;
+  {
+    FeaturesVectorTest features(originalContainer);
+    MemWriter<vector<char>> writer(section);
+    indexer::BuildStreetHousesIndex(features.GetVector(),
+                                    features.GetHeader().GetDefCodingParams(),
+                                    indexer::kStreetHousesMaxOffsetMeters, writer);
+  }
+
+  string const filePath = p.WritablePathForFile("street_houses_index_test" DATA_FILE_EXTENSION);
+  FileWriter::DeleteFileX(filePath);
+  {
+    FilesContainerW containerWriter(filePath);
+    vector<string> tags;
+    originalContainer.ForEachTag(MakeBackInsertFunctor(tags));
+    for (size_t i = 0; i < tags.size(); ++i)
+      containerWriter.Write(originalContainer.GetReader(tags[i]), tags[i]);
+    containerWriter.Write(section, STREET_HOUSES_FILE_TAG);
+  }
+
+  {
+    FeaturesVectorTest features(filePath);
+    FilesContainerR container(filePath);
+    auto const index = feature::StreetHousesIndex::Load(
+        container, features.GetHeader().GetDefCodingParams());
+    TEST(index, ());
+    TEST_EQUAL(index->GetMaxOffsetMeters(), indexer::kStreetHousesMaxOffsetMeters, ());
+    TEST_GREATER(index->GetStreetsCount(), 0, ());
+
+    size_t streets = 0;
+    size_t houses = 0;
+    features.GetVector().ForEach([&](FeatureType & ft, uint32_t featureIndex)
+    {
+      bool const isIndexed = index->ForEachHouse(featureIndex,
+          [&](feature::StreetHousesIndex::House const & house)
+      {
+        FeatureType houseFt;
+        features.GetVector().GetByIndex(house.m_featureIndex, houseFt);
+        TEST(ftypes::IsBuildingChecker::Instance()(houseFt), ());
+        TEST_EQUAL(houseFt.GetHouseNumber(), house.m_number, ());
+        TEST(feature::IsHouseNumber(house.m_number), ());
+
+        m2::PointD const center = houseFt.GetLimitRect(FeatureType::BEST_GEOMETRY).Center();
+        TEST_LESS(MercatorBounds::DistanceOnEarth(center, house.m_point), 1.0, ());
+        ++houses;
+      });
+
+      if (isIndexed)
+      {
+        TEST(ftypes::IsStreetChecker::Instance()(ft), ());
+        ++streets;
+      }
+    });
+
+    TEST_EQUAL(streets, index->GetStreetsCount(), ());
+    TEST_GREATER(houses, 0, ());
+  }
+
+  FileWriter::DeleteFileX(filePath);
+}
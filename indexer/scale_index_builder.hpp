@@ -9,7 +9,7 @@
 #include "defines.hpp"
 
 #include "coding/dd_vector.hpp"
-#include "coding/file_sort.hpp"
+#include "coding/parallel_file_sort.hpp"
 #include "coding/var_serial_vector.hpp"
 #include "coding/writer.hpp"
 
@@ -192,9 +192,15 @@ private:
   SinkT & m_Sink;
 };
 
+// Default memory budget of the cell-feature pairs sorting.
+size_t constexpr kScaleIndexSortMemoryBytes = 256 * 1024 * 1024;
+
+// |sortMemoryBytes| and |sortThreadsCount| are the budget of the cell-feature pairs sorting,
+// see ParallelFileSorter.
 template <class TFeaturesVector, class TWriter>
 void IndexScales(feature::DataHeader const & header, TFeaturesVector const & features,
-                 TWriter & writer, string const & tmpFilePrefix)
+                 TWriter & writer, string const & tmpFilePrefix, size_t sortMemoryBytes,
+                 size_t sortThreadsCount)
 {
   // TODO: Make scale bucketing dynamic.
 
@@ -207,9 +213,9 @@ void IndexScales(feature::DataHeader const & header, TFeaturesVector const & fea
   {
     FileWriter cellsToFeaturesAllBucketsWriter(cellsToFeatureAllBucketsFile);
 
-    using TSorter = FileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>>;
+    using TSorter = ParallelFileSorter<CellFeatureBucketTuple, WriterFunctor<FileWriter>>;
     WriterFunctor<FileWriter> out(cellsToFeaturesAllBucketsWriter);
-    TSorter sorter(1024 * 1024 /* bufferBytes */, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out);
+    TSorter sorter(sortMemoryBytes, tmpFilePrefix + CELL2FEATURE_TMP_EXT, out, sortThreadsCount);
     vector<uint32_t> featuresInBucket(bucketsCount);
     vector<uint32_t> cellsInBucket(bucketsCount);
     features.ForEach(FeatureCoverer<TSorter>(header, sorter, featuresInBucket, cellsInBucket));
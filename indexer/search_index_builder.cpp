@@ -385,7 +385,7 @@ void AddFeatureNameIndexPairs(FilesContainerR const & container,
 }
 
 void BuildSearchIndex(FilesContainerR const & cont, CategoriesHolder const & catHolder,
-                      Writer & writer, string const & tmpFilePath)
+                      Writer & writer, string const & tmpFilePath, size_t sortThreadsCount)
 {
   {
     FeaturesVectorTest features(cont);
@@ -398,7 +398,7 @@ void BuildSearchIndex(FilesContainerR const & cont, CategoriesHolder const & cat
     if (header.GetType() == feature::DataHeader::world)
       synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
 
-    StringsFile<SerializedFeatureInfoValue> names(tmpFilePath);
+    StringsFile<SerializedFeatureInfoValue> names(tmpFilePath, sortThreadsCount);
 
     features.GetVector().ForEach(FeatureInserter<StringsFile<SerializedFeatureInfoValue>>(
         synonyms.get(), names, catHolder, header.GetScaleRange(), valueBuilder));
@@ -419,12 +419,18 @@ void BuildSearchIndex(FilesContainerR const & cont, CategoriesHolder const & cat
 
 namespace indexer {
 bool BuildSearchIndexFromDatFile(string const & datFile, bool forceRebuild)
+{
+  CategoriesHolder catHolder(GetPlatform().GetReader(SEARCH_CATEGORIES_FILE_NAME));
+  return BuildSearchIndexFromDatFile(datFile, catHolder, forceRebuild, GetPlatform().CpuCores());
+}
+
+bool BuildSearchIndexFromDatFile(string const & datFile, CategoriesHolder const & catHolder,
+                                 bool forceRebuild, size_t sortThreadsCount)
 {
   LOG(LINFO, ("Start building search index. Bits = ", search::kPointCodingBits));
 
   try
   {
-    Platform & pl = GetPlatform();
     string const tmpFile1 = datFile + ".search_index_1.tmp";
     string const tmpFile2 = datFile + ".search_index_2.tmp";
 
@@ -436,9 +442,7 @@ bool BuildSearchIndexFromDatFile(string const & datFile, bool forceRebuild)
 
       FileWriter writer(tmpFile2);
 
-      CategoriesHolder catHolder(pl.GetReader(SEARCH_CATEGORIES_FILE_NAME));
-
-      BuildSearchIndex(readCont, catHolder, writer, tmpFile1);
+      BuildSearchIndex(readCont, catHolder, writer, tmpFile1, sortThreadsCount);
 
       LOG(LINFO, ("Search index size = ", writer.Size()));
     }
@@ -512,7 +516,7 @@ void BuildCompressedSearchIndex(FilesContainerR & container, Writer & indexWrite
   my::Timer timer;
 
   string stringsFilePath = platform.WritablePathForFile("strings.tmp");
-  StringsFile<FeatureIndexValue> stringsFile(stringsFilePath);
+  StringsFile<FeatureIndexValue> stringsFile(stringsFilePath, platform.CpuCores());
   MY_SCOPE_GUARD(stringsFileGuard, bind(&FileWriter::DeleteFileX, stringsFilePath));
 
   CategoriesHolder categoriesHolder(platform.GetReader(SEARCH_CATEGORIES_FILE_NAME));
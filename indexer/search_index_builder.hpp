@@ -2,6 +2,7 @@
 
 #include "std/string.hpp"
 
+class CategoriesHolder;
 class FilesContainerR;
 class Writer;
 
@@ -9,6 +10,11 @@ namespace indexer
 {
 bool BuildSearchIndexFromDatFile(string const & fName, bool forceRebuild = false);
 
+// Same as above, but with categories loaded by the caller, e.g. once for many files,
+// and with the number of threads sorting strings.
+bool BuildSearchIndexFromDatFile(string const & fName, CategoriesHolder const & catHolder,
+                                 bool forceRebuild, size_t sortThreadsCount);
+
 bool AddCompresedSearchIndexSection(string const & fName, bool forceRebuild);
 
 void BuildCompressedSearchIndex(FilesContainerR & container, Writer & indexWriter);
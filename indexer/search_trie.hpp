@@ -2,6 +2,7 @@
 
 #include "indexer/geometry_serialization.hpp"
 
+#include "coding/flat_trie.hpp"
 #include "coding/reader.hpp"
 #include "coding/trie.hpp"
 #include "coding/trie_reader.hpp"
@@ -51,6 +52,8 @@ public:
 using TEdgeValueReader = EmptyValueReader;
 using DefaultIterator =
     trie::Iterator<trie::ValueReader::ValueType, trie::TEdgeValueReader::ValueType>;
+using DefaultFlatTrie =
+    trie::FlatTrie<trie::ValueReader::ValueType, trie::TEdgeValueReader::ValueType>;
 
 inline serial::CodingParams GetCodingParams(serial::CodingParams const & orig)
 {
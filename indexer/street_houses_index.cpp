@@ -0,0 +1,204 @@
+#include "indexer/street_houses_index.hpp"
+
+#include "indexer/feature_impl.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "defines.hpp"
+
+#include "geometry/distance.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/writer.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+
+namespace feature
+{
+StreetHousesIndex::StreetHousesIndex(ModelReaderPtr const & reader,
+                                     serial::CodingParams const & cp)
+  : m_reader(reader), m_cp(cp)
+{
+  ReaderSource<ModelReaderPtr> src(m_reader);
+  m_maxOffsetMeters = ReadPrimitiveFromSource<uint32_t>(src);
+  uint32_t const count = ReadPrimitiveFromSource<uint32_t>(src);
+  m_streets.resize(count);
+  for (auto & street : m_streets)
+  {
+    street.first = ReadPrimitiveFromSource<uint32_t>(src);
+    street.second = ReadPrimitiveFromSource<uint32_t>(src);
+  }
+  m_blocksOffset = src.Pos();
+}
+
+// static
+unique_ptr<StreetHousesIndex> StreetHousesIndex::Load(FilesContainerR const & cont,
+                                                      serial::CodingParams const & cp)
+{
+  if (!cont.IsExist(STREET_HOUSES_FILE_TAG))
+    return unique_ptr<StreetHousesIndex>();
+  return unique_ptr<StreetHousesIndex>(
+      new StreetHousesIndex(cont.GetReader(STREET_HOUSES_FILE_TAG), cp));
+}
+}  // namespace feature
+
+namespace indexer
+{
+namespace
+{
+struct HouseInfo
+{
+  uint32_t m_index;
+  string m_number;
+  m2::PointD m_point;
+};
+
+struct StreetInfo
+{
+  uint32_t m_index;
+  vector<m2::PointD> m_points;
+};
+
+double GetDistanceToStreet(m2::PointD const & pt,
+                           vector<m2::ProjectionToSection<m2::PointD>> const & sections)
+{
+  double res = numeric_limits<double>::max();
+  for (auto const & section : sections)
+    res = min(res, MercatorBounds::DistanceOnEarth(pt, section(pt)));
+  return res;
+}
+}  // namespace
+
+void BuildStreetHousesIndex(FeaturesVector const & features, serial::CodingParams const & cp,
+                            uint32_t maxOffsetMeters, Writer & writer)
+{
+  // Same criteria as HouseDetector uses for streets and houses.
+  vector<HouseInfo> houses;
+  vector<StreetInfo> streets;
+  m4::Tree<uint32_t> housesTree;
+
+  features.ForEach([&](FeatureType & ft, uint32_t index)
+  {
+    if (ft.GetFeatureType() == feature::GEOM_LINE)
+    {
+      string name;
+      if (!ftypes::IsStreetChecker::Instance()(ft) ||
+          !ft.GetName(FeatureType::DEFAULT_LANG, name))
+        return;
+
+      StreetInfo street;
+      street.m_index = index;
+      ft.ForEachPoint([&street](m2::PointD const & p) { street.m_points.push_back(p); },
+                      FeatureType::BEST_GEOMETRY);
+      if (street.m_points.size() > 1)
+        streets.push_back(move(street));
+      return;
+    }
+
+    string const number = ft.GetHouseNumber();
+    if (!ftypes::IsBuildingChecker::Instance()(ft) || !feature::IsHouseNumber(number))
+      return;
+
+    m2::PointD const pt = ft.GetLimitRect(FeatureType::BEST_GEOMETRY).Center();
+    housesTree.Add(static_cast<uint32_t>(houses.size()), m2::RectD(pt, pt));
+    houses.push_back({index, number, pt});
+  });
+
+  sort(streets.begin(), streets.end(), [](StreetInfo const & s1, StreetInfo const & s2)
+  {
+    return s1.m_index < s2.m_index;
+  });
+
+  // Every street is written, even without houses: a street absent in the index means
+  // that it should be processed with geometry lookup.
+  vector<pair<uint32_t, uint32_t>> table;
+  vector<char> blocks;
+  MemWriter<vector<char>> blocksWriter(blocks);
+  size_t housesCount = 0;
+
+  vector<m2::ProjectionToSection<m2::PointD>> sections;
+  vector<uint32_t> streetHouses;
+  for (StreetInfo const & street : streets)
+  {
+    m2::RectD rect;
+    sections.resize(street.m_points.size() - 1);
+    for (size_t i = 0; i < street.m_points.size(); ++i)
+    {
+      rect.Add(MercatorBounds::RectByCenterXYAndSizeInMeters(street.m_points[i], maxOffsetMeters));
+      if (i + 1 < street.m_points.size())
+        sections[i].SetBounds(street.m_points[i], street.m_points[i + 1]);
+    }
+
+    streetHouses.clear();
+    housesTree.ForEachInRect(rect, [&](uint32_t i)
+    {
+      if (GetDistanceToStreet(houses[i].m_point, sections) <= maxOffsetMeters)
+        streetHouses.push_back(i);
+    });
+    sort(streetHouses.begin(), streetHouses.end());
+
+    table.emplace_back(street.m_index, static_cast<uint32_t>(blocks.size()));
+    WriteVarUint(blocksWriter, static_cast<uint32_t>(streetHouses.size()));
+    for (uint32_t i : streetHouses)
+    {
+      HouseInfo const & house = houses[i];
+      WriteVarUint(blocksWriter, house.m_index);
+      serial::SavePoint(blocksWriter, house.m_point, cp);
+      WriteVarUint(blocksWriter, static_cast<uint32_t>(house.m_number.size()));
+      blocksWriter.Write(house.m_number.data(), house.m_number.size());
+    }
+    housesCount += streetHouses.size();
+  }
+
+  WriteToSink(writer, maxOffsetMeters);
+  WriteToSink(writer, static_cast<uint32_t>(table.size()));
+  for (auto const & street : table)
+  {
+    WriteToSink(writer, street.first);
+    WriteToSink(writer, street.second);
+  }
+  writer.Write(blocks.data(), blocks.size());
+
+  LOG(LINFO, ("Street houses index: streets =", streets.size(), "houses =", houses.size(),
+              "links =", housesCount));
+}
+
+bool BuildStreetHousesIndexFromDatFile(string const & datFile, uint32_t maxOffsetMeters)
+{
+  LOG(LINFO, ("Start building street houses index for", datFile));
+  my::Timer timer;
+
+  try
+  {
+    vector<char> buffer;
+    {
+      FeaturesVectorTest features(datFile);
+      MemWriter<vector<char>> writer(buffer);
+      BuildStreetHousesIndex(features.GetVector(), features.GetHeader().GetDefCodingParams(),
+                             maxOffsetMeters, writer);
+    }
+
+    FilesContainerW(datFile, FileWriter::OP_WRITE_EXISTING).Write(buffer, STREET_HOUSES_FILE_TAG);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading file:", e.Msg()));
+    return false;
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Error writing street houses index:", e.Msg()));
+    return false;
+  }
+
+  LOG(LINFO, ("End building street houses index, elapsed", timer.ElapsedSeconds(), "s"));
+  return true;
+}
+}  // namespace indexer
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "indexer/coding_params.hpp"
+#include "indexer/geometry_serialization.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+class FeaturesVector;
+class Writer;
+
+namespace feature
+{
+/// Street-houses adjacency section of an mwm (STREET_HOUSES_FILE_TAG).
+///
+/// For every named street it keeps the buildings with house numbers whose centers are
+/// not farther than GetMaxOffsetMeters() from the street, so house detection does not
+/// need to read all the features around the street.
+///
+/// Format:
+/// [uint32 maxOffsetMeters] [uint32 streetsCount]
+/// [uint32 streetIndex, uint32 blockOffset] * streetsCount, sorted by streetIndex
+/// [block] * streetsCount: [vu housesCount] [vu houseIndex, point, vu size, number] * housesCount
+class StreetHousesIndex
+{
+public:
+  struct House
+  {
+    uint32_t m_featureIndex;
+    string m_number;
+    m2::PointD m_point;
+  };
+
+  StreetHousesIndex(ModelReaderPtr const & reader, serial::CodingParams const & cp);
+
+  /// @return Nullptr if the container has no section.
+  static unique_ptr<StreetHousesIndex> Load(FilesContainerR const & cont,
+                                            serial::CodingParams const & cp);
+
+  inline uint32_t GetMaxOffsetMeters() const { return m_maxOffsetMeters; }
+  inline size_t GetStreetsCount() const { return m_streets.size(); }
+
+  /// Calls toDo(House const &) for every house of the street.
+  /// @return false if the street is not in the index.
+  template <class ToDo>
+  bool ForEachHouse(uint32_t streetIndex, ToDo && toDo) const
+  {
+    auto const it = lower_bound(m_streets.begin(), m_streets.end(),
+                                make_pair(streetIndex, uint32_t(0)));
+    if (it == m_streets.end() || it->first != streetIndex)
+      return false;
+
+    uint64_t const begin = m_blocksOffset + it->second;
+    uint64_t const end =
+        (it + 1 == m_streets.end()) ? m_reader.Size() : m_blocksOffset + (it + 1)->second;
+    ReaderSource<ModelReaderPtr> src(m_reader.SubReader(begin, end - begin));
+
+    House house;
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      house.m_featureIndex = ReadVarUint<uint32_t>(src);
+      house.m_point = serial::LoadPoint(src, m_cp);
+      house.m_number.resize(ReadVarUint<uint32_t>(src));
+      src.Read(&house.m_number[0], house.m_number.size());
+      toDo(static_cast<House const &>(house));
+    }
+    return true;
+  }
+
+private:
+  ModelReaderPtr m_reader;
+  serial::CodingParams m_cp;
+  uint32_t m_maxOffsetMeters;
+  uint64_t m_blocksOffset;
+  // Pairs of street feature index and offset of its block.
+  vector<pair<uint32_t, uint32_t>> m_streets;
+};
+}  // namespace feature
+
+namespace indexer
+{
+/// Default max distance from a house to its street, it is the default offset
+/// of search::HouseDetector::ReadAllHouses().
+uint32_t constexpr kStreetHousesMaxOffsetMeters = 200;
+
+void BuildStreetHousesIndex(FeaturesVector const & features, serial::CodingParams const & cp,
+                            uint32_t maxOffsetMeters, Writer & writer);
+
+bool BuildStreetHousesIndexFromDatFile(string const & datFile,
+                                       uint32_t maxOffsetMeters = kStreetHousesMaxOffsetMeters);
+}  // namespace indexer
@@ -3,16 +3,19 @@
 #include "coding/file_writer.hpp"
 #include "coding/file_reader.hpp"
 
+#include "base/fork_join_pool.hpp"
 #include "base/macros.hpp"
 #include "base/mem_trie.hpp"
 #include "base/string_utils.hpp"
 #include "base/worker_thread.hpp"
 
 #include "coding/read_write_utils.hpp"
+#include "std/algorithm.hpp"
 #include "std/iterator_facade.hpp"
 #include "std/queue.hpp"
 #include "std/functional.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 template <typename TValue>
 class StringsFile
@@ -103,43 +106,59 @@ public:
     /// \param writer A writer that will be used to write strings.
     /// \param offsets A list of offsets [begin, end) that denote
     ///                groups of sorted strings in a file.  When strings will be
-    ///                sorted and dumped on a disk, a pair of offsets will be added
-    ///                to the list.
+    ///                sorted and dumped on a disk, a pair of offsets per every
+    ///                slice sorted by the pool will be added to the list.
     /// \param strings Vector of strings that should be sorted. Internal data is moved out from
     ///                strings, so it'll become empty after ctor.
-    SortAndDumpStringsTask(FileWriter & writer, OffsetsListT & offsets, StringsListT & strings)
-        : m_writer(writer), m_offsets(offsets)
+    /// \param pool A pool which sorts slices of strings in parallel.
+    SortAndDumpStringsTask(FileWriter & writer, OffsetsListT & offsets, StringsListT & strings,
+                           threads::ForkJoinPool & pool)
+        : m_writer(writer), m_offsets(offsets), m_pool(pool)
     {
       strings.swap(m_strings);
     }
 
-    /// Sorts strings via in-memory trie and writes them.
+    /// Sorts slices of strings via in-memory tries and writes them.
     void operator()()
     {
-      vector<uint8_t> memBuffer;
+      size_t const slicesCount =
+          max(size_t(1), min(m_pool.GetThreadsCount(), m_strings.size() / kMinSliceSize));
+      size_t const sliceSize = (m_strings.size() + slicesCount - 1) / slicesCount;
+      vector<vector<uint8_t>> memBuffers(slicesCount);
+      m_pool.ForEach(slicesCount, [&](size_t i)
       {
         my::MemTrie<strings::UniString, ValueT> trie;
-        for (auto const & s : m_strings)
-          trie.Add(s.GetString(), s.GetValue());
-        MemWriter<vector<uint8_t>> memWriter(memBuffer);
+        size_t const end = min(m_strings.size(), (i + 1) * sliceSize);
+        for (size_t j = i * sliceSize; j < end; ++j)
+          trie.Add(m_strings[j].GetString(), m_strings[j].GetValue());
+        MemWriter<vector<uint8_t>> memWriter(memBuffers[i]);
         trie.ForEach([&memWriter](const strings::UniString & s, const ValueT & v)
                      {
                        rw::Write(memWriter, s);
                        v.Write(memWriter);
                      });
-      }
+      });
 
-      uint64_t const spos = m_writer.Pos();
-      m_writer.Write(memBuffer.data(), memBuffer.size());
-      uint64_t const epos = m_writer.Pos();
-      m_offsets.push_back(make_pair(spos, epos));
+      for (auto const & memBuffer : memBuffers)
+      {
+        if (memBuffer.empty())
+          continue;
+        uint64_t const spos = m_writer.Pos();
+        m_writer.Write(memBuffer.data(), memBuffer.size());
+        uint64_t const epos = m_writer.Pos();
+        m_offsets.push_back(make_pair(spos, epos));
+      }
       m_writer.Flush();
     }
 
   private:
+    // Smaller slices aren't worth a separate sorted portion.
+    static size_t constexpr kMinSliceSize = 10000;
+
     FileWriter & m_writer;
     OffsetsListT & m_offsets;
     StringsListT m_strings;
+    threads::ForkJoinPool & m_pool;
 
     DISALLOW_COPY_AND_MOVE(SortAndDumpStringsTask);
   };
@@ -165,7 +184,9 @@ public:
     void increment();
   };
 
-  StringsFile(string const & fPath);
+  /// \param threadsCount Number of threads sorting portions of strings, 0 means
+  ///                     that strings are sorted on the single worker thread.
+  StringsFile(string const & fPath, size_t threadsCount = 0);
 
   void EndAdding();
   void OpenForRead();
@@ -186,6 +207,8 @@ private:
   StringsListT m_strings;
   OffsetsListT m_offsets;
 
+  threads::ForkJoinPool m_sortPool;
+
   // A worker thread that sorts and writes groups of strings.  The
   // whole process looks like a pipeline, i.e. main thread accumulates
   // strings while worker thread sequentially sorts and stores groups
@@ -205,6 +228,9 @@ private:
   priority_queue<QValue, vector<QValue>, greater<QValue>> m_queue;
 };
 
+template <typename ValueT>
+size_t constexpr StringsFile<ValueT>::SortAndDumpStringsTask::kMinSliceSize;
+
 template <typename ValueT>
 void StringsFile<ValueT>::AddString(TString const & s)
 {
@@ -242,8 +268,8 @@ void StringsFile<ValueT>::IteratorT::increment()
 }
 
 template <typename ValueT>
-StringsFile<ValueT>::StringsFile(string const & fPath)
-    : m_workerThread(1 /* maxTasks */)
+StringsFile<ValueT>::StringsFile(string const & fPath, size_t threadsCount)
+    : m_sortPool(threadsCount), m_workerThread(1 /* maxTasks */)
 {
   m_writer.reset(new FileWriter(fPath));
 }
@@ -252,7 +278,7 @@ template <typename ValueT>
 void StringsFile<ValueT>::Flush()
 {
   shared_ptr<SortAndDumpStringsTask> task(
-      new SortAndDumpStringsTask(*m_writer, m_offsets, m_strings));
+      new SortAndDumpStringsTask(*m_writer, m_offsets, m_strings, m_sortPool));
   m_workerThread.Push(task);
 }
 
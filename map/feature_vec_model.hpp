@@ -91,6 +91,13 @@ class FeaturesFetcher : public Index::Observer
     {
       m_multiIndex.ReadFeatures(toDo, features);
     }
+
+    template <class ToDo>
+    void ReadFeatures(ToDo & toDo, vector<FeatureID> const & features, FeaturesCache & cache,
+                      int scale) const
+    {
+      m_multiIndex.ReadFeatures(toDo, features, cache, scale);
+    }
     //@}
 
     Index const & GetIndex() const { return m_multiIndex; }
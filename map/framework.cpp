@@ -6,6 +6,7 @@
 
 #include "defines.hpp"
 
+#include "routing/cross_mwm_cache.hpp"
 #include "routing/online_absent_fetcher.hpp"
 #include "routing/osrm_router.hpp"
 #include "routing/road_graph_router.hpp"
@@ -92,6 +93,9 @@ namespace
   static const int kKeepPedestrianDistanceMeters = 10000;
   char const kRouterTypeKey[] = "router";
   char const kMapStyleKey[] = "MapStyleKeyV1";
+  char const kCrossMwmCacheFile[] = "cross_mwm_cache.bin";
+  // Budget of decoded features of the renderer.
+  size_t const kFeaturesCacheSize = 16 * 1024 * 1024;
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> Framework::RegisterMap(
@@ -227,6 +231,7 @@ Framework::Framework()
 
   m_model.InitClassificator();
   m_model.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
+  m_drapeFeaturesCache.SetMaxBytes(kFeaturesCacheSize);
   LOG(LDEBUG, ("Classificator initialized"));
 
 
@@ -263,6 +268,11 @@ Framework::Framework()
 //#endif
   m_routingSession.Init(routingStatisticsFn, routingVisualizerFn);
 
+  // Border crossings found in the previous sessions.
+  string const crossMwmCachePath = GetPlatform().WritablePathForFile(kCrossMwmCacheFile);
+  if (GetPlatform().IsFileExistsByFullPath(crossMwmCachePath))
+    routing::CrossMwmCache::Instance().Load(crossMwmCachePath);
+
   SetRouterImpl(RouterType::Vehicle);
 
   LOG(LDEBUG, ("Routing engine initialized"));
@@ -427,6 +437,7 @@ void Framework::UpdateLatestCountryFile(LocalCountryFile const & localFile)
 
 void Framework::OnMapDeregistered(platform::LocalCountryFile const & localFile)
 {
+  m_drapeFeaturesCache.ClearDeregistered();
   m_storage.DeleteCustomCountryVersion(localFile);
 }
 
@@ -905,6 +916,13 @@ void Framework::EnterBackground()
   ClearAllCaches();
 #endif
 
+  // Saving may take a while, so it doesn't block the UI thread.
+  string const crossMwmCachePath = GetPlatform().WritablePathForFile(kCrossMwmCacheFile);
+  GetPlatform().RunAsync([crossMwmCachePath]()
+  {
+    routing::CrossMwmCache::Instance().Save(crossMwmCachePath);
+  }, Platform::EPriorityBackground);
+
   if (m_drapeEngine != nullptr)
     m_drapeEngine->SetRenderingEnabled(false);
 }
@@ -943,7 +961,8 @@ void Framework::InitSearchEngine()
   {
     m_searchEngine.reset(new search::Engine(
         const_cast<Index &>(m_model.GetIndex()), platform.GetReader(SEARCH_CATEGORIES_FILE_NAME),
-        *m_infoGetter, languages::GetCurrentOrig(), make_unique<search::SearchQueryFactory>()));
+        *m_infoGetter, languages::GetCurrentOrig(), make_unique<search::SearchQueryFactory>(),
+        0 /* numConcurrentQueries */, platform.CpuCores()));
   }
   catch (RootException const & e)
   {
@@ -1216,9 +1235,9 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::OGLContextFactory> contextFactory,
     m_model.ForEachFeatureID(r, fn, scale);
   };
 
-  TReadFeaturesFn featureReadFn = [this](df::MapDataProvider::TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids) -> void
+  TReadFeaturesFn featureReadFn = [this](df::MapDataProvider::TReadCallback<FeatureType> const & fn, vector<FeatureID> const & ids, int scale) -> void
   {
-    m_model.ReadFeatures(fn, ids);
+    m_model.ReadFeatures(fn, ids, m_drapeFeaturesCache, scale);
   };
 
   TUpdateCountryIndexFn updateCountryIndex = [this](storage::TIndex const & currentIndex, m2::PointF const & pt)
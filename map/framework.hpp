@@ -107,6 +107,8 @@ protected:
   search::QuerySaver m_searchQuerySaver;
 
   model::FeaturesFetcher m_model;
+  // Decoded features of tiles, which are read by the renderer again and again.
+  FeaturesCache m_drapeFeaturesCache;
   ScreenBase m_currentModelView;
 
   routing::RoutingSession m_routingSession;
@@ -2,6 +2,7 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
+#include "indexer/drawing_rules.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/feature_data.hpp"
 #include "indexer/map_style_reader.hpp"
@@ -66,6 +67,54 @@ using namespace feature;
 namespace
 {
 
+class DoCheckRulesTable
+{
+  drule::RulesHolder const & m_holder;
+
+public:
+  DoCheckRulesTable(drule::RulesHolder const & holder) : m_holder(holder) {}
+
+  void operator() (ClassifObject const * p, uint32_t type) const
+  {
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      for (int geomType = GEOM_POINT; geomType <= GEOM_AREA; ++geomType)
+      {
+        drule::KeysT keys;
+        p->GetSuitable(scale, EGeomType(geomType), keys);
+
+        size_t i = 0;
+        m_holder.GetTable().ForEachRule(type, scale, EGeomType(geomType),
+                                        [&](drule::RulesTable::Rule const & rule)
+        {
+          TEST_LESS(i, keys.size(), (type, scale, geomType));
+          TEST(rule.m_key == keys[i], (type, scale, geomType));
+          TEST_EQUAL(rule.m_key.m_priority, keys[i].m_priority, (type, scale, geomType));
+          TEST_EQUAL(rule.m_rule, m_holder.Find(keys[i]), (type, scale, geomType));
+          ++i;
+        });
+        TEST_EQUAL(i, keys.size(), (type, scale, geomType));
+      }
+    }
+  }
+};
+
+}  // namespace
+
+UNIT_TEST(Classificator_RulesTable)
+{
+  RunForEveryMapStyle([]()
+  {
+    classificator::Load();
+
+    DoCheckRulesTable doCheck(drule::rules());
+    classif().ForEachTree(doCheck);
+  });
+}
+
+namespace
+{
+
 class DoCheckStyles
 {
   Classificator const & m_c;
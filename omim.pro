@@ -93,6 +93,10 @@ SUBDIRS = 3party base coding geometry indexer routing
     indexer_tests.depends = 3party base coding geometry indexer
     SUBDIRS *= indexer_tests
 
+    indexer_benchmarks.subdir = indexer/indexer_benchmarks
+    indexer_benchmarks.depends = 3party base coding geometry platform indexer
+    SUBDIRS *= indexer_benchmarks
+
     platform_tests.subdir = platform/platform_tests
     platform_tests.depends = 3party base coding platform platform_tests_support
     SUBDIRS *= platform_tests
@@ -136,6 +140,10 @@ SUBDIRS = 3party base coding geometry indexer routing
     routing_consistency_tests.depends = $$MapDepLibs routing
     SUBDIRS *= routing_consistency_tests
 
+    routing_benchmarks.subdir = routing/routing_benchmarks
+    routing_benchmarks.depends = $$MapDepLibs routing
+    SUBDIRS *= routing_benchmarks
+
     # TODO(AlexZ): Move pedestrian tests into routing dir.
     pedestrian_routing_tests.depends = $$MapDepLibs routing
     SUBDIRS *= pedestrian_routing_tests
@@ -161,5 +169,9 @@ SUBDIRS = 3party base coding geometry indexer routing
     drape_frontend_tests.subdir = drape_frontend/drape_frontend_tests
     drape_frontend_tests.depends = 3party base coding platform drape drape_frontend
     SUBDIRS *= drape_frontend_tests
+
+    drape_frontend_benchmarks.subdir = drape_frontend/drape_frontend_benchmarks
+    drape_frontend_benchmarks.depends = 3party base coding geometry platform storage indexer drape_frontend
+    SUBDIRS *= drape_frontend_benchmarks
   } # !no-tests
 } # !gtool
@@ -0,0 +1,456 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/cstdint.hpp"
+#include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/queue.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+
+// LandmarksTable keeps distances between a few landmark vertices and all vertices of
+// a strongly connected part of a graph. It's used by the ALT (A*, Landmarks, Triangle
+// inequality) heuristic: for any landmark L and vertices v, w
+//   d(v, w) >= d(L, w) - d(L, v) and d(v, w) >= d(v, L) - d(w, L).
+// Refer to http://research.microsoft.com/pubs/154937/soda05.pdf for more information.
+//
+// Distances are integers in units of the table. They are distances in the graph where
+// the weight of every edge is rounded down to the units, so the bounds are admissible and
+// the heuristic stays consistent: |d(L, v) - d(L, u)| <= floor(w(u, v) / unit) * unit.
+template <typename TVertex>
+class LandmarksTable
+{
+public:
+  using TDistance = uint32_t;
+
+  static TDistance constexpr kInfiniteDistance = numeric_limits<TDistance>::max();
+
+  // Returns the weight rounded down to the units.
+  static uint64_t ToUnits(double weight, double unit)
+  {
+    ASSERT_GREATER(unit, 0.0, ());
+    return static_cast<uint64_t>(floor(weight / unit));
+  }
+
+  // Distances are stored row by row: for the i-th vertex from[i * landmarksCount + j]
+  // is the distance from the j-th landmark to the vertex and to[i * landmarksCount + j]
+  // is the distance from the vertex to the j-th landmark.
+  // @vertices must be sorted and must not contain duplicates.
+  void Set(double unit, vector<TVertex> && landmarks, vector<TVertex> && vertices,
+           vector<TDistance> && from, vector<TDistance> && to)
+  {
+    ASSERT_GREATER(unit, 0.0, ());
+    ASSERT(is_sorted(vertices.begin(), vertices.end()), ());
+    ASSERT_EQUAL(from.size(), landmarks.size() * vertices.size(), ());
+    ASSERT_EQUAL(to.size(), landmarks.size() * vertices.size(), ());
+
+    m_unit = unit;
+    m_landmarks = move(landmarks);
+    m_vertices = move(vertices);
+    m_from = move(from);
+    m_to = move(to);
+  }
+
+  void Clear()
+  {
+    m_landmarks.clear();
+    m_vertices.clear();
+    m_from.clear();
+    m_to.clear();
+  }
+
+  inline bool IsEmpty() const { return m_landmarks.empty(); }
+
+  inline double GetUnit() const { return m_unit; }
+  inline size_t GetLandmarksCount() const { return m_landmarks.size(); }
+  inline vector<TVertex> const & GetLandmarks() const { return m_landmarks; }
+  inline vector<TVertex> const & GetVertices() const { return m_vertices; }
+  inline vector<TDistance> const & GetFromDistances() const { return m_from; }
+  inline vector<TDistance> const & GetToDistances() const { return m_to; }
+
+  // Returns false if the vertex is not covered by the table. Otherwise
+  // |from| and |to| point to GetLandmarksCount() distances from/to landmarks.
+  bool GetDistances(TVertex const & v, TDistance const *& from, TDistance const *& to) const
+  {
+    auto const it = lower_bound(m_vertices.begin(), m_vertices.end(), v);
+    if (it == m_vertices.end() || !(*it == v))
+      return false;
+    size_t const offset = distance(m_vertices.begin(), it) * m_landmarks.size();
+    from = &m_from[offset];
+    to = &m_to[offset];
+    return true;
+  }
+
+  // Returns the lower bound of the distance from v to w by rows of distances.
+  double GetLowerBound(TDistance const * fromV, TDistance const * toV, TDistance const * fromW,
+                       TDistance const * toW) const
+  {
+    int64_t bound = 0;
+    for (size_t i = 0; i < m_landmarks.size(); ++i)
+    {
+      bound = max(bound, static_cast<int64_t>(fromW[i]) - fromV[i]);
+      bound = max(bound, static_cast<int64_t>(toV[i]) - toW[i]);
+    }
+    return bound * m_unit;
+  }
+
+private:
+  double m_unit = 1.0;
+  vector<TVertex> m_landmarks;
+  vector<TVertex> m_vertices;
+  vector<TDistance> m_from;
+  vector<TDistance> m_to;
+};
+
+template <typename TVertex>
+typename LandmarksTable<TVertex>::TDistance constexpr LandmarksTable<TVertex>::kInfiniteDistance;
+
+namespace landmarks
+{
+// Finds distances in units, weights of edges are rounded down to the units.
+template <typename TGraph>
+void FindDistances(TGraph const & graph, typename TGraph::TVertexType const & source, bool forward,
+                   double unit, map<typename TGraph::TVertexType, uint64_t> & dist)
+{
+  using TVertexType = typename TGraph::TVertexType;
+  using TEdgeType = typename TGraph::TEdgeType;
+  using TState = pair<uint64_t, TVertexType>;
+
+  dist.clear();
+  priority_queue<TState, vector<TState>, greater<TState>> queue;
+
+  dist[source] = 0;
+  queue.emplace(0, source);
+
+  vector<TEdgeType> adj;
+  while (!queue.empty())
+  {
+    TState const state = queue.top();
+    queue.pop();
+
+    if (state.first > dist[state.second])
+      continue;
+
+    if (forward)
+      graph.GetOutgoingEdgesList(state.second, adj);
+    else
+      graph.GetIngoingEdgesList(state.second, adj);
+
+    for (auto const & edge : adj)
+    {
+      uint64_t const newDist =
+          state.first + LandmarksTable<TVertexType>::ToUnits(edge.GetWeight(), unit);
+      auto const it = dist.find(edge.GetTarget());
+      if (it != dist.end() && it->second <= newDist)
+        continue;
+      dist[edge.GetTarget()] = newDist;
+      queue.emplace(newDist, edge.GetTarget());
+    }
+  }
+}
+}  // namespace landmarks
+
+// Builds landmarks for the strongly connected part of the graph which contains |seed|.
+// Landmarks are chosen by the "farthest" strategy: every next landmark is the vertex
+// with the maximum round-trip distance to the nearest of already chosen landmarks.
+// Distances are in |unit|s of edge weights. Memory usage of the table is
+// (sizeof(TVertex) + 2 * landmarksCount * sizeof(uint32_t)) bytes per vertex.
+template <typename TGraph>
+void BuildLandmarks(TGraph const & graph, typename TGraph::TVertexType const & seed,
+                    size_t landmarksCount, double unit,
+                    LandmarksTable<typename TGraph::TVertexType> & table)
+{
+  using TVertexType = typename TGraph::TVertexType;
+  using TDistance = typename LandmarksTable<TVertexType>::TDistance;
+
+  table.Clear();
+  if (landmarksCount == 0)
+    return;
+
+  map<TVertexType, uint64_t> forward;
+  map<TVertexType, uint64_t> backward;
+  landmarks::FindDistances(graph, seed, true /* forward */, unit, forward);
+  landmarks::FindDistances(graph, seed, false /* forward */, unit, backward);
+
+  vector<TVertexType> vertices;
+  vector<uint64_t> nearest;
+  for (auto const & p : forward)
+  {
+    auto const it = backward.find(p.first);
+    if (it == backward.end())
+      continue;
+    vertices.push_back(p.first);
+    nearest.push_back(p.second + it->second);
+  }
+
+  size_t const verticesCount = vertices.size();
+  vector<TVertexType> chosen;
+  vector<vector<TDistance>> from;
+  vector<vector<TDistance>> to;
+
+  while (chosen.size() < landmarksCount)
+  {
+    auto const farthest = max_element(nearest.begin(), nearest.end());
+    if (farthest == nearest.end() || *farthest == 0)
+      break;
+
+    TVertexType const landmark = vertices[distance(nearest.begin(), farthest)];
+    landmarks::FindDistances(graph, landmark, true /* forward */, unit, forward);
+    landmarks::FindDistances(graph, landmark, false /* forward */, unit, backward);
+
+    from.emplace_back(verticesCount);
+    to.emplace_back(verticesCount);
+    for (size_t i = 0; i < verticesCount; ++i)
+    {
+      // All vertices are in the same strongly connected component.
+      uint64_t const fromDist = forward.at(vertices[i]);
+      uint64_t const toDist = backward.at(vertices[i]);
+      CHECK_LESS(max(fromDist, toDist), LandmarksTable<TVertexType>::kInfiniteDistance,
+                 ("Too small unit of distances:", unit));
+      from.back()[i] = static_cast<TDistance>(fromDist);
+      to.back()[i] = static_cast<TDistance>(toDist);
+      nearest[i] = min(nearest[i], fromDist + toDist);
+    }
+    chosen.push_back(landmark);
+  }
+
+  if (chosen.empty())
+    return;
+
+  size_t const count = chosen.size();
+  vector<TDistance> fromRows(verticesCount * count);
+  vector<TDistance> toRows(verticesCount * count);
+  for (size_t i = 0; i < verticesCount; ++i)
+  {
+    for (size_t j = 0; j < count; ++j)
+    {
+      fromRows[i * count + j] = from[j][i];
+      toRows[i * count + j] = to[j][i];
+    }
+  }
+
+  table.Set(unit, move(chosen), move(vertices), move(fromRows), move(toRows));
+}
+
+// AStarLandmarksGraph is a wrapper around a graph which may be used with AStarAlgorithm.
+// Its heuristic is the maximum of the wrapped graph heuristic and the landmarks lower bound,
+// both are consistent, so is the maximum. Note that the bidirectional algorithm uses
+// HeuristicCostEstimate(v, s) as an estimate of the distance from s to v, so the wrapped
+// graph must be symmetric to be used with FindPathBidirectional.
+//
+// The search is restricted to vertices covered by the table, to start and final vertices and
+// to extra vertices (e.g. temporary ones around start and final). Edges to other vertices
+// are skipped. A path through a skipped edge may be shorter than the found one only if
+// it is shorter than GetSkippedPathsLowerBound().
+template <typename TGraph>
+class AStarLandmarksGraph
+{
+public:
+  using TVertexType = typename TGraph::TVertexType;
+  using TEdgeType = typename TGraph::TEdgeType;
+  using TLandmarks = LandmarksTable<TVertexType>;
+  using TDistance = typename TLandmarks::TDistance;
+
+  // Distances of |extraVertices| and of |startVertex| and |finalVertex| (if they are not covered)
+  // are derived from the adjacent vertices. Extra vertices which can't be connected
+  // to the covered ones in both directions are skipped.
+  AStarLandmarksGraph(TGraph const & graph, TLandmarks const & landmarks,
+                      TVertexType const & startVertex, TVertexType const & finalVertex,
+                      vector<TVertexType> const & extraVertices = vector<TVertexType>())
+    : m_graph(graph)
+    , m_landmarks(landmarks)
+    , m_startVertex(startVertex)
+    , m_finalVertex(finalVertex)
+    , m_skippedPathsLowerBound(numeric_limits<double>::infinity())
+  {
+    vector<TVertexType> vertices = extraVertices;
+    vertices.push_back(startVertex);
+    vertices.push_back(finalVertex);
+    AddExtraVertices(vertices);
+  }
+
+  void GetOutgoingEdgesList(TVertexType const & v, vector<TEdgeType> & adj) const
+  {
+    m_graph.GetOutgoingEdgesList(v, adj);
+    RemoveUncovered(v, true /* outgoing */, adj);
+  }
+
+  void GetIngoingEdgesList(TVertexType const & v, vector<TEdgeType> & adj) const
+  {
+    m_graph.GetIngoingEdgesList(v, adj);
+    RemoveUncovered(v, false /* outgoing */, adj);
+  }
+
+  double HeuristicCostEstimate(TVertexType const & v, TVertexType const & w) const
+  {
+    double const estimate = m_graph.HeuristicCostEstimate(v, w);
+
+    TDistance const * fromV = nullptr;
+    TDistance const * toV = nullptr;
+    TDistance const * fromW = nullptr;
+    TDistance const * toW = nullptr;
+    if (!GetDistances(v, fromV, toV) || !GetDistances(w, fromW, toW))
+      return estimate;
+    return max(estimate, m_landmarks.GetLowerBound(fromV, toV, fromW, toW));
+  }
+
+  // Takes into account the |from| -> |to| edge which is skipped by the search.
+  // Distances of the table are not bounds for paths which leave the covered part of
+  // the graph, so only the wrapped graph heuristic is used here.
+  void AddSkippedEdge(TVertexType const & from, TVertexType const & to, double weight) const
+  {
+    double const bound = m_graph.HeuristicCostEstimate(m_startVertex, from) + weight +
+                         m_graph.HeuristicCostEstimate(to, m_finalVertex);
+    m_skippedPathsLowerBound = min(m_skippedPathsLowerBound, bound);
+  }
+
+  // Returns the lower bound of lengths of paths from the start to the final vertex which
+  // go through skipped edges or infinity if no edge was skipped.
+  inline double GetSkippedPathsLowerBound() const { return m_skippedPathsLowerBound; }
+
+  inline bool HasSkippedEdges() const
+  {
+    return m_skippedPathsLowerBound != numeric_limits<double>::infinity();
+  }
+
+private:
+  struct Distances
+  {
+    vector<TDistance> m_from;
+    vector<TDistance> m_to;
+  };
+
+  bool GetDistances(TVertexType const & v, TDistance const *& from, TDistance const *& to) const
+  {
+    if (m_landmarks.GetDistances(v, from, to))
+      return true;
+    auto const it = m_extra.find(v);
+    if (it == m_extra.end())
+      return false;
+    from = it->second.m_from.data();
+    to = it->second.m_to.data();
+    return true;
+  }
+
+  bool IsCovered(TVertexType const & v) const
+  {
+    TDistance const * from = nullptr;
+    TDistance const * to = nullptr;
+    return GetDistances(v, from, to);
+  }
+
+  bool IsAllowed(TVertexType const & v) const
+  {
+    return v == m_startVertex || v == m_finalVertex || IsCovered(v);
+  }
+
+  // Edges may be not assignable, so the filtered list is built anew.
+  void RemoveUncovered(TVertexType const & v, bool outgoing, vector<TEdgeType> & adj) const
+  {
+    auto const isAllowed = [this](TEdgeType const & edge) { return IsAllowed(edge.GetTarget()); };
+    if (all_of(adj.begin(), adj.end(), isAllowed))
+      return;
+
+    vector<TEdgeType> allowed;
+    allowed.reserve(adj.size());
+    for (auto const & edge : adj)
+    {
+      if (isAllowed(edge))
+        allowed.push_back(edge);
+      else if (outgoing)
+        AddSkippedEdge(v, edge.GetTarget(), edge.GetWeight());
+      else
+        AddSkippedEdge(edge.GetTarget(), v, edge.GetWeight());
+    }
+    adj.swap(allowed);
+  }
+
+  // Calculates exact distances from/to landmarks for vertices which are adjacent to covered
+  // ones by Bellman-Ford relaxations. There are a few such vertices, usually.
+  void AddExtraVertices(vector<TVertexType> const & vertices)
+  {
+    size_t const count = m_landmarks.GetLandmarksCount();
+    TDistance const kInf = TLandmarks::kInfiniteDistance;
+
+    for (auto const & v : vertices)
+    {
+      TDistance const * from = nullptr;
+      TDistance const * to = nullptr;
+      if (m_landmarks.GetDistances(v, from, to) || m_extra.count(v) != 0)
+        continue;
+      Distances & distances = m_extra[v];
+      distances.m_from.assign(count, kInf);
+      distances.m_to.assign(count, kInf);
+    }
+
+    vector<TEdgeType> adj;
+    for (size_t pass = 0; pass <= m_extra.size(); ++pass)
+    {
+      bool updated = false;
+      for (auto & p : m_extra)
+      {
+        m_graph.GetIngoingEdgesList(p.first, adj);
+        for (auto const & edge : adj)
+          updated |= Relax(edge, p.second.m_from, true /* from */);
+
+        m_graph.GetOutgoingEdgesList(p.first, adj);
+        for (auto const & edge : adj)
+          updated |= Relax(edge, p.second.m_to, false /* from */);
+      }
+      if (!updated)
+        break;
+    }
+
+    for (auto it = m_extra.begin(); it != m_extra.end();)
+    {
+      Distances const & d = it->second;
+      bool const reachable =
+          all_of(d.m_from.begin(), d.m_from.end(), [kInf](TDistance x) { return x != kInf; }) &&
+          all_of(d.m_to.begin(), d.m_to.end(), [kInf](TDistance x) { return x != kInf; });
+      if (reachable)
+        ++it;
+      else
+        it = m_extra.erase(it);
+    }
+  }
+
+  // Weights are rounded down to units of the table like in BuildLandmarks.
+  bool Relax(TEdgeType const & edge, vector<TDistance> & distances, bool from)
+  {
+    TDistance const * fromU = nullptr;
+    TDistance const * toU = nullptr;
+    if (!GetDistances(edge.GetTarget(), fromU, toU))
+      return false;
+
+    TDistance const * const row = from ? fromU : toU;
+    uint64_t const weight = TLandmarks::ToUnits(edge.GetWeight(), m_landmarks.GetUnit());
+    bool updated = false;
+    for (size_t i = 0; i < distances.size(); ++i)
+    {
+      if (row[i] == TLandmarks::kInfiniteDistance)
+        continue;
+      uint64_t const d = row[i] + weight;
+      if (d < distances[i])
+      {
+        distances[i] = static_cast<TDistance>(d);
+        updated = true;
+      }
+    }
+    return updated;
+  }
+
+  TGraph const & m_graph;
+  TLandmarks const & m_landmarks;
+  TVertexType const m_startVertex;
+  TVertexType const m_finalVertex;
+  map<TVertexType, Distances> m_extra;
+  mutable double m_skippedPathsLowerBound;
+};
+
+}  // namespace routing
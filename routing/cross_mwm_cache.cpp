@@ -0,0 +1,329 @@
+#include "routing/cross_mwm_cache.hpp"
+
+#include "indexer/point_to_int64.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "std/sstream.hpp"
+
+namespace
+{
+uint32_t constexpr kFileVersion = 0;
+uint32_t constexpr kCoordBits = POINT_COORD_BITS;
+
+// Rough estimation of memory used by a hash table node besides its value.
+size_t constexpr kHashNodeOverhead = 2 * sizeof(void *);
+}  // namespace
+
+namespace routing
+{
+string DebugPrint(CrossMwmCacheStats const & stats)
+{
+  ostringstream out;
+  out << "CrossMwmCacheStats [ mwms: " << stats.m_mwms << ", nodes: " << stats.m_nodes
+      << ", bytes: " << stats.m_bytes << ", hits: " << stats.m_hits
+      << ", misses: " << stats.m_misses << " ]";
+  return out.str();
+}
+
+CrossMwmCache::CrossMwmCache(size_t maxBytes) : m_maxBytes(maxBytes) {}
+
+// static
+CrossMwmCache & CrossMwmCache::Instance()
+{
+  static CrossMwmCache instance;
+  return instance;
+}
+
+bool CrossMwmCache::GetEdges(string const & mwmName, int64_t version, TWrittenNodeId ingoingNode,
+                             vector<CrossMwmCacheEdge> & edges)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const entryIt = m_entries.find(mwmName);
+  if (entryIt == m_entries.end())
+  {
+    ++m_misses;
+    return false;
+  }
+
+  MwmEntry & entry = entryIt->second;
+  if (entry.m_version != version)
+  {
+    m_bytes -= entry.m_bytes;
+    m_entries.erase(entryIt);
+    ++m_misses;
+    return false;
+  }
+
+  auto const it = entry.m_adjacency.find(ingoingNode);
+  if (it == entry.m_adjacency.end())
+  {
+    ++m_misses;
+    return false;
+  }
+
+  entry.m_lastAccess = ++m_accessCounter;
+  edges = it->second;
+  ++m_hits;
+  return true;
+}
+
+void CrossMwmCache::SetEdges(string const & mwmName, int64_t version, TWrittenNodeId ingoingNode,
+                             vector<CrossMwmCacheEdge> const & edges)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_maxBytes == 0)
+    return;
+
+  MwmEntry & entry = GetEntry(mwmName, version);
+  auto & nodeEdges = entry.m_adjacency[ingoingNode];
+  size_t const oldBytes = nodeEdges.empty() ? 0 : GetNodeBytes(nodeEdges);
+  nodeEdges.assign(edges.begin(), edges.end());
+  nodeEdges.shrink_to_fit();
+  size_t const newBytes = GetNodeBytes(nodeEdges);
+
+  entry.m_bytes = entry.m_bytes + newBytes - oldBytes;
+  m_bytes = m_bytes + newBytes - oldBytes;
+  ShrinkToSize(mwmName);
+}
+
+uint32_t CrossMwmCache::GetMwmIndex(string const & mwmName)
+{
+  lock_guard<mutex> lock(m_mutex);
+  return GetMwmIndexImpl(mwmName);
+}
+
+string CrossMwmCache::GetMwmName(uint32_t index) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  ASSERT_LESS(index, m_names.size(), ());
+  return m_names[index];
+}
+
+void CrossMwmCache::SetSize(size_t maxBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_maxBytes = maxBytes;
+  ShrinkToSize(string());
+}
+
+size_t CrossMwmCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_maxBytes;
+}
+
+void CrossMwmCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  ClearImpl();
+}
+
+CrossMwmCacheStats CrossMwmCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  CrossMwmCacheStats stats;
+  stats.m_mwms = m_entries.size();
+  for (auto const & entry : m_entries)
+    stats.m_nodes += entry.second.m_adjacency.size();
+  stats.m_bytes = m_bytes;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  return stats;
+}
+
+bool CrossMwmCache::Save(string const & path) const
+{
+  // The cache is serialized into memory first, so routing is not blocked by the file writing.
+  vector<char> buffer;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    MemWriter<vector<char>> writer(buffer);
+    WriteToSink(writer, kFileVersion);
+
+    WriteVarUint(writer, static_cast<uint32_t>(m_names.size()));
+    for (auto const & name : m_names)
+      rw::Write(writer, name);
+
+    WriteVarUint(writer, static_cast<uint32_t>(m_entries.size()));
+    for (auto const & entry : m_entries)
+    {
+      rw::Write(writer, entry.first);
+      WriteToSink(writer, entry.second.m_version);
+      WriteVarUint(writer, static_cast<uint32_t>(entry.second.m_adjacency.size()));
+      for (auto const & node : entry.second.m_adjacency)
+      {
+        WriteVarUint(writer, node.first);
+        WriteVarUint(writer, static_cast<uint32_t>(node.second.size()));
+        for (auto const & edge : node.second)
+        {
+          WriteVarUint(writer, edge.m_outgoingNode);
+          WriteToSink(writer, edge.m_ingoingNode);
+          WriteToSink(writer, PointToInt64(m2::PointD(edge.m_point.lon, edge.m_point.lat),
+                                           kCoordBits));
+          WriteToSink(writer, edge.m_weight);
+          WriteVarUint(writer, edge.m_nextMwm);
+          WriteToSink(writer, edge.m_nextVersion);
+        }
+      }
+    }
+  }
+
+  // The file is replaced at once, so an interrupted saving doesn't break it.
+  lock_guard<mutex> lock(m_saveMutex);
+  string const tmpPath = path + ".tmp";
+  try
+  {
+    FileWriter writer(tmpPath);
+    writer.Write(buffer.data(), buffer.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't save cross mwm cache to", path, e.Msg()));
+    return false;
+  }
+  if (!my::RenameFileX(tmpPath, path))
+  {
+    LOG(LWARNING, ("Can't replace cross mwm cache", path));
+    return false;
+  }
+  return true;
+}
+
+bool CrossMwmCache::Load(string const & path)
+{
+  lock_guard<mutex> lock(m_mutex);
+  ClearImpl();
+  try
+  {
+    FileReader reader(path);
+    ReaderSource<FileReader> src(reader);
+    uint32_t const fileVersion = ReadPrimitiveFromSource<uint32_t>(src);
+    if (fileVersion != kFileVersion)
+    {
+      LOG(LWARNING, ("Unknown cross mwm cache version", fileVersion, "in", path));
+      return false;
+    }
+
+    // Indexes of names in the file differ from indexes of names in the cache.
+    vector<uint32_t> nameIndexes(ReadVarUint<uint32_t>(src));
+    for (auto & index : nameIndexes)
+    {
+      string name;
+      rw::Read(src, name);
+      index = GetMwmIndexImpl(name);
+    }
+
+    uint32_t const entriesCount = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < entriesCount; ++i)
+    {
+      string mwmName;
+      rw::Read(src, mwmName);
+      MwmEntry & entry = GetEntry(mwmName, ReadPrimitiveFromSource<int64_t>(src));
+
+      uint32_t const nodesCount = ReadVarUint<uint32_t>(src);
+      for (uint32_t j = 0; j < nodesCount; ++j)
+      {
+        auto & edges = entry.m_adjacency[ReadVarUint<TWrittenNodeId>(src)];
+        edges.resize(ReadVarUint<uint32_t>(src));
+        for (auto & edge : edges)
+        {
+          edge.m_outgoingNode = ReadVarUint<TWrittenNodeId>(src);
+          edge.m_ingoingNode = ReadPrimitiveFromSource<TWrittenNodeId>(src);
+          m2::PointD const point =
+              Int64ToPoint(ReadPrimitiveFromSource<uint64_t>(src), kCoordBits);
+          edge.m_point = ms::LatLon(point.y, point.x);
+          edge.m_weight = ReadPrimitiveFromSource<TWrittenEdgeWeight>(src);
+          uint32_t const nextMwm = ReadVarUint<uint32_t>(src);
+          if (nextMwm >= nameIndexes.size())
+            MYTHROW(Reader::ReadException, ("Invalid mwm name index", nextMwm));
+          edge.m_nextMwm = nameIndexes[nextMwm];
+          edge.m_nextVersion = ReadPrimitiveFromSource<int64_t>(src);
+        }
+        size_t const bytes = GetNodeBytes(edges);
+        entry.m_bytes += bytes;
+        m_bytes += bytes;
+      }
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't load cross mwm cache from", path, e.Msg()));
+    ClearImpl();
+    return false;
+  }
+
+  ShrinkToSize(string());
+  return true;
+}
+
+// static
+size_t CrossMwmCache::GetNodeBytes(vector<CrossMwmCacheEdge> const & edges)
+{
+  return sizeof(TAdjacency::value_type) + kHashNodeOverhead +
+         edges.size() * sizeof(CrossMwmCacheEdge);
+}
+
+uint32_t CrossMwmCache::GetMwmIndexImpl(string const & mwmName)
+{
+  auto const it = m_nameIndexes.find(mwmName);
+  if (it != m_nameIndexes.end())
+    return it->second;
+
+  uint32_t const index = static_cast<uint32_t>(m_names.size());
+  m_names.push_back(mwmName);
+  m_nameIndexes.emplace(mwmName, index);
+  return index;
+}
+
+CrossMwmCache::MwmEntry & CrossMwmCache::GetEntry(string const & mwmName, int64_t version)
+{
+  MwmEntry & entry = m_entries[mwmName];
+  if (entry.m_version != version)
+  {
+    m_bytes -= entry.m_bytes;
+    entry = MwmEntry();
+    entry.m_version = version;
+  }
+  entry.m_lastAccess = ++m_accessCounter;
+  return entry;
+}
+
+void CrossMwmCache::ShrinkToSize(string const & keepMwm)
+{
+  while (m_bytes > m_maxBytes && !m_entries.empty())
+  {
+    auto victim = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+      if (it->first == keepMwm)
+        continue;
+      if (victim == m_entries.end() || it->second.m_lastAccess < victim->second.m_lastAccess)
+        victim = it;
+    }
+
+    // Only the kept mwm is left and it doesn't fit alone.
+    if (victim == m_entries.end())
+      victim = m_entries.find(keepMwm);
+
+    m_bytes -= victim->second.m_bytes;
+    m_entries.erase(victim);
+  }
+}
+
+void CrossMwmCache::ClearImpl()
+{
+  m_entries.clear();
+  m_bytes = 0;
+}
+}  // namespace routing
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "routing/cross_routing_context.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/unordered_map.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// Cached edge of the cross mwm graph: a border crossing reachable from an ingoing node.
+struct CrossMwmCacheEdge
+{
+  /// Outgoing node of the current mwm.
+  TWrittenNodeId m_outgoingNode = kInvalidContextEdgeNodeId;
+  /// Ingoing node of the next mwm, kInvalidContextEdgeNodeId if the next mwm had no routing
+  /// data when the edge was cached.
+  TWrittenNodeId m_ingoingNode = kInvalidContextEdgeNodeId;
+  ms::LatLon m_point = ms::LatLon::Zero();
+  TWrittenEdgeWeight m_weight = kInvalidContextEdgeWeight;
+  /// Index of the next mwm name, see CrossMwmCache::GetMwmName.
+  uint32_t m_nextMwm = 0;
+  /// Version of the next mwm, edges are stale when it differs from the current one.
+  int64_t m_nextVersion = 0;
+};
+
+struct CrossMwmCacheStats
+{
+  size_t m_mwms = 0;
+  size_t m_nodes = 0;
+  size_t m_bytes = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+};
+
+string DebugPrint(CrossMwmCacheStats const & stats);
+
+/// Process-wide cache of cross mwm adjacency lists. Most of long routes cross the same borders,
+/// so border crossings and weights found once are reused by all the next routes.
+/// Adjacency lists of an mwm are dropped when the mwm version changes. When the cache exceeds
+/// its memory budget the least recently used mwms are evicted.
+/// The cache may be saved to a file and loaded on the next start.
+/// \note All methods are thread safe.
+class CrossMwmCache
+{
+public:
+  static size_t constexpr kDefaultSize = 16 * 1024 * 1024;
+
+  explicit CrossMwmCache(size_t maxBytes = kDefaultSize);
+
+  static CrossMwmCache & Instance();
+
+  /// Returns false if there is no adjacency list of the ingoing node of mwm |mwmName| with version
+  /// |version|. Lists of other versions are removed.
+  bool GetEdges(string const & mwmName, int64_t version, TWrittenNodeId ingoingNode,
+                vector<CrossMwmCacheEdge> & edges);
+
+  void SetEdges(string const & mwmName, int64_t version, TWrittenNodeId ingoingNode,
+                vector<CrossMwmCacheEdge> const & edges);
+
+  /// Index of an mwm name for CrossMwmCacheEdge::m_nextMwm. Indexes are never reused.
+  uint32_t GetMwmIndex(string const & mwmName);
+  string GetMwmName(uint32_t index) const;
+
+  void SetSize(size_t maxBytes);
+  size_t GetSize() const;
+
+  void Clear();
+
+  CrossMwmCacheStats GetStats() const;
+
+  /// Saves the cache to the file |path|. Returns false on error.
+  /// The cache may be used while the file is written, so it may be called asynchronously.
+  bool Save(string const & path) const;
+  /// Replaces the cache with the content of the file |path|. Returns false on error,
+  /// the cache is empty in that case.
+  bool Load(string const & path);
+
+private:
+  using TAdjacency = unordered_map<TWrittenNodeId, vector<CrossMwmCacheEdge>>;
+
+  struct MwmEntry
+  {
+    int64_t m_version = 0;
+    TAdjacency m_adjacency;
+    size_t m_bytes = 0;
+    uint64_t m_lastAccess = 0;
+  };
+
+  static size_t GetNodeBytes(vector<CrossMwmCacheEdge> const & edges);
+
+  uint32_t GetMwmIndexImpl(string const & mwmName);
+  MwmEntry & GetEntry(string const & mwmName, int64_t version);
+  void ShrinkToSize(string const & keepMwm);
+  void ClearImpl();
+
+  mutable mutex m_mutex;
+  // Serializes writing of files by Save.
+  mutable mutex m_saveMutex;
+  size_t m_maxBytes;
+  size_t m_bytes = 0;
+  uint64_t m_accessCounter = 0;
+  unordered_map<string, MwmEntry> m_entries;
+  // Names are stored in a deque to keep them valid while new ones are added.
+  deque<string> m_names;
+  unordered_map<string, uint32_t> m_nameIndexes;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+};
+}  // namespace routing
@@ -3,10 +3,27 @@
 
 #include "geometry/distance_on_sphere.hpp"
 
+#include "platform/country_defines.hpp"
+#include "platform/local_country_file.hpp"
+
 namespace
 {
 inline bool IsValidEdgeWeight(EdgeWeight const & w) { return w != INVALID_EDGE_WEIGHT; }
+
+// Version of an absent mwm.
+int64_t constexpr kNoMwmVersion = -1;
+
+// Mwm version for the cross mwm cache. Routing files may be downloaded or deleted separately
+// from maps, so the presence of routing data changes the version too.
+int64_t GetMwmVersion(Index::MwmId const & id)
+{
+  if (!id.IsAlive())
+    return kNoMwmVersion;
+  MwmInfo const & info = *id.GetInfo();
+  bool const hasRouting = HasOptions(info.GetLocalFile().GetFiles(), MapOptions::CarRouting);
+  return info.GetVersion() * 2 + (hasRouting ? 1 : 0);
 }
+}  // namespace
 
 namespace routing
 {
@@ -177,6 +194,45 @@ void CrossMwmGraph::GetOutgoingEdgesList(BorderCross const & v,
     return;
   }
 
+  // Check cached edges.
+  string const & mwmName = v.toNode.mwmId.GetInfo()->GetCountryName();
+  int64_t const version = GetMwmVersion(v.toNode.mwmId);
+  vector<CrossMwmCacheEdge> cachedEdges;
+  if (m_cache.GetEdges(mwmName, version, v.toNode.node, cachedEdges) &&
+      ConvertCachedEdges(v, cachedEdges, adj))
+  {
+    return;
+  }
+
+  // Cache miss case.
+  adj.clear();
+  cachedEdges.clear();
+  FindOutgoingEdges(v, adj, cachedEdges);
+  m_cache.SetEdges(mwmName, version, v.toNode.node, cachedEdges);
+}
+
+bool CrossMwmGraph::ConvertCachedEdges(BorderCross const & v,
+                                       vector<CrossMwmCacheEdge> const & cachedEdges,
+                                       vector<CrossWeightedEdge> & adj) const
+{
+  for (auto const & edge : cachedEdges)
+  {
+    Index::MwmId const & nextMwmId = GetMwmIdByCacheIndex(edge.m_nextMwm);
+    if (GetMwmVersion(nextMwmId) != edge.m_nextVersion)
+      return false;
+    // The next mwm has no routing data.
+    if (edge.m_ingoingNode == kInvalidContextEdgeNodeId)
+      continue;
+    adj.emplace_back(BorderCross(CrossNode(edge.m_outgoingNode, v.toNode.mwmId, edge.m_point),
+                                 CrossNode(edge.m_ingoingNode, nextMwmId, edge.m_point)),
+                     edge.m_weight);
+  }
+  return true;
+}
+
+void CrossMwmGraph::FindOutgoingEdges(BorderCross const & v, vector<CrossWeightedEdge> & adj,
+                                      vector<CrossMwmCacheEdge> & cachedEdges) const
+{
   // Loading cross routing section.
   TRoutingMappingPtr currentMapping = m_indexManager.GetMappingById(v.toNode.mwmId);
   ASSERT(currentMapping->IsValid(), ());
@@ -200,15 +256,46 @@ void CrossMwmGraph::GetOutgoingEdgesList(BorderCross const & v,
 
   // Find outs. Generate adjacency list.
   currentContext.ForEachOutgoingNode([&, this](OutgoingCrossNode const & node)
-                                     {
-                                       EdgeWeight const outWeight = currentContext.GetAdjacencyCost(ingoingNode, node);
-                                       if (outWeight != kInvalidContextEdgeWeight && outWeight != 0)
-                                       {
-                                         BorderCross target = ConstructBorderCross(node, currentMapping);
-                                         if (target.toNode.IsValid())
-                                           adj.emplace_back(target, outWeight);
-                                       }
-                                     });
+  {
+    EdgeWeight const outWeight = currentContext.GetAdjacencyCost(ingoingNode, node);
+    if (outWeight == kInvalidContextEdgeWeight || outWeight == 0)
+      return;
+
+    CrossMwmCacheEdge cachedEdge;
+    cachedEdge.m_outgoingNode = node.m_nodeId;
+    cachedEdge.m_weight = outWeight;
+
+    BorderCross target = ConstructBorderCross(node, currentMapping);
+    if (target.toNode.IsValid())
+    {
+      adj.emplace_back(target, outWeight);
+      cachedEdge.m_ingoingNode = target.toNode.node;
+      cachedEdge.m_point = target.toNode.point;
+      cachedEdge.m_nextMwm =
+          m_cache.GetMwmIndex(target.toNode.mwmId.GetInfo()->GetCountryName());
+      cachedEdge.m_nextVersion = GetMwmVersion(target.toNode.mwmId);
+    }
+    else
+    {
+      // Edges to mwms without routing data are cached too, to find out when they appear.
+      string const & nextMwm = currentContext.GetOutgoingMwmName(node);
+      cachedEdge.m_nextMwm = m_cache.GetMwmIndex(nextMwm);
+      cachedEdge.m_nextVersion = GetMwmVersion(m_indexManager.GetMwmIdByName(nextMwm));
+    }
+    cachedEdges.push_back(cachedEdge);
+  });
+}
+
+Index::MwmId const & CrossMwmGraph::GetMwmIdByCacheIndex(uint32_t index) const
+{
+  auto it = m_cachedMwmIds.find(index);
+  if (it == m_cachedMwmIds.end())
+  {
+    it = m_cachedMwmIds
+             .emplace(index, m_indexManager.GetMwmIdByName(m_cache.GetMwmName(index)))
+             .first;
+  }
+  return it->second;
 }
 
 double CrossMwmGraph::HeuristicCostEstimate(BorderCross const & v, BorderCross const & w) const
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "cross_mwm_cache.hpp"
 #include "osrm_engine.hpp"
 #include "osrm_router.hpp"
 #include "router.hpp"
@@ -104,7 +105,12 @@ public:
   using TVertexType = BorderCross;
   using TEdgeType = CrossWeightedEdge;
 
-  explicit CrossMwmGraph(RoutingIndexManager & indexManager) : m_indexManager(indexManager) {}
+  /// \param cache Adjacency lists of ingoing nodes are taken from and stored to the cache.
+  explicit CrossMwmGraph(RoutingIndexManager & indexManager,
+                         CrossMwmCache & cache = CrossMwmCache::Instance())
+    : m_indexManager(indexManager), m_cache(cache)
+  {
+  }
 
   void GetOutgoingEdgesList(BorderCross const & v, vector<CrossWeightedEdge> & adj) const;
   void GetIngoingEdgesList(BorderCross const & /* v */,
@@ -118,11 +124,13 @@ public:
   IRouter::ResultCode SetStartNode(CrossNode const & startNode);
   IRouter::ResultCode SetFinalNode(CrossNode const & finalNode);
 
-private:
   // Cashing wrapper for the ConstructBorderCrossImpl function.
+  // Returns an invalid cross if the next mwm is absent.
   BorderCross ConstructBorderCross(OutgoingCrossNode const & startNode,
                                    TRoutingMappingPtr const & currentMapping) const;
 
+private:
+
   // Pure function to construct boder cross by outgoing cross node.
   bool ConstructBorderCrossImpl(OutgoingCrossNode const & startNode,
                                 TRoutingMappingPtr const & currentMapping,
@@ -136,6 +144,18 @@ private:
   void AddVirtualEdge(IngoingCrossNode const & node, CrossNode const & finalNode,
                       EdgeWeight weight);
 
+  // Converts cached edges to graph edges. Returns false if some of the next mwms were updated,
+  // downloaded or deleted since the edges were cached.
+  bool ConvertCachedEdges(BorderCross const & v, vector<CrossMwmCacheEdge> const & cachedEdges,
+                          vector<CrossWeightedEdge> & adj) const;
+
+  // Finds outgoing edges of the ingoing node v.toNode with its cross context and fills
+  // the edges for the cache.
+  void FindOutgoingEdges(BorderCross const & v, vector<CrossWeightedEdge> & adj,
+                         vector<CrossMwmCacheEdge> & cachedEdges) const;
+
+  Index::MwmId const & GetMwmIdByCacheIndex(uint32_t index) const;
+
   map<CrossNode, vector<CrossWeightedEdge> > m_virtualEdges;
 
   mutable RoutingIndexManager m_indexManager;
@@ -152,6 +172,9 @@ private:
   };
 
   mutable unordered_map<TCachingKey, BorderCross, Hash> m_cachedNextNodes;
+
+  CrossMwmCache & m_cache;
+  mutable unordered_map<uint32_t, Index::MwmId> m_cachedMwmIds;
 };
 
 //--------------------------------------------------------------------------------------------------
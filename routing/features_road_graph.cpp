@@ -18,8 +18,6 @@ namespace routing
 
 namespace
 {
-uint32_t constexpr kPowOfTwoForFeatureCacheSize = 10; // cache contains 2 ^ kPowOfTwoForFeatureCacheSize elements
-
 double constexpr kMwmRoadCrossingRadiusMeters = 2.0;
 
 double constexpr kMwmCrossingNodeEqualityRadiusMeters = 100.0;
@@ -88,20 +86,6 @@ void FeaturesRoadGraph::CrossCountryVehicleModel::Clear()
 }
 
 
-IRoadGraph::RoadInfo & FeaturesRoadGraph::RoadInfoCache::Find(FeatureID const & featureId, bool & found)
-{
-  auto res = m_cache.insert(make_pair(featureId.m_mwmId, TMwmFeatureCache()));
-  if (res.second)
-    res.first->second.Init(kPowOfTwoForFeatureCacheSize);
-  return res.first->second.Find(featureId.m_index, found);
-}
-
-void FeaturesRoadGraph::RoadInfoCache::Clear()
-{
-  m_cache.clear();
-}
-
-
 FeaturesRoadGraph::FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory)
     : m_index(index),
       m_vehicleModel(move(vehicleModelFactory))
@@ -110,45 +94,21 @@ FeaturesRoadGraph::FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFact
 
 uint32_t FeaturesRoadGraph::GetStreetReadScale() { return scales::GetUpperScale(); }
 
-class CrossFeaturesLoader
-{
-public:
-  CrossFeaturesLoader(FeaturesRoadGraph const & graph,
-                      IRoadGraph::CrossEdgesLoader & edgesLoader)
-      : m_graph(graph), m_edgesLoader(edgesLoader)
-  {}
-
-  void operator()(FeatureType & ft)
-  {
-    if (ft.GetFeatureType() != feature::GEOM_LINE)
-      return;
-
-    double const speedKMPH = m_graph.GetSpeedKMPHFromFt(ft);
-    if (speedKMPH <= 0.0)
-      return;
-
-    FeatureID const featureId = ft.GetID();
-
-    IRoadGraph::RoadInfo const & roadInfo = m_graph.GetCachedRoadInfo(featureId, ft, speedKMPH);
-
-    m_edgesLoader(featureId, roadInfo);
-  }
-
-private:
-  FeaturesRoadGraph const & m_graph;
-  IRoadGraph::CrossEdgesLoader & m_edgesLoader;
-};
-
 IRoadGraph::RoadInfo FeaturesRoadGraph::GetRoadInfo(FeatureID const & featureId) const
 {
-  RoadInfo const & ri = GetCachedRoadInfo(featureId);
-  ASSERT_GREATER(ri.m_speedKMPH, 0.0, ());
+  RoadArena::RoadView const road = GetRoad(featureId);
+  ASSERT_GREATER(road.m_speedKMPH, 0.0, ());
+
+  RoadInfo ri;
+  ri.m_bidirectional = road.m_bidirectional;
+  ri.m_speedKMPH = road.m_speedKMPH;
+  ri.m_points.assign(road.m_points, road.m_points + road.m_pointsCount);
   return ri;
 }
 
 double FeaturesRoadGraph::GetSpeedKMPH(FeatureID const & featureId) const
 {
-  double const speedKMPH = GetCachedRoadInfo(featureId).m_speedKMPH;
+  double const speedKMPH = GetRoad(featureId).m_speedKMPH;
   ASSERT_GREATER(speedKMPH, 0.0, ());
   return speedKMPH;
 }
@@ -161,9 +121,11 @@ double FeaturesRoadGraph::GetMaxSpeedKMPH() const
 void FeaturesRoadGraph::ForEachFeatureClosestToCross(m2::PointD const & cross,
                                                      CrossEdgesLoader & edgesLoader) const
 {
-  CrossFeaturesLoader featuresLoader(*this, edgesLoader);
   m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(cross, kMwmRoadCrossingRadiusMeters);
-  m_index.ForEachInRect(featuresLoader, rect, GetStreetReadScale());
+  ForEachRoadInRect(rect, [&edgesLoader](FeatureID const & featureId, RoadArena::RoadView const & road)
+  {
+    edgesLoader(featureId, road.m_points, road.m_pointsCount);
+  });
 }
 
 void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t count,
@@ -171,25 +133,17 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
 {
   NearestEdgeFinder finder(point);
 
-  auto const f = [&finder, this](FeatureType & ft)
+  RoadInfo ri;
+  auto const f = [&finder, &ri](FeatureID const & featureId, RoadArena::RoadView const & road)
   {
-    if (ft.GetFeatureType() != feature::GEOM_LINE)
-      return;
-
-    double const speedKMPH = m_vehicleModel.GetSpeed(ft);
-    if (speedKMPH <= 0.0)
-      return;
-
-    FeatureID const featureId = ft.GetID();
-
-    IRoadGraph::RoadInfo const & roadInfo = GetCachedRoadInfo(featureId, ft, speedKMPH);
-
-    finder.AddInformationSource(featureId, roadInfo);
+    ri.m_bidirectional = road.m_bidirectional;
+    ri.m_speedKMPH = road.m_speedKMPH;
+    ri.m_points.assign(road.m_points, road.m_points + road.m_pointsCount);
+    finder.AddInformationSource(featureId, ri);
   };
 
-  m_index.ForEachInRect(
-      f, MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters),
-      GetStreetReadScale());
+  ForEachRoadInRect(
+      MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters), f);
 
   finder.MakeResult(vicinities, count);
 }
@@ -232,7 +186,7 @@ void FeaturesRoadGraph::GetJunctionTypes(Junction const & junction, feature::Typ
 
 void FeaturesRoadGraph::ClearState()
 {
-  m_cache.Clear();
+  m_arena.Clear();
   m_vehicleModel.Clear();
   m_mwmLocks.clear();
 }
@@ -247,13 +201,11 @@ double FeaturesRoadGraph::GetSpeedKMPHFromFt(FeatureType const & ft) const
   return m_vehicleModel.GetSpeed(ft);
 }
 
-IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID const & featureId) const
+RoadArena::RoadView FeaturesRoadGraph::GetRoad(FeatureID const & featureId) const
 {
-  bool found = false;
-  RoadInfo & ri = m_cache.Find(featureId, found);
-
-  if (found)
-    return ri;
+  RoadArena::RoadView road;
+  if (m_arena.GetRoad(featureId, road))
+    return road;
 
   FeatureType ft;
   Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId);
@@ -261,38 +213,50 @@ IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID cons
   ASSERT_EQUAL(ft.GetFeatureType(), feature::GEOM_LINE, ());
 
   ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-
-  ri.m_bidirectional = !IsOneWay(ft);
-  ri.m_speedKMPH = GetSpeedKMPHFromFt(ft);
-  ft.SwapPoints(ri.m_points);
-
+  ft.SwapPoints(m_points);
+  m_arena.AddRoad(featureId, !IsOneWay(ft), GetSpeedKMPHFromFt(ft), m_points.data(),
+                  m_points.size());
   LockFeatureMwm(featureId);
 
-  return ri;
+  VERIFY(m_arena.GetRoad(featureId, road), ());
+  return road;
 }
 
-IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID const & featureId,
-                                                                  FeatureType & ft,
-                                                                  double speedKMPH) const
+void FeaturesRoadGraph::LoadTile(RoadArena::TTileId tile) const
 {
-  bool found = false;
-  RoadInfo & ri = m_cache.Find(featureId, found);
+  m_arena.AddTile(tile);
 
-  if (found)
-    return ri;
+  auto const f = [this, tile](FeatureType & ft)
+  {
+    if (ft.GetFeatureType() != feature::GEOM_LINE)
+      return;
 
-  // ft must be set
-  ASSERT_EQUAL(featureId, ft.GetID(), ());
+    FeatureID const & featureId = ft.GetID();
+    if (m_arena.BindRoad(tile, featureId))
+      return;
 
-  ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    double const speedKMPH = GetSpeedKMPHFromFt(ft);
+    if (speedKMPH <= 0.0)
+      return;
 
-  ri.m_bidirectional = !IsOneWay(ft);
-  ri.m_speedKMPH = speedKMPH;
-  ft.SwapPoints(ri.m_points);
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    ft.SwapPoints(m_points);
+    m_arena.AddRoad(tile, featureId, !IsOneWay(ft), speedKMPH, m_points.data(), m_points.size());
+    LockFeatureMwm(featureId);
+  };
 
-  LockFeatureMwm(featureId);
+  m_index.ForEachInRect(f, RoadArena::GetTileRect(tile), GetStreetReadScale());
+}
 
-  return ri;
+template <typename ToDo>
+void FeaturesRoadGraph::ForEachRoadInRect(m2::RectD const & rect, ToDo && toDo) const
+{
+  RoadArena::ForEachTileInRect(rect, [this](RoadArena::TTileId tile)
+  {
+    if (!m_arena.IsTileLoaded(tile))
+      LoadTile(tile);
+  });
+  m_arena.ForEachRoadInRect(rect, toDo);
 }
 
 void FeaturesRoadGraph::LockFeatureMwm(FeatureID const & featureId) const
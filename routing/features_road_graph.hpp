@@ -1,4 +1,5 @@
 #pragma once
+#include "routing/road_arena.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/vehicle_model.hpp"
 
@@ -7,7 +8,7 @@
 
 #include "geometry/point2d.hpp"
 
-#include "base/cache.hpp"
+#include "base/buffer_vector.hpp"
 
 #include "std/map.hpp"
 #include "std/unique_ptr.hpp"
@@ -43,18 +44,6 @@ private:
     mutable map<MwmSet::MwmId, shared_ptr<IVehicleModel>> m_cache;
   };
 
-  class RoadInfoCache
-  {
-  public:
-    RoadInfo & Find(FeatureID const & featureId, bool & found);
-
-    void Clear();
-
-  private:
-    using TMwmFeatureCache = my::Cache<uint32_t, RoadInfo>;
-    map<MwmSet::MwmId, TMwmFeatureCache> m_cache;
-  };
-
 public:
   FeaturesRoadGraph(Index & index, unique_ptr<IVehicleModelFactory> && vehicleModelFactory);
 
@@ -73,26 +62,29 @@ public:
   void ClearState() override;
 
 private:
-  friend class CrossFeaturesLoader;
-
   bool IsOneWay(FeatureType const & ft) const;
   double GetSpeedKMPHFromFt(FeatureType const & ft) const;
 
-  // Searches a feature RoadInfo in the cache, and if does not find then
-  // loads feature from the index and takes speed for the feature from the vehicle model.
-  RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId) const;
-  // Searches a feature RoadInfo in the cache, and if does not find then takes passed feature and speed.
-  // This version is used to prevent redundant feature loading when feature speed is known.
-  RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId,
-                                     FeatureType & ft,
-                                     double speedKMPH) const;
+  // Returns road from the arena, loads it from the index if it's not there yet.
+  RoadArena::RoadView GetRoad(FeatureID const & featureId) const;
+
+  // Loads all roads of the tile to the arena.
+  void LoadTile(RoadArena::TTileId tile) const;
+
+  // Calls toDo(FeatureID const &, RoadArena::RoadView const &) for roads which limit rects
+  // intersect the rect. Missing tiles are loaded first.
+  template <typename ToDo>
+  void ForEachRoadInRect(m2::RectD const & rect, ToDo && toDo) const;
 
   void LockFeatureMwm(FeatureID const & featureId) const;
 
   Index & m_index;
-  mutable RoadInfoCache m_cache;
+  mutable RoadArena m_arena;
   mutable CrossCountryVehicleModel m_vehicleModel;
   mutable map<MwmSet::MwmId, MwmSet::MwmHandle> m_mwmLocks;
+
+  // Buffer for points of a feature being added to the arena.
+  mutable buffer_vector<m2::PointD, 32> m_points;
 };
 
 }  // namespace routing
@@ -9,7 +9,10 @@
 
 #include "base/bits.hpp"
 
+#include "std/sstream.hpp"
 #include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 #include "3party/succinct/elias_fano.hpp"
 #include "3party/succinct/elias_fano_compressed_list.hpp"
@@ -24,6 +27,22 @@
 namespace routing
 {
 
+struct AdjacencyCacheStats
+{
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  size_t m_blocks = 0;
+  size_t m_bytes = 0;
+};
+
+inline string DebugPrint(AdjacencyCacheStats const & stats)
+{
+  ostringstream out;
+  out << "AdjacencyCacheStats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", blocks: " << stats.m_blocks << ", bytes: " << stats.m_bytes << " ]";
+  return out.str();
+}
+
 template <class EdgeDataT> class OsrmRawDataFacade : public BaseDataFacade<EdgeDataT>
 {
   template <class T> void ClearContainer(T & t)
@@ -31,6 +50,47 @@ template <class EdgeDataT> class OsrmRawDataFacade : public BaseDataFacade<EdgeD
     T().swap(t);
   }
 
+  // Adjacency cache. Nodes are grouped into blocks of kCacheBlockNodes consecutive ids.
+  // A block which adjacency was requested kHotBlockAccesses times is decompressed
+  // into a flat CSR array while the memory budget allows it. Blocks are never evicted,
+  // so the budget is spent on the blocks which become hot first.
+  enum
+  {
+    kCacheBlockNodes = 64,
+    kHotBlockAccesses = 8
+  };
+
+  struct CachedEdge
+  {
+    NodeID m_target;
+    NodeID m_id;
+    int m_distance;
+    bool m_shortcut;
+    bool m_backward;
+  };
+
+  struct CachedBlock
+  {
+    // m_begins[i] is the first edge of the i-th node of the block, m_begins.back() is
+    // the end of edges of the last node.
+    vector<EdgeID> m_begins;
+    vector<CachedEdge> m_edges;
+
+    bool HasEdge(EdgeID e) const { return e >= m_begins.front() && e < m_begins.back(); }
+    CachedEdge const & GetEdge(EdgeID e) const { return m_edges[e - m_begins.front()]; }
+  };
+
+  size_t m_cacheBudget = 0;
+  // The cache does not refer to the mapped data, so it survives reloading of the same data.
+  // Id of the cached data, empty id means that the data can't be identified.
+  string m_cachedDataId;
+
+  // The facade is used by one routing thread at a time, so the cache is not synchronized.
+  mutable vector<unique_ptr<CachedBlock>> m_cacheBlocks;
+  mutable vector<uint8_t> m_cacheAccesses;
+  mutable CachedBlock const * m_lastBlock = nullptr;
+  mutable AdjacencyCacheStats m_cacheStats;
+
 protected:
   succinct::elias_fano_compressed_list m_edgeData;
   succinct::rs_bit_vector m_shortcuts;
@@ -42,7 +102,9 @@ protected:
 public:
   //OsrmRawDataFacade(): m_numberOfNodes(0) {}
 
-  void LoadRawData(char const * pRawEdgeData, char const * pRawEdgeIds, char const * pRawEdgeShortcuts, char const * pRawFanoMatrix)
+  /// Adjacency cache is kept only when data with the same non-empty |dataId| is reloaded.
+  void LoadRawData(char const * pRawEdgeData, char const * pRawEdgeIds, char const * pRawEdgeShortcuts, char const * pRawFanoMatrix,
+                   string const & dataId)
   {
     ClearRawData();
 
@@ -58,6 +120,12 @@ public:
     ASSERT(pRawFanoMatrix, ());
     m_numberOfNodes = *reinterpret_cast<uint32_t const *>(pRawFanoMatrix);
     succinct::mapper::map(m_matrix, pRawFanoMatrix + sizeof(m_numberOfNodes));
+
+    if (dataId.empty() || dataId != m_cachedDataId)
+    {
+      ClearAdjacencyCache();
+      m_cachedDataId = dataId;
+    }
   }
 
   void ClearRawData()
@@ -68,6 +136,27 @@ public:
     ClearContainer(m_matrix);
   }
 
+  /// Sets memory budget in bytes for decompressed adjacency of hot nodes.
+  /// 0 (default) disables the cache.
+  void SetAdjacencyCacheSize(size_t bytes)
+  {
+    if (bytes < m_cacheStats.m_bytes)
+      ClearAdjacencyCache();
+    m_cacheBudget = bytes;
+  }
+
+  size_t GetAdjacencyCacheSize() const { return m_cacheBudget; }
+
+  void ClearAdjacencyCache()
+  {
+    ClearContainer(m_cacheBlocks);
+    ClearContainer(m_cacheAccesses);
+    m_lastBlock = nullptr;
+    m_cacheStats = AdjacencyCacheStats();
+  }
+
+  AdjacencyCacheStats const & GetAdjacencyCacheStats() const { return m_cacheStats; }
+
   unsigned GetNumberOfNodes() const override
   {
     return m_numberOfNodes;
@@ -85,19 +174,29 @@ public:
 
   NodeID GetTarget(const EdgeID e) const override
   {
-    return (m_matrix.select(e) / 2) % GetNumberOfNodes();
+    if (m_lastBlock && m_lastBlock->HasEdge(e))
+    {
+      ++m_cacheStats.m_hits;
+      return m_lastBlock->GetEdge(e).m_target;
+    }
+    return GetTargetRaw(e);
   }
 
   EdgeDataT GetEdgeData(const EdgeID e, NodeID node) const override
   {
-    EdgeDataT res;
+    CachedBlock const * block = FindCachedEdge(e, node);
+    if (!block)
+      return GetEdgeDataRaw(e, node);
 
-    res.shortcut = m_shortcuts[e];
-    res.id = res.shortcut ? (node - static_cast<NodeID>(bits::ZigZagDecode(m_edgeId[static_cast<size_t>(m_shortcuts.rank(e))]))) : 0;
-    res.backward = (m_matrix.select(e) % 2 == 1);
-    res.forward = !res.backward;
-    res.distance = static_cast<int>(m_edgeData[e]);
+    ++m_cacheStats.m_hits;
+    CachedEdge const & edge = block->GetEdge(e);
 
+    EdgeDataT res;
+    res.shortcut = edge.m_shortcut;
+    res.id = edge.m_id;
+    res.backward = edge.m_backward;
+    res.forward = !res.backward;
+    res.distance = edge.m_distance;
     return res;
   }
 
@@ -116,14 +215,14 @@ public:
 
   EdgeID BeginEdges(const NodeID n) const override
   {
-    uint64_t idx = 2 * n * (uint64_t)GetNumberOfNodes();
-    return n == 0 ? 0 : static_cast<EdgeID>(m_matrix.rank(min(idx, m_matrix.size())));
+    CachedBlock const * block = FindCachedNode(n);
+    return block ? block->m_begins[n % kCacheBlockNodes] : BeginEdgesRaw(n);
   }
 
   EdgeID EndEdges(const NodeID n) const override
   {
-    uint64_t const idx = 2 * (n + 1) * (uint64_t)GetNumberOfNodes();
-    return static_cast<EdgeID>(m_matrix.rank(min(idx, m_matrix.size())));
+    CachedBlock const * block = FindCachedNode(n);
+    return block ? block->m_begins[n % kCacheBlockNodes + 1] : EndEdgesRaw(n);
   }
 
   EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
@@ -250,6 +349,128 @@ public:
   {
     return std::string();
   }
+
+private:
+  NodeID GetTargetRaw(EdgeID e) const
+  {
+    return (m_matrix.select(e) / 2) % GetNumberOfNodes();
+  }
+
+  EdgeDataT GetEdgeDataRaw(EdgeID e, NodeID node) const
+  {
+    EdgeDataT res;
+
+    res.shortcut = m_shortcuts[e];
+    res.id = res.shortcut ? (node - static_cast<NodeID>(bits::ZigZagDecode(m_edgeId[static_cast<size_t>(m_shortcuts.rank(e))]))) : 0;
+    res.backward = (m_matrix.select(e) % 2 == 1);
+    res.forward = !res.backward;
+    res.distance = static_cast<int>(m_edgeData[e]);
+
+    return res;
+  }
+
+  EdgeID BeginEdgesRaw(NodeID n) const
+  {
+    uint64_t idx = 2 * n * (uint64_t)GetNumberOfNodes();
+    return n == 0 ? 0 : static_cast<EdgeID>(m_matrix.rank(min(idx, m_matrix.size())));
+  }
+
+  EdgeID EndEdgesRaw(NodeID n) const
+  {
+    uint64_t const idx = 2 * (n + 1) * (uint64_t)GetNumberOfNodes();
+    return static_cast<EdgeID>(m_matrix.rank(min(idx, m_matrix.size())));
+  }
+
+  /// @return a cached block of the node n or nullptr if the block is not cached (yet).
+  CachedBlock const * FindCachedNode(NodeID n) const
+  {
+    if (m_cacheBudget == 0)
+      return nullptr;
+
+    if (m_cacheBlocks.empty())
+    {
+      size_t const blocksCount = (GetNumberOfNodes() + kCacheBlockNodes - 1) / kCacheBlockNodes;
+      m_cacheBlocks.resize(blocksCount);
+      m_cacheAccesses.resize(blocksCount, 0);
+    }
+
+    size_t const index = n / kCacheBlockNodes;
+    ASSERT_LESS(index, m_cacheBlocks.size(), ());
+    unique_ptr<CachedBlock> & block = m_cacheBlocks[index];
+    if (!block)
+    {
+      if (++m_cacheAccesses[index] < kHotBlockAccesses)
+      {
+        ++m_cacheStats.m_misses;
+        return nullptr;
+      }
+      m_cacheAccesses[index] = 0;
+      block = DecodeBlock(index);
+      if (!block)
+      {
+        ++m_cacheStats.m_misses;
+        return nullptr;
+      }
+    }
+
+    ++m_cacheStats.m_hits;
+    m_lastBlock = block.get();
+    return m_lastBlock;
+  }
+
+  /// @return a cached block which contains the edge e of the node or nullptr.
+  CachedBlock const * FindCachedEdge(EdgeID e, NodeID node) const
+  {
+    if (m_lastBlock && m_lastBlock->HasEdge(e))
+      return m_lastBlock;
+
+    size_t const index = node / kCacheBlockNodes;
+    if (index >= m_cacheBlocks.size() || !m_cacheBlocks[index])
+      return nullptr;
+
+    CachedBlock const * block = m_cacheBlocks[index].get();
+    if (!block->HasEdge(e))
+      return nullptr;
+    m_lastBlock = block;
+    return block;
+  }
+
+  /// @return nullptr if the block does not fit into the memory budget.
+  unique_ptr<CachedBlock> DecodeBlock(size_t index) const
+  {
+    NodeID const firstNode = static_cast<NodeID>(index * kCacheBlockNodes);
+    NodeID const endNode = min(static_cast<NodeID>(firstNode + kCacheBlockNodes),
+                               static_cast<NodeID>(GetNumberOfNodes()));
+    EdgeID const firstEdge = BeginEdgesRaw(firstNode);
+    EdgeID const endEdge = EndEdgesRaw(endNode - 1);
+
+    size_t const bytes = sizeof(CachedBlock) + (endNode - firstNode + 1) * sizeof(EdgeID) +
+                         (endEdge - firstEdge) * sizeof(CachedEdge);
+    if (m_cacheStats.m_bytes + bytes > m_cacheBudget)
+      return nullptr;
+
+    unique_ptr<CachedBlock> block(new CachedBlock());
+    block->m_begins.reserve(endNode - firstNode + 1);
+    block->m_edges.reserve(endEdge - firstEdge);
+    block->m_begins.push_back(firstEdge);
+    for (NodeID node = firstNode; node < endNode; ++node)
+    {
+      EdgeID const end = EndEdgesRaw(node);
+      for (EdgeID e = block->m_begins.back(); e < end; ++e)
+      {
+        EdgeDataT const data = GetEdgeDataRaw(e, node);
+        block->m_edges.push_back({GetTargetRaw(e), static_cast<NodeID>(data.id), data.distance,
+                                  static_cast<bool>(data.shortcut),
+                                  static_cast<bool>(data.backward)});
+      }
+      block->m_begins.push_back(end);
+    }
+    ASSERT_EQUAL(block->m_begins.back(), endEdge, ());
+
+    ++m_cacheStats.m_blocks;
+    m_cacheStats.m_bytes += bytes;
+    return block;
+  }
 };
 
 
@@ -268,7 +489,8 @@ template <class EdgeDataT> class OsrmDataFacade : public OsrmRawDataFacade<EdgeD
 
 public:
 
-  void Load(FilesMappingContainer const & container)
+  /// |dataId| identifies the file and its version, see LoadRawData().
+  void Load(FilesMappingContainer const & container, string const & dataId)
   {
     Clear();
 
@@ -285,7 +507,8 @@ public:
     m_handleShortcuts.Assign(container.Map(ROUTING_SHORTCUTS_FILE_TAG));
     ASSERT(m_handleShortcuts.IsValid(), ());
 
-    LoadRawData(m_handleEdgeData.GetData<char>(), m_handleEdgeId.GetData<char>(), m_handleShortcuts.GetData<char>(), m_handleFanoMatrix.GetData<char>());
+    LoadRawData(m_handleEdgeData.GetData<char>(), m_handleEdgeId.GetData<char>(), m_handleShortcuts.GetData<char>(), m_handleFanoMatrix.GetData<char>(),
+                dataId);
   }
 
   void Clear()
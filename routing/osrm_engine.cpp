@@ -29,11 +29,37 @@ void GenerateRoutingTaskFromNodeId(NodeID const nodeId, bool const isStartNode,
   taskNode.name_id = 1;
 }
 
-void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
-                       TRawDataFacade & facade, vector<EdgeWeight> & result)
+namespace
+{
+void FindWeightsMatrixImpl(PhantomNodeArray const & sources, PhantomNodeArray const & targets,
+                           TRawDataFacade & facade, vector<EdgeWeight> & result)
 {
   SearchEngineData engineData;
   NMManyToManyRouting<TRawDataFacade> pathFinder(&facade, engineData);
+
+  // Calculate time consumption of a NtoM path finding.
+  my::HighResTimer timer(true);
+  shared_ptr<vector<EdgeWeight>> resultTable = pathFinder(sources, targets);
+  LOG(LINFO, ("Duration of a single one-to-many routing call", timer.ElapsedNano(), "ns"));
+  ASSERT_EQUAL(resultTable->size(), sources.size() * targets.size(), ());
+  result.swap(*resultTable);
+}
+
+void FillPhantomNodes(vector<TRoutingNodes> const & nodes, PhantomNodeArray & phantomNodes)
+{
+  phantomNodes.resize(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    phantomNodes[i].clear();
+    for (FeatureGraphNode const & node : nodes[i])
+      phantomNodes[i].push_back(node.node);
+  }
+}
+}  // namespace
+
+void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
+                       TRawDataFacade & facade, vector<EdgeWeight> & result)
+{
   PhantomNodeArray sourcesTaskVector(sources.size());
   PhantomNodeArray targetsTaskVector(targets.size());
   for (size_t i = 0; i < sources.size(); ++i)
@@ -41,13 +67,19 @@ void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targ
   for (size_t i = 0; i < targets.size(); ++i)
     targetsTaskVector[i].push_back(targets[i].node);
 
-  // Calculate time consumption of a NtoM path finding.
-  my::HighResTimer timer(true);
-  shared_ptr<vector<EdgeWeight>> resultTable = pathFinder(sourcesTaskVector, targetsTaskVector);
-  LOG(LINFO, ("Duration of a single one-to-many routing call", timer.ElapsedNano(), "ns"));
-  timer.Reset();
-  ASSERT_EQUAL(resultTable->size(), sources.size() * targets.size(), ());
-  result.swap(*resultTable);
+  FindWeightsMatrixImpl(sourcesTaskVector, targetsTaskVector, facade, result);
+}
+
+void FindWeightsMatrix(vector<TRoutingNodes> const & sources,
+                       vector<TRoutingNodes> const & targets, TRawDataFacade & facade,
+                       vector<EdgeWeight> & result)
+{
+  PhantomNodeArray sourcesTaskVector;
+  PhantomNodeArray targetsTaskVector;
+  FillPhantomNodes(sources, sourcesTaskVector);
+  FillPhantomNodes(targets, targetsTaskVector);
+
+  FindWeightsMatrixImpl(sourcesTaskVector, targetsTaskVector, facade, result);
 }
 
 bool FindSingleRoute(FeatureGraphNode const & source, FeatureGraphNode const & target,
@@ -88,6 +88,14 @@ using TRawDataFacade = OsrmRawDataFacade<QueryEdge::EdgeData>;
 void FindWeightsMatrix(TRoutingNodes const & sources, TRoutingNodes const & targets,
                        TRawDataFacade & facade, vector<EdgeWeight> & result);
 
+/*!
+ * \brief The same as above, but each source (target) is represented by several candidate nodes.
+ * The best of them is used for every pair. Unreachable pairs have INVALID_EDGE_WEIGHT weight.
+ */
+void FindWeightsMatrix(vector<TRoutingNodes> const & sources,
+                       vector<TRoutingNodes> const & targets, TRawDataFacade & facade,
+                       vector<EdgeWeight> & result);
+
 /*! Find single shortest path in a single MWM between 2 OSRM nodes
    * \param source Source OSRM graph node to make path.
    * \param taget Target OSRM graph node to make path.
@@ -19,6 +19,7 @@
 
 #include "coding/reader_wrapper.hpp"
 
+#include "base/fork_join_pool.hpp"
 #include "base/logging.hpp"
 #include "base/math.hpp"
 #include "base/scope_guard.hpp"
@@ -26,6 +27,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/limits.hpp"
+#include "std/map.hpp"
 #include "std/string.hpp"
 
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
@@ -66,10 +68,13 @@ bool OsrmRouter::CheckRoutingAbility(m2::PointD const & startPoint, m2::PointD c
 }
 
 OsrmRouter::OsrmRouter(Index * index, TCountryFileFn const & countryFileFn)
-    : m_pIndex(index), m_indexManager(countryFileFn, *index)
+    : m_pIndex(index), m_indexManager(countryFileFn, *index),
+      m_matrixThreadsCount(GetPlatform().CpuCores())
 {
 }
 
+OsrmRouter::~OsrmRouter() {}
+
 string OsrmRouter::GetName() const
 {
   return "vehicle";
@@ -282,12 +287,23 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   timer.Reset();
   delegate.OnProgress(kPointsFoundProgress);
 
-  // 4. Find route.
-  RawRoutingResult routingResult;
-
   // Manually load facade to avoid unmaping files we routing on.
   startMapping->LoadFacade();
 
+  return FindRouteByNodes(startTask, m_cachedTargets, startMapping, targetMapping, delegate, route);
+}
+
+OsrmRouter::ResultCode OsrmRouter::FindRouteByNodes(TFeatureGraphNodeVec const & startTask,
+                                                    TFeatureGraphNodeVec const & finalTask,
+                                                    TRoutingMappingPtr const & startMapping,
+                                                    TRoutingMappingPtr const & targetMapping,
+                                                    RouterDelegate const & delegate, Route & route)
+{
+  my::HighResTimer timer(true);
+
+  // 4. Find route.
+  RawRoutingResult routingResult;
+
   // 4.1 Single mwm case
   if (startMapping->GetMwmId() == targetMapping->GetMwmId())
   {
@@ -296,8 +312,7 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
                                   {
                                     indexPair.second->FreeCrossContext();
                                   });
-    if (!FindRouteFromCases(startTask, m_cachedTargets, startMapping->m_dataFacade,
-                            routingResult))
+    if (!FindRouteFromCases(startTask, finalTask, startMapping->m_dataFacade, routingResult))
     {
       return RouteNotFound;
     }
@@ -322,7 +337,7 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   {
     LOG(LINFO, ("Multiple mwm routing case"));
     TCheckedPath finalPath;
-    ResultCode code = CalculateCrossMwmPath(startTask, m_cachedTargets, m_indexManager, delegate,
+    ResultCode code = CalculateCrossMwmPath(startTask, finalTask, m_indexManager, delegate,
                                             finalPath);
     timer.Reset();
     INTERRUPT_WHEN_CANCELLED(delegate);
@@ -345,6 +360,108 @@ OsrmRouter::ResultCode OsrmRouter::CalculateRoute(m2::PointD const & startPoint,
   }
 }
 
+void OsrmRouter::SetMatrixThreadsCount(size_t count)
+{
+  if (count == m_matrixThreadsCount)
+    return;
+  m_matrixThreadsCount = count;
+  m_matrixPool.reset();
+}
+
+void OsrmRouter::FindMatrixNodes(vector<m2::PointD> const & points,
+                                 vector<TRoutingNodes> & nodes)
+{
+  nodes.assign(points.size(), TRoutingNodes());
+
+  // Keep mappings loaded until all the points are processed.
+  map<string, unique_ptr<MappingGuard>> guards;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TRoutingMappingPtr mapping = m_indexManager.GetMappingByPoint(points[i]);
+    if (!mapping->IsValid())
+      continue;
+    auto & guard = guards[mapping->GetCountryName()];
+    if (!guard)
+      guard.reset(new MappingGuard(mapping));
+
+    if (FindPhantomNodes(points[i], m2::PointD::Zero(), nodes[i], kMaxNodeCandidatesCount,
+                         mapping) != NoError)
+    {
+      nodes[i].clear();
+    }
+  }
+}
+
+IRouter::ResultCode OsrmRouter::CalculateTravelMatrix(vector<m2::PointD> const & sources,
+                                                      vector<m2::PointD> const & targets,
+                                                      bool withDistances,
+                                                      RouterDelegate const & delegate,
+                                                      TravelMatrix & matrix)
+{
+  my::HighResTimer timer(true);
+  matrix.Reset(sources.size(), targets.size(), withDistances);
+
+  vector<TRoutingNodes> sourceNodes;
+  vector<TRoutingNodes> targetNodes;
+  FindMatrixNodes(sources, sourceNodes);
+  FindMatrixNodes(targets, targetNodes);
+  INTERRUPT_WHEN_CANCELLED(delegate);
+  LOG(LINFO, ("Duration of the matrix points lookup", timer.ElapsedNano()));
+  timer.Reset();
+
+  if (!m_matrixPool)
+    m_matrixPool.reset(new threads::ForkJoinPool(m_matrixThreadsCount));
+
+  vector<EdgeWeight> weights;
+  ResultCode const code = FindWeightsMatrix(sourceNodes, targetNodes, m_indexManager,
+                                            *m_matrixPool, delegate, weights);
+  if (code != NoError)
+    return code;
+  LOG(LINFO, ("Duration of the", sources.size(), "x", targets.size(), "matrix calculation",
+              timer.ElapsedNano()));
+
+  for (size_t i = 0; i < weights.size(); ++i)
+  {
+    if (weights[i] != INVALID_EDGE_WEIGHT)
+      matrix.m_durations[i] = weights[i] * kOSRMWeightToSecondsMultiplier;
+  }
+
+  if (!withDistances)
+    return NoError;
+
+  timer.Reset();
+
+  // Nodes of points are already found, so routes are restored from them, and mappings
+  // are kept loaded until all the routes are restored.
+  map<string, unique_ptr<MappingGuard>> guards;
+  auto const getMapping = [&](TRoutingNodes const & nodes)
+  {
+    TRoutingMappingPtr mapping = m_indexManager.GetMappingById(nodes.front().mwmId);
+    auto & guard = guards[mapping->GetCountryName()];
+    if (!guard)
+      guard.reset(new MappingGuard(mapping));
+    return mapping;
+  };
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      if (!matrix.IsReachable(i, j))
+        continue;
+      Route route(GetName());
+      ResultCode const code =
+          FindRouteByNodes(sourceNodes[i], targetNodes[j], getMapping(sourceNodes[i]),
+                           getMapping(targetNodes[j]), delegate, route);
+      INTERRUPT_WHEN_CANCELLED(delegate);
+      if (code == NoError)
+        matrix.m_distances[matrix.GetIndex(i, j)] = route.GetTotalDistanceMeters();
+    }
+  }
+  LOG(LINFO, ("Duration of the matrix distances calculation", timer.ElapsedNano()));
+  return NoError;
+}
+
 IRouter::ResultCode OsrmRouter::FindPhantomNodes(m2::PointD const & point,
                                                  m2::PointD const & direction,
                                                  TFeatureGraphNodeVec & res, size_t maxCount,
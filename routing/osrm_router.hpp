@@ -5,9 +5,13 @@
 #include "routing/route.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_mapping.hpp"
+#include "routing/travel_matrix.hpp"
+
+#include "std/unique_ptr.hpp"
 
 
 namespace feature { class TypesHolder; }
+namespace threads { class ForkJoinPool; }
 
 class Index;
 struct RawRouteData;
@@ -28,6 +32,7 @@ public:
   typedef vector<double> GeomTurnCandidateT;
 
   OsrmRouter(Index * index, TCountryFileFn const & countryFileFn);
+  ~OsrmRouter() override;
 
   virtual string GetName() const override;
 
@@ -37,6 +42,27 @@ public:
 
   virtual void ClearState() override;
 
+  /// Sets memory budget in bytes of the decompressed adjacency of hot graph nodes
+  /// per mwm. 0 (default) disables the cache.
+  void SetAdjacencyCacheSize(size_t bytes) { m_indexManager.SetAdjacencyCacheSize(bytes); }
+
+  /*!
+   * \brief Calculates travel durations (and route lengths) from every source to every target.
+   * Sources and targets may be in different mwms. Rows of sources are calculated in parallel.
+   * \param withDistances Route lengths need unpacked routes, so a route is restored from
+   * the found graph nodes for every reachable pair, which is much slower than durations.
+   * \param matrix Result matrix. Pairs which points are not found or which have no route
+   * are unreachable.
+   * \return NoError or Cancelled.
+   */
+  ResultCode CalculateTravelMatrix(vector<m2::PointD> const & sources,
+                                   vector<m2::PointD> const & targets, bool withDistances,
+                                   RouterDelegate const & delegate, TravelMatrix & matrix);
+
+  /// Sets count of threads used by CalculateTravelMatrix. 0 means that the matrix is
+  /// calculated on the caller's thread. By default it's count of cpu cores.
+  void SetMatrixThreadsCount(size_t count);
+
   /*! Find single shortest path in a single MWM between 2 sets of edges
      * \param source: vector of source edges to make path
      * \param taget: vector of target edges to make path
@@ -89,6 +115,17 @@ protected:
                                 Route::TTurns & turnsDir, Route::TTimes & times);
 
 private:
+  /*!
+   * \brief Finds route between already found graph nodes of start and final points.
+   * Facades of the mappings must be loaded.
+   * \return NoError or error code
+   */
+  ResultCode FindRouteByNodes(TFeatureGraphNodeVec const & startTask,
+                              TFeatureGraphNodeVec const & finalTask,
+                              TRoutingMappingPtr const & startMapping,
+                              TRoutingMappingPtr const & targetMapping,
+                              RouterDelegate const & delegate, Route & route);
+
   /*!
    * \brief Makes route (points turns and other annotations) from the map cross structs and submits
    * them to @route class
@@ -102,9 +139,15 @@ private:
 
   Index const * m_pIndex;
 
+  /// Finds graph nodes of points for the travel matrix. Nodes of not found points are empty.
+  void FindMatrixNodes(vector<m2::PointD> const & points, vector<TRoutingNodes> & nodes);
+
   TFeatureGraphNodeVec m_cachedTargets;
   m2::PointD m_cachedTargetPoint;
 
   RoutingIndexManager m_indexManager;
+
+  size_t m_matrixThreadsCount;
+  unique_ptr<threads::ForkJoinPool> m_matrixPool;
 };
 }  // namespace routing
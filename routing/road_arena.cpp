@@ -0,0 +1,145 @@
+#include "routing/road_arena.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/cmath.hpp"
+
+namespace routing
+{
+// static
+double constexpr RoadArena::kTileSize;
+
+// static
+RoadArena::TTileId RoadArena::GetTileId(int32_t x, int32_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+// static
+m2::RectD RoadArena::GetTileRect(TTileId tile)
+{
+  double const x = static_cast<int32_t>(static_cast<uint32_t>(tile >> 32)) * kTileSize;
+  double const y = static_cast<int32_t>(static_cast<uint32_t>(tile)) * kTileSize;
+  return m2::RectD(x, y, x + kTileSize, y + kTileSize);
+}
+
+// static
+int32_t RoadArena::GetTileCoord(double c)
+{
+  return static_cast<int32_t>(floor(c / kTileSize));
+}
+
+// static
+RoadArena::RoadView RoadArena::MakeView(MwmRoads const & mwm, Road const & road)
+{
+  return {mwm.m_points.data() + road.m_firstPoint, road.m_pointsCount, road.m_speedKMPH,
+          road.m_bidirectional};
+}
+
+void RoadArena::AddTile(TTileId tile)
+{
+  m_tiles[tile];
+}
+
+void RoadArena::AddRoad(FeatureID const & featureId, bool bidirectional, double speedKMPH,
+                        m2::PointD const * points, size_t pointsCount)
+{
+  AddRoadImpl(featureId, bidirectional, speedKMPH, points, pointsCount);
+}
+
+void RoadArena::AddRoad(TTileId tile, FeatureID const & featureId, bool bidirectional,
+                        double speedKMPH, m2::PointD const * points, size_t pointsCount)
+{
+  BindRoadImpl(tile, AddRoadImpl(featureId, bidirectional, speedKMPH, points, pointsCount));
+}
+
+bool RoadArena::BindRoad(TTileId tile, FeatureID const & featureId)
+{
+  auto const mwmIt = m_mwms.find(featureId.m_mwmId);
+  if (mwmIt == m_mwms.end())
+    return false;
+
+  MwmRoads const & mwm = mwmIt->second;
+  auto const it = mwm.m_featureToRoad.find(featureId.m_index);
+  if (it == mwm.m_featureToRoad.end())
+    return false;
+
+  BindRoadImpl(tile, {&mwm, it->second});
+  return true;
+}
+
+void RoadArena::BindRoadImpl(TTileId tile, RoadRef const & ref)
+{
+  auto const it = m_tiles.find(tile);
+  ASSERT(it != m_tiles.end(), ("Tile is not added."));
+  if (ref.m_mwm->m_roads[ref.m_road].m_rect.IsIntersect(GetTileRect(tile)))
+    it->second.push_back(ref);
+}
+
+RoadArena::RoadRef RoadArena::AddRoadImpl(FeatureID const & featureId, bool bidirectional,
+                                          double speedKMPH, m2::PointD const * points,
+                                          size_t pointsCount)
+{
+  ASSERT_GREATER(pointsCount, 1, ());
+
+  MwmRoads & mwm = m_mwms[featureId.m_mwmId];
+  mwm.m_mwmId = featureId.m_mwmId;
+
+  auto const res = mwm.m_featureToRoad.insert(
+      make_pair(featureId.m_index, static_cast<uint32_t>(mwm.m_roads.size())));
+  if (res.second)
+  {
+    Road road;
+    road.m_featureIndex = featureId.m_index;
+    road.m_firstPoint = static_cast<uint32_t>(mwm.m_points.size());
+    road.m_pointsCount = static_cast<uint32_t>(pointsCount);
+    road.m_speedKMPH = static_cast<float>(speedKMPH);
+    road.m_bidirectional = bidirectional;
+    for (size_t i = 0; i < pointsCount; ++i)
+      road.m_rect.Add(points[i]);
+
+    mwm.m_points.insert(mwm.m_points.end(), points, points + pointsCount);
+    mwm.m_roads.push_back(road);
+  }
+
+  return {&mwm, res.first->second};
+}
+
+bool RoadArena::GetRoad(FeatureID const & featureId, RoadView & road) const
+{
+  auto const mwmIt = m_mwms.find(featureId.m_mwmId);
+  if (mwmIt == m_mwms.end())
+    return false;
+
+  MwmRoads const & mwm = mwmIt->second;
+  auto const it = mwm.m_featureToRoad.find(featureId.m_index);
+  if (it == mwm.m_featureToRoad.end())
+    return false;
+
+  road = MakeView(mwm, mwm.m_roads[it->second]);
+  return true;
+}
+
+size_t RoadArena::GetRoadsCount() const
+{
+  size_t count = 0;
+  for (auto const & mwm : m_mwms)
+    count += mwm.second.m_roads.size();
+  return count;
+}
+
+size_t RoadArena::GetPointsCount() const
+{
+  size_t count = 0;
+  for (auto const & mwm : m_mwms)
+    count += mwm.second.m_points.size();
+  return count;
+}
+
+void RoadArena::Clear()
+{
+  m_mwms.clear();
+  m_tiles.clear();
+  m_refs.clear();
+}
+}  // namespace routing
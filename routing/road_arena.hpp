@@ -0,0 +1,160 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// Geometry and attributes of roads kept for a routing session.
+///
+/// Roads of every mwm are stored compactly: points of all roads are in one array and
+/// a road refers to its range of points, so a loaded road costs no allocations and
+/// no feature decoding. Roads are added by square tiles of the mercator plane, a tile
+/// knows all the roads intersecting it once it is loaded.
+class RoadArena
+{
+public:
+  using TTileId = uint64_t;
+
+  // Tile side in mercator units, about 1 km on the equator.
+  static double constexpr kTileSize = 0.01;
+
+  struct Road
+  {
+    uint32_t m_featureIndex;
+    uint32_t m_firstPoint;
+    uint32_t m_pointsCount;
+    float m_speedKMPH;
+    bool m_bidirectional;
+    m2::RectD m_rect;
+  };
+
+  /// Read-only view of a road, valid until the next call of a non-const method.
+  struct RoadView
+  {
+    m2::PointD const * m_points;
+    size_t m_pointsCount;
+    double m_speedKMPH;
+    bool m_bidirectional;
+  };
+
+  static TTileId GetTileId(int32_t x, int32_t y);
+  static m2::RectD GetTileRect(TTileId tile);
+
+  /// Calls toDo(TTileId) for all tiles intersecting the rect.
+  template <typename ToDo>
+  static void ForEachTileInRect(m2::RectD const & rect, ToDo && toDo)
+  {
+    int32_t const minX = GetTileCoord(rect.minX());
+    int32_t const maxX = GetTileCoord(rect.maxX());
+    int32_t const minY = GetTileCoord(rect.minY());
+    int32_t const maxY = GetTileCoord(rect.maxY());
+    for (int32_t y = minY; y <= maxY; ++y)
+    {
+      for (int32_t x = minX; x <= maxX; ++x)
+        toDo(GetTileId(x, y));
+    }
+  }
+
+  inline bool IsTileLoaded(TTileId tile) const { return m_tiles.count(tile) != 0; }
+
+  /// Marks the tile as loaded, roads are added to it with AddRoad().
+  void AddTile(TTileId tile);
+
+  /// Adds the road to the arena if it's not there yet.
+  void AddRoad(FeatureID const & featureId, bool bidirectional, double speedKMPH,
+               m2::PointD const * points, size_t pointsCount);
+
+  /// Adds the road and binds it to the loaded tile if the road intersects the tile.
+  void AddRoad(TTileId tile, FeatureID const & featureId, bool bidirectional, double speedKMPH,
+               m2::PointD const * points, size_t pointsCount);
+
+  /// Binds already added road to the loaded tile if the road intersects the tile.
+  /// @return False if the road is not added.
+  bool BindRoad(TTileId tile, FeatureID const & featureId);
+
+  /// @return False if the road is not loaded.
+  bool GetRoad(FeatureID const & featureId, RoadView & road) const;
+
+  /// Calls toDo(FeatureID const &, RoadView const &) once for every road of loaded tiles
+  /// which limit rect intersects the rect.
+  template <typename ToDo>
+  void ForEachRoadInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    m_refs.clear();
+    ForEachTileInRect(rect, [this, &rect](TTileId tile)
+    {
+      auto const it = m_tiles.find(tile);
+      if (it == m_tiles.end())
+        return;
+
+      // A road is in several tiles when it crosses tiles borders. Rects are small,
+      // so there are few roads and linear search is enough to skip duplicates.
+      size_t const prevCount = m_refs.size();
+      for (RoadRef const & ref : it->second)
+      {
+        if (ref.m_mwm->m_roads[ref.m_road].m_rect.IsIntersect(rect) &&
+            find(m_refs.begin(), m_refs.begin() + prevCount, ref) == m_refs.begin() + prevCount)
+        {
+          m_refs.push_back(ref);
+        }
+      }
+    });
+
+    for (RoadRef const & ref : m_refs)
+    {
+      Road const & road = ref.m_mwm->m_roads[ref.m_road];
+      toDo(FeatureID(ref.m_mwm->m_mwmId, road.m_featureIndex), MakeView(*ref.m_mwm, road));
+    }
+  }
+
+  size_t GetRoadsCount() const;
+  size_t GetPointsCount() const;
+  inline size_t GetTilesCount() const { return m_tiles.size(); }
+
+  void Clear();
+
+private:
+  struct MwmRoads
+  {
+    MwmSet::MwmId m_mwmId;
+    vector<m2::PointD> m_points;
+    vector<Road> m_roads;
+    unordered_map<uint32_t, uint32_t> m_featureToRoad;
+  };
+
+  struct RoadRef
+  {
+    MwmRoads const * m_mwm;
+    uint32_t m_road;
+
+    inline bool operator==(RoadRef const & rhs) const
+    {
+      return m_mwm == rhs.m_mwm && m_road == rhs.m_road;
+    }
+  };
+
+  static int32_t GetTileCoord(double c);
+  static RoadView MakeView(MwmRoads const & mwm, Road const & road);
+
+  RoadRef AddRoadImpl(FeatureID const & featureId, bool bidirectional, double speedKMPH,
+                      m2::PointD const * points, size_t pointsCount);
+  void BindRoadImpl(TTileId tile, RoadRef const & ref);
+
+  map<MwmSet::MwmId, MwmRoads> m_mwms;
+  unordered_map<TTileId, vector<RoadRef>> m_tiles;
+
+  // Buffer for ForEachRoadInRect().
+  mutable vector<RoadRef> m_refs;
+};
+}  // namespace routing
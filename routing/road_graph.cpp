@@ -163,11 +163,15 @@ IRoadGraph::CrossEdgesLoader::CrossEdgesLoader(m2::PointD const & cross, TEdgeVe
 
 void IRoadGraph::CrossEdgesLoader::operator()(FeatureID const & featureId, RoadInfo const & roadInfo)
 {
-  size_t const numPoints = roadInfo.m_points.size();
+  (*this)(featureId, roadInfo.m_points.data(), roadInfo.m_points.size());
+}
 
+void IRoadGraph::CrossEdgesLoader::operator()(FeatureID const & featureId,
+                                              m2::PointD const * points, size_t numPoints)
+{
   for (size_t i = 0; i < numPoints; ++i)
   {
-    m2::PointD const & p = roadInfo.m_points[i];
+    m2::PointD const & p = points[i];
 
     if (!PointsAlmostEqualAbs(m_cross, p))
       continue;
@@ -177,7 +181,7 @@ void IRoadGraph::CrossEdgesLoader::operator()(FeatureID const & featureId, RoadI
       //               p
       // o------------>o
 
-      m_outgoingEdges.emplace_back(featureId, false /* forward */, i - 1, p, roadInfo.m_points[i - 1]);
+      m_outgoingEdges.emplace_back(featureId, false /* forward */, i - 1, p, points[i - 1]);
     }
 
     if (i < numPoints - 1)
@@ -185,7 +189,7 @@ void IRoadGraph::CrossEdgesLoader::operator()(FeatureID const & featureId, RoadI
       // p
       // o------------>o
 
-      m_outgoingEdges.emplace_back(featureId, true /* forward */, i, p, roadInfo.m_points[i + 1]);
+      m_outgoingEdges.emplace_back(featureId, true /* forward */, i, p, points[i + 1]);
     }
   }
 }
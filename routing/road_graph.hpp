@@ -106,6 +106,7 @@ public:
     CrossEdgesLoader(m2::PointD const & cross, TEdgeVector & outgoingEdges);
 
     void operator()(FeatureID const & featureId, RoadInfo const & roadInfo);
+    void operator()(FeatureID const & featureId, m2::PointD const * points, size_t numPoints);
 
   private:
     m2::PointD const m_cross;
@@ -0,0 +1,297 @@
+#include "routing/road_graph_landmarks.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/limits.hpp"
+#include "std/sstream.hpp"
+
+#include "defines.hpp"
+
+namespace routing
+{
+namespace
+{
+uint8_t constexpr kLandmarksVersion = 1;
+
+// Unit of distances is stored in milliseconds.
+double constexpr kMillisecondsPerSecond = 1000.0;
+}  // namespace
+
+string DebugPrint(RoadPointId const & id)
+{
+  ostringstream out;
+  out << "RoadPointId [ " << id.m_featureId << ", " << id.m_pointId << " ]";
+  return out.str();
+}
+
+bool GetRoadPointIds(IRoadGraph const & graph, vector<Junction> const & junctions,
+                     vector<RoadPointId> & ids)
+{
+  ids.clear();
+  ids.reserve(junctions.size());
+
+  IRoadGraph::TEdgeVector edges;
+  for (Junction const & junction : junctions)
+  {
+    edges.clear();
+    graph.GetOutgoingEdges(junction, edges);
+
+    // Points of edges are almost equal to the junction, the exactly equal one is preferred.
+    bool found = false;
+    RoadPointId id;
+    for (Edge const & e : edges)
+    {
+      if (e.IsFake())
+        continue;
+      RoadPointId const candidate(e.GetFeatureId().m_index,
+                                  e.IsForward() ? e.GetSegId() : e.GetSegId() + 1);
+      if (e.GetStartJunction() == junction)
+      {
+        id = candidate;
+        found = true;
+        break;
+      }
+      if (!found)
+      {
+        id = candidate;
+        found = true;
+      }
+    }
+
+    if (!found)
+    {
+      LOG(LWARNING, ("No real roads from", junction));
+      return false;
+    }
+    ids.push_back(id);
+  }
+  return true;
+}
+
+// Format of the section:
+// uint8_t version, varuint unit in milliseconds, varuint landmarks count (K),
+// varuint vertices count (N), K varuint indices of landmarks in vertices and N vertices
+// sorted by ids. Every vertex is a varuint delta of the feature id from the previous vertex,
+// varuint point id, K varuint distances from landmarks and K varuint distances to landmarks.
+// Distances are in units of the table, they are rounded down by BuildLandmarks.
+void SerializeRoadGraphLandmarks(TRoadGraphLandmarks const & landmarks,
+                                 vector<RoadPointId> const & ids, Writer & writer)
+{
+  vector<Junction> const & vertices = landmarks.GetVertices();
+  CHECK_EQUAL(vertices.size(), ids.size(), ());
+
+  size_t const landmarksCount = landmarks.GetLandmarksCount();
+  uint64_t const unit = static_cast<uint64_t>(round(landmarks.GetUnit() * kMillisecondsPerSecond));
+  CHECK_GREATER(unit, 0, ("Unit of distances is less than a millisecond."));
+
+  vector<size_t> order(vertices.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  sort(order.begin(), order.end(), [&ids](size_t l, size_t r) { return ids[l] < ids[r]; });
+
+  // Positions of vertices in the written order.
+  vector<uint32_t> positions(vertices.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    positions[order[i]] = static_cast<uint32_t>(i);
+
+  WriteToSink(writer, kLandmarksVersion);
+  WriteVarUint(writer, unit);
+  WriteVarUint(writer, static_cast<uint32_t>(landmarksCount));
+  WriteVarUint(writer, static_cast<uint32_t>(vertices.size()));
+
+  for (Junction const & landmark : landmarks.GetLandmarks())
+  {
+    auto const it = lower_bound(vertices.begin(), vertices.end(), landmark);
+    ASSERT(it != vertices.end() && *it == landmark, ());
+    WriteVarUint(writer, positions[distance(vertices.begin(), it)]);
+  }
+
+  auto const & from = landmarks.GetFromDistances();
+  auto const & to = landmarks.GetToDistances();
+  uint32_t prevFeatureId = 0;
+  for (size_t i : order)
+  {
+    RoadPointId const & id = ids[i];
+    WriteVarUint(writer, id.m_featureId - prevFeatureId);
+    WriteVarUint(writer, id.m_pointId);
+    prevFeatureId = id.m_featureId;
+
+    for (size_t j = 0; j < landmarksCount; ++j)
+      WriteVarUint(writer, from[i * landmarksCount + j]);
+    for (size_t j = 0; j < landmarksCount; ++j)
+      WriteVarUint(writer, to[i * landmarksCount + j]);
+  }
+}
+
+bool DeserializeRoadGraphLandmarks(Reader const & reader, TGetRoadPointFn const & getPoint,
+                                   TRoadGraphLandmarks & landmarks)
+{
+  using TDistance = TRoadGraphLandmarks::TDistance;
+
+  landmarks.Clear();
+
+  ReaderSource<ReaderPtr<Reader>> src(reader.CreateSubReader(0, reader.Size()));
+  uint8_t const version = ReadPrimitiveFromSource<uint8_t>(src);
+  if (version != kLandmarksVersion)
+  {
+    LOG(LWARNING, ("Unknown landmarks version:", version));
+    return false;
+  }
+
+  uint64_t const unit = ReadVarUint<uint64_t>(src);
+  uint32_t const landmarksCount = ReadVarUint<uint32_t>(src);
+  uint32_t const verticesCount = ReadVarUint<uint32_t>(src);
+  if (unit == 0)
+    return false;
+
+  vector<uint32_t> indices(landmarksCount);
+  for (auto & index : indices)
+  {
+    index = ReadVarUint<uint32_t>(src);
+    if (index >= verticesCount)
+      return false;
+  }
+
+  vector<Junction> vertices;
+  vertices.reserve(verticesCount);
+  vector<TDistance> from(static_cast<size_t>(landmarksCount) * verticesCount);
+  vector<TDistance> to(from.size());
+  RoadPointId id;
+  for (size_t i = 0; i < verticesCount; ++i)
+  {
+    id.m_featureId += ReadVarUint<uint32_t>(src);
+    id.m_pointId = ReadVarUint<uint32_t>(src);
+    m2::PointD point;
+    if (!getPoint(id, point))
+    {
+      LOG(LWARNING, ("Landmarks don't match roads, no point", id));
+      return false;
+    }
+    vertices.emplace_back(point);
+
+    for (size_t j = 0; j < landmarksCount; ++j)
+      from[i * landmarksCount + j] = ReadVarUint<TDistance>(src);
+    for (size_t j = 0; j < landmarksCount; ++j)
+      to[i * landmarksCount + j] = ReadVarUint<TDistance>(src);
+  }
+
+  vector<Junction> points;
+  points.reserve(landmarksCount);
+  for (uint32_t const index : indices)
+    points.push_back(vertices[index]);
+
+  // The table is keyed by junctions, so rows are reordered.
+  vector<size_t> order(verticesCount);
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  sort(order.begin(), order.end(),
+       [&vertices](size_t l, size_t r) { return vertices[l] < vertices[r]; });
+
+  vector<Junction> sortedVertices;
+  sortedVertices.reserve(verticesCount);
+  vector<TDistance> sortedFrom;
+  sortedFrom.reserve(from.size());
+  vector<TDistance> sortedTo;
+  sortedTo.reserve(to.size());
+  for (size_t i : order)
+  {
+    if (!sortedVertices.empty() && sortedVertices.back() == vertices[i])
+    {
+      LOG(LWARNING, ("Duplicate landmarks vertex", vertices[i]));
+      return false;
+    }
+    sortedVertices.push_back(vertices[i]);
+    sortedFrom.insert(sortedFrom.end(), from.begin() + i * landmarksCount,
+                      from.begin() + (i + 1) * landmarksCount);
+    sortedTo.insert(sortedTo.end(), to.begin() + i * landmarksCount,
+                    to.begin() + (i + 1) * landmarksCount);
+  }
+
+  landmarks.Set(unit / kMillisecondsPerSecond, move(points), move(sortedVertices),
+                move(sortedFrom), move(sortedTo));
+  return true;
+}
+
+RoadGraphLandmarksLoader::RoadGraphLandmarksLoader(Index const & index) : m_index(index) {}
+
+shared_ptr<TRoadGraphLandmarks const> RoadGraphLandmarksLoader::Get(MwmSet::MwmId const & mwmId)
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  // Drop landmarks of deregistered mwms.
+  for (auto it = m_landmarks.begin(); it != m_landmarks.end();)
+  {
+    if (it->first.IsAlive())
+      ++it;
+    else
+      it = m_landmarks.erase(it);
+  }
+
+  auto const it = m_landmarks.find(mwmId);
+  if (it != m_landmarks.end())
+    return it->second;
+
+  MwmSet::MwmHandle const handle = m_index.GetMwmHandleById(mwmId);
+  if (!handle.IsAlive())
+    return nullptr;
+
+  shared_ptr<TRoadGraphLandmarks> landmarks;
+  MwmValue const * value = handle.GetValue<MwmValue>();
+  if (value->m_cont.IsExist(ROUTING_LANDMARKS_FILE_TAG))
+  {
+    try
+    {
+      // Vertices are sorted by features, so every feature is read once.
+      Index::FeaturesLoaderGuard guard(m_index, mwmId);
+      FeatureType ft;
+      uint32_t loadedFeatureId = numeric_limits<uint32_t>::max();
+      auto const getPoint = [&](RoadPointId const & id, m2::PointD & point)
+      {
+        if (id.m_featureId != loadedFeatureId)
+        {
+          guard.GetFeatureByIndex(id.m_featureId, ft);
+          ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+          loadedFeatureId = id.m_featureId;
+        }
+        if (ft.GetFeatureType() != feature::GEOM_LINE || id.m_pointId >= ft.GetPointsCount())
+          return false;
+        point = ft.GetPoint(id.m_pointId);
+        return true;
+      };
+
+      landmarks = make_shared<TRoadGraphLandmarks>();
+      if (!DeserializeRoadGraphLandmarks(*value->m_cont.GetReader(ROUTING_LANDMARKS_FILE_TAG).GetPtr(),
+                                         getPoint, *landmarks))
+      {
+        landmarks.reset();
+      }
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LERROR, ("Can't read landmarks of", value->GetCountryFileName(), ":", e.Msg()));
+      landmarks.reset();
+    }
+  }
+
+  m_landmarks[mwmId] = landmarks;
+  return landmarks;
+}
+
+void RoadGraphLandmarksLoader::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_landmarks.clear();
+}
+
+}  // namespace routing
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "routing/base/astar_landmarks.hpp"
+#include "routing/road_graph.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+class Index;
+class Reader;
+class Writer;
+
+namespace routing
+{
+
+/// Landmarks of a road graph. Distances are travel times in kRoadGraphLandmarksUnit
+/// (see BuildRoadGraphLandmarks in routing_algorithm.hpp).
+using TRoadGraphLandmarks = LandmarksTable<Junction>;
+
+/// Unit of distances of road graph landmarks, in seconds.
+double constexpr kRoadGraphLandmarksUnit = 0.1;
+
+/// Id of a point of a road feature in an mwm.
+struct RoadPointId
+{
+  RoadPointId() = default;
+  RoadPointId(uint32_t featureId, uint32_t pointId) : m_featureId(featureId), m_pointId(pointId) {}
+
+  inline bool operator<(RoadPointId const & r) const
+  {
+    if (m_featureId != r.m_featureId)
+      return m_featureId < r.m_featureId;
+    return m_pointId < r.m_pointId;
+  }
+
+  inline bool operator==(RoadPointId const & r) const
+  {
+    return m_featureId == r.m_featureId && m_pointId == r.m_pointId;
+  }
+
+  uint32_t m_featureId = 0;
+  uint32_t m_pointId = 0;
+};
+
+string DebugPrint(RoadPointId const & id);
+
+/// Finds ids of points of real roads which are |junctions|.
+/// @return false if some junction has no outgoing real roads.
+bool GetRoadPointIds(IRoadGraph const & graph, vector<Junction> const & junctions,
+                     vector<RoadPointId> & ids);
+
+/// |ids| are ids of landmarks.GetVertices(), see GetRoadPointIds().
+void SerializeRoadGraphLandmarks(TRoadGraphLandmarks const & landmarks,
+                                 vector<RoadPointId> const & ids, Writer & writer);
+
+/// Returns false if there is no such point.
+using TGetRoadPointFn = function<bool(RoadPointId const & id, m2::PointD & point)>;
+
+/// |getPoint| is called for ids in the increasing order.
+/// @return false if the data has unknown format or some point can't be found.
+bool DeserializeRoadGraphLandmarks(Reader const & reader, TGetRoadPointFn const & getPoint,
+                                   TRoadGraphLandmarks & landmarks);
+
+/// Loads landmarks from ROUTING_LANDMARKS_FILE_TAG sections of mwms and keeps them.
+class RoadGraphLandmarksLoader
+{
+public:
+  explicit RoadGraphLandmarksLoader(Index const & index);
+
+  /// @return nullptr if the mwm is not alive or it has no landmarks.
+  shared_ptr<TRoadGraphLandmarks const> Get(MwmSet::MwmId const & mwmId);
+
+  void Clear();
+
+private:
+  Index const & m_index;
+
+  mutex m_mutex;
+  map<MwmSet::MwmId, shared_ptr<TRoadGraphLandmarks const>> m_landmarks;
+};
+
+}  // namespace routing
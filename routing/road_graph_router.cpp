@@ -276,4 +276,13 @@ unique_ptr<IRouter> CreatePedestrianAStarBidirectionalRouter(Index & index, TCou
   return router;
 }
 
+unique_ptr<IRouter> CreatePedestrianAStarLandmarksRouter(Index & index, TCountryFileFn const & countryFileFn)
+{
+  unique_ptr<IVehicleModelFactory> vehicleModelFactory(new PedestrianModelFactory());
+  unique_ptr<IRoutingAlgorithm> algorithm(new AStarLandmarksRoutingAlgorithm(index));
+  unique_ptr<IDirectionsEngine> directionsEngine(new PedestrianDirectionsEngine());
+  unique_ptr<IRouter> router(new RoadGraphRouter("astar-landmarks-pedestrian", index, countryFileFn, move(vehicleModelFactory), move(algorithm), move(directionsEngine)));
+  return router;
+}
+
 }  // namespace routing
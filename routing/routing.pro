@@ -16,6 +16,7 @@ SOURCES += \
     async_router.cpp \
     base/followed_polyline.cpp \
     car_model.cpp \
+    cross_mwm_cache.cpp \
     cross_mwm_road_graph.cpp \
     cross_mwm_router.cpp \
     cross_routing_context.cpp \
@@ -29,7 +30,9 @@ SOURCES += \
     osrm_router.cpp \
     pedestrian_directions.cpp \
     pedestrian_model.cpp \
+    road_arena.cpp \
     road_graph.cpp \
+    road_graph_landmarks.cpp \
     road_graph_router.cpp \
     route.cpp \
     router.cpp \
@@ -38,6 +41,7 @@ SOURCES += \
     routing_mapping.cpp \
     routing_session.cpp \
     speed_camera.cpp \
+    travel_matrix.cpp \
     turns.cpp \
     turns_generator.cpp \
     turns_notification_manager.cpp \
@@ -48,8 +52,10 @@ SOURCES += \
 HEADERS += \
     async_router.hpp \
     base/astar_algorithm.hpp \
+    base/astar_landmarks.hpp \
     base/followed_polyline.hpp \
     car_model.hpp \
+    cross_mwm_cache.hpp \
     cross_mwm_road_graph.hpp \
     cross_mwm_router.hpp \
     cross_routing_context.hpp \
@@ -65,7 +71,9 @@ HEADERS += \
     osrm_router.hpp \
     pedestrian_directions.hpp \
     pedestrian_model.hpp \
+    road_arena.hpp \
     road_graph.hpp \
+    road_graph_landmarks.hpp \
     road_graph_router.hpp \
     route.hpp \
     router.hpp \
@@ -75,6 +83,7 @@ HEADERS += \
     routing_session.hpp \
     routing_settings.hpp \
     speed_camera.hpp \
+    travel_matrix.hpp \
     turns.hpp \
     turns_generator.hpp \
     turns_notification_manager.hpp \
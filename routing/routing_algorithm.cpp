@@ -1,12 +1,17 @@
 #include "routing/road_graph.hpp"
 #include "routing/routing_algorithm.hpp"
 #include "routing/base/astar_algorithm.hpp"
+#include "routing/base/astar_landmarks.hpp"
 #include "routing/base/astar_progress.hpp"
 
 #include "base/assert.hpp"
+#include "base/logging.hpp"
 
 #include "geometry/mercator.hpp"
 
+#include "std/limits.hpp"
+#include "std/set.hpp"
+
 namespace routing
 {
 
@@ -14,6 +19,9 @@ namespace
 {
 float constexpr kProgressInterval = 2;
 
+// Depth of the search for temporary junctions around start and final positions.
+size_t constexpr kFakeJunctionsDepth = 3;
+
 double constexpr KMPH2MPS = 1000.0 / (60 * 60);
 
 inline double TimeBetweenSec(Junction const & j1, Junction const & j2, double speedMPS)
@@ -38,15 +46,29 @@ private:
 };
 
 /// A wrapper around IRoadGraph, which makes it possible to use IRoadGraph with astar algorithms.
+/// When |mwmId| is valid, real edges of other mwms are skipped.
 class RoadGraph
 {
 public:
   using TVertexType = Junction;
   using TEdgeType = WeightedEdge;
 
-  RoadGraph(IRoadGraph const & roadGraph)
+  struct SkippedEdge
+  {
+    SkippedEdge(Junction const & from, Junction const & to, double weight)
+      : m_from(from), m_to(to), m_weight(weight)
+    {
+    }
+
+    Junction m_from;
+    Junction m_to;
+    double m_weight;
+  };
+
+  RoadGraph(IRoadGraph const & roadGraph, MwmSet::MwmId const & mwmId = MwmSet::MwmId())
     : m_roadGraph(roadGraph)
     , m_maxSpeedMPS(roadGraph.GetMaxSpeedKMPH() * KMPH2MPS)
+    , m_mwmId(mwmId)
   {}
 
   void GetOutgoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
@@ -60,9 +82,12 @@ public:
     for (auto const & e : edges)
     {
       ASSERT_EQUAL(v, e.GetStartJunction(), ());
-
       double const speedMPS = m_roadGraph.GetSpeedKMPH(e) * KMPH2MPS;
-      adj.emplace_back(e.GetEndJunction(), TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS));
+      double const weight = TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS);
+      if (IsSkipped(e, weight))
+        continue;
+
+      adj.emplace_back(e.GetEndJunction(), weight);
     }
   }
 
@@ -77,9 +102,12 @@ public:
     for (auto const & e : edges)
     {
       ASSERT_EQUAL(v, e.GetEndJunction(), ());
-
       double const speedMPS = m_roadGraph.GetSpeedKMPH(e) * KMPH2MPS;
-      adj.emplace_back(e.GetStartJunction(), TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS));
+      double const weight = TimeBetweenSec(e.GetStartJunction(), e.GetEndJunction(), speedMPS);
+      if (IsSkipped(e, weight))
+        continue;
+
+      adj.emplace_back(e.GetStartJunction(), weight);
     }
   }
 
@@ -88,24 +116,102 @@ public:
     return TimeBetweenSec(v, w, m_maxSpeedMPS);
   }
 
+  // Returns the weight of the path or infinity if some edge of the path is skipped.
+  double GetPathWeight(vector<Junction> const & path) const
+  {
+    double weight = 0.0;
+    vector<WeightedEdge> adj;
+    for (size_t i = 0; i + 1 < path.size(); ++i)
+    {
+      GetOutgoingEdgesList(path[i], adj);
+      double edgeWeight = numeric_limits<double>::infinity();
+      for (auto const & edge : adj)
+      {
+        if (edge.GetTarget() == path[i + 1])
+          edgeWeight = min(edgeWeight, edge.GetWeight());
+      }
+      weight += edgeWeight;
+    }
+    return weight;
+  }
+
+  inline vector<SkippedEdge> const & GetSkippedEdges() const { return m_skippedEdges; }
+
 private:
+  bool IsSkipped(Edge const & e, double weight) const
+  {
+    if (!m_mwmId.IsAlive() || e.IsFake() || e.GetFeatureId().m_mwmId == m_mwmId)
+      return false;
+    m_skippedEdges.emplace_back(e.GetStartJunction(), e.GetEndJunction(), weight);
+    return true;
+  }
+
   IRoadGraph const & m_roadGraph;
   double const m_maxSpeedMPS;
+  MwmSet::MwmId const m_mwmId;
+  mutable vector<SkippedEdge> m_skippedEdges;
 };
 
 typedef AStarAlgorithm<RoadGraph> TAlgorithmImpl;
 
-IRoutingAlgorithm::Result Convert(TAlgorithmImpl::Result value)
+typedef AStarLandmarksGraph<RoadGraph> TLandmarksGraph;
+typedef AStarAlgorithm<TLandmarksGraph> TLandmarksAlgorithmImpl;
+
+template <typename TResult>
+IRoutingAlgorithm::Result Convert(TResult value)
 {
   switch (value)
   {
-  case TAlgorithmImpl::Result::OK: return IRoutingAlgorithm::Result::OK;
-  case TAlgorithmImpl::Result::NoPath: return IRoutingAlgorithm::Result::NoPath;
-  case TAlgorithmImpl::Result::Cancelled: return IRoutingAlgorithm::Result::Cancelled;
+  case TResult::OK: return IRoutingAlgorithm::Result::OK;
+  case TResult::NoPath: return IRoutingAlgorithm::Result::NoPath;
+  case TResult::Cancelled: return IRoutingAlgorithm::Result::Cancelled;
   }
   ASSERT(false, ("Unexpected TAlgorithmImpl::Result value:", value));
   return IRoutingAlgorithm::Result::NoPath;
 }
+
+// Returns mwm of the closest real edge outgoing from the junction, which may be a fake one.
+MwmSet::MwmId FindMwmId(IRoadGraph const & graph, Junction const & junction)
+{
+  IRoadGraph::TEdgeVector edges;
+  vector<Junction> junctions = {junction};
+  for (size_t i = 0; i < junctions.size() && i <= kFakeJunctionsDepth; ++i)
+  {
+    graph.GetOutgoingEdges(junctions[i], edges);
+    for (auto const & e : edges)
+    {
+      if (!e.IsFake())
+        return e.GetFeatureId().m_mwmId;
+      junctions.push_back(e.GetEndJunction());
+    }
+  }
+  return MwmSet::MwmId();
+}
+
+// Collects junctions which are not farther than kFakeJunctionsDepth edges from the junction.
+// Temporary junctions of start and final positions are among them.
+void CollectJunctionsAround(RoadGraph const & graph, Junction const & junction,
+                            vector<Junction> & junctions)
+{
+  set<Junction> visited = {junction};
+  vector<Junction> wave = {junction};
+  vector<WeightedEdge> adj;
+  for (size_t depth = 0; depth < kFakeJunctionsDepth && !wave.empty(); ++depth)
+  {
+    vector<Junction> next;
+    for (auto const & v : wave)
+    {
+      graph.GetOutgoingEdgesList(v, adj);
+      for (auto const & e : adj)
+      {
+        if (visited.insert(e.GetTarget()).second)
+          next.push_back(e.GetTarget());
+      }
+    }
+    junctions.insert(junctions.end(), next.begin(), next.end());
+    wave.swap(next);
+  }
+}
 }  // namespace
 
 string DebugPrint(IRoutingAlgorithm::Result const & value)
@@ -176,4 +282,72 @@ IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRoute(
   return Convert(res);
 }
 
+// *************************** AStar-bidirectional with landmarks routing algorithm implementation ***
+
+AStarLandmarksRoutingAlgorithm::AStarLandmarksRoutingAlgorithm(Index const & index)
+  : m_loader(index)
+{
+}
+
+IRoutingAlgorithm::Result AStarLandmarksRoutingAlgorithm::CalculateRoute(
+    IRoadGraph const & graph, Junction const & startPos, Junction const & finalPos,
+    RouterDelegate const & delegate, vector<Junction> & path)
+{
+  MwmSet::MwmId const mwmId = FindMwmId(graph, startPos);
+  shared_ptr<TRoadGraphLandmarks const> landmarks;
+  if (mwmId.IsAlive() && mwmId == FindMwmId(graph, finalPos))
+    landmarks = m_loader.Get(mwmId);
+  if (!landmarks || landmarks->IsEmpty())
+    return m_fallback.CalculateRoute(graph, startPos, finalPos, delegate, path);
+
+  RoadGraph const roadGraph(graph, mwmId);
+  vector<Junction> fakeJunctions;
+  CollectJunctionsAround(roadGraph, startPos, fakeJunctions);
+  CollectJunctionsAround(roadGraph, finalPos, fakeJunctions);
+  TLandmarksGraph const landmarksGraph(roadGraph, *landmarks, startPos, finalPos, fakeJunctions);
+
+  AStarProgress progress(0, 100);
+
+  function<void(Junction const &, Junction const &)> onVisitJunctionFn =
+      [&delegate, &progress](Junction const & junction, Junction const & target)
+  {
+    delegate.OnPointCheck(junction.GetPoint());
+    auto const lastValue = progress.GetLastValue();
+    auto const newValue =
+        progress.GetProgressForBidirectedAlgo(junction.GetPoint(), target.GetPoint());
+    if (newValue - lastValue > kProgressInterval)
+      delegate.OnProgress(newValue);
+  };
+
+  my::Cancellable const & cancellable = delegate;
+  progress.Initialize(startPos.GetPoint(), finalPos.GetPoint());
+  TLandmarksAlgorithmImpl::Result const res = TLandmarksAlgorithmImpl().FindPathBidirectional(
+      landmarksGraph, startPos, finalPos, path, cancellable, onVisitJunctionFn);
+
+  if (res == TLandmarksAlgorithmImpl::Result::Cancelled)
+    return Convert(res);
+
+  // The search met roads which are not covered by landmarks. The plain search is needed
+  // only if a path through them may be shorter than the found one.
+  for (auto const & edge : roadGraph.GetSkippedEdges())
+    landmarksGraph.AddSkippedEdge(edge.m_from, edge.m_to, edge.m_weight);
+  double const skippedPathsLowerBound = landmarksGraph.GetSkippedPathsLowerBound();
+  double const pathWeight = res == TLandmarksAlgorithmImpl::Result::OK
+                                ? roadGraph.GetPathWeight(path)
+                                : numeric_limits<double>::infinity();
+  if (skippedPathsLowerBound < pathWeight)
+  {
+    LOG(LDEBUG, ("Route may leave landmarks area, fall back to the plain search."));
+    path.clear();
+    return m_fallback.CalculateRoute(graph, startPos, finalPos, delegate, path);
+  }
+  return Convert(res);
+}
+
+void BuildRoadGraphLandmarks(IRoadGraph const & graph, Junction const & seed,
+                             size_t landmarksCount, TRoadGraphLandmarks & landmarks)
+{
+  BuildLandmarks(RoadGraph(graph), seed, landmarksCount, kRoadGraphLandmarksUnit, landmarks);
+}
+
 }  // namespace routing
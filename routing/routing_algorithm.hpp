@@ -3,6 +3,7 @@
 #include "base/cancellable.hpp"
 
 #include "routing/road_graph.hpp"
+#include "routing/road_graph_landmarks.hpp"
 #include "routing/router.hpp"
 
 #include "std/functional.hpp"
@@ -51,4 +52,28 @@ public:
                         vector<Junction> & path) override;
 };
 
+// AStar-bidirectional routing algorithm with ALT (A*, Landmarks, Triangle inequality) heuristic.
+// It uses landmarks of the mwm where the route starts and finishes. When the mwm has
+// no landmarks or when the route may leave the mwm it falls back to
+// AStarBidirectionalRoutingAlgorithm. The graph must be symmetric, i.e. pedestrian.
+class AStarLandmarksRoutingAlgorithm : public IRoutingAlgorithm
+{
+public:
+  explicit AStarLandmarksRoutingAlgorithm(Index const & index);
+
+  // IRoutingAlgorithm overrides:
+  Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
+                        Junction const & finalPos, RouterDelegate const & delegate,
+                        vector<Junction> & path) override;
+
+private:
+  RoadGraphLandmarksLoader m_loader;
+  AStarBidirectionalRoutingAlgorithm m_fallback;
+};
+
+// Builds landmarks for the part of the graph which is strongly connected with |seed|.
+// Weights of edges are the same as used by the routing algorithms above.
+void BuildRoadGraphLandmarks(IRoadGraph const & graph, Junction const & seed,
+                             size_t landmarksCount, TRoadGraphLandmarks & landmarks);
+
 }  // namespace routing
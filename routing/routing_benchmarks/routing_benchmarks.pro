@@ -0,0 +1,22 @@
+# This subproject implements routing benchmarks.
+# They are launched on real maps from the data directory.
+
+TARGET = routing_benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = map routing search storage indexer platform geometry coding base osrm jansson protobuf tomcrypt succinct stats_client generator gflags
+
+include($$ROOT_DIR/common.pri)
+
+QT *= core
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+SOURCES += \
+  ../routing_integration_tests/routing_test_tools.cpp \
+  travel_matrix_benchmark.cpp \
+
+HEADERS += \
@@ -0,0 +1,97 @@
+#include "testing/testing.hpp"
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/osrm_router.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/travel_matrix.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+using namespace routing;
+
+// Testing stub to make routing test tools linkable.
+static CommandLineOptions g_options;
+CommandLineOptions const & GetTestingOptions() {return g_options;}
+
+DEFINE_string(data_path, "../../data/", "Working directory, 'path_to_exe/../../data' if empty.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+DEFINE_double(lat, 55.7522, "Latitude of the center of the points area.");
+DEFINE_double(lon, 37.6156, "Longitude of the center of the points area.");
+DEFINE_double(radius, 30000., "Half of the side of the points area in meters.");
+DEFINE_uint64(sources, 100, "Count of sources.");
+DEFINE_uint64(targets, 100, "Count of targets.");
+DEFINE_uint64(threads, 0, "Count of matrix threads, count of cpu cores if 0.");
+DEFINE_uint64(seed, 0, "Seed of the random points generator.");
+DEFINE_bool(distances, false, "Calculate distances too (a route for every pair).");
+
+namespace
+{
+vector<m2::PointD> GeneratePoints(m2::RectD const & rect, size_t count, mt19937 & rng)
+{
+  uniform_real_distribution<double> x(rect.minX(), rect.maxX());
+  uniform_real_distribution<double> y(rect.minY(), rect.maxY());
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+    points.emplace_back(x(rng), y(rng));
+  return points;
+}
+
+void RunBenchmark(OsrmRouter & router, vector<m2::PointD> const & sources,
+                  vector<m2::PointD> const & targets, size_t threadsCount)
+{
+  router.ClearState();
+  router.SetMatrixThreadsCount(threadsCount);
+
+  RouterDelegate delegate;
+  TravelMatrix matrix;
+  my::Timer timer;
+  IRouter::ResultCode const code =
+      router.CalculateTravelMatrix(sources, targets, FLAGS_distances, delegate, matrix);
+  double const seconds = timer.ElapsedSeconds();
+
+  size_t reachable = 0;
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      if (matrix.IsReachable(i, j))
+        ++reachable;
+    }
+  }
+  LOG(LINFO, ("Matrix", sources.size(), "x", targets.size(), "threads:", threadsCount,
+              "result:", code, "time:", seconds, "s, reachable pairs:", reachable));
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Times calculation of travel matrices between random points.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  g_options.m_dataPath = FLAGS_data_path.c_str();
+  g_options.m_resourcePath = FLAGS_user_resource_path.c_str();
+
+  OsrmRouter * router = dynamic_cast<OsrmRouter *>(integration::GetOsrmComponents().GetRouter());
+  CHECK(router, ());
+
+  mt19937 rng(static_cast<uint32_t>(FLAGS_seed));
+  m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(
+      MercatorBounds::FromLatLon(FLAGS_lat, FLAGS_lon), FLAGS_radius);
+  vector<m2::PointD> const sources = GeneratePoints(rect, FLAGS_sources, rng);
+  vector<m2::PointD> const targets = GeneratePoints(rect, FLAGS_targets, rng);
+
+  size_t const threadsCount = FLAGS_threads == 0 ? GetPlatform().CpuCores() : FLAGS_threads;
+  RunBenchmark(*router, sources, targets, 0 /* threadsCount */);
+  RunBenchmark(*router, sources, targets, threadsCount);
+  return 0;
+}
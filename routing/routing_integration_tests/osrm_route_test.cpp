@@ -2,8 +2,15 @@
 
 #include "routing/routing_integration_tests/routing_test_tools.hpp"
 
+#include "routing/osrm_router.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/travel_matrix.hpp"
+
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 using namespace routing;
 
 namespace
@@ -262,4 +269,75 @@ namespace
 
     integration::TestRouteTime(route, 900.);
   }
+
+  // Compares route calculation time with and without the adjacency cache of OSRM facades.
+  UNIT_TEST(RussiaSmolenskRussiaMoscowAdjacencyCacheTest)
+  {
+    integration::IRouterComponents & components = integration::GetOsrmComponents();
+    OsrmRouter * router = dynamic_cast<OsrmRouter *>(components.GetRouter());
+    TEST(router, ());
+
+    m2::PointD const startPoint = MercatorBounds::FromLatLon(54.7998, 32.05489);
+    m2::PointD const finalPoint = MercatorBounds::FromLatLon(55.753, 37.60169);
+    size_t const kRoutesCount = 5;
+
+    auto const calculate = [&](size_t cacheSize, double & routeMeters)
+    {
+      router->ClearState();
+      router->SetAdjacencyCacheSize(cacheSize);
+      my::Timer timer;
+      for (size_t i = 0; i < kRoutesCount; ++i)
+      {
+        TRouteResult const routeResult =
+            integration::CalculateRoute(components, startPoint, {0., 0.}, finalPoint);
+        TEST_EQUAL(routeResult.second, IRouter::NoError, ());
+        routeMeters = routeResult.first->GetTotalDistanceMeters();
+      }
+      return timer.ElapsedSeconds();
+    };
+
+    double metersWithoutCache = 0;
+    double const secondsWithoutCache = calculate(0 /* cacheSize */, metersWithoutCache);
+    double metersWithCache = 0;
+    double const secondsWithCache = calculate(64 * 1024 * 1024 /* cacheSize */, metersWithCache);
+    router->SetAdjacencyCacheSize(0);
+    router->ClearState();
+
+    TEST_ALMOST_EQUAL_ULPS(metersWithoutCache, metersWithCache, ());
+    LOG(LINFO, ("Routes:", kRoutesCount, "without adjacency cache:", secondsWithoutCache,
+                "s, with adjacency cache:", secondsWithCache, "s"));
+  }
+
+  UNIT_TEST(RussiaTravelMatrixTest)
+  {
+    integration::IRouterComponents & components = integration::GetOsrmComponents();
+    OsrmRouter * router = dynamic_cast<OsrmRouter *>(components.GetRouter());
+    TEST(router, ());
+
+    // Points of Moscow and Smolensk, so the matrix has single and cross mwm routes.
+    vector<m2::PointD> const points = {MercatorBounds::FromLatLon(55.7971, 37.53804),
+                                       MercatorBounds::FromLatLon(55.8579, 37.40990),
+                                       MercatorBounds::FromLatLon(54.7998, 32.05489)};
+    RouterDelegate delegate;
+    TravelMatrix matrix;
+    TEST_EQUAL(router->CalculateTravelMatrix(points, points, true /* withDistances */, delegate,
+                                             matrix),
+               IRouter::NoError, ());
+    LOG(LINFO, (matrix));
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      for (size_t j = 0; j < points.size(); ++j)
+      {
+        if (i == j)
+          continue;
+        TRouteResult const routeResult =
+            integration::CalculateRoute(components, points[i], {0., 0.}, points[j]);
+        TEST_EQUAL(routeResult.second, IRouter::NoError, ());
+        TEST(matrix.IsReachable(i, j), (i, j));
+        integration::TestRouteTime(*routeResult.first, matrix.GetDuration(i, j), 0.1);
+        integration::TestRouteLength(*routeResult.first, matrix.m_distances[matrix.GetIndex(i, j)]);
+      }
+    }
+  }
 }  // namespace
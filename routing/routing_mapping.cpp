@@ -12,6 +12,7 @@
 #include "coding/reader_wrapper.hpp"
 
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
 
 
 using platform::CountryFile;
@@ -135,7 +136,9 @@ void RoutingMapping::LoadFacade()
     LoadFileIfNeeded();
     if (!m_handle.IsAlive())
       return;
-    m_dataFacade.Load(m_container);
+    platform::LocalCountryFile const & localFile = m_handle.GetInfo()->GetLocalFile();
+    m_dataFacade.Load(m_container, localFile.GetPath(MapOptions::CarRouting) + ':' +
+                                       strings::to_string(localFile.GetVersion()));
   }
   ++m_facadeCounter;
 }
@@ -145,6 +148,8 @@ void RoutingMapping::FreeFacade()
   --m_facadeCounter;
   if (!m_facadeCounter)
   {
+    if (m_dataFacade.GetAdjacencyCacheSize() != 0)
+      LOG(LDEBUG, (m_countryFile, m_dataFacade.GetAdjacencyCacheStats()));
     FreeFileIfPossible();
     m_dataFacade.Clear();
   }
@@ -192,6 +197,7 @@ TRoutingMappingPtr RoutingIndexManager::GetMappingByName(string const & mapName)
 
   // Or load and check file.
   TRoutingMappingPtr newMapping(new RoutingMapping(mapName, m_index));
+  newMapping->m_dataFacade.SetAdjacencyCacheSize(m_adjacencyCacheSize);
   m_mapping[mapName] = newMapping;
   return newMapping;
 }
@@ -203,4 +209,23 @@ TRoutingMappingPtr RoutingIndexManager::GetMappingById(Index::MwmId const & id)
   return GetMappingByName(id.GetInfo()->GetCountryName());
 }
 
+Index::MwmId RoutingIndexManager::GetMwmIdByName(string const & mapName) const
+{
+  return m_index.GetMwmIdByCountryFile(CountryFile(mapName));
+}
+
+unique_ptr<RoutingIndexManager> RoutingIndexManager::CreateEmptyCopy() const
+{
+  unique_ptr<RoutingIndexManager> manager(new RoutingIndexManager(m_countryFileFn, m_index));
+  manager->m_adjacencyCacheSize = m_adjacencyCacheSize;
+  return manager;
+}
+
+void RoutingIndexManager::SetAdjacencyCacheSize(size_t bytes)
+{
+  m_adjacencyCacheSize = bytes;
+  for (auto & mapping : m_mapping)
+    mapping.second->m_dataFacade.SetAdjacencyCacheSize(bytes);
+}
+
 }  // namespace routing
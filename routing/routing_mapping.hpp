@@ -9,6 +9,7 @@
 #include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/unique_ptr.hpp"
 #include "std/unordered_map.hpp"
 
 
@@ -108,6 +109,16 @@ public:
 
   TRoutingMappingPtr GetMappingById(Index::MwmId const & id);
 
+  /// Returns id of the mwm without loading its routing mapping.
+  Index::MwmId GetMwmIdByName(string const & mapName) const;
+
+  /// Sets memory budget of the adjacency cache of every mapping (see OsrmRawDataFacade).
+  void SetAdjacencyCacheSize(size_t bytes);
+
+  /// Creates a manager with the same settings and without any mappings. Managers don't share
+  /// mappings, so different threads may use different managers simultaneously.
+  unique_ptr<RoutingIndexManager> CreateEmptyCopy() const;
+
   template <class TFunctor>
   void ForEachMapping(TFunctor toDo)
   {
@@ -121,6 +132,7 @@ private:
   // TODO (ldragunov) Rewrite to mwmId.
   unordered_map<string, TRoutingMappingPtr> m_mapping;
   MwmSet & m_index;
+  size_t m_adjacencyCacheSize = 0;
 };
 
 }  // namespace routing
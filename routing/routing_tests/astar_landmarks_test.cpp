@@ -0,0 +1,340 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/road_graph_builder.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/astar_landmarks.hpp"
+#include "routing/road_graph_landmarks.hpp"
+#include "routing/routing_algorithm.hpp"
+
+#include "indexer/classificator_loader.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/timer.hpp"
+
+#include "std/sstream.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+using namespace routing;
+using namespace routing_test;
+
+namespace
+{
+double constexpr kKMPH2MPS = 1000.0 / (60 * 60);
+
+// Unit of distances of landmarks in tests, in seconds.
+double constexpr kUnit = 0.1;
+
+class WeightedEdge
+{
+public:
+  WeightedEdge(Junction const & target, double weight) : m_target(target), m_weight(weight) {}
+
+  inline Junction const & GetTarget() const { return m_target; }
+  inline double GetWeight() const { return m_weight; }
+
+private:
+  Junction m_target;
+  double m_weight;
+};
+
+// The same weights and heuristic as routing algorithms use for IRoadGraph.
+// Counts settled vertices, i.e. requests of adjacency lists.
+class CountingRoadGraph
+{
+public:
+  using TVertexType = Junction;
+  using TEdgeType = WeightedEdge;
+
+  explicit CountingRoadGraph(IRoadGraph const & graph)
+    : m_graph(graph), m_maxSpeedMPS(graph.GetMaxSpeedKMPH() * kKMPH2MPS), m_settled(0)
+  {
+  }
+
+  void GetOutgoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  {
+    ++m_settled;
+    IRoadGraph::TEdgeVector edges;
+    m_graph.GetOutgoingEdges(v, edges);
+    adj.clear();
+    for (auto const & e : edges)
+      adj.emplace_back(e.GetEndJunction(), GetWeight(e));
+  }
+
+  void GetIngoingEdgesList(Junction const & v, vector<WeightedEdge> & adj) const
+  {
+    ++m_settled;
+    IRoadGraph::TEdgeVector edges;
+    m_graph.GetIngoingEdges(v, edges);
+    adj.clear();
+    for (auto const & e : edges)
+      adj.emplace_back(e.GetStartJunction(), GetWeight(e));
+  }
+
+  double HeuristicCostEstimate(Junction const & v, Junction const & w) const
+  {
+    return MercatorBounds::DistanceOnEarth(v.GetPoint(), w.GetPoint()) / m_maxSpeedMPS;
+  }
+
+  double GetPathLength(vector<Junction> const & path) const
+  {
+    double length = 0.0;
+    vector<WeightedEdge> adj;
+    for (size_t i = 0; i + 1 < path.size(); ++i)
+    {
+      GetOutgoingEdgesList(path[i], adj);
+      double weight = -1.0;
+      for (auto const & e : adj)
+      {
+        if (e.GetTarget() == path[i + 1] && (weight < 0.0 || e.GetWeight() < weight))
+          weight = e.GetWeight();
+      }
+      TEST_GREATER_OR_EQUAL(weight, 0.0, (path[i], path[i + 1]));
+      length += weight;
+    }
+    return length;
+  }
+
+  inline size_t GetSettledCount() const { return m_settled; }
+  inline void ResetSettledCount() { m_settled = 0; }
+
+private:
+  double GetWeight(Edge const & e) const
+  {
+    double const speedMPS = m_graph.GetSpeedKMPH(e) * kKMPH2MPS;
+    return MercatorBounds::DistanceOnEarth(e.GetStartJunction().GetPoint(),
+                                           e.GetEndJunction().GetPoint()) / speedMPS;
+  }
+
+  IRoadGraph const & m_graph;
+  double const m_maxSpeedMPS;
+  mutable size_t m_settled;
+};
+
+struct SearchStats
+{
+  SearchStats() : m_settled(0), m_timeSec(0.0) {}
+
+  size_t m_settled;
+  double m_timeSec;
+};
+
+string DebugPrint(SearchStats const & stats)
+{
+  ostringstream out;
+  out << stats.m_settled << " settled vertices, " << stats.m_timeSec << " sec";
+  return out.str();
+}
+
+template <typename TGraph>
+double FindPath(CountingRoadGraph & countingGraph, TGraph const & graph, Junction const & startPos,
+                Junction const & finalPos, bool bidirectional, SearchStats & stats)
+{
+  using TAlgorithm = AStarAlgorithm<TGraph>;
+
+  countingGraph.ResetSettledCount();
+  my::Timer timer;
+  vector<Junction> path;
+  typename TAlgorithm::Result const result =
+      bidirectional ? TAlgorithm().FindPathBidirectional(graph, startPos, finalPos, path)
+                    : TAlgorithm().FindPath(graph, startPos, finalPos, path);
+  stats.m_timeSec += timer.ElapsedSeconds();
+  stats.m_settled += countingGraph.GetSettledCount();
+
+  TEST_EQUAL(TAlgorithm::Result::OK, result, ());
+  TEST(!path.empty(), ());
+  TEST_EQUAL(startPos, path.front(), ());
+  TEST_EQUAL(finalPos, path.back(), ());
+  return countingGraph.GetPathLength(path);
+}
+
+// Compares the plain geometric heuristic with the ALT one on all pairs of |junctions|.
+void RunBenchmark(string const & name, IRoadGraph const & roadGraph,
+                  vector<Junction> const & junctions, size_t landmarksCount)
+{
+  CountingRoadGraph graph(roadGraph);
+
+  LandmarksTable<Junction> landmarks;
+  BuildLandmarks(graph, junctions.front(), landmarksCount, kUnit, landmarks);
+  TEST_EQUAL(landmarksCount, landmarks.GetLandmarksCount(), ());
+
+  SearchStats plain, plainBidirectional, alt, altBidirectional;
+  for (auto const & startPos : junctions)
+  {
+    for (auto const & finalPos : junctions)
+    {
+      if (startPos == finalPos)
+        continue;
+
+      AStarLandmarksGraph<CountingRoadGraph> const altGraph(graph, landmarks, startPos, finalPos);
+
+      double const expected = FindPath(graph, graph, startPos, finalPos, false, plain);
+      double const kEps = 1e-6 * expected;
+      TEST(my::AlmostEqualAbs(expected, FindPath(graph, graph, startPos, finalPos, true,
+                                                 plainBidirectional), kEps), ());
+      TEST(my::AlmostEqualAbs(expected, FindPath(graph, altGraph, startPos, finalPos, false, alt),
+                              kEps), ());
+      TEST(my::AlmostEqualAbs(expected, FindPath(graph, altGraph, startPos, finalPos, true,
+                                                 altBidirectional), kEps), ());
+      TEST(!altGraph.HasSkippedEdges(), ());
+    }
+  }
+
+  LOG(LINFO, (name, "landmarks:", landmarksCount, "queries:", junctions.size() * (junctions.size() - 1)));
+  LOG(LINFO, ("A*:", plain));
+  LOG(LINFO, ("A*-bidirectional:", plainBidirectional));
+  LOG(LINFO, ("ALT:", alt));
+  LOG(LINFO, ("ALT-bidirectional:", altBidirectional));
+
+  // ALT heuristic dominates the geometric one, so it can't settle more vertices.
+  TEST_LESS_OR_EQUAL(alt.m_settled, plain.m_settled, ());
+}
+
+// Grid of roads where every fifth road is fast and the others are slow, so the geometric
+// heuristic which assumes the max speed is weak.
+void InitRoadGraphMockSourceWithGrid(RoadGraphMockSource & graph, size_t size)
+{
+  double const maxSpeedKMPH = graph.GetMaxSpeedKMPH();
+  for (size_t i = 0; i < size; ++i)
+  {
+    double const speedKMPH = (i % 5 == 0) ? maxSpeedKMPH : maxSpeedKMPH / 5;
+    IRoadGraph::RoadInfo horizontal(true /* bidir */, speedKMPH, {});
+    IRoadGraph::RoadInfo vertical(true /* bidir */, speedKMPH, {});
+    for (size_t j = 0; j < size; ++j)
+    {
+      horizontal.m_points.emplace_back(j, i);
+      vertical.m_points.emplace_back(i, j);
+    }
+    graph.AddRoad(move(horizontal));
+    graph.AddRoad(move(vertical));
+  }
+}
+}  // namespace
+
+UNIT_TEST(AStarLandmarks_Graph2)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  InitRoadGraphMockSourceWithTest2(graph);
+
+  vector<Junction> const junctions = {m2::PointD(0, 0), m2::PointD(80, 55), m2::PointD(80, 0),
+                                      m2::PointD(5, 40), m2::PointD(37, 30)};
+  RunBenchmark("Graph2", graph, junctions, 4 /* landmarksCount */);
+}
+
+UNIT_TEST(AStarLandmarks_Grid)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  InitRoadGraphMockSourceWithGrid(graph, 21 /* size */);
+
+  vector<Junction> const junctions = {m2::PointD(1, 1), m2::PointD(19, 18), m2::PointD(3, 17),
+                                      m2::PointD(17, 2), m2::PointD(10, 10)};
+  RunBenchmark("Grid", graph, junctions, 4 /* landmarksCount */);
+}
+
+UNIT_TEST(AStarLandmarks_FakeEdges)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  InitRoadGraphMockSourceWithGrid(graph, 21 /* size */);
+
+  CountingRoadGraph countingGraph(graph);
+  LandmarksTable<Junction> landmarks;
+  BuildLandmarks(countingGraph, m2::PointD(0, 0), 4 /* landmarksCount */, kUnit, landmarks);
+
+  // Start and final positions are projected into the middles of road segments.
+  Junction const startPos = m2::PointD(3.5, 1.2);
+  Junction const finalPos = m2::PointD(16.8, 5.5);
+  Junction const startProj = m2::PointD(3.5, 1);
+  Junction const finalProj = m2::PointD(17, 5.5);
+  graph.AddFakeEdges(startPos, {make_pair(Edge(MakeTestFeatureID(2), true /* forward */, 3 /* segId */,
+                                               m2::PointD(3, 1), m2::PointD(4, 1)),
+                                          startProj.GetPoint())});
+  graph.AddFakeEdges(finalPos, {make_pair(Edge(MakeTestFeatureID(35), true /* forward */, 5 /* segId */,
+                                               m2::PointD(17, 5), m2::PointD(17, 6)),
+                                          finalProj.GetPoint())});
+
+  SearchStats stats;
+  double const expected = FindPath(countingGraph, countingGraph, startPos, finalPos, false, stats);
+
+  AStarLandmarksGraph<CountingRoadGraph> const altGraph(countingGraph, landmarks, startPos, finalPos,
+                                                        {startProj, finalProj});
+  double const kEps = 1e-6 * expected;
+  TEST(my::AlmostEqualAbs(expected, FindPath(countingGraph, altGraph, startPos, finalPos, false, stats),
+                          kEps), ());
+  TEST(my::AlmostEqualAbs(expected, FindPath(countingGraph, altGraph, startPos, finalPos, true, stats),
+                          kEps), ());
+  TEST(!altGraph.HasSkippedEdges(), ());
+
+  // Projections are not covered by landmarks, so edges to them are skipped.
+  AStarLandmarksGraph<CountingRoadGraph> const uncoveredGraph(countingGraph, landmarks, startPos,
+                                                              finalPos);
+  vector<Junction> path;
+  TEST_EQUAL(AStarAlgorithm<AStarLandmarksGraph<CountingRoadGraph>>::Result::NoPath,
+             AStarAlgorithm<AStarLandmarksGraph<CountingRoadGraph>>().FindPath(
+                 uncoveredGraph, startPos, finalPos, path), ());
+  TEST(uncoveredGraph.HasSkippedEdges(), ());
+  // The bound of paths through skipped edges is admissible.
+  TEST_LESS_OR_EQUAL(uncoveredGraph.GetSkippedPathsLowerBound(), expected, ());
+}
+
+UNIT_TEST(AStarLandmarks_Serialization)
+{
+  classificator::Load();
+
+  RoadGraphMockSource graph;
+  InitRoadGraphMockSourceWithTest2(graph);
+
+  TRoadGraphLandmarks landmarks;
+  BuildRoadGraphLandmarks(graph, m2::PointD(0, 0), 3 /* landmarksCount */, landmarks);
+  TEST_EQUAL(3, landmarks.GetLandmarksCount(), ());
+
+  // Weights of BuildRoadGraphLandmarks are the same as in CountingRoadGraph.
+  TRoadGraphLandmarks expected;
+  BuildLandmarks(CountingRoadGraph(graph), m2::PointD(0, 0), 3 /* landmarksCount */,
+                 kRoadGraphLandmarksUnit, expected);
+  TEST_EQUAL(expected.GetLandmarks(), landmarks.GetLandmarks(), ());
+  TEST_EQUAL(expected.GetFromDistances(), landmarks.GetFromDistances(), ());
+
+  vector<RoadPointId> ids;
+  TEST(GetRoadPointIds(graph, landmarks.GetVertices(), ids), ());
+  TEST_EQUAL(landmarks.GetVertices().size(), ids.size(), ());
+
+  vector<char> buffer;
+  MemWriter<vector<char>> writer(buffer);
+  SerializeRoadGraphLandmarks(landmarks, ids, writer);
+
+  // Points are resolved by ids of roads in the increasing order.
+  RoadPointId prevId;
+  auto const getPoint = [&graph, &prevId](RoadPointId const & id, m2::PointD & point)
+  {
+    TEST(prevId < id || prevId == id, (prevId, id));
+    prevId = id;
+    auto const & points = graph.GetRoadInfo(MakeTestFeatureID(id.m_featureId)).m_points;
+    if (id.m_pointId >= points.size())
+      return false;
+    point = points[id.m_pointId];
+    return true;
+  };
+
+  TRoadGraphLandmarks deserialized;
+  MemReader reader(buffer.data(), buffer.size());
+  TEST(DeserializeRoadGraphLandmarks(reader, getPoint, deserialized), ());
+  TEST_EQUAL(landmarks.GetUnit(), deserialized.GetUnit(), ());
+  TEST_EQUAL(landmarks.GetLandmarks(), deserialized.GetLandmarks(), ());
+  TEST_EQUAL(landmarks.GetVertices(), deserialized.GetVertices(), ());
+  TEST_EQUAL(landmarks.GetFromDistances(), deserialized.GetFromDistances(), ());
+  TEST_EQUAL(landmarks.GetToDistances(), deserialized.GetToDistances(), ());
+}
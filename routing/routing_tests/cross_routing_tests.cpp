@@ -1,12 +1,21 @@
 #include "testing/testing.hpp"
 
+#include "routing/cross_mwm_cache.hpp"
 #include "routing/cross_mwm_road_graph.hpp"
 #include "routing/cross_mwm_router.hpp"
 #include "routing/cross_routing_context.hpp"
 
+#include "coding/file_writer.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "platform/platform.hpp"
+
+#include "base/math.hpp"
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+
 using namespace routing;
 
 namespace
@@ -143,4 +152,130 @@ UNIT_TEST(TestFindingByPoint)
   TEST_EQUAL(node.m_nodeId, 3, ());
   TEST(!newContext.FindIngoingNodeByPoint(p3, node), ());
 }
+
+CrossMwmCacheEdge MakeCacheEdge(TWrittenNodeId outgoingNode, TWrittenNodeId ingoingNode,
+                                ms::LatLon const & point, TWrittenEdgeWeight weight,
+                                uint32_t nextMwm, int64_t nextVersion)
+{
+  CrossMwmCacheEdge edge;
+  edge.m_outgoingNode = outgoingNode;
+  edge.m_ingoingNode = ingoingNode;
+  edge.m_point = point;
+  edge.m_weight = weight;
+  edge.m_nextMwm = nextMwm;
+  edge.m_nextVersion = nextVersion;
+  return edge;
+}
+
+void TestSameEdges(vector<CrossMwmCacheEdge> const & lhs, vector<CrossMwmCacheEdge> const & rhs)
+{
+  TEST_EQUAL(lhs.size(), rhs.size(), ());
+  for (size_t i = 0; i < lhs.size(); ++i)
+  {
+    TEST_EQUAL(lhs[i].m_outgoingNode, rhs[i].m_outgoingNode, (i));
+    TEST_EQUAL(lhs[i].m_ingoingNode, rhs[i].m_ingoingNode, (i));
+    TEST(my::AlmostEqualAbs(lhs[i].m_point.lat, rhs[i].m_point.lat, 1e-6), (i));
+    TEST(my::AlmostEqualAbs(lhs[i].m_point.lon, rhs[i].m_point.lon, 1e-6), (i));
+    TEST_EQUAL(lhs[i].m_weight, rhs[i].m_weight, (i));
+    TEST_EQUAL(lhs[i].m_nextMwm, rhs[i].m_nextMwm, (i));
+    TEST_EQUAL(lhs[i].m_nextVersion, rhs[i].m_nextVersion, (i));
+  }
+}
+
+UNIT_TEST(TestCrossMwmCache)
+{
+  CrossMwmCache cache;
+  uint32_t const bar = cache.GetMwmIndex("bar");
+  TEST_EQUAL(cache.GetMwmIndex("bar"), bar, ());
+  TEST_EQUAL(cache.GetMwmName(bar), "bar", ());
+
+  vector<CrossMwmCacheEdge> const edges = {
+      MakeCacheEdge(10, 20, {1., 2.}, 100, bar, 1),
+      MakeCacheEdge(11, kInvalidContextEdgeNodeId, {3., 4.}, 200, bar, 1)};
+  vector<CrossMwmCacheEdge> result;
+  TEST(!cache.GetEdges("foo", 1, 5, result), ());
+  cache.SetEdges("foo", 1, 5, edges);
+  TEST(cache.GetEdges("foo", 1, 5, result), ());
+  TestSameEdges(edges, result);
+  TEST(!cache.GetEdges("foo", 1, 6, result), ());
+
+  CrossMwmCacheStats stats = cache.GetStats();
+  TEST_EQUAL(stats.m_mwms, 1, (stats));
+  TEST_EQUAL(stats.m_nodes, 1, (stats));
+  TEST_EQUAL(stats.m_hits, 1, (stats));
+  TEST_EQUAL(stats.m_misses, 2, (stats));
+
+  // A new version of the mwm drops the old adjacency.
+  TEST(!cache.GetEdges("foo", 2, 5, result), ());
+  TEST_EQUAL(cache.GetStats().m_mwms, 0, ());
+  TEST_EQUAL(cache.GetStats().m_bytes, 0, ());
+}
+
+UNIT_TEST(TestCrossMwmCacheBudget)
+{
+  vector<CrossMwmCacheEdge> edges;
+  for (TWrittenNodeId i = 0; i < 10; ++i)
+    edges.push_back(MakeCacheEdge(i, i, ms::LatLon::Zero(), i, 0 /* nextMwm */, 1));
+
+  CrossMwmCache cache;
+  cache.SetEdges("foo", 1, 1, edges);
+  size_t const mwmBytes = cache.GetStats().m_bytes;
+  TEST_GREATER(mwmBytes, 0, ());
+
+  // The budget fits two mwms, the least recently used one is evicted.
+  cache.SetSize(2 * mwmBytes);
+  cache.SetEdges("bar", 1, 1, edges);
+  vector<CrossMwmCacheEdge> result;
+  TEST(cache.GetEdges("foo", 1, 1, result), ());
+  cache.SetEdges("baz", 1, 1, edges);
+  TEST(cache.GetEdges("foo", 1, 1, result), ());
+  TEST(!cache.GetEdges("bar", 1, 1, result), ());
+  TEST(cache.GetEdges("baz", 1, 1, result), ());
+  TEST_LESS_OR_EQUAL(cache.GetStats().m_bytes, cache.GetSize(), ());
+
+  cache.SetSize(0);
+  TEST_EQUAL(cache.GetStats().m_mwms, 0, ());
+  cache.SetEdges("foo", 1, 1, edges);
+  TEST(!cache.GetEdges("foo", 1, 1, result), ());
+}
+
+UNIT_TEST(TestCrossMwmCacheSerialization)
+{
+  string const path = GetPlatform().WritablePathForFile("cross_mwm_cache_test.bin");
+  MY_SCOPE_GUARD(fileDeleter, bind(FileWriter::DeleteFileX, path));
+
+  CrossMwmCache cache;
+  uint32_t const bar = cache.GetMwmIndex("bar");
+  uint32_t const baz = cache.GetMwmIndex("baz");
+  vector<CrossMwmCacheEdge> const fooEdges = {
+      MakeCacheEdge(10, 20, {55.5, 37.5}, 100, bar, 151020),
+      MakeCacheEdge(11, kInvalidContextEdgeNodeId, {-10.25, 120.75}, 200, baz, -1)};
+  vector<CrossMwmCacheEdge> const barEdges = {
+      MakeCacheEdge(30, 40, {1., 1.}, 300, baz, 151020)};
+  cache.SetEdges("foo", 151020, 1, fooEdges);
+  cache.SetEdges("bar", 151020, 2, barEdges);
+  TEST(cache.Save(path), ());
+
+  // Other indexes of names in the loading cache.
+  CrossMwmCache newCache;
+  newCache.GetMwmIndex("qux");
+  newCache.GetMwmIndex("baz");
+  TEST(newCache.Load(path), ());
+  TEST_EQUAL(newCache.GetStats().m_mwms, 2, ());
+  TEST_EQUAL(newCache.GetStats().m_bytes, cache.GetStats().m_bytes, ());
+
+  vector<CrossMwmCacheEdge> result;
+  TEST(newCache.GetEdges("foo", 151020, 1, result), ());
+  TEST_EQUAL(newCache.GetMwmName(result[0].m_nextMwm), "bar", ());
+  TEST_EQUAL(newCache.GetMwmName(result[1].m_nextMwm), "baz", ());
+  for (auto & edge : result)
+    edge.m_nextMwm = cache.GetMwmIndex(newCache.GetMwmName(edge.m_nextMwm));
+  TestSameEdges(fooEdges, result);
+
+  TEST(newCache.GetEdges("bar", 151020, 2, result), ());
+  TEST_EQUAL(newCache.GetMwmName(result[0].m_nextMwm), "baz", ());
+
+  TEST(!newCache.Load(path + ".absent"), ());
+  TEST_EQUAL(newCache.GetStats().m_mwms, 0, ());
+}
 }  // namespace
@@ -0,0 +1,315 @@
+#include "testing/testing.hpp"
+
+#include "routing/osrm_data_facade.hpp"
+#include "routing/osrm_engine.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/matrix_traversal.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/bits.hpp"
+#include "base/scope_guard.hpp"
+
+#include "std/bind.hpp"
+#include "std/cstring.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+#include "3party/osrm/osrm-backend/data_structures/query_edge.hpp"
+
+using namespace routing;
+
+namespace
+{
+using TEdgeData = QueryEdge::EdgeData;
+using TFacade = OsrmRawDataFacade<TEdgeData>;
+
+struct TestEdge
+{
+  uint32_t m_source;
+  uint32_t m_target;
+  bool m_backward;
+  bool m_shortcut;
+  uint32_t m_id;
+  uint32_t m_distance;
+};
+
+template <typename T>
+vector<char> Freeze(T & data, char const * fileName)
+{
+  string const path = GetPlatform().WritablePathForFile(fileName);
+  MY_SCOPE_GUARD(fileDeleter, bind(FileWriter::DeleteFileX, path));
+  succinct::mapper::freeze(data, path.c_str());
+
+  FileReader reader(path);
+  vector<char> buffer(reader.Size());
+  reader.Read(0, buffer.data(), buffer.size());
+  return buffer;
+}
+
+// Packs edges in the same way as the osrm converter does. Edges must be sorted by
+// source, target and direction.
+class TestFacadeData
+{
+public:
+  TestFacadeData(uint32_t nodesCount, vector<TestEdge> const & edges)
+  {
+    vector<uint64_t> matrix;
+    vector<uint32_t> distances;
+    vector<uint64_t> ids;
+    vector<bool> shortcuts;
+    for (auto const & e : edges)
+    {
+      matrix.push_back(TraverseMatrixInRowOrder<uint64_t>(nodesCount, e.m_source, e.m_target,
+                                                           e.m_backward));
+      distances.push_back(e.m_distance);
+      shortcuts.push_back(e.m_shortcut);
+      if (e.m_shortcut)
+        ids.push_back(bits::ZigZagEncode(int64_t(e.m_source) - int64_t(e.m_id)));
+    }
+
+    succinct::elias_fano::elias_fano_builder builder(matrix.back(), matrix.size());
+    for (auto e : matrix)
+      builder.push_back(e);
+    succinct::elias_fano fano(&builder);
+    vector<char> const fanoData = Freeze(fano, "test_matrix.tmp");
+    m_matrix.resize(sizeof(nodesCount));
+    memcpy(m_matrix.data(), &nodesCount, sizeof(nodesCount));
+    m_matrix.insert(m_matrix.end(), fanoData.begin(), fanoData.end());
+
+    succinct::elias_fano_compressed_list edgeData(distances);
+    m_edgeData = Freeze(edgeData, "test_edge_data.tmp");
+    succinct::elias_fano_compressed_list edgeIds(ids);
+    m_edgeIds = Freeze(edgeIds, "test_edge_ids.tmp");
+    succinct::rs_bit_vector shortcutsVector(shortcuts);
+    m_shortcuts = Freeze(shortcutsVector, "test_shortcuts.tmp");
+  }
+
+  void Load(TFacade & facade, string const & dataId = string()) const
+  {
+    facade.LoadRawData(m_edgeData.data(), m_edgeIds.data(), m_shortcuts.data(), m_matrix.data(),
+                       dataId);
+  }
+
+private:
+  vector<char> m_matrix;
+  vector<char> m_edgeData;
+  vector<char> m_edgeIds;
+  vector<char> m_shortcuts;
+};
+
+vector<TestEdge> GenerateEdges(uint32_t nodesCount)
+{
+  mt19937 rng(0);
+  vector<TestEdge> edges;
+  for (uint32_t source = 0; source < nodesCount; ++source)
+  {
+    // Leave some nodes without edges.
+    if (source % 7 == 3)
+      continue;
+
+    uint32_t const degree = rng() % 5 + 1;
+    vector<uint32_t> targets;
+    for (uint32_t i = 0; i < degree; ++i)
+      targets.push_back(rng() % nodesCount);
+    sort(targets.begin(), targets.end());
+    targets.erase(unique(targets.begin(), targets.end()), targets.end());
+
+    for (uint32_t target : targets)
+    {
+      for (bool backward : {false, true})
+      {
+        if (rng() % 2 == 0)
+          continue;
+        bool const shortcut = rng() % 3 == 0;
+        edges.push_back({source, target, backward, shortcut,
+                         shortcut ? static_cast<uint32_t>(rng() % nodesCount) : 0,
+                         static_cast<uint32_t>(rng() % 10000)});
+      }
+    }
+  }
+  return edges;
+}
+
+// Makes edges of a not contracted graph: every directed edge is stored as a forward edge
+// of its source and as a backward edge of its target.
+vector<TestEdge> MakeGraphEdges(vector<TestEdge> const & directedEdges)
+{
+  vector<TestEdge> edges;
+  for (auto const & e : directedEdges)
+  {
+    edges.push_back({e.m_source, e.m_target, false /* backward */, false /* shortcut */, 0,
+                     e.m_distance});
+    edges.push_back({e.m_target, e.m_source, true /* backward */, false /* shortcut */, 0,
+                     e.m_distance});
+  }
+  sort(edges.begin(), edges.end(), [](TestEdge const & lhs, TestEdge const & rhs)
+  {
+    if (lhs.m_source != rhs.m_source)
+      return lhs.m_source < rhs.m_source;
+    if (lhs.m_target != rhs.m_target)
+      return lhs.m_target < rhs.m_target;
+    return lhs.m_backward < rhs.m_backward;
+  });
+  return edges;
+}
+
+void TestSameAdjacency(TFacade const & expected, TFacade const & facade)
+{
+  TEST_EQUAL(expected.GetNumberOfNodes(), facade.GetNumberOfNodes(), ());
+  for (NodeID node = 0; node < expected.GetNumberOfNodes(); ++node)
+  {
+    TEST_EQUAL(expected.BeginEdges(node), facade.BeginEdges(node), (node));
+    TEST_EQUAL(expected.EndEdges(node), facade.EndEdges(node), (node));
+    for (auto e : facade.GetAdjacentEdgeRange(node))
+    {
+      TEST_EQUAL(expected.GetTarget(e), facade.GetTarget(e), (node, e));
+      TEdgeData const lhs = expected.GetEdgeData(e, node);
+      TEdgeData const rhs = facade.GetEdgeData(e, node);
+      TEST_EQUAL(lhs.id, rhs.id, (node, e));
+      TEST_EQUAL(lhs.shortcut, rhs.shortcut, (node, e));
+      TEST_EQUAL(lhs.distance, rhs.distance, (node, e));
+      TEST_EQUAL(lhs.forward, rhs.forward, (node, e));
+      TEST_EQUAL(lhs.backward, rhs.backward, (node, e));
+    }
+  }
+}
+}  // namespace
+
+UNIT_TEST(OsrmRawDataFacade_Smoke)
+{
+  uint32_t const kNodesCount = 4;
+  vector<TestEdge> const edges = {
+      {0, 1, false, false, 0, 10}, {0, 1, true, false, 0, 10}, {1, 3, false, true, 2, 25},
+      {3, 0, true, false, 0, 7}};
+  TestFacadeData const data(kNodesCount, edges);
+
+  TFacade facade;
+  data.Load(facade);
+  TEST_EQUAL(facade.GetNumberOfNodes(), kNodesCount, ());
+  TEST_EQUAL(facade.GetNumberOfEdges(), edges.size(), ());
+
+  TEST_EQUAL(facade.GetOutDegree(0), 2, ());
+  TEST_EQUAL(facade.GetOutDegree(1), 1, ());
+  TEST_EQUAL(facade.GetOutDegree(2), 0, ());
+  TEST_EQUAL(facade.GetOutDegree(3), 1, ());
+
+  EdgeID const e = facade.BeginEdges(1);
+  TEST_EQUAL(facade.GetTarget(e), 3, ());
+  TEdgeData const edgeData = facade.GetEdgeData(e, 1);
+  TEST(edgeData.shortcut, ());
+  TEST(edgeData.forward, ());
+  TEST_EQUAL(edgeData.id, 2, ());
+  TEST_EQUAL(edgeData.distance, 25, ());
+}
+
+UNIT_TEST(OsrmRawDataFacade_AdjacencyCache)
+{
+  uint32_t const kNodesCount = 1000;
+  TestFacadeData const data(kNodesCount, GenerateEdges(kNodesCount));
+
+  TFacade expected;
+  data.Load(expected);
+
+  TFacade facade;
+  facade.SetAdjacencyCacheSize(10 * 1024 * 1024);
+  data.Load(facade, "data");
+
+  // The first passes make all the blocks hot, the last ones read the cache only.
+  for (size_t i = 0; i < 6; ++i)
+    TestSameAdjacency(expected, facade);
+
+  AdjacencyCacheStats const stats = facade.GetAdjacencyCacheStats();
+  TEST_EQUAL(stats.m_blocks, (kNodesCount + 63) / 64, (stats));
+  TEST_GREATER(stats.m_hits, stats.m_misses, (stats));
+  TEST_LESS_OR_EQUAL(stats.m_bytes, facade.GetAdjacencyCacheSize(), (stats));
+  TEST_EQUAL(expected.GetAdjacencyCacheStats().m_blocks, 0, ());
+
+  // Reloading of the same data keeps the cache.
+  facade.ClearRawData();
+  data.Load(facade, "data");
+  TEST_EQUAL(facade.GetAdjacencyCacheStats().m_blocks, stats.m_blocks, ());
+  TestSameAdjacency(expected, facade);
+
+  // Loading of other data of the same size drops the cache.
+  TestFacadeData const sameSizeData(kNodesCount, GenerateEdges(kNodesCount));
+  sameSizeData.Load(facade, "sameSizeData");
+  TEST_EQUAL(facade.GetAdjacencyCacheStats().m_blocks, 0, ());
+  for (size_t i = 0; i < 6; ++i)
+    TestSameAdjacency(expected, facade);
+
+  // Data without id can't be identified, so the cache is dropped.
+  facade.ClearRawData();
+  sameSizeData.Load(facade);
+  TEST_EQUAL(facade.GetAdjacencyCacheStats().m_blocks, 0, ());
+
+  // Loading of other data drops the cache.
+  TestFacadeData const otherData(kNodesCount / 2, GenerateEdges(kNodesCount / 2));
+  TFacade otherExpected;
+  otherData.Load(otherExpected);
+  otherData.Load(facade, "otherData");
+  TEST_EQUAL(facade.GetAdjacencyCacheStats().m_blocks, 0, ());
+  for (size_t i = 0; i < 6; ++i)
+    TestSameAdjacency(otherExpected, facade);
+}
+
+UNIT_TEST(OsrmRawDataFacade_AdjacencyCacheBudget)
+{
+  uint32_t const kNodesCount = 1000;
+  TestFacadeData const data(kNodesCount, GenerateEdges(kNodesCount));
+
+  TFacade expected;
+  data.Load(expected);
+
+  size_t const kBudget = 4 * 1024;
+  TFacade facade;
+  facade.SetAdjacencyCacheSize(kBudget);
+  data.Load(facade);
+  for (size_t i = 0; i < 6; ++i)
+    TestSameAdjacency(expected, facade);
+
+  AdjacencyCacheStats const stats = facade.GetAdjacencyCacheStats();
+  TEST_GREATER(stats.m_blocks, 0, (stats));
+  TEST_LESS(stats.m_blocks, (kNodesCount + 63) / 64, (stats));
+  TEST_LESS_OR_EQUAL(stats.m_bytes, kBudget, (stats));
+
+  facade.SetAdjacencyCacheSize(0);
+  TEST_EQUAL(facade.GetAdjacencyCacheStats().m_blocks, 0, ());
+  TestSameAdjacency(expected, facade);
+}
+
+UNIT_TEST(FindWeightsMatrix_Candidates)
+{
+  uint32_t const kNodesCount = 5;
+  TestFacadeData const data(kNodesCount, MakeGraphEdges({{0, 1, false, false, 0, 10},
+                                                         {1, 2, false, false, 0, 10},
+                                                         {2, 3, false, false, 0, 10},
+                                                         {0, 3, false, false, 0, 50},
+                                                         {3, 0, false, false, 0, 5}}));
+  TFacade facade;
+  data.Load(facade);
+
+  Index::MwmId const mwmId;
+  auto const makeNodes = [&mwmId](vector<NodeID> const & ids, bool isStartNode)
+  {
+    TRoutingNodes nodes;
+    for (NodeID id : ids)
+      nodes.emplace_back(id, isStartNode, mwmId);
+    return nodes;
+  };
+
+  // Node 4 is isolated, the third source has two candidates.
+  vector<TRoutingNodes> const sources = {makeNodes({0}, true), makeNodes({1}, true),
+                                         makeNodes({4, 2}, true)};
+  vector<TRoutingNodes> const targets = {makeNodes({3}, false), makeNodes({0}, false),
+                                         makeNodes({4}, false)};
+  vector<EdgeWeight> weights;
+  FindWeightsMatrix(sources, targets, facade, weights);
+
+  vector<EdgeWeight> const expected = {30, 0,  INVALID_EDGE_WEIGHT,
+                                       20, 25, INVALID_EDGE_WEIGHT,
+                                       10, 15, 0};
+  TEST_EQUAL(weights, expected, ());
+}
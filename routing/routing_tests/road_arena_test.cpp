@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_arena.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
+
+using namespace routing;
+
+namespace
+{
+struct RoadsCollector
+{
+  void operator()(FeatureID const & featureId, RoadArena::RoadView const & road)
+  {
+    m_ids.push_back(featureId);
+    m_pointsCount.push_back(road.m_pointsCount);
+  }
+
+  vector<FeatureID> m_ids;
+  vector<size_t> m_pointsCount;
+};
+}  // namespace
+
+UNIT_TEST(RoadArena_Tiles)
+{
+  double const size = RoadArena::kTileSize;
+
+  RoadArena::TTileId const tile = RoadArena::GetTileId(-3, 5);
+  m2::RectD const rect = RoadArena::GetTileRect(tile);
+  TEST_ALMOST_EQUAL_ULPS(rect.minX(), -3 * size, ());
+  TEST_ALMOST_EQUAL_ULPS(rect.minY(), 5 * size, ());
+  TEST_ALMOST_EQUAL_ULPS(rect.maxX(), -2 * size, ());
+  TEST_ALMOST_EQUAL_ULPS(rect.maxY(), 6 * size, ());
+
+  vector<RoadArena::TTileId> tiles;
+  RoadArena::ForEachTileInRect(m2::RectD(-0.5 * size, 0.5 * size, 0.5 * size, 1.5 * size),
+                               [&tiles](RoadArena::TTileId tile) { tiles.push_back(tile); });
+  vector<RoadArena::TTileId> const expected = {
+      RoadArena::GetTileId(-1, 0), RoadArena::GetTileId(0, 0),
+      RoadArena::GetTileId(-1, 1), RoadArena::GetTileId(0, 1)};
+  TEST_EQUAL(tiles, expected, ());
+}
+
+UNIT_TEST(RoadArena_Smoke)
+{
+  double const size = RoadArena::kTileSize;
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+
+  RoadArena arena;
+  RoadArena::TTileId const left = RoadArena::GetTileId(0, 0);
+  RoadArena::TTileId const right = RoadArena::GetTileId(1, 0);
+  TEST(!arena.IsTileLoaded(left), ());
+
+  // Road 0 crosses the border of the tiles, road 1 is in the left tile only.
+  vector<m2::PointD> const road0 = {{0.5 * size, 0.5 * size}, {1.5 * size, 0.5 * size}};
+  vector<m2::PointD> const road1 = {
+      {0.1 * size, 0.1 * size}, {0.2 * size, 0.2 * size}, {0.3 * size, 0.1 * size}};
+
+  arena.AddTile(left);
+  arena.AddRoad(left, FeatureID(mwmId, 0), true /* bidirectional */, 60.0, road0.data(),
+                road0.size());
+  arena.AddRoad(left, FeatureID(mwmId, 1), false /* bidirectional */, 30.0, road1.data(),
+                road1.size());
+  TEST(arena.IsTileLoaded(left), ());
+
+  arena.AddTile(right);
+  TEST(arena.BindRoad(right, FeatureID(mwmId, 0)), ());
+  TEST(arena.BindRoad(right, FeatureID(mwmId, 1)), ());
+  TEST(!arena.BindRoad(right, FeatureID(mwmId, 2)), ());
+
+  TEST_EQUAL(arena.GetTilesCount(), 2, ());
+  TEST_EQUAL(arena.GetRoadsCount(), 2, ());
+  TEST_EQUAL(arena.GetPointsCount(), 5, ());
+
+  // Every road is reported once, even if it's in several tiles.
+  RoadsCollector all;
+  arena.ForEachRoadInRect(m2::RectD(0, 0, 2 * size, size), all);
+  vector<FeatureID> const expectedAll = {FeatureID(mwmId, 0), FeatureID(mwmId, 1)};
+  TEST_EQUAL(all.m_ids, expectedAll, ());
+  vector<size_t> const expectedPoints = {2, 3};
+  TEST_EQUAL(all.m_pointsCount, expectedPoints, ());
+
+  // Road 1 is not bound to the right tile.
+  RoadsCollector inRight;
+  arena.ForEachRoadInRect(m2::RectD(1.2 * size, 0.2 * size, 1.8 * size, 0.8 * size), inRight);
+  vector<FeatureID> const expectedRight = {FeatureID(mwmId, 0)};
+  TEST_EQUAL(inRight.m_ids, expectedRight, ());
+
+  RoadArena::RoadView road;
+  TEST(arena.GetRoad(FeatureID(mwmId, 1), road), ());
+  TEST_EQUAL(road.m_pointsCount, 3, ());
+  TEST_EQUAL(road.m_points[2], road1[2], ());
+  TEST_ALMOST_EQUAL_ULPS(road.m_speedKMPH, 30.0, ());
+  TEST(!road.m_bidirectional, ());
+  TEST(!arena.GetRoad(FeatureID(mwmId, 2), road), ());
+
+  // A road added without a tile is not visible in tiles.
+  vector<m2::PointD> const road2 = {{5.5 * size, 0.5 * size}, {5.6 * size, 0.5 * size}};
+  arena.AddRoad(FeatureID(mwmId, 2), true /* bidirectional */, 90.0, road2.data(), road2.size());
+  TEST(arena.GetRoad(FeatureID(mwmId, 2), road), ());
+  RoadsCollector none;
+  arena.ForEachRoadInRect(m2::RectD(5 * size, 0, 6 * size, size), none);
+  TEST(none.m_ids.empty(), ());
+
+  arena.Clear();
+  TEST(!arena.IsTileLoaded(left), ());
+  TEST(!arena.GetRoad(FeatureID(mwmId, 0), road), ());
+  TEST_EQUAL(arena.GetRoadsCount(), 0, ());
+}
@@ -22,6 +22,7 @@ INCLUDEPATH += $$ROOT_DIR/3party/jansson/src \
 SOURCES += \
   ../../testing/testingmain.cpp \
   astar_algorithm_test.cpp \
+  astar_landmarks_test.cpp \
   astar_progress_test.cpp \
   astar_router_test.cpp \
   async_router_test.cpp \
@@ -29,7 +30,9 @@ SOURCES += \
   followed_polyline_test.cpp \
   nearest_edge_finder_tests.cpp \
   online_cross_fetcher_test.cpp \
+  osrm_data_facade_test.cpp \
   osrm_router_test.cpp \
+  road_arena_test.cpp \
   road_graph_builder.cpp \
   road_graph_nearest_edges_test.cpp \
   route_tests.cpp \
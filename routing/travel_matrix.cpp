@@ -0,0 +1,365 @@
+#include "routing/travel_matrix.hpp"
+
+#include "routing/cross_mwm_road_graph.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_mapping.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/fork_join_pool.hpp"
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/map.hpp"
+#include "std/queue.hpp"
+#include "std/set.hpp"
+#include "std/sstream.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+
+namespace routing
+{
+namespace
+{
+inline bool IsValidEdgeWeight(EdgeWeight w) { return w != INVALID_EDGE_WEIGHT; }
+
+using TMwmToIndices = map<Index::MwmId, vector<size_t>>;
+
+TMwmToIndices GroupByMwm(vector<TRoutingNodes> const & nodes)
+{
+  TMwmToIndices result;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    if (!nodes[i].empty())
+      result[nodes[i].front().mwmId].push_back(i);
+  }
+  return result;
+}
+
+/// Calculates rows of the weights matrix. Uses its own routing mappings, so different
+/// workers may run simultaneously.
+class MatrixWorker
+{
+public:
+  MatrixWorker(vector<TRoutingNodes> const & sources, vector<TRoutingNodes> const & targets,
+               TMwmToIndices const & targetsByMwm, unique_ptr<RoutingIndexManager> indexManager,
+               RouterDelegate const & delegate, vector<EdgeWeight> & weights)
+    : m_sources(sources)
+    , m_targets(targets)
+    , m_targetsByMwm(targetsByMwm)
+    , m_indexManager(move(indexManager))
+    , m_crossGraph(*m_indexManager)
+    , m_delegate(delegate)
+    , m_weights(weights)
+  {
+  }
+
+  /// Fills rows of sources from one mwm.
+  void CalculateRows(Index::MwmId const & mwmId, vector<size_t> const & rows)
+  {
+    TRoutingMappingPtr mapping = m_indexManager->GetMappingById(mwmId);
+    if (!mapping->IsValid())
+      return;
+    MappingGuard mappingGuard(mapping);
+    UNUSED_VALUE(mappingGuard);
+
+    vector<TRoutingNodes> sources;
+    sources.reserve(rows.size());
+    for (size_t row : rows)
+      sources.push_back(m_sources[row]);
+
+    // Targets of the same mwm.
+    auto const it = m_targetsByMwm.find(mwmId);
+    if (it != m_targetsByMwm.end())
+    {
+      vector<TRoutingNodes> targets;
+      for (size_t target : it->second)
+        targets.push_back(m_targets[target]);
+
+      vector<EdgeWeight> weights;
+      FindWeightsMatrix(sources, targets, mapping->m_dataFacade, weights);
+      for (size_t i = 0; i < rows.size(); ++i)
+      {
+        for (size_t j = 0; j < it->second.size(); ++j)
+          GetWeight(rows[i], it->second[j]) = weights[i * targets.size() + j];
+      }
+    }
+
+    if (m_targetsByMwm.size() == (it == m_targetsByMwm.end() ? 0 : 1))
+      return;
+
+    // Targets of other mwms.
+    mapping->LoadCrossContext();
+    vector<OutgoingCrossNode> outgoingNodes;
+    mapping->m_crossContext.ForEachOutgoingNode([&outgoingNodes](OutgoingCrossNode const & node)
+                                                {
+                                                  outgoingNodes.push_back(node);
+                                                });
+    if (outgoingNodes.empty())
+      return;
+
+    vector<TRoutingNodes> targets;
+    targets.reserve(outgoingNodes.size());
+    for (auto const & node : outgoingNodes)
+    {
+      targets.push_back({FeatureGraphNode(node.m_nodeId, false /* isStartNode */, mwmId)});
+      targets.back().back().segmentPoint = MercatorBounds::FromLatLon(node.m_point);
+    }
+
+    vector<EdgeWeight> weights;
+    FindWeightsMatrix(sources, targets, mapping->m_dataFacade, weights);
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      if (m_delegate.IsCancelled())
+        return;
+
+      vector<pair<BorderCross, EdgeWeight>> starts;
+      for (size_t j = 0; j < outgoingNodes.size(); ++j)
+      {
+        EdgeWeight const weight = weights[i * outgoingNodes.size() + j];
+        if (!IsValidEdgeWeight(weight))
+          continue;
+        BorderCross const cross = m_crossGraph.ConstructBorderCross(outgoingNodes[j], mapping);
+        if (cross.toNode.IsValid())
+          starts.emplace_back(cross, weight);
+      }
+      CalculateCrossMwmRow(rows[i], mwmId, starts);
+    }
+  }
+
+private:
+  // Weights from the ingoing nodes of an mwm to its targets.
+  struct IngoingWeights
+  {
+    unordered_map<NodeID, size_t> m_rows;
+    vector<size_t> m_targets;
+    vector<EdgeWeight> m_weights;
+  };
+
+  EdgeWeight & GetWeight(size_t source, size_t target)
+  {
+    return m_weights[source * m_targets.size() + target];
+  }
+
+  IngoingWeights const & GetIngoingWeights(Index::MwmId const & mwmId)
+  {
+    auto it = m_ingoingWeights.find(mwmId);
+    if (it != m_ingoingWeights.end())
+      return it->second;
+
+    IngoingWeights & result = m_ingoingWeights[mwmId];
+    auto const targetsIt = m_targetsByMwm.find(mwmId);
+    if (targetsIt == m_targetsByMwm.end())
+      return result;
+
+    TRoutingMappingPtr mapping = m_indexManager->GetMappingById(mwmId);
+    if (!mapping->IsValid())
+      return result;
+    MappingGuard mappingGuard(mapping);
+    UNUSED_VALUE(mappingGuard);
+    mapping->LoadCrossContext();
+
+    vector<TRoutingNodes> sources;
+    mapping->m_crossContext.ForEachIngoingNode([&](IngoingCrossNode const & node)
+                                               {
+                                                 result.m_rows[node.m_nodeId] = sources.size();
+                                                 sources.push_back({FeatureGraphNode(
+                                                     node.m_nodeId, true /* isStartNode */, mwmId)});
+                                               });
+    if (sources.empty())
+      return result;
+
+    vector<TRoutingNodes> targets;
+    for (size_t target : targetsIt->second)
+      targets.push_back(m_targets[target]);
+
+    result.m_targets = targetsIt->second;
+    FindWeightsMatrix(sources, targets, mapping->m_dataFacade, result.m_weights);
+    return result;
+  }
+
+  /// Dijkstra's algorithm on the graph of border crosses from the source to the ingoing nodes
+  /// of the target mwms. Stops when all the targets of other mwms are reached and no better
+  /// routes to them are possible.
+  void CalculateCrossMwmRow(size_t row, Index::MwmId const & sourceMwmId,
+                            vector<pair<BorderCross, EdgeWeight>> const & starts)
+  {
+    using TQueueItem = pair<double, BorderCross>;
+    priority_queue<TQueueItem, vector<TQueueItem>, greater<TQueueItem>> queue;
+    map<BorderCross, double> bestDistances;
+    for (auto const & start : starts)
+    {
+      auto const res = bestDistances.insert(make_pair(start.first, start.second));
+      if (!res.second)
+      {
+        if (res.first->second <= start.second)
+          continue;
+        res.first->second = start.second;
+      }
+      queue.emplace(start.second, start.first);
+    }
+
+    vector<size_t> crossTargets;
+    for (auto const & mwmTargets : m_targetsByMwm)
+    {
+      if (mwmTargets.first != sourceMwmId)
+        crossTargets.insert(crossTargets.end(), mwmTargets.second.begin(), mwmTargets.second.end());
+    }
+    vector<double> distances(m_targets.size(), TravelMatrix::kUnreachable);
+
+    // Distance which can't improve the distances to the targets.
+    double bound = TravelMatrix::kUnreachable;
+    auto const updateBound = [&]()
+    {
+      bound = 0;
+      for (size_t target : crossTargets)
+        bound = max(bound, distances[target]);
+    };
+
+    set<BorderCross> settled;
+    vector<CrossWeightedEdge> adj;
+    while (!queue.empty())
+    {
+      TQueueItem const item = queue.top();
+      queue.pop();
+      double const distance = item.first;
+      BorderCross const & cross = item.second;
+      if (distance >= bound)
+        break;
+      if (!settled.insert(cross).second)
+        continue;
+
+      if (settled.size() % 1024 == 0 && m_delegate.IsCancelled())
+        return;
+
+      Index::MwmId const & mwmId = cross.toNode.mwmId;
+      if (mwmId != sourceMwmId)
+      {
+        IngoingWeights const & ingoing = GetIngoingWeights(mwmId);
+        auto const it = ingoing.m_rows.find(cross.toNode.node);
+        if (it != ingoing.m_rows.end())
+        {
+          bool updated = false;
+          for (size_t j = 0; j < ingoing.m_targets.size(); ++j)
+          {
+            EdgeWeight const weight = ingoing.m_weights[it->second * ingoing.m_targets.size() + j];
+            size_t const target = ingoing.m_targets[j];
+            if (IsValidEdgeWeight(weight) && distance + weight < distances[target])
+            {
+              distances[target] = distance + weight;
+              updated = true;
+            }
+          }
+          if (updated)
+            updateBound();
+        }
+      }
+
+      m_crossGraph.GetOutgoingEdgesList(cross, adj);
+      for (CrossWeightedEdge const & edge : adj)
+      {
+        double const newDistance = distance + edge.GetWeight();
+        auto const res = bestDistances.insert(make_pair(edge.GetTarget(), newDistance));
+        if (!res.second)
+        {
+          if (res.first->second <= newDistance)
+            continue;
+          res.first->second = newDistance;
+        }
+        queue.emplace(newDistance, edge.GetTarget());
+      }
+    }
+
+    for (size_t target : crossTargets)
+    {
+      if (distances[target] != TravelMatrix::kUnreachable)
+        GetWeight(row, target) = static_cast<EdgeWeight>(distances[target]);
+    }
+  }
+
+  vector<TRoutingNodes> const & m_sources;
+  vector<TRoutingNodes> const & m_targets;
+  TMwmToIndices const & m_targetsByMwm;
+  unique_ptr<RoutingIndexManager> m_indexManager;
+  CrossMwmGraph m_crossGraph;
+  RouterDelegate const & m_delegate;
+  vector<EdgeWeight> & m_weights;
+
+  map<Index::MwmId, IngoingWeights> m_ingoingWeights;
+};
+}  // namespace
+
+// static
+double constexpr TravelMatrix::kUnreachable;
+
+void TravelMatrix::Reset(size_t sourcesCount, size_t targetsCount, bool withDistances)
+{
+  m_sourcesCount = sourcesCount;
+  m_targetsCount = targetsCount;
+  m_durations.assign(sourcesCount * targetsCount, kUnreachable);
+  m_distances.clear();
+  if (withDistances)
+    m_distances.assign(sourcesCount * targetsCount, kUnreachable);
+}
+
+string DebugPrint(TravelMatrix const & matrix)
+{
+  ostringstream os;
+  os << "TravelMatrix [ " << matrix.m_sourcesCount << "x" << matrix.m_targetsCount;
+  for (size_t i = 0; i < matrix.m_sourcesCount; ++i)
+  {
+    os << "\n";
+    for (size_t j = 0; j < matrix.m_targetsCount; ++j)
+    {
+      os << " " << matrix.GetDuration(i, j);
+      if (!matrix.m_distances.empty())
+        os << "/" << matrix.m_distances[matrix.GetIndex(i, j)];
+    }
+  }
+  os << " ]";
+  return os.str();
+}
+
+IRouter::ResultCode FindWeightsMatrix(vector<TRoutingNodes> const & sources,
+                                      vector<TRoutingNodes> const & targets,
+                                      RoutingIndexManager const & indexManager,
+                                      threads::ForkJoinPool & pool,
+                                      RouterDelegate const & delegate,
+                                      vector<EdgeWeight> & weights)
+{
+  weights.assign(sources.size() * targets.size(), INVALID_EDGE_WEIGHT);
+
+  TMwmToIndices const sourcesByMwm = GroupByMwm(sources);
+  TMwmToIndices const targetsByMwm = GroupByMwm(targets);
+
+  // Every task is a part of rows of one mwm. Sources of one mwm are kept together as much as
+  // possible, because the weights from them are found by one many-to-many call.
+  size_t const tasksCount = max(pool.GetThreadsCount(), static_cast<size_t>(1));
+  size_t const rowsPerTask = (sources.size() + tasksCount - 1) / tasksCount;
+  vector<pair<Index::MwmId, vector<size_t>>> tasks;
+  for (auto const & mwmSources : sourcesByMwm)
+  {
+    vector<size_t> const & rows = mwmSources.second;
+    for (size_t begin = 0; begin < rows.size(); begin += rowsPerTask)
+    {
+      size_t const end = min(rows.size(), begin + rowsPerTask);
+      tasks.emplace_back(mwmSources.first,
+                         vector<size_t>(rows.begin() + begin, rows.begin() + end));
+    }
+  }
+
+  pool.ForEach(tasks.size(), [&](size_t i)
+               {
+                 if (delegate.IsCancelled())
+                   return;
+                 MatrixWorker worker(sources, targets, targetsByMwm, indexManager.CreateEmptyCopy(),
+                                     delegate, weights);
+                 worker.CalculateRows(tasks[i].first, tasks[i].second);
+               });
+
+  return delegate.IsCancelled() ? IRouter::Cancelled : IRouter::NoError;
+}
+}  // namespace routing
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "routing/osrm_engine.hpp"
+#include "routing/router.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/limits.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace threads
+{
+class ForkJoinPool;
+}  // namespace threads
+
+namespace routing
+{
+class RouterDelegate;
+class RoutingIndexManager;
+
+/// Travel durations and distances between every source and every target.
+/// Values are stored row by row, sources are rows.
+struct TravelMatrix
+{
+  static double constexpr kUnreachable = numeric_limits<double>::infinity();
+
+  void Reset(size_t sourcesCount, size_t targetsCount, bool withDistances);
+
+  inline size_t GetIndex(size_t source, size_t target) const
+  {
+    ASSERT_LESS(source, m_sourcesCount, ());
+    ASSERT_LESS(target, m_targetsCount, ());
+    return source * m_targetsCount + target;
+  }
+
+  inline double GetDuration(size_t source, size_t target) const
+  {
+    return m_durations[GetIndex(source, target)];
+  }
+
+  inline bool IsReachable(size_t source, size_t target) const
+  {
+    return GetDuration(source, target) != kUnreachable;
+  }
+
+  size_t m_sourcesCount = 0;
+  size_t m_targetsCount = 0;
+  /// Durations in seconds, kUnreachable when there is no route.
+  vector<double> m_durations;
+  /// Route lengths in meters, kUnreachable when there is no route.
+  /// Empty when distances were not requested.
+  vector<double> m_distances;
+};
+
+string DebugPrint(TravelMatrix const & matrix);
+
+/*!
+ * \brief Calculates OSRM weights of routes from every source to every target.
+ * Sources and targets may be in different mwms: the weight of a route through several mwms
+ * is combined from the weights from the source to the outgoing nodes of its mwm, the cross
+ * context weights between border nodes and the weights from the ingoing nodes of the target mwm
+ * to the target. As in OsrmRouter, routes between nodes of one mwm don't leave it.
+ * \param sources Candidate graph nodes of every source, all candidates are in one mwm.
+ * \param targets Candidate graph nodes of every target, all candidates are in one mwm.
+ * \param indexManager Prototype of the index managers of the workers.
+ * \param pool Source rows are split between the workers of the pool. Every worker uses its own
+ * routing mappings.
+ * \param weights Result weights, INVALID_EDGE_WEIGHT for unreachable pairs. Sources are rows.
+ * \return NoError or Cancelled.
+ */
+IRouter::ResultCode FindWeightsMatrix(vector<TRoutingNodes> const & sources,
+                                      vector<TRoutingNodes> const & targets,
+                                      RoutingIndexManager const & indexManager,
+                                      threads::ForkJoinPool & pool,
+                                      RouterDelegate const & delegate,
+                                      vector<EdgeWeight> & weights);
+}  // namespace routing
@@ -1,10 +1,14 @@
 #pragma once
+#include "search/levenshtein_automaton.hpp"
 #include "search/search_common.hpp"
 #include "search/search_query.hpp"
 #include "search/search_query_params.hpp"
 
+#include "indexer/index.hpp"
 #include "indexer/search_trie.hpp"
 
+#include "coding/reader_wrapper.hpp"
+
 #include "base/mutex.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
@@ -13,12 +17,23 @@
 #include "std/algorithm.hpp"
 #include "std/target_os.hpp"
 #include "std/unique_ptr.hpp"
-#include "std/unordered_set.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
 namespace search
 {
+/// @return Root of the search index trie of the mwm: the in-memory one when it is loaded
+/// (see Index::SetFlatSearchTrie()), otherwise the trie read through searchReader.
+/// Both searchReader and cp should outlive the root.
+inline trie::DefaultIterator * ReadSearchTrie(MwmValue const & value, Reader * searchReader,
+                                              serial::CodingParams const & cp)
+{
+  if (auto const * searchTrie = value.GetSearchTrie())
+    return searchTrie->CreateRootIterator();
+  return trie::ReadTrie(SubReaderWrapper<Reader>(searchReader), trie::ValueReader(cp),
+                        trie::TEdgeValueReader());
+}
+
 namespace impl
 {
 template <class TSrcIter, class TCompIter>
@@ -102,6 +117,16 @@ void FullMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar co
   if (!CheckMatchString(rootPrefix, rootPrefixSize, s))
       return;
 
+  // Walk the flat trie directly, without creating iterators for the nodes on the way.
+  if (auto const * pFlatRoot = dynamic_cast<trie::DefaultFlatTrie::Iterator const *>(&trieRoot))
+  {
+    auto const & flatTrie = pFlatRoot->GetTrie();
+    auto node = pFlatRoot->GetNode();
+    if (flatTrie.MoveToNode(node, s.data(), s.size()))
+      flatTrie.ForEachValue(node, f);
+    return;
+  }
+
   size_t symbolsMatched = 0;
   bool bFullEdgeMatched;
   unique_ptr<trie::DefaultIterator> const pIter(
@@ -121,6 +146,35 @@ void FullMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar co
     f(pIter->m_value[i]);
 }
 
+template <typename F>
+void ForEachValueInSubtree(vector<trie::DefaultIterator *> & trieQueue, F & f)
+{
+  // 'f' can throw an exception. So be prepared to delete unprocessed elements.
+  MY_SCOPE_GUARD(doDelete, GetRangeDeletor(trieQueue, DeleteFunctor()));
+
+  while (!trieQueue.empty())
+  {
+    // Next 2 lines don't throw any exceptions while moving
+    // ownership from container to smart pointer.
+    unique_ptr<trie::DefaultIterator> const pIter(trieQueue.back());
+    trieQueue.pop_back();
+
+    // Values of a flat trie subtree are stored contiguously, so no iterators are needed.
+    auto const * pFlatIter = dynamic_cast<trie::DefaultFlatTrie::Iterator const *>(pIter.get());
+    if (pFlatIter)
+    {
+      pFlatIter->GetTrie().ForEachValueInSubtree(pFlatIter->GetNode(), f);
+      continue;
+    }
+
+    for (size_t i = 0; i < pIter->m_value.size(); ++i)
+      f(pIter->m_value[i]);
+
+    for (size_t i = 0; i < pIter->m_edge.size(); ++i)
+      trieQueue.push_back(pIter->GoToEdge(i));
+  }
+}
+
 template <typename F>
 void PrefixMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar const * rootPrefix,
                        size_t rootPrefixSize, strings::UniString s, F & f)
@@ -128,6 +182,16 @@ void PrefixMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar
   if (!CheckMatchString(rootPrefix, rootPrefixSize, s))
       return;
 
+  // Walk the flat trie directly, without creating iterators for the nodes on the way.
+  if (auto const * pFlatRoot = dynamic_cast<trie::DefaultFlatTrie::Iterator const *>(&trieRoot))
+  {
+    auto const & flatTrie = pFlatRoot->GetTrie();
+    auto node = pFlatRoot->GetNode();
+    if (flatTrie.MoveToString(node, s.data(), s.size()))
+      flatTrie.ForEachValueInSubtree(node, f);
+    return;
+  }
+
   using TQueue = vector<trie::DefaultIterator *>;
   TQueue trieQueue;
   {
@@ -145,34 +209,107 @@ void PrefixMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar
     trieQueue.push_back(pRootIter);
   }
 
+  ForEachValueInSubtree(trieQueue, f);
+}
+
+// Calls f for each value of the words which are within automaton's max errors from its pattern.
+// When bPrefixMatch is true, f is called for each value of the words with such a prefix.
+// Edges are fed to the automaton symbol by symbol and subtrees which can't be matched
+// are skipped without reading them.
+template <typename F>
+void FuzzyMatchInTrie(trie::DefaultIterator const & trieRoot, strings::UniChar const * rootPrefix,
+                      size_t rootPrefixSize, LevenshteinAutomaton const & automaton,
+                      bool bPrefixMatch, F & f)
+{
+  using TState = LevenshteinAutomaton::State;
+
+  TState rootState = automaton.Start();
+  for (size_t i = 0; i <= rootPrefixSize; ++i)
+  {
+    // A prefix match may be found in the middle of the root prefix.
+    if (bPrefixMatch && automaton.IsAccepting(rootState))
+    {
+      vector<trie::DefaultIterator *> subtree = {trieRoot.Clone()};
+      ForEachValueInSubtree(subtree, f);
+      return;
+    }
+    if (i < rootPrefixSize)
+      rootState = automaton.Step(rootState, rootPrefix[i]);
+  }
+  if (!automaton.CanMatch(rootState))
+    return;
+
+  vector<pair<trie::DefaultIterator *, TState>> trieQueue;
+  trieQueue.emplace_back(trieRoot.Clone(), rootState);
+
   // 'f' can throw an exception. So be prepared to delete unprocessed elements.
-  MY_SCOPE_GUARD(doDelete, GetRangeDeletor(trieQueue, DeleteFunctor()));
+  MY_SCOPE_GUARD(doDelete, [&trieQueue]()
+  {
+    for (auto & item : trieQueue)
+      delete item.first;
+  });
 
   while (!trieQueue.empty())
   {
-    // Next 2 lines don't throw any exceptions while moving
-    // ownership from container to smart pointer.
-    unique_ptr<trie::DefaultIterator> const pIter(trieQueue.back());
+    unique_ptr<trie::DefaultIterator> pIter(trieQueue.back().first);
+    TState const state = trieQueue.back().second;
     trieQueue.pop_back();
 
-    for (size_t i = 0; i < pIter->m_value.size(); ++i)
-      f(pIter->m_value[i]);
+    if (bPrefixMatch && automaton.IsAccepting(state))
+    {
+      vector<trie::DefaultIterator *> subtree = {pIter.release()};
+      ForEachValueInSubtree(subtree, f);
+      continue;
+    }
+
+    if (automaton.IsAccepting(state))
+    {
+      for (size_t i = 0; i < pIter->m_value.size(); ++i)
+        f(pIter->m_value[i]);
+    }
 
     for (size_t i = 0; i < pIter->m_edge.size(); ++i)
-      trieQueue.push_back(pIter->GoToEdge(i));
+    {
+      auto const & edge = pIter->m_edge[i].m_str;
+      TState edgeState = state;
+      bool accepting = false;
+      for (size_t j = 0; j < edge.size() && !accepting; ++j)
+      {
+        edgeState = automaton.Step(edgeState, edge[j]);
+        // A prefix match may be found in the middle of the edge.
+        accepting = bPrefixMatch && automaton.IsAccepting(edgeState);
+      }
+      // The minimum of the distances column never decreases, so it's enough
+      // to check the state at the end of the edge.
+      if (accepting || automaton.CanMatch(edgeState))
+        trieQueue.emplace_back(pIter->GoToEdge(i), edgeState);
+    }
   }
 }
 
+// Intersects sets of feature values matched by consecutive query tokens.
+// Every set is kept as a vector of values sorted by feature id.
+// Membership in the previous set is checked by a bitmap when the set is dense,
+// by a linear scan when it is small and by galloping from the last found
+// position otherwise, as the values of a trie node come sorted by feature id.
 template <class TFilter>
 class OffsetIntersecter
 {
   using ValueT = trie::ValueReader::ValueType;
 
-  struct HashFn
+  static size_t constexpr kSmallSetSize = 16;
+  // The bitmap is built when it takes at most that many bits per value.
+  static size_t constexpr kMaxBitsPerValue = 64;
+
+  struct LessFn
   {
-    size_t operator() (ValueT const & v) const
+    bool operator() (ValueT const & v1, ValueT const & v2) const
     {
-      return v.m_featureId;
+      return v1.m_featureId < v2.m_featureId;
+    }
+    bool operator() (ValueT const & v, uint32_t featureId) const
+    {
+      return v.m_featureId < featureId;
     }
   };
   struct EqualFn
@@ -183,44 +320,148 @@ class OffsetIntersecter
     }
   };
 
-  using TSet = unordered_set<ValueT, HashFn, EqualFn>;
-
   TFilter const & m_filter;
-  unique_ptr<TSet> m_prevSet;
-  unique_ptr<TSet> m_set;
+  // Values matched by the previous steps, sorted by feature id.
+  vector<ValueT> m_prevSet;
+  // Values matched by the current step in the order of arrival.
+  vector<ValueT> m_set;
+  // Bitmap of m_prevSet feature ids starting from m_prevSet.front().m_featureId.
+  vector<uint64_t> m_prevBits;
+  // Position in m_prevSet where the last lookup has stopped.
+  size_t m_cursor = 0;
+  bool m_hasPrevSet = false;
+
+  bool HasFeature(uint32_t featureId)
+  {
+    if (m_prevSet.empty() || featureId < m_prevSet.front().m_featureId ||
+        featureId > m_prevSet.back().m_featureId)
+    {
+      return false;
+    }
+
+    if (!m_prevBits.empty())
+    {
+      uint32_t const bit = featureId - m_prevSet.front().m_featureId;
+      return (m_prevBits[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    if (m_prevSet.size() <= kSmallSetSize)
+    {
+      for (auto const & v : m_prevSet)
+      {
+        if (v.m_featureId == featureId)
+          return true;
+      }
+      return false;
+    }
+
+    // Gallop from the cursor towards featureId, then search in the found range.
+    size_t const size = m_prevSet.size();
+    size_t lo = 0;
+    size_t hi = size;
+    if (m_cursor >= size)
+      m_cursor = size - 1;
+    if (m_prevSet[m_cursor].m_featureId <= featureId)
+    {
+      lo = m_cursor;
+      size_t step = 1;
+      while (lo + step < size && m_prevSet[lo + step].m_featureId <= featureId)
+      {
+        lo += step;
+        step *= 2;
+      }
+      hi = min(size, lo + step + 1);
+    }
+    else
+    {
+      hi = m_cursor;
+      size_t step = 1;
+      while (step <= hi && m_prevSet[hi - step].m_featureId > featureId)
+      {
+        hi -= step;
+        step *= 2;
+      }
+      lo = step <= hi ? hi - step : 0;
+    }
+
+    auto const it = lower_bound(m_prevSet.begin() + lo, m_prevSet.begin() + hi, featureId, LessFn());
+    m_cursor = static_cast<size_t>(it - m_prevSet.begin());
+    return it != m_prevSet.end() && it->m_featureId == featureId;
+  }
+
+  void BuildPrevBits()
+  {
+    m_prevBits.clear();
+    if (m_prevSet.size() <= kSmallSetSize)
+      return;
+
+    uint64_t const range =
+        uint64_t(m_prevSet.back().m_featureId) - m_prevSet.front().m_featureId + 1;
+    if (range > m_prevSet.size() * kMaxBitsPerValue)
+      return;
+
+    m_prevBits.assign(static_cast<size_t>((range + 63) / 64), 0);
+    for (auto const & v : m_prevSet)
+    {
+      uint32_t const bit = v.m_featureId - m_prevSet.front().m_featureId;
+      m_prevBits[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+  }
 
 public:
-  explicit OffsetIntersecter(TFilter const & filter) : m_filter(filter), m_set(new TSet) {}
+  explicit OffsetIntersecter(TFilter const & filter) : m_filter(filter) {}
 
   void operator() (ValueT const & v)
   {
-    if (m_prevSet && !m_prevSet->count(v))
+    if (m_hasPrevSet && !HasFeature(v.m_featureId))
       return;
 
     if (!m_filter(v.m_featureId))
       return;
 
-    m_set->insert(v);
+    m_set.push_back(v);
   }
 
+  /// Starts from the given intersection of the previous steps.
+  void SetResults(vector<ValueT> const & values)
+  {
+    ASSERT(is_sorted(values.begin(), values.end(), LessFn()), ());
+    m_prevSet = values;
+    m_set.clear();
+    m_cursor = 0;
+    m_hasPrevSet = true;
+    BuildPrevBits();
+  }
+
+  /// @return Intersection of the finished steps sorted by feature id.
+  vector<ValueT> const & GetResults() const { return m_prevSet; }
+
   void NextStep()
   {
-    if (!m_prevSet)
-      m_prevSet.reset(new TSet);
+    // The first matched value of every feature is kept.
+    stable_sort(m_set.begin(), m_set.end(), LessFn());
+    m_set.erase(unique(m_set.begin(), m_set.end(), EqualFn()), m_set.end());
 
     m_prevSet.swap(m_set);
-    m_set->clear();
+    m_set.clear();
+    m_cursor = 0;
+    m_hasPrevSet = true;
+    BuildPrevBits();
   }
 
   template <class ToDo>
   void ForEachResult(ToDo && toDo) const
   {
-    if (!m_prevSet)
-      return;
-    for (auto const & value : *m_prevSet)
+    for (auto const & value : m_prevSet)
       toDo(value);
   }
 };
+
+template <class TFilter>
+size_t constexpr OffsetIntersecter<TFilter>::kSmallSetSize;
+
+template <class TFilter>
+size_t constexpr OffsetIntersecter<TFilter>::kMaxBitsPerValue;
 }  // namespace search::impl
 
 struct TrieRootPrefix
@@ -306,6 +547,34 @@ void MatchTokenPrefixInTrie(SearchQueryParams::TSynonymsVector const & syns,
   }
 }
 
+// Calls toDo for each feature whose tokens are within maxErrors edits from
+// at least one synonym, or, when bPrefix is true, have such a prefix.
+// Synonyms longer than LevenshteinAutomaton::kMaxPatternSize are matched exactly.
+// *NOTE* toDo may be called several times for the same feature.
+template <typename ToDo>
+void MatchTokenFuzzyInTrie(SearchQueryParams::TSynonymsVector const & syns,
+                           TrieRootPrefix const & trieRoot, uint32_t maxErrors, bool bPrefix,
+                           ToDo && toDo)
+{
+  for (auto const & syn : syns)
+  {
+    ASSERT(!syn.empty(), ());
+    if (syn.size() > LevenshteinAutomaton::kMaxPatternSize)
+    {
+      if (bPrefix)
+        impl::PrefixMatchInTrie(trieRoot.m_root, trieRoot.m_prefix, trieRoot.m_prefixSize, syn,
+                                toDo);
+      else
+        impl::FullMatchInTrie(trieRoot.m_root, trieRoot.m_prefix, trieRoot.m_prefixSize, syn, toDo);
+      continue;
+    }
+
+    LevenshteinAutomaton const automaton(syn, maxErrors);
+    impl::FuzzyMatchInTrie(trieRoot.m_root, trieRoot.m_prefix, trieRoot.m_prefixSize, automaton,
+                           bPrefix, toDo);
+  }
+}
+
 // Fills holder with features whose names correspond to tokens list up to synonyms.
 // *NOTE* the same feature may be put in the same holder's slot several times.
 template <typename THolder>
@@ -338,9 +607,10 @@ void MatchTokensAndPrefixInTrie(vector<SearchQueryParams::TSynonymsVector> const
 // Fills holder with categories whose description matches to at least one
 // token from a search query.
 // *NOTE* query prefix will be treated as a complete token in the function.
+// Holder's slots of the tokens before firstToken are left empty.
 template <typename THolder>
 bool MatchCategoriesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
-                           THolder && holder)
+                           THolder && holder, size_t firstToken = 0)
 {
   ASSERT_LESS(trieRoot.m_edge.size(), numeric_limits<uint32_t>::max(), ());
   uint32_t const numLangs = static_cast<uint32_t>(trieRoot.m_edge.size());
@@ -351,14 +621,20 @@ bool MatchCategoriesInTrie(SearchQueryParams const & params, trie::DefaultIterat
     if (edge[0] == search::kCategoriesLang)
     {
       unique_ptr<trie::DefaultIterator> const catRoot(trieRoot.GoToEdge(langIx));
-      MatchTokensInTrie(params.m_tokens, TrieRootPrefix(*catRoot, edge), holder);
+      TrieRootPrefix const catPrefix(*catRoot, edge);
+      holder.Resize(params.m_tokens.size());
+      for (size_t i = firstToken; i < params.m_tokens.size(); ++i)
+      {
+        holder.SwitchTo(i);
+        MatchTokenInTrie(params.m_tokens[i], catPrefix, holder);
+      }
 
       // Last token's prefix is used as a complete token here, to
       // limit the number of features in the last bucket of a
       // holder. Probably, this is a false optimization.
       holder.Resize(params.m_tokens.size() + 1);
       holder.SwitchTo(params.m_tokens.size());
-      MatchTokenInTrie(params.m_prefixTokens, TrieRootPrefix(*catRoot, edge), holder);
+      MatchTokenInTrie(params.m_prefixTokens, catPrefix, holder);
       return true;
     }
   }
@@ -387,17 +663,52 @@ void ForEachLangPrefix(SearchQueryParams const & params, trie::DefaultIterator c
   }
 }
 
+/// Intersection of features matched by the complete tokens of the last query in an mwm.
+/// MatchFeaturesInTrie() resumes from it when the next query extends these tokens,
+/// e.g. when the user types one more symbol of the prefix or finishes it, so only
+/// the new tokens and the prefix are matched. It should be cleared when the filter changes.
+struct TrieMatchingState
+{
+  void Clear()
+  {
+    m_tokens.clear();
+    m_langs.clear();
+    m_values.clear();
+  }
+
+  vector<SearchQueryParams::TSynonymsVector> m_tokens;
+  SearchQueryParams::TLangsSet m_langs;
+  vector<Query::TTrieValue> m_values;
+};
+
 // Calls toDo for each feature whose description contains *ALL* tokens from a search query.
 // Each feature will be passed to toDo only once.
+// Returns true if matching is resumed from the state of the previous query.
 template <typename TFilter, typename ToDo>
-void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
-                         TFilter const & filter, ToDo && toDo)
+bool MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
+                         TFilter const & filter, TrieMatchingState & state, ToDo && toDo)
 {
+  size_t firstToken = 0;
+  if (!state.m_tokens.empty() && state.m_tokens.size() <= params.m_tokens.size() &&
+      state.m_langs == params.m_langs &&
+      equal(state.m_tokens.begin(), state.m_tokens.end(), params.m_tokens.begin()))
+  {
+    firstToken = state.m_tokens.size();
+  }
+  else
+  {
+    state.Clear();
+  }
+
   TrieValuesHolder<TFilter> categoriesHolder(filter);
-  CHECK(MatchCategoriesInTrie(params, trieRoot, categoriesHolder), ("Can't find categories."));
+  CHECK(MatchCategoriesInTrie(params, trieRoot, categoriesHolder, firstToken),
+        ("Can't find categories."));
 
   impl::OffsetIntersecter<TFilter> intersecter(filter);
-  for (size_t i = 0; i < params.m_tokens.size(); ++i)
+  if (firstToken != 0)
+    intersecter.SetResults(state.m_values);
+
+  for (size_t i = firstToken; i < params.m_tokens.size(); ++i)
   {
     ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
     {
@@ -407,6 +718,13 @@ void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator
     intersecter.NextStep();
   }
 
+  if (firstToken != params.m_tokens.size())
+  {
+    state.m_tokens = params.m_tokens;
+    state.m_langs = params.m_langs;
+    state.m_values = intersecter.GetResults();
+  }
+
   if (!params.m_prefixTokens.empty())
   {
     ForEachLangPrefix(params, trieRoot, [&](TrieRootPrefix & langRoot, int8_t /* lang */)
@@ -418,5 +736,14 @@ void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator
   }
 
   intersecter.ForEachResult(forward<ToDo>(toDo));
+  return firstToken != 0;
+}
+
+template <typename TFilter, typename ToDo>
+void MatchFeaturesInTrie(SearchQueryParams const & params, trie::DefaultIterator const & trieRoot,
+                         TFilter const & filter, ToDo && toDo)
+{
+  TrieMatchingState state;
+  MatchFeaturesInTrie(params, trieRoot, filter, state, forward<ToDo>(toDo));
 }
 }  // namespace search
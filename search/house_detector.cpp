@@ -4,6 +4,7 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/feature_impl.hpp"
+#include "indexer/street_houses_index.hpp"
 
 #include "geometry/angles.hpp"
 #include "geometry/distance.hpp"
@@ -12,6 +13,7 @@
 #include "base/logging.hpp"
 #include "base/stl_iterator.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/numeric.hpp"
 #include "std/set.hpp"
@@ -311,7 +313,7 @@ void Street::SortHousesProjection()
 }
 
 HouseDetector::HouseDetector(Index const * pIndex)
-  : m_loader(pIndex), m_streetNum(0)
+  : m_pIndex(pIndex), m_loader(pIndex), m_streetNum(0)
 {
   // default value for conversions
   SetMetres2Mercator(360.0 / 40.0E06);
@@ -721,6 +723,33 @@ HouseProjection const * MergedStreet::GetHousePivot(bool isOdd, bool & sign) con
   return 0;
 }
 
+template <class ProjectionCalcT>
+void HouseDetector::AddHouse(FeatureID const & id, string const & number, m2::PointD const & pt,
+                             Street * st, ProjectionCalcT & calc)
+{
+  HouseMapT::iterator const it = m_id2house.find(id);
+  bool const isNew = it == m_id2house.end();
+
+  HouseProjection pr;
+  if (calc.GetProjection(isNew ? pt : it->second->GetPosition(), pr))
+  {
+    House * p;
+    if (isNew)
+    {
+      p = new House(number, pt);
+      m_id2house[id] = p;
+    }
+    else
+    {
+      p = it->second;
+      ASSERT(p != 0, ());
+    }
+
+    pr.m_house = p;
+    st->m_houses.push_back(pr);
+  }
+}
+
 template <class ProjectionCalcT>
 void HouseDetector::ReadHouse(FeatureType const & f, Street * st, ProjectionCalcT & calc)
 {
@@ -729,33 +758,16 @@ void HouseDetector::ReadHouse(FeatureType const & f, Street * st, ProjectionCalc
   /// @todo After new data generation we can skip IsHouseNumber check here.
   if (ftypes::IsBuildingChecker::Instance()(f) && feature::IsHouseNumber(houseNumber))
   {
-    HouseMapT::iterator const it = m_id2house.find(f.GetID());
-    bool const isNew = it == m_id2house.end();
-
-    m2::PointD const pt = isNew ? f.GetLimitRect(FeatureType::BEST_GEOMETRY).Center() : it->second->GetPosition();
-
-    HouseProjection pr;
-    if (calc.GetProjection(pt, pr))
-    {
-      House * p;
-      if (isNew)
-      {
-        p = new House(houseNumber, pt);
-        m_id2house[f.GetID()] = p;
-      }
-      else
-      {
-        p = it->second;
-        ASSERT(p != 0, ());
-      }
-
-      pr.m_house = p;
-      st->m_houses.push_back(pr);
-    }
+    FeatureID const & id = f.GetID();
+    HouseMapT::iterator const it = m_id2house.find(id);
+    m2::PointD const pt = (it == m_id2house.end()) ?
+        f.GetLimitRect(FeatureType::BEST_GEOMETRY).Center() : it->second->GetPosition();
+    AddHouse(id, houseNumber, pt, st, calc);
   }
 }
 
-void HouseDetector::ReadHouses(Street * st, double offsetMeters)
+void HouseDetector::ReadHouses(FeatureID const & id, Street * st, double offsetMeters,
+                               vector<shared_ptr<MwmInfo>> const & mwmsInfo)
 {
   if (st->m_housesReaded)
     return;
@@ -763,8 +775,36 @@ void HouseDetector::ReadHouses(Street * st, double offsetMeters)
   //offsetMeters = max(HN_MIN_READ_OFFSET_M, min(GetApprLengthMeters(st->m_number) / 2, offsetMeters));
 
   ProjectionCalcToStreet calcker(st, offsetMeters);
-  m_loader.ForEachInRect(st->GetLimitRect(offsetMeters),
-                         bind(&HouseDetector::ReadHouse<ProjectionCalcToStreet>, this, _1, st, ref(calcker)));
+  m2::RectD const rect = st->GetLimitRect(offsetMeters);
+
+  // Take candidate houses from the street-houses section if the mwm has it. The section knows
+  // only the houses of its own mwm, so it's skipped when the street is near another country.
+  // Projections are calculated here because the street may be reversed while merging.
+  bool isIndexed = false;
+  bool const isNearOtherMwm = any_of(mwmsInfo.begin(), mwmsInfo.end(),
+                                     [&](shared_ptr<MwmInfo> const & info)
+  {
+    return info != id.m_mwmId.GetInfo() && info->GetType() == MwmInfo::COUNTRY &&
+        info->m_limitRect.IsIntersect(rect);
+  });
+  if (!isNearOtherMwm)
+  {
+    MwmSet::MwmHandle const handle = m_pIndex->GetMwmHandleById(id.m_mwmId);
+    MwmValue const * value = handle.GetValue<MwmValue>();
+    feature::StreetHousesIndex const * index = value ? value->GetStreetHousesIndex() : nullptr;
+    isIndexed = index && offsetMeters <= index->GetMaxOffsetMeters() &&
+        index->ForEachHouse(id.m_index, [&](feature::StreetHousesIndex::House const & house)
+        {
+          AddHouse(FeatureID(id.m_mwmId, house.m_featureIndex), house.m_number, house.m_point, st,
+                   calcker);
+        });
+  }
+
+  if (!isIndexed)
+  {
+    m_loader.ForEachInRect(rect,
+                           bind(&HouseDetector::ReadHouse<ProjectionCalcToStreet>, this, _1, st, ref(calcker)));
+  }
 
   st->m_length = calcker.GetLength();
   st->SortHousesProjection();
@@ -774,8 +814,11 @@ void HouseDetector::ReadAllHouses(double offsetMeters)
 {
   m_houseOffsetM = offsetMeters;
 
+  vector<shared_ptr<MwmInfo>> mwmsInfo;
+  m_pIndex->GetMwmsInfo(mwmsInfo);
+
   for (StreetMapT::iterator it = m_id2st.begin(); it != m_id2st.end(); ++it)
-    ReadHouses(it->second, offsetMeters);
+    ReadHouses(it->first, it->second, offsetMeters, mwmsInfo);
 
   for (size_t i = 0; i < m_streets.size(); ++i)
   {
@@ -224,6 +224,7 @@ inline string DebugPrint(HouseResult const & r)
 
 class HouseDetector
 {
+  Index const * m_pIndex;
   FeatureLoader m_loader;
 
   typedef map<FeatureID, Street *> StreetMapT;
@@ -242,9 +243,13 @@ class HouseDetector
   StreetPtr FindConnection(Street const * st, bool beg) const;
   void MergeStreets(Street * st);
 
+  template <class ProjectionCalcT>
+  void AddHouse(FeatureID const & id, string const & number, m2::PointD const & pt, Street * st,
+                ProjectionCalcT & calc);
   template <class ProjectionCalcT>
   void ReadHouse(FeatureType const & f, Street * st, ProjectionCalcT & calc);
-  void ReadHouses(Street * st, double offsetMeters);
+  void ReadHouses(FeatureID const & id, Street * st, double offsetMeters,
+                  vector<shared_ptr<MwmInfo>> const & mwmsInfo);
 
   void SetMetres2Mercator(double factor);
 
@@ -0,0 +1,144 @@
+#include "search/levenshtein_automaton.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace search
+{
+using strings::UniChar;
+
+uint32_t constexpr LevenshteinAutomaton::kMaxPatternSize;
+
+LevenshteinAutomaton::LevenshteinAutomaton(strings::UniString const & pattern, uint32_t maxErrors)
+  : m_size(static_cast<uint32_t>(pattern.size())), m_maxErrors(maxErrors)
+{
+  ASSERT_LESS_OR_EQUAL(pattern.size(), kMaxPatternSize, ());
+  m_mask = m_size == kMaxPatternSize ? ~uint64_t(0) : (uint64_t(1) << m_size) - 1;
+
+  for (uint32_t i = 0; i < m_size; ++i)
+    m_peq.push_back(make_pair(pattern[i], uint64_t(1) << i));
+  sort(m_peq.begin(), m_peq.end());
+
+  // Merge masks of equal symbols.
+  size_t count = 0;
+  for (size_t i = 0; i < m_peq.size(); ++i)
+  {
+    if (count != 0 && m_peq[count - 1].first == m_peq[i].first)
+      m_peq[count - 1].second |= m_peq[i].second;
+    else
+      m_peq[count++] = m_peq[i];
+  }
+  m_peq.resize(count);
+}
+
+LevenshteinAutomaton::State LevenshteinAutomaton::Start() const
+{
+  // Distance between i first symbols of the pattern and the empty string is i.
+  State state;
+  state.m_vp = m_mask;
+  state.m_distance = m_size;
+  return state;
+}
+
+LevenshteinAutomaton::State LevenshteinAutomaton::Step(State const & state, UniChar c) const
+{
+  State next;
+  next.m_length = state.m_length + 1;
+  if (m_size == 0)
+  {
+    next.m_distance = next.m_length;
+    return next;
+  }
+
+  uint64_t const eq = GetPeq(c);
+  uint64_t const vp = state.m_vp;
+  uint64_t const vn = state.m_vn;
+
+  uint64_t const xv = eq | vn;
+  uint64_t const xh = (((eq & vp) + vp) ^ vp) | eq;
+  uint64_t hp = vn | ~(xh | vp);
+  uint64_t hn = vp & xh;
+
+  uint64_t const last = uint64_t(1) << (m_size - 1);
+  next.m_distance = state.m_distance;
+  if (hp & last)
+    ++next.m_distance;
+  else if (hn & last)
+    --next.m_distance;
+
+  // The first row grows by one with every consumed symbol.
+  hp = (hp << 1) | 1;
+  hn = hn << 1;
+  next.m_vp = (hn | ~(xv | hp)) & m_mask;
+  next.m_vn = (hp & xv) & m_mask;
+  return next;
+}
+
+bool LevenshteinAutomaton::CanMatch(State const & state) const
+{
+  // Any alignment of the pattern with a continuation passes through the current column,
+  // so its minimum is a lower bound of all further distances.
+  if (state.m_distance <= m_maxErrors)
+    return true;
+
+  // The distance between i first symbols of the pattern and the consumed symbols is at
+  // least |m_length - i|, so only the rows of the band around m_length may be small enough.
+  uint32_t const first = state.m_length > m_maxErrors ? state.m_length - m_maxErrors : 0;
+  if (first > m_size)
+    return false;
+  uint32_t const last = min(m_size, state.m_length + m_maxErrors);
+
+  uint64_t const below = first == kMaxPatternSize ? ~uint64_t(0) : (uint64_t(1) << first) - 1;
+  int64_t value = static_cast<int64_t>(state.m_length) +
+                  static_cast<int64_t>(bits::popcount(state.m_vp & below)) -
+                  static_cast<int64_t>(bits::popcount(state.m_vn & below));
+  for (uint32_t i = first;; ++i)
+  {
+    if (value <= static_cast<int64_t>(m_maxErrors))
+      return true;
+    if (i == last)
+      return false;
+    uint64_t const bit = uint64_t(1) << i;
+    if (state.m_vp & bit)
+      ++value;
+    else if (state.m_vn & bit)
+      --value;
+  }
+}
+
+bool LevenshteinAutomaton::Matches(strings::UniString const & s) const
+{
+  State state = Start();
+  for (UniChar c : s)
+  {
+    state = Step(state, c);
+    if (!IsAccepting(state) && !CanMatch(state))
+      return false;
+  }
+  return IsAccepting(state);
+}
+
+bool LevenshteinAutomaton::MatchesPrefix(strings::UniString const & s) const
+{
+  State state = Start();
+  if (IsAccepting(state))
+    return true;
+  for (UniChar c : s)
+  {
+    state = Step(state, c);
+    if (IsAccepting(state))
+      return true;
+    if (!CanMatch(state))
+      return false;
+  }
+  return false;
+}
+
+uint64_t LevenshteinAutomaton::GetPeq(UniChar c) const
+{
+  auto const it = lower_bound(m_peq.begin(), m_peq.end(), make_pair(c, uint64_t(0)));
+  return (it != m_peq.end() && it->first == c) ? it->second : 0;
+}
+}  // namespace search
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "base/buffer_vector.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/utility.hpp"
+
+namespace search
+{
+/// Bit-parallel (Myers/Hyyro) Levenshtein automaton for a pattern of at most
+/// kMaxPatternSize symbols with a bounded number of errors.
+///
+/// The state is a column of the edit distances between the prefixes of the pattern
+/// and the consumed text, encoded as vertical deltas in two words, so every step is
+/// O(1). States are values, so the automaton can be driven along trie edges and
+/// the whole subtree can be skipped as soon as CanMatch() returns false.
+class LevenshteinAutomaton
+{
+public:
+  static uint32_t constexpr kMaxPatternSize = 64;
+
+  struct State
+  {
+    // Positive and negative vertical deltas of the column.
+    uint64_t m_vp = 0;
+    uint64_t m_vn = 0;
+    // Number of consumed symbols.
+    uint32_t m_length = 0;
+    // Edit distance between the whole pattern and the consumed symbols.
+    uint32_t m_distance = 0;
+  };
+
+  /// @precondition pattern.size() <= kMaxPatternSize.
+  LevenshteinAutomaton(strings::UniString const & pattern, uint32_t maxErrors);
+
+  State Start() const;
+  State Step(State const & state, strings::UniChar c) const;
+
+  inline bool IsAccepting(State const & state) const { return state.m_distance <= m_maxErrors; }
+
+  /// @return false when no continuation of the consumed symbols can be accepted.
+  /// Only the rows within maxErrors from the number of consumed symbols are checked,
+  /// so the cost doesn't depend on the pattern size.
+  bool CanMatch(State const & state) const;
+
+  inline uint32_t GetMaxErrors() const { return m_maxErrors; }
+
+  /// @return true if the distance between the pattern and s is at most maxErrors.
+  bool Matches(strings::UniString const & s) const;
+
+  /// @return true if the distance between the pattern and some prefix of s is at most maxErrors.
+  bool MatchesPrefix(strings::UniString const & s) const;
+
+private:
+  uint64_t GetPeq(strings::UniChar c) const;
+
+  // Bit masks of the pattern positions for every pattern symbol, sorted by symbol.
+  buffer_vector<pair<strings::UniChar, uint64_t>, 32> m_peq;
+  uint64_t m_mask;
+  uint32_t m_size;
+  uint32_t m_maxErrors;
+};
+}  // namespace search
@@ -19,6 +19,7 @@ HEADERS += \
     keyword_lang_matcher.hpp \
     keyword_matcher.hpp \
     latlon_match.hpp \
+    levenshtein_automaton.hpp \
     locality_finder.hpp \
     params.hpp \
     query_saver.hpp \
@@ -40,6 +41,7 @@ SOURCES += \
     keyword_lang_matcher.cpp \
     keyword_matcher.cpp \
     latlon_match.cpp \
+    levenshtein_automaton.cpp \
     locality_finder.cpp \
     params.cpp \
     query_saver.cpp \
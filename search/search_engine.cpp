@@ -15,9 +15,13 @@
 
 #include "geometry/distance_on_sphere.hpp"
 
+#include "base/fork_join_pool.hpp"
+#include "base/logging.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/map.hpp"
+#include "std/sstream.hpp"
 #include "std/vector.hpp"
 #include "std/bind.hpp"
 
@@ -71,10 +75,74 @@ public:
 
 }
 
+Engine::QueryHandle::QueryHandle() : m_query(nullptr), m_cancelled(false), m_finished(false) {}
+
+void Engine::QueryHandle::Cancel()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cancelled = true;
+  if (m_query)
+    m_query->Cancel();
+}
+
+bool Engine::QueryHandle::IsFinished() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_finished;
+}
+
+void Engine::QueryHandle::Wait() const
+{
+  unique_lock<mutex> lock(m_mutex);
+  m_cv.wait(lock, [this]() { return m_finished; });
+}
+
+void Engine::QueryHandle::Attach(Query & query)
+{
+  lock_guard<mutex> lock(m_mutex);
+  ASSERT(!m_query, ());
+  ASSERT(!m_finished, ());
+  if (m_cancelled)
+    query.Cancel();
+  m_query = &query;
+}
+
+void Engine::QueryHandle::Finish()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_query = nullptr;
+  m_finished = true;
+  m_cv.notify_all();
+}
+
+Engine::Stats::Stats()
+  : m_submitted(0)
+  , m_completed(0)
+  , m_cancelled(0)
+  , m_pending(0)
+  , m_totalLatencySec(0.0)
+  , m_maxLatencySec(0.0)
+  , m_uptimeSec(0.0)
+{
+}
+
+double Engine::Stats::GetThroughput() const
+{
+  return m_uptimeSec > 0.0 ? m_completed / m_uptimeSec : 0.0;
+}
+
+double Engine::Stats::GetAverageLatency() const
+{
+  return m_completed > 0 ? m_totalLatencySec / m_completed : 0.0;
+}
+
 Engine::Engine(Index & index, Reader * categoriesR, storage::CountryInfoGetter const & infoGetter,
-               string const & locale, unique_ptr<SearchQueryFactory> && factory)
+               string const & locale, unique_ptr<SearchQueryFactory> && factory,
+               size_t numConcurrentQueries, size_t numSearchThreads)
   : m_factory(move(factory))
   , m_data(make_unique<EngineData>(categoriesR))
+  , m_shutdown(false)
+  , m_cachesGeneration(0)
 {
   m_isReadyThread.clear();
 
@@ -82,18 +150,46 @@ Engine::Engine(Index & index, Reader * categoriesR, storage::CountryInfoGetter c
   m_data->m_categories.ForEachName(bind<void>(ref(doInit), _1));
   doInit.GetSuggests(m_data->m_suggests);
 
+  if (numSearchThreads > 1)
+    m_workers = make_unique<threads::ForkJoinPool>(numSearchThreads);
+
   m_query =
       m_factory->BuildSearchQuery(index, m_data->m_categories, m_data->m_suggests, infoGetter);
   m_query->SetPreferredLocale(locale);
+  m_query->SetWorkers(m_workers.get());
+
+  for (size_t i = 0; i < numConcurrentQueries; ++i)
+  {
+    m_concurrentQueries.push_back(
+        m_factory->BuildSearchQuery(index, m_data->m_categories, m_data->m_suggests, infoGetter));
+    m_concurrentQueries.back()->SetPreferredLocale(locale);
+    m_concurrentQueries.back()->SetWorkers(m_workers.get());
+  }
+  for (size_t i = 0; i < numConcurrentQueries; ++i)
+    m_concurrentThreads.emplace_back(&Engine::ConcurrentWorker, this, i);
 }
 
 Engine::~Engine()
 {
+  {
+    lock_guard<mutex> lock(m_requestsMutex);
+    m_shutdown = true;
+    for (auto & query : m_concurrentQueries)
+      query->Cancel();
+  }
+  m_requestsCv.notify_all();
+
+  for (auto & thread : m_concurrentThreads)
+    thread.join();
 }
 
 void Engine::SupportOldFormat(bool b)
 {
   m_query->SupportOldFormat(b);
+
+  // Concurrent queries read this flag only at the start of processing.
+  for (auto & query : m_concurrentQueries)
+    query->SupportOldFormat(b);
 }
 
 void Engine::PrepareSearch(m2::RectD const & viewport)
@@ -161,19 +257,19 @@ void Engine::EmitResults(SearchParams const & params, Results & res)
 }
 
 void Engine::SetRankPivot(SearchParams const & params,
-                          m2::RectD const & viewport, bool viewportSearch)
+                          m2::RectD const & viewport, bool viewportSearch, Query & query)
 {
   if (!viewportSearch && params.IsValidPosition())
   {
     m2::PointD const pos = MercatorBounds::FromLatLon(params.m_lat, params.m_lon);
     if (m2::Inflate(viewport, viewport.SizeX() / 4.0, viewport.SizeY() / 4.0).IsPointInside(pos))
     {
-      m_query->SetRankPivot(pos);
+      query.SetRankPivot(pos);
       return;
     }
   }
 
-  m_query->SetRankPivot(viewport.Center());
+  query.SetRankPivot(viewport.Center());
 }
 
 void Engine::SearchAsync()
@@ -204,27 +300,44 @@ void Engine::SearchAsync()
       viewport = m_viewport;
   }
 
+  DoSearch(params, viewport, oneTimeSearch, *m_query, nullptr /* handle */);
+}
+
+void Engine::DoSearch(SearchParams const & params, m2::RectD viewport, bool oneTimeSearch,
+                      Query & query, QueryHandle * handle)
+{
   bool const viewportSearch = params.HasSearchMode(SearchParams::IN_VIEWPORT_ONLY);
 
   // Initialize query.
-  m_query->Init(viewportSearch);
+  query.Init(viewportSearch);
+  if (handle)
+  {
+    handle->Attach(query);
+
+    // Init() resets the cancel flag, so the shutdown requested before it is applied again.
+    // ~Engine() cancels queries under the same mutex, so it either sees the initialized
+    // query or is seen here.
+    lock_guard<mutex> lock(m_requestsMutex);
+    if (m_shutdown)
+      query.Cancel();
+  }
 
-  SetRankPivot(params, viewport, viewportSearch);
+  SetRankPivot(params, viewport, viewportSearch, query);
 
-  m_query->SetSearchInWorld(params.HasSearchMode(SearchParams::SEARCH_WORLD));
+  query.SetSearchInWorld(params.HasSearchMode(SearchParams::SEARCH_WORLD));
 
   // Language validity is checked inside
-  m_query->SetInputLocale(params.m_inputLocale);
+  query.SetInputLocale(params.m_inputLocale);
 
   ASSERT(!params.m_query.empty(), ());
-  m_query->SetQuery(params.m_query);
+  query.SetQuery(params.m_query);
 
   Results res;
 
-  // Call m_query->IsCancelled() everywhere it needed without storing
+  // Call query.IsCancelled() everywhere it needed without storing
   // return value.  This flag can be changed from another thread.
 
-  m_query->SearchCoordinates(params.m_query, res);
+  query.SearchCoordinates(params.m_query, res);
 
   try
   {
@@ -233,21 +346,21 @@ void Engine::SearchAsync()
 
     if (viewportSearch)
     {
-      m_query->SetViewport(viewport, true);
-      m_query->SearchViewportPoints(res);
+      query.SetViewport(viewport, true);
+      query.SearchViewportPoints(res);
 
       if (res.GetCount() > 0)
         EmitResults(params, res);
     }
     else
     {
-      while (!m_query->IsCancelled())
+      while (!query.IsCancelled())
       {
         bool const isInflated = GetInflatedViewport(viewport);
         size_t const oldCount = res.GetCount();
 
-        m_query->SetViewport(viewport, oneTimeSearch);
-        m_query->Search(res, RESULTS_COUNT);
+        query.SetViewport(viewport, oneTimeSearch);
+        query.Search(res, RESULTS_COUNT);
 
         size_t const newCount = res.GetCount();
         bool const exit = (oneTimeSearch || !isInflated || newCount >= RESULTS_COUNT);
@@ -266,11 +379,11 @@ void Engine::SearchAsync()
 
   // Make additional search in whole mwm when not enough results (only for non-empty query).
   size_t const count = res.GetCount();
-  if (!viewportSearch && !m_query->IsCancelled() && count < RESULTS_COUNT)
+  if (!viewportSearch && !query.IsCancelled() && count < RESULTS_COUNT)
   {
     try
     {
-      m_query->SearchAdditional(res, RESULTS_COUNT);
+      query.SearchAdditional(res, RESULTS_COUNT);
     }
     catch (Query::CancelException const &)
     {
@@ -282,7 +395,7 @@ void Engine::SearchAsync()
   }
 
   // Emit finish marker to client.
-  params.m_callback(Results::GetEndMarker(m_query->IsCancelled()));
+  params.m_callback(Results::GetEndMarker(query.IsCancelled()));
 }
 
 bool Engine::GetNameByType(uint32_t type, int8_t locale, string & name) const
@@ -309,6 +422,7 @@ void Engine::ClearViewportsCache()
   threads::MutexGuard guard(m_searchMutex);
 
   m_query->ClearCaches();
+  ++m_cachesGeneration;
 }
 
 void Engine::ClearAllCaches()
@@ -323,6 +437,112 @@ void Engine::ClearAllCaches()
 
     m_searchMutex.Unlock();
   }
+  ++m_cachesGeneration;
+}
+
+shared_ptr<Engine::QueryHandle> Engine::Submit(SearchParams const & params,
+                                               m2::RectD const & viewport)
+{
+  CHECK(!m_concurrentQueries.empty(), ("Engine was created without concurrent queries."));
+  ASSERT(!params.m_query.empty(), ());
+
+  auto handle = make_shared<QueryHandle>();
+  {
+    lock_guard<mutex> lock(m_requestsMutex);
+    m_requests.push_back({params, viewport, handle});
+    ++m_stats.m_submitted;
+  }
+  m_requestsCv.notify_one();
+  return handle;
+}
+
+Engine::Stats Engine::GetStats() const
+{
+  lock_guard<mutex> lock(m_requestsMutex);
+  Stats stats = m_stats;
+  stats.m_pending = m_requests.size();
+  stats.m_uptimeSec = m_uptime.ElapsedSeconds();
+  return stats;
+}
+
+void Engine::ConcurrentWorker(size_t i)
+{
+  Query & query = *m_concurrentQueries[i];
+  uint32_t cachesGeneration = m_cachesGeneration;
+
+  while (true)
+  {
+    Request request;
+    {
+      unique_lock<mutex> lock(m_requestsMutex);
+      m_requestsCv.wait(lock, [this]() { return m_shutdown || !m_requests.empty(); });
+      if (m_shutdown)
+        break;
+      request = move(m_requests.front());
+      m_requests.pop_front();
+    }
+
+    if (cachesGeneration != m_cachesGeneration)
+    {
+      cachesGeneration = m_cachesGeneration;
+      query.ClearCaches();
+    }
+
+    SearchParams const & params = request.m_params;
+    m2::RectD viewport = request.m_viewport;
+    bool const oneTimeSearch = params.GetSearchRect(viewport);
+
+    my::Timer timer;
+    try
+    {
+      DoSearch(params, viewport, oneTimeSearch, query, request.m_handle.get());
+    }
+    catch (RootException const & ex)
+    {
+      LOG(LERROR, ("Search failed:", params.m_query, ex.Msg()));
+      params.m_callback(Results::GetEndMarker(true /* isCancelled */));
+    }
+    double const latency = timer.ElapsedSeconds();
+    bool const cancelled = query.IsCancelled();
+
+    // Stats are updated before the handle is finished, so a client who waits
+    // for the handle sees the query in stats.
+    {
+      lock_guard<mutex> lock(m_requestsMutex);
+      if (cancelled)
+      {
+        ++m_stats.m_cancelled;
+      }
+      else
+      {
+        ++m_stats.m_completed;
+        m_stats.m_totalLatencySec += latency;
+        m_stats.m_maxLatencySec = max(m_stats.m_maxLatencySec, latency);
+      }
+    }
+    request.m_handle->Finish();
+  }
+
+  // Notify clients of the requests that were not processed.
+  lock_guard<mutex> lock(m_requestsMutex);
+  for (auto & request : m_requests)
+  {
+    request.m_params.m_callback(Results::GetEndMarker(true /* isCancelled */));
+    request.m_handle->Finish();
+    ++m_stats.m_cancelled;
+  }
+  m_requests.clear();
+}
+
+string DebugPrint(Engine::Stats const & stats)
+{
+  ostringstream os;
+  os << "Engine::Stats [ submitted: " << stats.m_submitted << ", completed: " << stats.m_completed
+     << ", cancelled: " << stats.m_cancelled << ", pending: " << stats.m_pending
+     << ", throughput: " << stats.GetThroughput() << " q/s"
+     << ", avg latency: " << stats.GetAverageLatency() << " s"
+     << ", max latency: " << stats.m_maxLatencySec << " s ]";
+  return os.str();
 }
 
 }  // namespace search
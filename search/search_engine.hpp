@@ -9,11 +9,18 @@
 #include "coding/reader.hpp"
 
 #include "base/mutex.hpp"
+#include "base/timer.hpp"
+#include "base/thread.hpp"
 
 #include "std/unique_ptr.hpp"
 #include "std/string.hpp"
 #include "std/function.hpp"
 #include "std/atomic.hpp"
+#include "std/condition_variable.hpp"
+#include "std/deque.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
 
 
 class Index;
@@ -23,6 +30,11 @@ namespace storage
 class CountryInfoGetter;
 }
 
+namespace threads
+{
+class ForkJoinPool;
+}
+
 namespace search
 {
 class EngineData;
@@ -33,9 +45,60 @@ class Engine
   typedef function<void (Results const &)> SearchCallbackT;
 
 public:
+  /// Handle of a query started by Engine::Submit(). All methods are thread-safe.
+  class QueryHandle
+  {
+  public:
+    QueryHandle();
+
+    /// Cancels the query. Query's callback still receives the end marker.
+    void Cancel();
+
+    bool IsFinished() const;
+
+    /// Blocks until the query is finished.
+    void Wait() const;
+
+  private:
+    friend class Engine;
+
+    /// Binds the handle with initialized |query|, so Cancel() reaches it.
+    void Attach(Query & query);
+    void Finish();
+
+    mutable mutex m_mutex;
+    mutable condition_variable m_cv;
+    Query * m_query;
+    bool m_cancelled;
+    bool m_finished;
+  };
+
+  /// Counters of the concurrent mode (see Submit()).
+  struct Stats
+  {
+    Stats();
+
+    /// @return Number of completed queries per second of the engine's uptime.
+    double GetThroughput() const;
+    double GetAverageLatency() const;
+
+    uint64_t m_submitted;
+    uint64_t m_completed;
+    uint64_t m_cancelled;
+    size_t m_pending;
+    double m_totalLatencySec;
+    double m_maxLatencySec;
+    double m_uptimeSec;
+  };
+
   // Doesn't take ownership of index. Takes ownership of pCategories
+  // When |numConcurrentQueries| is not zero, the engine creates a pool of
+  // Query instances (with their own viewport caches) to serve Submit() calls.
+  // When |numSearchThreads| is greater than one, every query matches features
+  // of different mwms in parallel on a pool of this size shared by all queries.
   Engine(Index & index, Reader * categoriesR, storage::CountryInfoGetter const & infoGetter,
-         string const & locale, unique_ptr<SearchQueryFactory> && factory);
+         string const & locale, unique_ptr<SearchQueryFactory> && factory,
+         size_t numConcurrentQueries = 0, size_t numSearchThreads = 0);
   ~Engine();
 
   void SupportOldFormat(bool b);
@@ -50,14 +113,37 @@ public:
   void ClearViewportsCache();
   void ClearAllCaches();
 
+  /// Starts the query independently of all other queries, Search() calls included.
+  /// Can be called from any thread, works only in the concurrent mode.
+  /// Results are passed to params.m_callback from one of the engine's threads.
+  /// @param[in] viewport Viewport to search in (when params has no search rect).
+  shared_ptr<QueryHandle> Submit(SearchParams const & params, m2::RectD const & viewport);
+
+  Stats GetStats() const;
+
 private:
   static const int RESULTS_COUNT = 30;
 
+  struct Request
+  {
+    SearchParams m_params;
+    m2::RectD m_viewport;
+    shared_ptr<QueryHandle> m_handle;
+  };
+
   void SetRankPivot(SearchParams const & params,
-                    m2::RectD const & viewport, bool viewportSearch);
+                    m2::RectD const & viewport, bool viewportSearch, Query & query);
   void SetViewportAsync(m2::RectD const & viewport);
   void SearchAsync();
 
+  /// Runs the whole search process for |params| on |query|.
+  /// @param[in] handle Optional handle to bind with the query after initialization.
+  void DoSearch(SearchParams const & params, m2::RectD viewport, bool oneTimeSearch,
+                Query & query, QueryHandle * handle);
+
+  /// Main loop of the concurrent mode worker owning m_concurrentQueries[i].
+  void ConcurrentWorker(size_t i);
+
   void EmitResults(SearchParams const & params, Results & res);
 
   threads::Mutex m_searchMutex;
@@ -67,9 +153,30 @@ private:
   SearchParams m_params;
   m2::RectD m_viewport;
 
+  // Declared before queries, because they keep the pointer.
+  unique_ptr<threads::ForkJoinPool> m_workers;
+
   unique_ptr<Query> m_query;
   unique_ptr<SearchQueryFactory> m_factory;
   unique_ptr<EngineData> const m_data;
+
+  /// @name Concurrent mode.
+  //@{
+  vector<unique_ptr<Query>> m_concurrentQueries;
+  vector<threads::SimpleThread> m_concurrentThreads;
+
+  mutable mutex m_requestsMutex;
+  condition_variable m_requestsCv;
+  deque<Request> m_requests;
+  bool m_shutdown;
+
+  /// Incremented to ask workers to clear caches of their queries.
+  atomic<uint32_t> m_cachesGeneration;
+
+  Stats m_stats;
+  my::Timer m_uptime;
+  //@}
 };
 
+string DebugPrint(Engine::Stats const & stats);
 }  // namespace search
@@ -5,6 +5,8 @@
 #include "search/search_integration_tests/test_search_engine.hpp"
 #include "search/search_integration_tests/test_search_request.hpp"
 
+#include "search/params.hpp"
+
 #include "indexer/classificator_loader.hpp"
 #include "indexer/scales.hpp"
 
@@ -36,6 +38,39 @@ public:
 private:
   platform::LocalCountryFile m_file;
 };
+
+// Collects results of a query submitted via TestSearchEngine::Submit().
+class ResultsCollector
+{
+public:
+  ResultsCollector() : m_endMarkers(0) {}
+
+  void operator()(search::Results const & results)
+  {
+    lock_guard<mutex> lock(m_mu);
+    if (results.IsEndMarker())
+      ++m_endMarkers;
+    else
+      m_results.assign(results.Begin(), results.End());
+  }
+
+  size_t GetCount() const
+  {
+    lock_guard<mutex> lock(m_mu);
+    return m_results.size();
+  }
+
+  size_t GetEndMarkers() const
+  {
+    lock_guard<mutex> lock(m_mu);
+    return m_endMarkers;
+  }
+
+private:
+  mutable mutex m_mu;
+  vector<search::Result> m_results;
+  size_t m_endMarkers;
+};
 }  // namespace
 
 void TestFeaturesCount(TestSearchEngine const & engine, m2::RectD const & rect,
@@ -131,3 +166,177 @@ UNIT_TEST(GenerateTestMwm_NotPrefixFreeNames)
     TEST_EQUAL(3, request.Results().size(), ());
   }
 }
+
+UNIT_TEST(GenerateTestMwm_FlatSearchTrie)
+{
+  classificator::Load();
+  ScopedMapFile scopedFile("FlatTown");
+  platform::LocalCountryFile & file = scopedFile.GetFile();
+
+  {
+    TestMwmBuilder builder(file);
+    builder.AddPOI(m2::PointD(0, 0), "Wine shop", "en");
+    builder.AddPOI(m2::PointD(1, 0), "Tequila shop", "en");
+    builder.AddPOI(m2::PointD(0, 1), "Brandy shop", "en");
+    builder.AddPOI(m2::PointD(1, 1), "Russian vodka shop", "en");
+  }
+
+  TestSearchEngine engine("en" /* locale */);
+  engine.SetFlatSearchTrie(true);
+  auto ret = engine.RegisterMap(file);
+  TEST_EQUAL(MwmSet::RegResult::Success, ret.second, ("Can't register generated map."));
+
+  char const * queries[] = {"wine ", "shop ", "vodka ", "brandy "};
+  size_t const expected[] = {1, 4, 1, 1};
+  for (size_t i = 0; i < ARRAY_SIZE(queries); ++i)
+  {
+    TestSearchRequest request(engine, queries[i], "en",
+                              m2::RectD(m2::PointD(0, 0), m2::PointD(100, 100)));
+    request.Wait();
+    TEST_EQUAL(expected[i], request.Results().size(), (queries[i]));
+  }
+}
+
+UNIT_TEST(GenerateTestMwm_ParallelMwms)
+{
+  classificator::Load();
+  ScopedMapFile mskFile("Moscow");
+  ScopedMapFile mtvFile("MTV");
+  ScopedMapFile zrhFile("Zurich");
+
+  {
+    TestMwmBuilder builder(mskFile.GetFile());
+    builder.AddPOI(m2::PointD(0, 0), "Cafe MTV", "en");
+    builder.AddPOI(m2::PointD(1, 0), "Wine shop", "en");
+  }
+  {
+    TestMwmBuilder builder(mtvFile.GetFile());
+    builder.AddPOI(m2::PointD(10, 0), "MTV", "en");
+    builder.AddPOI(m2::PointD(11, 0), "MTV shop", "en");
+  }
+  {
+    TestMwmBuilder builder(zrhFile.GetFile());
+    builder.AddPOI(m2::PointD(0, 10), "Bar MTV", "en");
+    builder.AddPOI(m2::PointD(0, 11), "Cafe", "en");
+  }
+
+  // Results of mwms matched on the workers are the same as of the sequential search.
+  TestSearchEngine sequential("en" /* locale */);
+  TestSearchEngine parallel("en" /* locale */, 0 /* numConcurrentQueries */,
+                            3 /* numSearchThreads */);
+  for (TestSearchEngine * engine : {&sequential, &parallel})
+  {
+    for (ScopedMapFile * file : {&mskFile, &mtvFile, &zrhFile})
+    {
+      auto ret = engine->RegisterMap(file->GetFile());
+      TEST_EQUAL(MwmSet::RegResult::Success, ret.second, ("Can't register generated map."));
+    }
+  }
+
+  char const * queries[] = {"mtv ", "cafe ", "shop ", "mtv shop "};
+  size_t const expected[] = {4, 2, 2, 1};
+  for (size_t i = 0; i < ARRAY_SIZE(queries); ++i)
+  {
+    m2::RectD const viewport(m2::PointD(-1, -1), m2::PointD(100, 100));
+    TestSearchRequest sequentialRequest(sequential, queries[i], "en", viewport);
+    sequentialRequest.Wait();
+    TestSearchRequest parallelRequest(parallel, queries[i], "en", viewport);
+    parallelRequest.Wait();
+
+    vector<search::Result> const & sequentialResults = sequentialRequest.Results();
+    vector<search::Result> const & parallelResults = parallelRequest.Results();
+    TEST_EQUAL(expected[i], sequentialResults.size(), (queries[i]));
+    TEST_EQUAL(expected[i], parallelResults.size(), (queries[i]));
+    for (size_t j = 0; j < min(sequentialResults.size(), parallelResults.size()); ++j)
+    {
+      TEST_EQUAL(string(sequentialResults[j].GetString()), string(parallelResults[j].GetString()),
+                 (queries[i], j));
+    }
+  }
+}
+
+UNIT_TEST(GenerateTestMwm_IncrementalQueries)
+{
+  classificator::Load();
+  ScopedMapFile scopedFile("TypeTown");
+  platform::LocalCountryFile & file = scopedFile.GetFile();
+
+  {
+    TestMwmBuilder builder(file);
+    builder.AddPOI(m2::PointD(0, 0), "Wine shop", "en");
+    builder.AddPOI(m2::PointD(1, 0), "Tequila shop", "en");
+    builder.AddPOI(m2::PointD(0, 1), "Brandy shop", "en");
+    builder.AddPOI(m2::PointD(1, 1), "Russian vodka shop", "en");
+  }
+
+  TestSearchEngine engine("en" /* locale */);
+  auto ret = engine.RegisterMap(file);
+  TEST_EQUAL(MwmSet::RegResult::Success, ret.second, ("Can't register generated map."));
+
+  // Every query extends or drops the tokens of the previous one.
+  char const * queries[] = {"shop ", "shop wine ", "russian ", "russian vodka ",
+                            "russian vodka shop ", "shop "};
+  size_t const expected[] = {4, 1, 1, 1, 1, 4};
+  bool const extendsPrevious[] = {false, true, false, true, true, false};
+  for (size_t i = 0; i < ARRAY_SIZE(queries); ++i)
+  {
+    size_t const hits = engine.GetTrieStateHits();
+    TestSearchRequest request(engine, queries[i], "en",
+                              m2::RectD(m2::PointD(0, 0), m2::PointD(100, 100)));
+    request.Wait();
+    TEST_EQUAL(expected[i], request.Results().size(), (queries[i]));
+
+    // Matching of the previous tokens is reused only when they are extended.
+    TEST_EQUAL(extendsPrevious[i], engine.GetTrieStateHits() > hits, (queries[i]));
+  }
+}
+
+UNIT_TEST(GenerateTestMwm_ConcurrentQueries)
+{
+  classificator::Load();
+  ScopedMapFile scopedFile("BuzzCity");
+  platform::LocalCountryFile & file = scopedFile.GetFile();
+
+  {
+    TestMwmBuilder builder(file);
+    builder.AddPOI(m2::PointD(0, 0), "Wine shop", "en");
+    builder.AddPOI(m2::PointD(1, 0), "Tequila shop", "en");
+    builder.AddPOI(m2::PointD(0, 1), "Brandy shop", "en");
+    builder.AddPOI(m2::PointD(1, 1), "Russian vodka shop", "en");
+  }
+
+  TestSearchEngine engine("en" /* locale */, 3 /* numConcurrentQueries */);
+  auto ret = engine.RegisterMap(file);
+  TEST_EQUAL(MwmSet::RegResult::Success, ret.second, ("Can't register generated map."));
+
+  char const * queries[] = {"wine ", "shop ", "vodka ", "brandy ", "shop "};
+  size_t const expected[] = {1, 4, 1, 1, 4};
+
+  vector<ResultsCollector> collectors(ARRAY_SIZE(queries));
+  vector<shared_ptr<search::Engine::QueryHandle>> handles;
+  for (size_t i = 0; i < ARRAY_SIZE(queries); ++i)
+  {
+    search::SearchParams params;
+    params.m_query = queries[i];
+    params.m_inputLocale = "en";
+    params.m_callback = [&collectors, i](search::Results const & results)
+    {
+      collectors[i](results);
+    };
+    params.SetSearchMode(search::SearchParams::IN_VIEWPORT_ONLY);
+    handles.push_back(engine.Submit(params, m2::RectD(m2::PointD(0, 0), m2::PointD(100, 100))));
+  }
+
+  for (size_t i = 0; i < handles.size(); ++i)
+  {
+    handles[i]->Wait();
+    TEST(handles[i]->IsFinished(), ());
+    TEST_EQUAL(1, collectors[i].GetEndMarkers(), (queries[i]));
+    TEST_EQUAL(expected[i], collectors[i].GetCount(), (queries[i]));
+  }
+
+  search::Engine::Stats const stats = engine.GetStats();
+  TEST_EQUAL(stats.m_submitted, ARRAY_SIZE(queries), (stats));
+  TEST_EQUAL(stats.m_completed + stats.m_cancelled, ARRAY_SIZE(queries), (stats));
+  TEST_EQUAL(stats.m_pending, 0, (stats));
+}
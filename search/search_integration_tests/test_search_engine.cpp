@@ -30,21 +30,31 @@ public:
 
 class TestSearchQueryFactory : public search::SearchQueryFactory
 {
+public:
+  explicit TestSearchQueryFactory(vector<search::Query const *> & queries) : m_queries(queries) {}
+
+private:
   // search::SearchQueryFactory overrides:
   unique_ptr<search::Query> BuildSearchQuery(Index & index, CategoriesHolder const & categories,
                                              vector<search::Suggest> const & suggests,
                                              storage::CountryInfoGetter const & infoGetter) override
   {
-    return make_unique<TestQuery>(index, categories, suggests, infoGetter);
+    auto query = make_unique<TestQuery>(index, categories, suggests, infoGetter);
+    m_queries.push_back(query.get());
+    return move(query);
   }
+
+  vector<search::Query const *> & m_queries;
 };
 }  // namespace
 
-TestSearchEngine::TestSearchEngine(string const & locale)
+TestSearchEngine::TestSearchEngine(string const & locale, size_t numConcurrentQueries,
+                                   size_t numSearchThreads)
   : m_platform(GetPlatform())
   , m_infoGetter(m_platform.GetReader(PACKED_POLYGONS_FILE), m_platform.GetReader(COUNTRIES_FILE))
   , m_engine(*this, m_platform.GetReader(SEARCH_CATEGORIES_FILE_NAME), m_infoGetter, locale,
-             make_unique<TestSearchQueryFactory>())
+             make_unique<TestSearchQueryFactory>(m_queries), numConcurrentQueries,
+             numSearchThreads)
 {
 }
 
@@ -52,3 +62,19 @@ bool TestSearchEngine::Search(search::SearchParams const & params, m2::RectD con
 {
   return m_engine.Search(params, viewport);
 }
+
+shared_ptr<search::Engine::QueryHandle> TestSearchEngine::Submit(
+    search::SearchParams const & params, m2::RectD const & viewport)
+{
+  return m_engine.Submit(params, viewport);
+}
+
+search::Engine::Stats TestSearchEngine::GetStats() const { return m_engine.GetStats(); }
+
+size_t TestSearchEngine::GetTrieStateHits() const
+{
+  size_t hits = 0;
+  for (search::Query const * query : m_queries)
+    hits += query->GetTrieStateHits();
+  return hits;
+}
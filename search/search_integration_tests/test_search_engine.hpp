@@ -9,23 +9,37 @@
 #include "storage/country_info_getter.hpp"
 
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class Platform;
 
 namespace search
 {
+class Query;
 class SearchParams;
 }
 
 class TestSearchEngine : public Index
 {
 public:
-  TestSearchEngine(std::string const & locale);
+  TestSearchEngine(std::string const & locale, size_t numConcurrentQueries = 0,
+                   size_t numSearchThreads = 0);
 
   bool Search(search::SearchParams const & params, m2::RectD const & viewport);
 
+  shared_ptr<search::Engine::QueryHandle> Submit(search::SearchParams const & params,
+                                                 m2::RectD const & viewport);
+
+  search::Engine::Stats GetStats() const;
+
+  /// @return Sum of search::Query::GetTrieStateHits() of the engine's queries.
+  /// Should be called when there are no running queries.
+  size_t GetTrieStateHits() const;
+
 private:
   Platform & m_platform;
   storage::CountryInfoGetter m_infoGetter;
+  // Queries are owned by m_engine.
+  vector<search::Query const *> m_queries;
   search::Engine m_engine;
 };
@@ -25,6 +25,7 @@
 #include "coding/multilang_utf8_string.hpp"
 #include "coding/reader_wrapper.hpp"
 
+#include "base/fork_join_pool.hpp"
 #include "base/logging.hpp"
 #include "base/stl_add.hpp"
 #include "base/string_utils.hpp"
@@ -81,6 +82,8 @@ Query::Query(Index & index, CategoriesHolder const & categories, vector<Suggest>
   , m_locality(&index)
 #endif
   , m_worldSearch(true)
+  , m_workers(nullptr)
+  , m_trieStateHits(0)
 {
   // m_viewport is initialized as empty rects
 
@@ -162,6 +165,8 @@ void Query::SetViewportByIndex(TMWMVector const & mwmsInfo, m2::RectD const & vi
 
     m_viewport[idx] = viewport;
     UpdateViewportOffsets(mwmsInfo, viewport, m_offsetsInViewport[idx]);
+    // Matching states depend on the features in viewport.
+    m_trieStates[idx].clear();
 
 #ifdef FIND_LOCALITY_TEST
     m_locality.SetViewportByIndex(viewport, idx);
@@ -225,6 +230,7 @@ void Query::ClearCaches()
 {
   for (size_t i = 0; i < COUNT_V; ++i)
     ClearCache(i);
+  m_trieStates[COUNT_V].clear();
 
   m_houseDetector.ClearCaches();
 
@@ -236,6 +242,7 @@ void Query::ClearCache(size_t ind)
   // clear cache and free memory
   TOffsetsVector emptyV;
   emptyV.swap(m_offsetsInViewport[ind]);
+  m_trieStates[ind].clear();
 
   m_viewport[ind].MakeEmpty();
 }
@@ -1765,8 +1772,7 @@ void Query::SearchLocality(MwmValue const * pMwm, impl::Locality & res1, impl::R
   ModelReaderPtr searchReader = pMwm->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
 
   unique_ptr<trie::DefaultIterator> const trieRoot(
-      trie::ReadTrie(SubReaderWrapper<Reader>(searchReader.GetPtr()), trie::ValueReader(cp),
-                     trie::TEdgeValueReader()));
+      ReadSearchTrie(*pMwm, searchReader.GetPtr(), cp));
 
   ForEachLangPrefix(params, *trieRoot, [&](TrieRootPrefix & langRoot, int8_t lang)
   {
@@ -1846,43 +1852,113 @@ namespace
   };
 }
 
+template <class ToDo>
+bool Query::MatchFeaturesInMwm(Index::MwmHandle const & mwmHandle,
+                               SearchQueryParams const & params, MwmSearchData const & data,
+                               ToDo && toDo) const
+{
+  MwmValue const * const value = mwmHandle.GetValue<MwmValue>();
+  serial::CodingParams cp(trie::GetCodingParams(value->GetHeader().GetDefCodingParams()));
+  ModelReaderPtr searchReader = value->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
+  unique_ptr<trie::DefaultIterator> const trieRoot(
+      ReadSearchTrie(*value, searchReader.GetPtr(), cp));
+
+  FeaturesFilter filter(data.m_offsets, *this);
+  return MatchFeaturesInTrie(params, *trieRoot, filter, *data.m_state, forward<ToDo>(toDo));
+}
+
 void Query::SearchFeatures(SearchQueryParams const & params, TMWMVector const & mwmsInfo,
                            ViewportID vID)
 {
+  vector<Index::MwmHandle> handles;
   for (shared_ptr<MwmInfo> const & info : mwmsInfo)
   {
     // Search only mwms that intersect with viewport (world always does).
     if (m_viewport[vID].IsIntersect(info->m_limitRect))
-      SearchInMWM(m_index.GetMwmHandleById(info), params, vID);
+      handles.push_back(m_index.GetMwmHandleById(info));
+  }
+
+  if (!m_workers || handles.size() < 2)
+  {
+    for (Index::MwmHandle const & handle : handles)
+      SearchInMWM(handle, params, vID);
+    return;
+  }
+
+  // Features of mwms are matched on the workers and then added on the query's thread
+  // in the order of mwms, so results are the same as in the sequential mode.
+  vector<MwmSearchData> data(handles.size());
+  vector<uint8_t> isSearched(handles.size());
+  for (size_t i = 0; i < handles.size(); ++i)
+    isSearched[i] = GetMwmSearchData(handles[i], vID, data[i]);
+
+  vector<vector<TTrieValue>> values(handles.size());
+  vector<uint8_t> isStateReused(handles.size());
+  m_workers->ForEach(handles.size(), [&](size_t i)
+  {
+    if (!isSearched[i])
+      return;
+    isStateReused[i] = MatchFeaturesInMwm(handles[i], params, data[i],
+                                          [&values, i](TTrieValue const & value)
+                                          {
+                                            values[i].push_back(value);
+                                          });
+  });
+
+  for (size_t i = 0; i < handles.size(); ++i)
+  {
+    if (isStateReused[i])
+      ++m_trieStateHits;
+    MwmSet::MwmId const mwmId = handles[i].GetId();
+    for (TTrieValue const & value : values[i])
+      AddResultFromTrie(value, mwmId, vID);
   }
 }
 
 void Query::SearchInMWM(Index::MwmHandle const & mwmHandle, SearchQueryParams const & params,
                         ViewportID viewportId /*= DEFAULT_V*/)
+{
+  MwmSearchData data;
+  if (!GetMwmSearchData(mwmHandle, viewportId, data))
+    return;
+
+  MwmSet::MwmId const mwmId = mwmHandle.GetId();
+  bool const isStateReused =
+      MatchFeaturesInMwm(mwmHandle, params, data, [&](TTrieValue const & value)
+      {
+        AddResultFromTrie(value, mwmId, viewportId);
+      });
+  if (isStateReused)
+    ++m_trieStateHits;
+}
+
+bool Query::GetMwmSearchData(Index::MwmHandle const & mwmHandle, ViewportID viewportId,
+                             MwmSearchData & data)
 {
   MwmValue const * const value = mwmHandle.GetValue<MwmValue>();
   if (!value || !value->m_cont.IsExist(SEARCH_INDEX_FILE_TAG))
-    return;
+    return false;
 
-  TFHeader const & header = value->GetHeader();
   /// @todo do not process World.mwm here - do it in SearchLocality
-  bool const isWorld = (header.GetType() == TFHeader::world);
+  bool const isWorld = (value->GetHeader().GetType() == TFHeader::world);
   if (isWorld && !m_worldSearch)
-    return;
-
-  serial::CodingParams cp(trie::GetCodingParams(header.GetDefCodingParams()));
-  ModelReaderPtr searchReader = value->m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
-  unique_ptr<trie::DefaultIterator> const trieRoot(
-      trie::ReadTrie(SubReaderWrapper<Reader>(searchReader.GetPtr()), trie::ValueReader(cp),
-                     trie::TEdgeValueReader()));
+    return false;
 
   MwmSet::MwmId const mwmId = mwmHandle.GetId();
-  FeaturesFilter filter(viewportId == DEFAULT_V || isWorld ?
-                          0 : &m_offsetsInViewport[viewportId][mwmId], *this);
-  MatchFeaturesInTrie(params, *trieRoot, filter, [&](TTrieValue const & value)
-  {
-    AddResultFromTrie(value, mwmId, viewportId);
-  });
+  data.m_offsets = (viewportId == DEFAULT_V || isWorld ?
+                      0 : &m_offsetsInViewport[viewportId][mwmId]);
+  // States are kept separately for filters with and without viewport.
+  data.m_state = &GetTrieState(mwmId, isWorld ? DEFAULT_V : viewportId);
+  return true;
+}
+
+TrieMatchingState & Query::GetTrieState(MwmSet::MwmId const & mwmId, ViewportID vID)
+{
+  size_t const ind = (vID == DEFAULT_V ? static_cast<size_t>(COUNT_V) : static_cast<size_t>(vID));
+  auto & state = m_trieStates[ind][mwmId];
+  if (!state)
+    state = make_shared<TrieMatchingState>();
+  return *state;
 }
 
 void Query::SuggestStrings(Results & res)
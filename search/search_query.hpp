@@ -36,10 +36,12 @@ class FeatureType;
 class CategoriesHolder;
 
 namespace storage { class CountryInfoGetter; }
+namespace threads { class ForkJoinPool; }
 
 namespace search
 {
 struct SearchQueryParams;
+struct TrieMatchingState;
 
 namespace impl
 {
@@ -71,6 +73,10 @@ public:
 
   inline void SetSearchInWorld(bool b) { m_worldSearch = b; }
 
+  /// Sets the pool to match features of different mwms in parallel, nullptr to match
+  /// them on the query's thread. Doesn't take ownership of |workers|.
+  inline void SetWorkers(threads::ForkJoinPool * workers) { m_workers = workers; }
+
   /// Suggestions language code, not the same as we use in mwm data
   int8_t m_inputLocaleCode, m_currentLocaleCode;
 
@@ -94,6 +100,10 @@ public:
 
   void ClearCaches();
 
+  /// @return Number of mwm lookups which resumed features matching from the state
+  /// of the previous query (@see TrieMatchingState).
+  inline size_t GetTrieStateHits() const { return m_trieStateHits; }
+
   struct CancelException {};
 
   /// @name This stuff is public for implementation classes in search_query.cpp
@@ -168,6 +178,22 @@ private:
                    ViewportID viewportId = DEFAULT_V);
   //@}
 
+  /// Data of the query which SearchInMWM() uses for an mwm. It's prepared on the query's
+  /// thread, so features of different mwms can be matched in parallel.
+  struct MwmSearchData
+  {
+    vector<uint32_t> const * m_offsets = nullptr;
+    TrieMatchingState * m_state = nullptr;
+  };
+  /// @return false if the mwm should not be searched.
+  bool GetMwmSearchData(Index::MwmHandle const & mwmHandle, ViewportID viewportId,
+                        MwmSearchData & data);
+  /// Calls toDo for every feature of the mwm which matches params.
+  /// @return true if matching is resumed from the state of the previous query.
+  template <class ToDo>
+  bool MatchFeaturesInMwm(Index::MwmHandle const & mwmHandle, SearchQueryParams const & params,
+                          MwmSearchData const & data, ToDo && toDo) const;
+
   void SuggestStrings(Results & res);
   void MatchForSuggestionsImpl(strings::UniString const & token, int8_t locale, string const & prolog, Results & res);
 
@@ -200,6 +226,7 @@ private:
   m2::RectD m_viewport[COUNT_V];
   m2::PointD m_pivot;
   bool m_worldSearch;
+  threads::ForkJoinPool * m_workers;
 
   /// @name Get ranking params.
   //@{
@@ -217,6 +244,14 @@ private:
   TOffsetsVector m_offsetsInViewport[COUNT_V];
   bool m_supportOldFormat;
 
+  /// States of features matching of the last query in every mwm, for every viewport
+  /// and for the search without viewport (last element), so the next keystroke
+  /// matches only the changed tokens (@see TrieMatchingState).
+  using TTrieStates = map<MwmSet::MwmId, shared_ptr<TrieMatchingState>>;
+  TTrieStates m_trieStates[COUNT_V + 1];
+  TrieMatchingState & GetTrieState(MwmSet::MwmId const & mwmId, ViewportID vID);
+  size_t m_trieStateHits;
+
   template <class TParam>
   class TCompare
   {
@@ -0,0 +1,245 @@
+#include "testing/testing.hpp"
+
+#include "search/feature_offset_match.hpp"
+#include "search/levenshtein_automaton.hpp"
+
+#include "indexer/search_trie.hpp"
+#include "indexer/string_file_values.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/reader.hpp"
+#include "coding/trie_builder.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+using namespace search;
+using namespace strings;
+
+namespace
+{
+using TValue = trie::ValueReader::ValueType;
+
+uint8_t const kLang = 1;
+
+struct KeyValue
+{
+  buffer_vector<trie::TrieChar, 16> m_key;
+  SerializedFeatureInfoValue m_value;
+
+  uint32_t GetKeySize() const { return m_key.size(); }
+  trie::TrieChar const * GetKeyData() const { return m_key.data(); }
+  SerializedFeatureInfoValue const & GetValue() const { return m_value; }
+
+  void const * value_data() const { return m_value.data(); }
+  size_t value_size() const { return m_value.size(); }
+
+  bool operator==(KeyValue const & kv) const
+  {
+    return m_key == kv.m_key && m_value == kv.m_value;
+  }
+
+  bool operator<(KeyValue const & kv) const
+  {
+    return m_key != kv.m_key ? m_key < kv.m_key : m_value < kv.m_value;
+  }
+
+  void Swap(KeyValue & kv)
+  {
+    m_key.swap(kv.m_key);
+    m_value.swap(kv.m_value);
+  }
+};
+
+// Serialized search index trie of the words: the value of the i-th word has the feature id i.
+class TestTrie
+{
+public:
+  explicit TestTrie(vector<string> const & words)
+    : m_cp(kPointCodingBits, m2::PointD(0, 0))
+  {
+    trie::ValueReader const saver(m_cp);
+    vector<KeyValue> keyValues(words.size());
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+      UniString const s = MakeUniString(words[i]);
+      keyValues[i].m_key.push_back(kLang);
+      keyValues[i].m_key.append(s.begin(), s.end());
+
+      TValue v;
+      v.m_pt = m2::PointD(0, 0);
+      v.m_featureId = static_cast<uint32_t>(i);
+      v.m_rank = 0;
+      PushBackByteSink<SerializedFeatureInfoValue::ValueT> sink(keyValues[i].m_value.m_value);
+      saver.Save(sink, v);
+    }
+    sort(keyValues.begin(), keyValues.end());
+
+    PushBackByteSink<vector<uint8_t>> sink(m_serial);
+    trie::Build<PushBackByteSink<vector<uint8_t>>, vector<KeyValue>::iterator,
+                trie::EmptyEdgeBuilder, ValueList<SerializedFeatureInfoValue>>(
+        sink, keyValues.begin(), keyValues.end(), trie::EmptyEdgeBuilder());
+    reverse(m_serial.begin(), m_serial.end());
+
+    MemReader reader(m_serial.data(), m_serial.size());
+    m_root.reset(trie::ReadTrie(reader, trie::ValueReader(m_cp), trie::TEdgeValueReader()));
+    TEST_EQUAL(m_root->m_edge.size(), 1, ());
+    m_langRoot.reset(m_root->GoToEdge(0));
+
+    m_flatTrie.reset(new trie::DefaultFlatTrie(*m_root));
+    m_flatRoot.reset(m_flatTrie->CreateRootIterator());
+    m_flatLangRoot.reset(m_flatRoot->GoToEdge(0));
+  }
+
+  /// @return Sorted ids of the features found by MatchTokenFuzzyInTrie().
+  vector<uint32_t> Match(string const & token, uint32_t maxErrors, bool prefix) const
+  {
+    return MatchFuzzy(*m_langRoot, token, maxErrors, prefix);
+  }
+
+  /// The same as Match() but on the in-memory copy of the trie.
+  vector<uint32_t> MatchFlat(string const & token, uint32_t maxErrors, bool prefix) const
+  {
+    return MatchFuzzy(*m_flatLangRoot, token, maxErrors, prefix);
+  }
+
+  /// @return Sorted ids of the features found by MatchTokenInTrie() or,
+  /// when prefix is set, by MatchTokenPrefixInTrie().
+  vector<uint32_t> MatchExact(string const & token, bool prefix, bool flat) const
+  {
+    TrieRootPrefix const rootPrefix(flat ? *m_flatLangRoot : *m_langRoot, GetLangEdge());
+    vector<uint32_t> ids;
+    auto const collect = [&ids](TValue const & v) { ids.push_back(v.m_featureId); };
+    if (prefix)
+      MatchTokenPrefixInTrie({MakeUniString(token)}, rootPrefix, collect);
+    else
+      MatchTokenInTrie({MakeUniString(token)}, rootPrefix, collect);
+    return SortUnique(ids);
+  }
+
+  trie::DefaultIterator::Edge::EdgeStrT const & GetLangEdge() const
+  {
+    return m_root->m_edge[0].m_str;
+  }
+
+private:
+  vector<uint32_t> MatchFuzzy(trie::DefaultIterator const & langRoot, string const & token,
+                              uint32_t maxErrors, bool prefix) const
+  {
+    TrieRootPrefix const rootPrefix(langRoot, GetLangEdge());
+    vector<uint32_t> ids;
+    MatchTokenFuzzyInTrie({MakeUniString(token)}, rootPrefix, maxErrors, prefix,
+                          [&ids](TValue const & v) { ids.push_back(v.m_featureId); });
+    return SortUnique(ids);
+  }
+
+  static vector<uint32_t> SortUnique(vector<uint32_t> & ids)
+  {
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+  }
+
+  serial::CodingParams m_cp;
+  vector<uint8_t> m_serial;
+  unique_ptr<trie::DefaultIterator> m_root;
+  unique_ptr<trie::DefaultIterator> m_langRoot;
+  unique_ptr<trie::DefaultFlatTrie> m_flatTrie;
+  unique_ptr<trie::DefaultIterator> m_flatRoot;
+  unique_ptr<trie::DefaultIterator> m_flatLangRoot;
+};
+
+// Ids of the words which match the pattern, found without the trie.
+vector<uint32_t> MatchWords(vector<string> const & words, string const & token,
+                            uint32_t maxErrors, bool prefix)
+{
+  LevenshteinAutomaton const automaton(MakeUniString(token), maxErrors);
+  vector<uint32_t> ids;
+  for (size_t i = 0; i < words.size(); ++i)
+  {
+    UniString const s = MakeUniString(words[i]);
+    if (prefix ? automaton.MatchesPrefix(s) : automaton.Matches(s))
+      ids.push_back(static_cast<uint32_t>(i));
+  }
+  return ids;
+}
+}  // namespace
+
+UNIT_TEST(FuzzyTrieMatch_Smoke)
+{
+  vector<string> const words = {"moscow", "moskva", "mosque", "london", "londres",
+                                "lomond", "cafe",   "caffe",  "coffee", "cafeteria"};
+  TestTrie const trie(words);
+  TEST_EQUAL(trie.GetLangEdge().size(), 1, ());
+
+  TEST_EQUAL(trie.Match("moscow", 0, false), vector<uint32_t>({0}), ());
+  TEST_EQUAL(trie.Match("moskow", 1, false), vector<uint32_t>({0}), ());
+  TEST_EQUAL(trie.Match("londn", 1, false), vector<uint32_t>({3}), ());
+  TEST_EQUAL(trie.Match("cafe", 1, false), vector<uint32_t>({6, 7}), ());
+  TEST_EQUAL(trie.Match("cafe", 0, true), vector<uint32_t>({6, 9}), ());
+  TEST_EQUAL(trie.Match("mosk", 1, true), vector<uint32_t>({0, 1, 2}), ());
+  TEST(trie.Match("paris", 2, false).empty(), ());
+
+  vector<string> const tokens = {"moscow", "mosk", "lond", "cafe", "cofe", "x", "caffeteria"};
+  for (string const & token : tokens)
+  {
+    for (uint32_t maxErrors = 0; maxErrors <= 2; ++maxErrors)
+    {
+      for (bool prefix : {false, true})
+      {
+        auto const expected = MatchWords(words, token, maxErrors, prefix);
+        TEST_EQUAL(trie.Match(token, maxErrors, prefix), expected, (token, maxErrors, prefix));
+        TEST_EQUAL(trie.MatchFlat(token, maxErrors, prefix), expected, (token, maxErrors, prefix));
+      }
+    }
+  }
+}
+
+UNIT_TEST(FuzzyTrieMatch_RootPrefix)
+{
+  // All the words share "abc", so it goes to the edge of the language and
+  // MatchTokenFuzzyInTrie() feeds it to the automaton as the root prefix.
+  vector<string> const words = {"abcd", "abcx", "abcxyz"};
+  TestTrie const trie(words);
+  TEST_EQUAL(trie.GetLangEdge().size(), 4, ());
+
+  // The prefix match is found in the middle of the root prefix.
+  TEST_EQUAL(trie.Match("ab", 0, true), vector<uint32_t>({0, 1, 2}), ());
+  TEST_EQUAL(trie.MatchFlat("ab", 0, true), vector<uint32_t>({0, 1, 2}), ());
+  TEST(trie.Match("ab", 0, false).empty(), ());
+  TEST_EQUAL(trie.Match("ab", 2, false), vector<uint32_t>({0, 1}), ());
+
+  TEST_EQUAL(trie.Match("abx", 1, false), vector<uint32_t>({1}), ());
+  TEST_EQUAL(trie.Match("abcxy", 0, true), vector<uint32_t>({2}), ());
+  TEST(trie.Match("b", 0, true).empty(), ());
+  TEST_EQUAL(trie.Match("b", 1, true), vector<uint32_t>({0, 1, 2}), ());
+}
+
+UNIT_TEST(FuzzyTrieMatch_ExactOnFlatTrie)
+{
+  // "moscow" and "mosque" share the edge "mos", so some tokens end in the middle of edges.
+  vector<string> const words = {"moscow", "mosque", "moscowriver", "lomond", "london"};
+  TestTrie const trie(words);
+
+  TEST_EQUAL(trie.MatchExact("moscow", false, true), vector<uint32_t>({0}), ());
+  TEST(trie.MatchExact("mos", false, true).empty(), ());
+  TEST(trie.MatchExact("mosc", false, true).empty(), ());
+  TEST_EQUAL(trie.MatchExact("mosc", true, true), vector<uint32_t>({0, 2}), ());
+  TEST_EQUAL(trie.MatchExact("lo", true, true), vector<uint32_t>({3, 4}), ());
+
+  vector<string> const tokens = {"m", "mo", "mos", "mosc", "moscow", "moscowr", "moscowriver",
+                                 "moscowrivers", "mosque", "l", "lon", "london", "x"};
+  for (string const & token : tokens)
+  {
+    for (bool prefix : {false, true})
+    {
+      auto const expected = MatchWords(words, token, 0 /* maxErrors */, prefix);
+      TEST_EQUAL(trie.MatchExact(token, prefix, false), expected, (token, prefix));
+      TEST_EQUAL(trie.MatchExact(token, prefix, true), expected, (token, prefix));
+    }
+  }
+}
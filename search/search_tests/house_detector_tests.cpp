@@ -7,6 +7,7 @@
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/index.hpp"
 #include "indexer/scales.hpp"
+#include "indexer/street_houses_index.hpp"
 
 #include "platform/platform.hpp"
 
@@ -15,7 +16,14 @@
 
 #include "geometry/distance_on_sphere.hpp"
 
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
 #include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+
+#include "defines.hpp"
 
 #include "std/iostream.hpp"
 #include "std/fstream.hpp"
@@ -253,11 +261,10 @@ UNIT_TEST(HS_StreetsMerge)
 namespace
 {
 
-m2::PointD FindHouse(Index & index, vector<string> const & streets,
-                     string const & houseName, double offset)
+vector<search::HouseResult> FindHouses(search::HouseDetector & houser, Index & index,
+                                       vector<string> const & streets,
+                                       string const & houseName, double offset)
 {
-  search::HouseDetector houser(&index);
-
   StreetIDsByName toDo;
   toDo.streetNames = streets;
   index.ForEachInScale(toDo, scales::GetUpperScale());
@@ -269,6 +276,14 @@ m2::PointD FindHouse(Index & index, vector<string> const & streets,
 
   vector<search::HouseResult> houses;
   houser.GetHouseForName(houseName, houses);
+  return houses;
+}
+
+m2::PointD FindHouse(Index & index, vector<string> const & streets,
+                     string const & houseName, double offset)
+{
+  search::HouseDetector houser(&index);
+  vector<search::HouseResult> const houses = FindHouses(houser, index, streets, houseName, offset);
 
   TEST_EQUAL(houses.size(), 1, (houses));
   return houses[0].m_house->GetPosition();
@@ -308,6 +323,67 @@ UNIT_TEST(HS_FindHouseSmoke)
 }
 
 
+UNIT_TEST(HS_FindHouseWithStreetHousesSection)
+{
+  classificator::Load();
+
+  string const & writableDir = GetPlatform().WritableDir();
+  string const indexedName = "minsk-pass-strhouses";
+  string const indexedPath = my::JoinFoldersToPath(writableDir, indexedName + DATA_FILE_EXTENSION);
+  TEST(my::CopyFileX(my::JoinFoldersToPath(writableDir, "minsk-pass" DATA_FILE_EXTENSION),
+                     indexedPath), ());
+  MY_SCOPE_GUARD(removeIndexedFile, bind(FileWriter::DeleteFileX, indexedPath));
+  TEST(indexer::BuildStreetHousesIndexFromDatFile(indexedPath), ());
+
+  LocalCountryFile const indexedFile = LocalCountryFile::MakeForTesting(indexedName);
+  MY_SCOPE_GUARD(removeIndexedIndexes,
+                 bind(&platform::CountryIndexes::DeleteFromDisk, cref(indexedFile)));
+
+  // Mwms are registered in different indexes, otherwise they overlap and
+  // HouseDetector reads houses by geometry for both of them.
+  Index original;
+  auto const originalRes = original.Register(LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(MwmSet::RegResult::Success, originalRes.second, ());
+  Index indexed;
+  auto const indexedRes = indexed.Register(indexedFile);
+  TEST_EQUAL(MwmSet::RegResult::Success, indexedRes.second, ());
+
+  {
+    MwmSet::MwmHandle const originalHandle = original.GetMwmHandleById(originalRes.first);
+    TEST(!originalHandle.GetValue<MwmValue>()->GetStreetHousesIndex(), ());
+    MwmSet::MwmHandle const indexedHandle = indexed.GetMwmHandleById(indexedRes.first);
+    TEST(indexedHandle.GetValue<MwmValue>()->GetStreetHousesIndex(), ());
+  }
+
+  vector<string> const streets = {"Московская улица", "проспект Независимости", "улица Ленина"};
+  vector<string> const numbers = {"1", "2", "5", "7", "10", "12", "21", "28", "30"};
+  for (string const & street : streets)
+  {
+    for (string const & number : numbers)
+    {
+      for (double offset : {40.0, 100.0, 200.0})
+      {
+        search::HouseDetector originalHouser(&original);
+        search::HouseDetector indexedHouser(&indexed);
+        vector<search::HouseResult> const expected =
+            FindHouses(originalHouser, original, {street}, number, offset);
+        vector<search::HouseResult> const actual =
+            FindHouses(indexedHouser, indexed, {street}, number, offset);
+
+        TEST_EQUAL(expected.size(), actual.size(), (street, number, offset, expected, actual));
+        for (size_t i = 0; i < min(expected.size(), actual.size()); ++i)
+        {
+          TEST_EQUAL(expected[i].m_house->GetNumber(), actual[i].m_house->GetNumber(),
+                     (street, number, offset));
+          // Points in the section are rounded with the coding params of the mwm.
+          TEST(expected[i].GetOrg().EqualDxDy(actual[i].GetOrg(), 1.0E-6),
+               (street, number, offset, expected[i].GetOrg(), actual[i].GetOrg()));
+        }
+      }
+    }
+  }
+}
+
 UNIT_TEST(HS_StreetsCompare)
 {
   search::Street A, B;
@@ -0,0 +1,213 @@
+#include "testing/testing.hpp"
+#include "testing/benchmark.hpp"
+
+#include "search/approximate_string_match.hpp"
+#include "search/levenshtein_automaton.hpp"
+
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+
+using namespace search;
+using namespace strings;
+
+namespace
+{
+
+// Plain Levenshtein model for StringMatchCost: composite operations cost as much
+// as the corresponding single-symbol ones, swap is not cheaper than two substitutions.
+class UnitMatchCost
+{
+public:
+  uint32_t Cost10(UniChar) const { return 1; }
+  uint32_t Cost01(UniChar) const { return 1; }
+  uint32_t Cost11(UniChar, UniChar) const { return 1; }
+  uint32_t Cost12(UniChar, UniChar const *) const { return 2; }
+  uint32_t Cost21(UniChar const *, UniChar) const { return 2; }
+  uint32_t Cost22(UniChar const *, UniChar const *) const { return 2; }
+  uint32_t SwapCost(UniChar, UniChar) const { return 2; }
+};
+
+char const * kCorpus[] = {
+  "hello", "world", "moscow", "london", "pizza", "restaurant", "cafe", "street", "avenue",
+  "boulevard", "square", "station", "museum", "theatre", "hospital", "pharmacy", "supermarket",
+  "kindergarten", "university", "library", "embassy", "cinema", "hotel", "hostel", "parking",
+  "fuel", "bakery", "butcher", "bicycle", "playground", "cathedral", "monument", "fountain",
+  "lenina", "tverskaya", "arbat", "sadovaya", "kutuzovsky", "prospekt", "nevsky", "vasilievsky",
+  "brandenburger", "alexanderplatz", "champs", "elysees", "trafalgar", "piccadilly", "broadway"
+};
+
+uint32_t AutomatonDistance(char const * pattern, char const * s, uint32_t maxErrors)
+{
+  LevenshteinAutomaton const automaton(MakeUniString(pattern), maxErrors);
+  LevenshteinAutomaton::State state = automaton.Start();
+  for (UniChar c : MakeUniString(s))
+    state = automaton.Step(state, c);
+  return state.m_distance;
+}
+
+bool Matches(char const * pattern, char const * s, uint32_t maxErrors)
+{
+  return LevenshteinAutomaton(MakeUniString(pattern), maxErrors).Matches(MakeUniString(s));
+}
+
+bool MatchesPrefix(char const * pattern, char const * s, uint32_t maxErrors)
+{
+  return LevenshteinAutomaton(MakeUniString(pattern), maxErrors).MatchesPrefix(MakeUniString(s));
+}
+
+// Inserts, deletes or replaces up to errors random symbols of word.
+UniString MakeTypo(UniString const & word, uint32_t errors, mt19937 & rng)
+{
+  vector<UniChar> s(word.begin(), word.end());
+  uniform_int_distribution<uint32_t> ops(0, 2);
+  uniform_int_distribution<UniChar> symbols('a', 'z');
+  for (uint32_t i = 0; i < errors && !s.empty(); ++i)
+  {
+    size_t const pos = uniform_int_distribution<size_t>(0, s.size() - 1)(rng);
+    switch (ops(rng))
+    {
+    case 0: s.insert(s.begin() + pos, symbols(rng)); break;
+    case 1: s.erase(s.begin() + pos); break;
+    default: s[pos] = symbols(rng); break;
+    }
+  }
+  return UniString(s.begin(), s.end());
+}
+
+void MakeQueries(vector<UniString> & words, vector<UniString> & queries)
+{
+  mt19937 rng(0);
+  for (char const * word : kCorpus)
+  {
+    words.push_back(MakeUniString(word));
+    for (uint32_t errors = 0; errors <= 3; ++errors)
+      queries.push_back(MakeTypo(words.back(), errors, rng));
+  }
+}
+
+}  // namespace
+
+UNIT_TEST(LevenshteinAutomaton_Distance)
+{
+  TEST_EQUAL(AutomatonDistance("", "", 0), 0, ());
+  TEST_EQUAL(AutomatonDistance("", "abc", 0), 3, ());
+  TEST_EQUAL(AutomatonDistance("abc", "", 0), 3, ());
+  TEST_EQUAL(AutomatonDistance("a", "b", 0), 1, ());
+  TEST_EQUAL(AutomatonDistance("ab", "ba", 0), 2, ());
+  TEST_EQUAL(AutomatonDistance("Hello!", "Helo!", 0), 1, ());
+  TEST_EQUAL(AutomatonDistance("kitten", "sitting", 0), 3, ());
+  TEST_EQUAL(AutomatonDistance("moscow", "moskva", 0), 3, ());
+}
+
+UNIT_TEST(LevenshteinAutomaton_Matches)
+{
+  TEST(Matches("moscow", "moscow", 0), ());
+  TEST(!Matches("moscow", "moscov", 0), ());
+  TEST(Matches("moscow", "moscov", 1), ());
+  TEST(Matches("moscow", "mosow", 1), ());
+  TEST(Matches("moscow", "mosscow", 1), ());
+  TEST(!Matches("moscow", "moskva", 2), ());
+  TEST(Matches("moscow", "moskva", 3), ());
+  TEST(!Matches("moscow", "moscowcity", 1), ());
+}
+
+UNIT_TEST(LevenshteinAutomaton_MatchesPrefix)
+{
+  TEST(MatchesPrefix("", "anything", 0), ());
+  TEST(MatchesPrefix("mos", "moscow", 0), ());
+  TEST(MatchesPrefix("moscow", "moscowcity", 0), ());
+  TEST(MatchesPrefix("mosk", "moscow", 1), ());
+  TEST(!MatchesPrefix("mosk", "moscow", 0), ());
+  TEST(!MatchesPrefix("london", "moscow", 2), ());
+}
+
+UNIT_TEST(LevenshteinAutomaton_CanMatch)
+{
+  LevenshteinAutomaton const automaton(MakeUniString("abc"), 1);
+  LevenshteinAutomaton::State state = automaton.Start();
+  TEST(automaton.CanMatch(state), ());
+
+  // "ax" can be continued to "axbc" or "axc".
+  state = automaton.Step(state, 'a');
+  state = automaton.Step(state, 'x');
+  TEST(automaton.CanMatch(state), ());
+  TEST(!automaton.IsAccepting(state), ());
+
+  // Every continuation of "axy" is at least two errors away.
+  state = automaton.Step(state, 'y');
+  TEST(!automaton.CanMatch(state), ());
+}
+
+UNIT_TEST(LevenshteinAutomaton_StringMatchCost)
+{
+  vector<UniString> words, queries;
+  MakeQueries(words, queries);
+
+  for (UniString const & query : queries)
+  {
+    for (uint32_t maxErrors = 0; maxErrors <= 2; ++maxErrors)
+    {
+      LevenshteinAutomaton const automaton(query, maxErrors);
+      for (UniString const & word : words)
+      {
+        uint32_t const cost = StringMatchCost(query.data(), query.size(), word.data(), word.size(),
+                                              UnitMatchCost(), maxErrors);
+        TEST_EQUAL(cost <= maxErrors, automaton.Matches(word), (query, word, maxErrors));
+
+        uint32_t const prefixCost = StringMatchCost(query.data(), query.size(), word.data(),
+                                                    word.size(), UnitMatchCost(), maxErrors,
+                                                    true /* bPrefixMatch */);
+        TEST_EQUAL(prefixCost <= maxErrors, automaton.MatchesPrefix(word),
+                   (query, word, maxErrors));
+      }
+    }
+  }
+}
+
+#ifndef DEBUG
+BENCHMARK_TEST(StringMatchCost_Corpus)
+{
+  vector<UniString> words, queries;
+  MakeQueries(words, queries);
+
+  size_t matches = 0;
+  BENCHMARK_N_TIMES(100, 10.0)
+  {
+    for (UniString const & query : queries)
+    {
+      for (UniString const & word : words)
+      {
+        if (StringMatchCost(query.data(), query.size(), word.data(), word.size(),
+                            DefaultMatchCost(), 2 * 256) <= 2 * 256)
+          ++matches;
+      }
+    }
+  }
+  FORCE_USE_VALUE(matches);
+}
+
+BENCHMARK_TEST(LevenshteinAutomaton_Corpus)
+{
+  vector<UniString> words, queries;
+  MakeQueries(words, queries);
+
+  size_t matches = 0;
+  BENCHMARK_N_TIMES(100, 10.0)
+  {
+    for (UniString const & query : queries)
+    {
+      LevenshteinAutomaton const automaton(query, 2);
+      for (UniString const & word : words)
+      {
+        if (automaton.Matches(word))
+          ++matches;
+      }
+    }
+  }
+  FORCE_USE_VALUE(matches);
+}
+#endif
@@ -0,0 +1,125 @@
+#include "testing/testing.hpp"
+
+#include "search/feature_offset_match.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+#include "std/unordered_set.hpp"
+#include "std/vector.hpp"
+
+using namespace search;
+
+namespace
+{
+using TValue = trie::ValueReader::ValueType;
+
+struct OddFilter
+{
+  bool operator()(uint32_t featureId) const { return featureId % 2 == 1; }
+};
+
+struct EmptyFilter
+{
+  bool operator()(uint32_t /* featureId */) const { return true; }
+};
+
+TValue MakeValue(uint32_t featureId)
+{
+  TValue v;
+  v.m_featureId = featureId;
+  v.m_rank = 0;
+  return v;
+}
+
+template <class TFilter>
+vector<uint32_t> Intersect(vector<vector<uint32_t>> const & steps, TFilter const & filter)
+{
+  search::impl::OffsetIntersecter<TFilter> intersecter(filter);
+  for (auto const & step : steps)
+  {
+    for (uint32_t featureId : step)
+      intersecter(MakeValue(featureId));
+    intersecter.NextStep();
+  }
+
+  vector<uint32_t> result;
+  intersecter.ForEachResult([&result](TValue const & v) { result.push_back(v.m_featureId); });
+  return result;
+}
+
+template <class TFilter>
+vector<uint32_t> IntersectNaive(vector<vector<uint32_t>> const & steps, TFilter const & filter)
+{
+  unordered_set<uint32_t> prev;
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    unordered_set<uint32_t> curr;
+    for (uint32_t featureId : steps[i])
+    {
+      if ((i == 0 || prev.count(featureId)) && filter(featureId))
+        curr.insert(featureId);
+    }
+    prev.swap(curr);
+  }
+
+  vector<uint32_t> result(prev.begin(), prev.end());
+  sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(OffsetIntersecter_Smoke)
+{
+  EmptyFilter const filter;
+  TEST(Intersect({}, filter).empty(), ());
+  TEST_EQUAL(Intersect({{3, 1, 2, 1}}, filter), vector<uint32_t>({1, 2, 3}), ());
+  TEST_EQUAL(Intersect({{3, 1, 2}, {2, 5, 3}}, filter), vector<uint32_t>({2, 3}), ());
+  TEST(Intersect({{3, 1, 2}, {4, 5}, {1, 2, 3}}, filter).empty(), ());
+  TEST_EQUAL(Intersect({{3, 1, 2}, {2, 5, 3}}, OddFilter()), vector<uint32_t>({3}), ());
+}
+
+UNIT_TEST(OffsetIntersecter_KeepsFirstValue)
+{
+  EmptyFilter const filter;
+  search::impl::OffsetIntersecter<EmptyFilter> intersecter(filter);
+  TValue v = MakeValue(7);
+  v.m_rank = 1;
+  intersecter(v);
+  v.m_rank = 2;
+  intersecter(v);
+  intersecter.NextStep();
+
+  size_t count = 0;
+  intersecter.ForEachResult([&count](TValue const & value)
+  {
+    TEST_EQUAL(value.m_rank, 1, ());
+    ++count;
+  });
+  TEST_EQUAL(count, 1, ());
+}
+
+UNIT_TEST(OffsetIntersecter_Random)
+{
+  mt19937 rng(0);
+  // Dense, sparse and small sets go through different lookup paths.
+  for (uint32_t maxId : {100u, 10000u, 10000000u})
+  {
+    for (size_t stepSize : {size_t(10), size_t(1000), size_t(50000)})
+    {
+      uniform_int_distribution<uint32_t> ids(0, maxId);
+      vector<vector<uint32_t>> steps(3);
+      for (auto & step : steps)
+      {
+        for (size_t i = 0; i < stepSize; ++i)
+          step.push_back(ids(rng));
+        // Values of a trie node come sorted, so mix sorted runs with random ones.
+        sort(step.begin(), step.begin() + step.size() / 2);
+      }
+
+      TEST_EQUAL(Intersect(steps, EmptyFilter()), IntersectNaive(steps, EmptyFilter()),
+                 (maxId, stepSize));
+      TEST_EQUAL(Intersect(steps, OddFilter()), IntersectNaive(steps, OddFilter()),
+                 (maxId, stepSize));
+    }
+  }
+}
@@ -17,11 +17,14 @@ macx-*: LIBS *= "-framework IOKit"
 SOURCES += \
     ../../testing/testingmain.cpp \
     algos_tests.cpp \
+    fuzzy_trie_match_test.cpp \
     house_detector_tests.cpp \
     keyword_lang_matcher_test.cpp \
     keyword_matcher_test.cpp \
     latlon_match_test.cpp \
+    levenshtein_automaton_test.cpp \
     locality_finder_test.cpp \
+    offset_intersecter_test.cpp \
     query_saver_tests.cpp \
     string_intersection_test.cpp \
     string_match_test.cpp \
@@ -5,7 +5,10 @@
 #endif
 
 #include <exception>
+using std::current_exception;
 using std::exception;
+using std::exception_ptr;
+using std::rethrow_exception;
 using std::logic_error;
 using std::runtime_error;
 
@@ -0,0 +1,238 @@
+#include "storage/countries_grid.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/math.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+
+namespace storage
+{
+namespace
+{
+// Margin in cells to mark cells touched by polygon edges conservatively.
+double constexpr kEps = 1e-6;
+
+// Grid of cells [c0, c0 + width) x [r0, r0 + height) of one country.
+class CountryRaster
+{
+public:
+  CountryRaster(int c0, int r0, int width, int height)
+    : m_c0(c0), m_r0(r0), m_width(width), m_height(height),
+      m_border(width * height, false), m_inside(width * height, false), m_crossings(height)
+  {
+  }
+
+  // Points are in cell units.
+  void AddPolygon(vector<m2::PointD> const & points)
+  {
+    size_t const count = points.size();
+    if (count < 3)
+      return;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      m2::PointD const & a = points[i];
+      m2::PointD const & b = points[(i + 1) % count];
+      MarkBorder(a, b);
+      AddCrossings(a, b);
+    }
+
+    // Cell is inside the polygon when odd number of edges cross the horizontal ray
+    // from its center to the left.
+    for (int r = 0; r < m_height; ++r)
+    {
+      vector<double> & xs = m_crossings[r];
+      sort(xs.begin(), xs.end());
+      for (size_t i = 0; i + 1 < xs.size(); i += 2)
+      {
+        int const from = max(static_cast<int>(ceil(xs[i] - 0.5)) - m_c0, 0);
+        int const to = min(static_cast<int>(ceil(xs[i + 1] - 0.5)) - m_c0, m_width);
+        for (int c = from; c < to; ++c)
+          m_inside[r * m_width + c] = true;
+      }
+      xs.clear();
+    }
+  }
+
+  // Calls toDo(column, row, covers) for all cells intersecting the country.
+  template <typename ToDo>
+  void ForEachCell(ToDo && toDo) const
+  {
+    for (int r = 0; r < m_height; ++r)
+    {
+      for (int c = 0; c < m_width; ++c)
+      {
+        size_t const i = r * m_width + c;
+        if (m_border[i])
+          toDo(m_c0 + c, m_r0 + r, false);
+        else if (m_inside[i])
+          toDo(m_c0 + c, m_r0 + r, true);
+      }
+    }
+  }
+
+private:
+  int ClampColumn(double x) const
+  {
+    return my::clamp(static_cast<int>(floor(x)) - m_c0, 0, m_width - 1);
+  }
+
+  int ClampRow(double y) const
+  {
+    return my::clamp(static_cast<int>(floor(y)) - m_r0, 0, m_height - 1);
+  }
+
+  void MarkBorder(m2::PointD a, m2::PointD b)
+  {
+    if (a.x > b.x)
+      swap(a, b);
+
+    int const from = ClampColumn(a.x - kEps);
+    int const to = ClampColumn(b.x + kEps);
+    double const dx = b.x - a.x;
+    for (int c = from; c <= to; ++c)
+    {
+      // Part of the segment inside the column.
+      double y1 = a.y;
+      double y2 = b.y;
+      if (dx > 0)
+      {
+        double const x1 = max(a.x, static_cast<double>(m_c0 + c));
+        double const x2 = min(b.x, static_cast<double>(m_c0 + c + 1));
+        y1 = a.y + (b.y - a.y) * (x1 - a.x) / dx;
+        y2 = a.y + (b.y - a.y) * (x2 - a.x) / dx;
+      }
+      if (y1 > y2)
+        swap(y1, y2);
+
+      int const rowTo = ClampRow(y2 + kEps);
+      for (int r = ClampRow(y1 - kEps); r <= rowTo; ++r)
+        m_border[r * m_width + c] = true;
+    }
+  }
+
+  void AddCrossings(m2::PointD const & a, m2::PointD const & b)
+  {
+    if (a.y == b.y)
+      return;
+
+    // Rows with centers in [min(a.y, b.y), max(a.y, b.y)).
+    int const from = max(static_cast<int>(ceil(min(a.y, b.y) - 0.5)) - m_r0, 0);
+    int const to = min(static_cast<int>(ceil(max(a.y, b.y) - 0.5)) - m_r0, m_height);
+    for (int r = from; r < to; ++r)
+    {
+      double const y = m_r0 + r + 0.5;
+      m_crossings[r].push_back(a.x + (b.x - a.x) * (y - a.y) / (b.y - a.y));
+    }
+  }
+
+  int const m_c0;
+  int const m_r0;
+  int const m_width;
+  int const m_height;
+
+  vector<bool> m_border;
+  vector<bool> m_inside;
+  vector<vector<double>> m_crossings;
+};
+}  // namespace
+
+// static
+uint32_t constexpr CountriesGrid::kDefaultSize;
+
+CountriesGrid::CountriesGrid(uint32_t size)
+  : m_size(size), m_rect(MercatorBounds::FullRect()), m_cellWidth(m_rect.SizeX() / size),
+    m_cellHeight(m_rect.SizeY() / size)
+{
+  ASSERT_GREATER(m_size, 0, ());
+}
+
+void CountriesGrid::Add(IdType id, vector<m2::RegionD> const & regions)
+{
+  ASSERT(m_offsets.empty(), ("Grid is already finished."));
+
+  m2::RectD rect;
+  for (auto const & region : regions)
+    rect.Add(region.GetRect());
+  if (!rect.IsValid())
+    return;
+
+  int const c0 = GetColumn(rect.minX());
+  int const r0 = GetRow(rect.minY());
+  CountryRaster raster(c0, r0, GetColumn(rect.maxX()) - c0 + 1, GetRow(rect.maxY()) - r0 + 1);
+
+  vector<m2::PointD> points;
+  for (auto const & region : regions)
+  {
+    points.clear();
+    region.ForEachPoint([this, &points](m2::PointD const & p)
+    {
+      points.emplace_back((p.x - m_rect.minX()) / m_cellWidth, (p.y - m_rect.minY()) / m_cellHeight);
+    });
+    raster.AddPolygon(points);
+  }
+
+  uint32_t const entry = static_cast<uint32_t>(id) << 1;
+  raster.ForEachCell([this, entry](int c, int r, bool covers)
+  {
+    m_cellEntries.emplace_back(static_cast<uint32_t>(r) * m_size + c, entry | (covers ? 1 : 0));
+  });
+}
+
+void CountriesGrid::Finish()
+{
+  // Entries of a cell are ordered by ids since ids come in increasing order.
+  stable_sort(m_cellEntries.begin(), m_cellEntries.end(),
+              [](pair<uint32_t, uint32_t> const & e1, pair<uint32_t, uint32_t> const & e2)
+              {
+                return e1.first < e2.first;
+              });
+
+  m_offsets.assign(m_size * m_size + 1, 0);
+  for (auto const & e : m_cellEntries)
+    ++m_offsets[e.first + 1];
+  for (size_t i = 1; i < m_offsets.size(); ++i)
+    m_offsets[i] += m_offsets[i - 1];
+
+  m_entries.resize(m_cellEntries.size());
+  for (size_t i = 0; i < m_cellEntries.size(); ++i)
+    m_entries[i] = m_cellEntries[i].second;
+
+  vector<pair<uint32_t, uint32_t>>().swap(m_cellEntries);
+}
+
+void CountriesGrid::GetStatistics(size_t & covered, size_t & border, size_t & empty) const
+{
+  covered = border = empty = 0;
+  for (size_t cell = 0; cell + 1 < m_offsets.size(); ++cell)
+  {
+    if (m_offsets[cell] == m_offsets[cell + 1])
+    {
+      ++empty;
+      continue;
+    }
+
+    bool isCovered = false;
+    for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+      isCovered = isCovered || (m_entries[i] & 1) != 0;
+    if (isCovered)
+      ++covered;
+    else
+      ++border;
+  }
+}
+
+uint32_t CountriesGrid::GetColumn(double x) const
+{
+  double const c = floor((x - m_rect.minX()) / m_cellWidth);
+  return static_cast<uint32_t>(my::clamp(c, 0.0, static_cast<double>(m_size - 1)));
+}
+
+uint32_t CountriesGrid::GetRow(double y) const
+{
+  double const r = floor((y - m_rect.minY()) / m_cellHeight);
+  return static_cast<uint32_t>(my::clamp(r, 0.0, static_cast<double>(m_size - 1)));
+}
+}  // namespace storage
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace storage
+{
+// Uniform grid over the whole mercator plane for fast point-in-country queries.
+//
+// Every cell keeps the countries whose polygons intersect it, ordered by id. A country
+// is marked as covering the cell when the cell lies entirely inside one of its polygons,
+// so only cells crossed by polygon borders need exact point-in-polygon tests.
+class CountriesGrid
+{
+public:
+  using IdType = size_t;
+
+  static uint32_t constexpr kDefaultSize = 512;
+
+  explicit CountriesGrid(uint32_t size = kDefaultSize);
+
+  // Adds country |id| with outer polygons |regions|. Ids should be added in increasing order.
+  void Add(IdType id, vector<m2::RegionD> const & regions);
+
+  // Packs the grid, must be called after all countries are added.
+  void Finish();
+
+  // Calls |toDo(id, covers)| for all countries of the cell containing |pt| in the order of
+  // their ids while |toDo| returns true. |covers| is true when the whole cell is inside
+  // the country.
+  template <typename ToDo>
+  void ForEachCandidate(m2::PointD const & pt, ToDo && toDo) const
+  {
+    ASSERT(!m_offsets.empty(), ("Finish() is not called."));
+    uint32_t const cell = GetRow(pt.y) * m_size + GetColumn(pt.x);
+    for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+    {
+      if (!toDo(static_cast<IdType>(m_entries[i] >> 1), (m_entries[i] & 1) != 0))
+        return;
+    }
+  }
+
+  inline uint32_t GetSize() const { return m_size; }
+
+  // Returns numbers of cells fully covered by a country, cells with borders and empty cells.
+  void GetStatistics(size_t & covered, size_t & border, size_t & empty) const;
+
+private:
+  uint32_t GetColumn(double x) const;
+  uint32_t GetRow(double y) const;
+
+  uint32_t const m_size;
+  m2::RectD const m_rect;
+  double const m_cellWidth;
+  double const m_cellHeight;
+
+  // Cell entries of countries added so far, packed into m_offsets and m_entries by Finish().
+  vector<pair<uint32_t, uint32_t>> m_cellEntries;
+
+  // Entries of cell c are [m_offsets[c], m_offsets[c + 1]) in m_entries.
+  // Entry is (id << 1) | covers.
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_entries;
+};
+}  // namespace storage
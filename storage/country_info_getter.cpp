@@ -8,8 +8,11 @@
 
 #include "coding/read_write_utils.hpp"
 
+#include "base/logging.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/function.hpp"
 #include "std/limits.hpp"
@@ -112,12 +115,15 @@ void CountryInfoGetter::GetMatchedRegions(string const & enNamePrefix, IdSet & r
 
 bool CountryInfoGetter::IsBelongToRegions(m2::PointD const & pt, IdSet const & regions) const
 {
-  for (auto const & id : regions)
+  bool result = false;
+  GetGrid().ForEachCandidate(pt, [&](IdType id, bool covers)
   {
-    if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegion(id, pt))
+    if (find(regions.begin(), regions.end(), id) == regions.end())
       return true;
-  }
-  return false;
+    result = covers || (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegion(id, pt));
+    return !result;
+  });
+  return result;
 }
 
 bool CountryInfoGetter::IsBelongToRegions(string const & fileName, IdSet const & regions) const
@@ -148,16 +154,7 @@ bool CountryInfoGetter::IsBelongToRegion(size_t id, m2::PointD const & pt) const
   if (!isFound)
   {
     rgns.clear();
-    // Load regions from file.
-    ReaderSource<ModelReaderPtr> src(m_reader.GetReader(strings::to_string(id)));
-
-    uint32_t const count = ReadVarUint<uint32_t>(src);
-    for (size_t i = 0; i < count; ++i)
-    {
-      vector<m2::PointD> points;
-      serial::LoadOuterPath(src, serial::CodingParams(), points);
-      rgns.emplace_back(move(points));
-    }
+    LoadRegions(id, rgns);
   }
 
   for (auto const & rgn : rgns)
@@ -168,14 +165,53 @@ bool CountryInfoGetter::IsBelongToRegion(size_t id, m2::PointD const & pt) const
   return false;
 }
 
-CountryInfoGetter::IdType CountryInfoGetter::FindFirstCountry(m2::PointD const & pt) const
+void CountryInfoGetter::LoadRegions(size_t id, vector<m2::RegionD> & rgns) const
 {
-  for (size_t id = 0; id < m_countries.size(); ++id)
+  ReaderSource<ModelReaderPtr> src(m_reader.GetReader(strings::to_string(id)));
+
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  for (size_t i = 0; i < count; ++i)
   {
-    if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegion(id, pt))
-      return id;
+    vector<m2::PointD> points;
+    serial::LoadOuterPath(src, serial::CodingParams(), points);
+    rgns.emplace_back(move(points));
   }
-  return kInvalidId;
+}
+
+CountriesGrid const & CountryInfoGetter::GetGrid() const
+{
+  call_once(m_gridFlag, [this]()
+  {
+    my::Timer timer;
+    vector<m2::RegionD> rgns;
+    for (size_t id = 0; id < m_countries.size(); ++id)
+    {
+      rgns.clear();
+      {
+        lock_guard<mutex> lock(m_cacheMutex);
+        LoadRegions(id, rgns);
+      }
+      m_grid.Add(id, rgns);
+    }
+    m_grid.Finish();
+    LOG(LDEBUG, ("Countries grid is built in", timer.ElapsedSeconds(), "seconds"));
+  });
+  return m_grid;
+}
+
+CountryInfoGetter::IdType CountryInfoGetter::FindFirstCountry(m2::PointD const & pt) const
+{
+  IdType result = kInvalidId;
+  GetGrid().ForEachCandidate(pt, [&](IdType id, bool covers)
+  {
+    if (covers || (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegion(id, pt)))
+    {
+      result = id;
+      return false;
+    }
+    return true;
+  });
+  return result;
 }
 
 template <typename ToDo>
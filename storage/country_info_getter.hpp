@@ -1,5 +1,6 @@
 #pragma once
 
+#include "storage/countries_grid.hpp"
 #include "storage/country_decl.hpp"
 
 #include "geometry/region2d.hpp"
@@ -64,6 +65,12 @@ private:
   // Returns true when |pt| belongs to a country identified by |id|.
   bool IsBelongToRegion(size_t id, m2::PointD const & pt) const;
 
+  // Reads polygons of a country identified by |id|.
+  void LoadRegions(size_t id, vector<m2::RegionD> & rgns) const;
+
+  // Returns the grid, builds it on the first call.
+  CountriesGrid const & GetGrid() const;
+
   // Returns identifier of a first country containing |pt|.
   IdType FindFirstCountry(m2::PointD const & pt) const;
 
@@ -81,5 +88,11 @@ private:
   FilesContainerR m_reader;
   mutable my::Cache<uint32_t, vector<m2::RegionD>> m_cache;
   mutable mutex m_cacheMutex;
+
+  // Countries by grid cells, so polygons are tested only for points near
+  // country borders. It's built on the first lookup by point, because
+  // all the polygons are decoded for it.
+  mutable CountriesGrid m_grid;
+  mutable once_flag m_gridFlag;
 };
 }  // namespace storage
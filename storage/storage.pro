@@ -11,6 +11,7 @@ include($$ROOT_DIR/common.pri)
 INCLUDEPATH += $$ROOT_DIR/3party/jansson/src
 
 HEADERS += \
+  countries_grid.hpp \
   country.hpp \
   country_decl.hpp \
   country_info_getter.hpp \
@@ -24,6 +25,7 @@ HEADERS += \
   storage_defines.hpp \
 
 SOURCES += \
+  countries_grid.cpp \
   country.cpp \
   country_decl.cpp \
   country_info_getter.cpp \
@@ -0,0 +1,134 @@
+#include "testing/testing.hpp"
+
+#include "storage/countries_grid.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "std/cmath.hpp"
+#include "std/limits.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+
+using namespace storage;
+
+namespace
+{
+using TId = CountriesGrid::IdType;
+
+TId const kNoCountry = numeric_limits<TId>::max();
+
+m2::RegionD MakeRegion(vector<m2::PointD> const & points)
+{
+  return m2::RegionD(points.begin(), points.end());
+}
+
+TId FindByGrid(CountriesGrid const & grid, vector<vector<m2::RegionD>> const & countries,
+               m2::PointD const & pt)
+{
+  TId result = kNoCountry;
+  grid.ForEachCandidate(pt, [&](TId id, bool covers)
+  {
+    bool isInside = covers;
+    for (size_t i = 0; i < countries[id].size() && !isInside; ++i)
+      isInside = countries[id][i].Contains(pt);
+    if (isInside)
+      result = id;
+    return !isInside;
+  });
+  return result;
+}
+
+TId FindNaive(vector<vector<m2::RegionD>> const & countries, m2::PointD const & pt)
+{
+  for (TId id = 0; id < countries.size(); ++id)
+  {
+    for (auto const & region : countries[id])
+    {
+      if (region.Contains(pt))
+        return id;
+    }
+  }
+  return kNoCountry;
+}
+}  // namespace
+
+UNIT_TEST(CountriesGrid_Smoke)
+{
+  vector<vector<m2::RegionD>> countries(2);
+  // Big square and a triangle intersecting it.
+  countries[0].push_back(MakeRegion({{-100, -100}, {100, -100}, {100, 100}, {-100, 100}}));
+  countries[1].push_back(MakeRegion({{50, 0}, {170, 0}, {50, 120}}));
+
+  CountriesGrid grid(64);
+  for (TId id = 0; id < countries.size(); ++id)
+    grid.Add(id, countries[id]);
+  grid.Finish();
+
+  // Cells in the middle of the square don't need polygon tests.
+  size_t count = 0;
+  grid.ForEachCandidate(m2::PointD(0, 0), [&count](TId id, bool covers)
+  {
+    TEST_EQUAL(id, 0, ());
+    TEST(covers, ());
+    ++count;
+    return true;
+  });
+  TEST_EQUAL(count, 1, ());
+
+  grid.ForEachCandidate(m2::PointD(-170, -170), [](TId, bool)
+  {
+    TEST(false, ("There are no countries."));
+    return true;
+  });
+
+  size_t covered, border, empty;
+  grid.GetStatistics(covered, border, empty);
+  TEST_EQUAL(covered + border + empty, 64 * 64, ());
+  TEST_GREATER(covered, border, ());
+
+  TEST_EQUAL(FindByGrid(grid, countries, m2::PointD(99, 10)), 0, ());
+  TEST_EQUAL(FindByGrid(grid, countries, m2::PointD(101, 10)), 1, ());
+  TEST_EQUAL(FindByGrid(grid, countries, m2::PointD(101, 110)), kNoCountry, ());
+}
+
+UNIT_TEST(CountriesGrid_Random)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(MercatorBounds::minX, MercatorBounds::maxX);
+  uniform_real_distribution<double> size(0.1, 50.0);
+  uniform_int_distribution<int> vertices(3, 12);
+
+  // Random star-shaped polygons, some of them are split into several parts.
+  vector<vector<m2::RegionD>> countries(50);
+  for (auto & country : countries)
+  {
+    for (int part = uniform_int_distribution<int>(1, 3)(rng); part > 0; --part)
+    {
+      m2::PointD const center(coord(rng), coord(rng));
+      int const count = vertices(rng);
+      vector<m2::PointD> points;
+      for (int i = 0; i < count; ++i)
+      {
+        double const angle = 2 * math::pi * i / count;
+        double const r = size(rng);
+        points.emplace_back(center.x + r * cos(angle), center.y + r * sin(angle));
+      }
+      country.push_back(MakeRegion(points));
+    }
+  }
+
+  for (uint32_t gridSize : {1u, 7u, 256u})
+  {
+    CountriesGrid grid(gridSize);
+    for (TId id = 0; id < countries.size(); ++id)
+      grid.Add(id, countries[id]);
+    grid.Finish();
+
+    for (size_t i = 0; i < 20000; ++i)
+    {
+      m2::PointD const pt(coord(rng), coord(rng));
+      TEST_EQUAL(FindByGrid(grid, countries, pt), FindNaive(countries, pt), (gridSize, pt));
+    }
+  }
+}
@@ -1,14 +1,23 @@
 #include "testing/testing.hpp"
+#include "testing/benchmark.hpp"
 
 #include "storage/country_info_getter.hpp"
 #include "storage/country.hpp"
+#include "storage/country_polygon.hpp"
+
+#include "indexer/geometry_serialization.hpp"
 
 #include "geometry/mercator.hpp"
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
+
 #include "base/logging.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
 
+#include "std/random.hpp"
 #include "std/unique_ptr.hpp"
 
 
@@ -23,6 +32,64 @@ unique_ptr<CountryInfoGetter> CreateCountryInfoGetter()
                                         platform.GetReader(COUNTRIES_FILE));
 }
 
+// Countries polygons and names for brute force point lookup.
+class AllCountries
+{
+public:
+  AllCountries()
+  {
+    FilesContainerR const reader(GetPlatform().GetReader(PACKED_POLYGONS_FILE));
+    vector<CountryDef> countries;
+    {
+      ReaderSource<ModelReaderPtr> src(reader.GetReader(PACKED_POLYGONS_INFO_TAG));
+      rw::Read(src, countries);
+    }
+
+    m_regions.resize(countries.size());
+    for (size_t id = 0; id < countries.size(); ++id)
+    {
+      m_names.push_back(countries[id].m_name);
+
+      ReaderSource<ModelReaderPtr> src(reader.GetReader(strings::to_string(id)));
+      uint32_t const count = ReadVarUint<uint32_t>(src);
+      for (size_t i = 0; i < count; ++i)
+      {
+        vector<m2::PointD> points;
+        serial::LoadOuterPath(src, serial::CodingParams(), points);
+        m_regions[id].emplace_back(move(points));
+      }
+    }
+  }
+
+  string GetRegionFile(m2::PointD const & pt) const
+  {
+    for (size_t id = 0; id < m_regions.size(); ++id)
+    {
+      for (auto const & region : m_regions[id])
+      {
+        if (region.GetRect().IsPointInside(pt) && region.Contains(pt))
+          return m_names[id];
+      }
+    }
+    return string();
+  }
+
+private:
+  vector<string> m_names;
+  vector<vector<m2::RegionD>> m_regions;
+};
+
+vector<m2::PointD> MakeRandomPoints(size_t count)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> lat(-80.0, 80.0);
+  uniform_real_distribution<double> lon(-180.0, 180.0);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(MercatorBounds::FromLatLon(lat(rng), lon(rng)));
+  return points;
+}
+
 bool IsEmptyName(map<string, CountryInfo> const & id2info, string const & id)
 {
   auto const it = id2info.find(id);
@@ -79,3 +146,56 @@ UNIT_TEST(CountryInfoGetter_SomeRects)
 
   LOG(LINFO, ("Canada: ", getter->CalcLimitRect("Canada_")));
 }
+
+UNIT_TEST(CountryInfoGetter_RandomPoints)
+{
+  auto const getter = CreateCountryInfoGetter();
+  AllCountries const countries;
+
+  size_t found = 0;
+  for (m2::PointD const & pt : MakeRandomPoints(5000))
+  {
+    string const name = countries.GetRegionFile(pt);
+    TEST_EQUAL(getter->GetRegionFile(pt), name, (MercatorBounds::ToLatLon(pt)));
+    if (!name.empty())
+      ++found;
+  }
+  LOG(LINFO, ("Points in countries:", found));
+  TEST_GREATER(found, 0, ());
+}
+
+#ifndef DEBUG
+BENCHMARK_TEST(CountryInfoGetter_GetRegionFile)
+{
+  auto const getter = CreateCountryInfoGetter();
+  vector<m2::PointD> const points = MakeRandomPoints(10000);
+
+  size_t found = 0;
+  BENCHMARK_N_TIMES(10, 10.0)
+  {
+    for (m2::PointD const & pt : points)
+    {
+      if (!getter->GetRegionFile(pt).empty())
+        ++found;
+    }
+  }
+  FORCE_USE_VALUE(found);
+}
+
+BENCHMARK_TEST(CountryInfoGetter_BruteForce)
+{
+  AllCountries const countries;
+  vector<m2::PointD> const points = MakeRandomPoints(10000);
+
+  size_t found = 0;
+  BENCHMARK_N_TIMES(10, 10.0)
+  {
+    for (m2::PointD const & pt : points)
+    {
+      if (!countries.GetRegionFile(pt).empty())
+        ++found;
+    }
+  }
+  FORCE_USE_VALUE(found);
+}
+#endif
@@ -29,6 +29,7 @@ HEADERS += \
 
 SOURCES += \
   ../../testing/testingmain.cpp \
+  countries_grid_test.cpp \
   country_info_getter_test.cpp \
   fake_map_files_downloader.cpp \
   queued_country_tests.cpp \